@@ -32,16 +32,45 @@ SPDX-License-Identifier: MIT
 
 */
 
+#ifndef HAGL_CONFIG_H
+#define HAGL_CONFIG_H
+
 #ifdef HAGL_INCLUDE_SDKCONFIG_H
 #include "sdkconfig.h"
 
-#ifdef CONFIG_HAGL_TJPGD_NEEDS_BYTESWAP
-#define TJPGD_NEEDS_BYTESWAP
-#endif /* CONFIG_HAGL_TJPGD_NEEDS_BYTESWAP */
+#ifdef CONFIG_HAGL_PIXEL_FORMAT
+#define HAGL_PIXEL_FORMAT CONFIG_HAGL_PIXEL_FORMAT
+#endif /* CONFIG_HAGL_PIXEL_FORMAT */
+
+#ifdef CONFIG_HAGL_CHAR_BUFFER_SIZE
+#define HAGL_CHAR_BUFFER_SIZE CONFIG_HAGL_CHAR_BUFFER_SIZE
+#endif /* CONFIG_HAGL_CHAR_BUFFER_SIZE */
+
+#ifdef CONFIG_HAGL_BLIT_BUFFER_SIZE
+#define HAGL_BLIT_BUFFER_SIZE CONFIG_HAGL_BLIT_BUFFER_SIZE
+#endif /* CONFIG_HAGL_BLIT_BUFFER_SIZE */
+
+#ifdef CONFIG_HAGL_SHADER_BUFFER_SIZE
+#define HAGL_SHADER_BUFFER_SIZE CONFIG_HAGL_SHADER_BUFFER_SIZE
+#endif /* CONFIG_HAGL_SHADER_BUFFER_SIZE */
+
+#ifdef CONFIG_HAGL_IMAGE_BUFFER_SIZE
+#define HAGL_IMAGE_BUFFER_SIZE CONFIG_HAGL_IMAGE_BUFFER_SIZE
+#endif /* CONFIG_HAGL_IMAGE_BUFFER_SIZE */
+
+#ifdef CONFIG_HAGL_IMAGE_WORK_SIZE
+#define HAGL_IMAGE_WORK_SIZE CONFIG_HAGL_IMAGE_WORK_SIZE
+#endif /* CONFIG_HAGL_IMAGE_WORK_SIZE */
+
+#ifdef CONFIG_HAGL_IMAGE_PNG_WORK_SIZE
+#define HAGL_IMAGE_PNG_WORK_SIZE CONFIG_HAGL_IMAGE_PNG_WORK_SIZE
+#endif /* CONFIG_HAGL_IMAGE_PNG_WORK_SIZE */
 
 #else
 
 /* If you don't use menuconfig change the settings here. */
-#define TJPGD_NEEDS_BYTESWAP
+/* #define HAGL_PIXEL_FORMAT HAGL_FORMAT_RGB565 */
 
 #endif /* HAGL_INCLUDE_SDKCONFIG_H */
+
+#endif /* HAGL_CONFIG_H */
@@ -38,6 +38,9 @@ SPDX-License-Identifier: MIT
 #include <stddef.h>
 #include <stdint.h>
 
+#include "hagl/antialias.h"
+#include "hagl/arc.h"
+#include "hagl/bezier.h"
 #include "hagl/backend.h"
 #include "hagl/bitmap.h"
 #include "hagl/blit.h"
@@ -51,6 +54,8 @@ SPDX-License-Identifier: MIT
 #include "hagl/pixel.h"
 #include "hagl/polygon.h"
 #include "hagl/rectangle.h"
+#include "hagl/shader.h"
+#include "hagl/span.h"
 #include "hagl/surface.h"
 #include "hagl/triangle.h"
 #include "hagl/vline.h"
@@ -62,7 +67,10 @@ extern "C" {
 
 #define ABS(x) ((x) > 0 ? (x) : -(x))
 
-/* If you want to use bigger fonts than 6x9 you need to define this. */
+/*
+ * Size in bytes of the glyph scratch buffer hagl_put_char() allocates from
+ * the stack. Bigger glyphs are drawn in several strips.
+ */
 #ifndef HAGL_CHAR_BUFFER_SIZE
 #define HAGL_CHAR_BUFFER_SIZE (6 * 9 * 2)
 #endif
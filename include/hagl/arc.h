@@ -0,0 +1,145 @@
+
+/*
+
+MIT License
+
+Copyright (c) 2018-2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef HAGL_ARC_H
+#define HAGL_ARC_H
+
+#include <stdint.h>
+
+#include "hagl/color.h"
+#include "hagl/span.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+Angles are degrees in 16.16 fixed point. Zero degrees points right and
+angles grow clockwise. Shape goes clockwise from start to end angle and
+wraps around if end is smaller than start. Equal angles draw nothing and
+end at least full turn after start draws the whole circle. Pixels are
+inside when their centers are inside the angle.
+*/
+#define HAGL_DEGREES(degrees) ((int32_t)((degrees) * 65536))
+
+/**
+ * Draw an arc
+ *
+ * Arc is the outer edge of hagl_fill_pie() with the same radius. Full
+ * arc differs from hagl_draw_circle() by a few pixels near the
+ * diagonals. Output will be clipped to the current clip window.
+ *
+ * @param surface
+ * @param x0 center X
+ * @param y0 center Y
+ * @param r radius
+ * @param start start angle
+ * @param end end angle
+ * @param color
+ */
+void hagl_draw_arc(
+    void const *surface, int16_t x0, int16_t y0, int16_t r, int32_t start, int32_t end,
+    hagl_color_t color
+);
+
+/**
+ * Draw a filled pie
+ *
+ * Pie has the same pixels as hagl_fill_circle() between the start and
+ * end angles. Output will be clipped to the current clip window.
+ *
+ * @param surface
+ * @param x0 center X
+ * @param y0 center Y
+ * @param r radius
+ * @param start start angle
+ * @param end end angle
+ * @param color
+ */
+void hagl_fill_pie(
+    void const *surface, int16_t x0, int16_t y0, int16_t r, int32_t start, int32_t end,
+    hagl_color_t color
+);
+
+/**
+ * Draw a filled ring
+ *
+ * Ring is a filled circle with radius r1 with the filled circle with
+ * radius r0 - 1 removed from the middle, between the start and end
+ * angles. Inner radius of zero draws a pie. Output will be clipped to
+ * the current clip window.
+ *
+ * @param surface
+ * @param x0 center X
+ * @param y0 center Y
+ * @param r0 inner radius
+ * @param r1 outer radius
+ * @param start start angle
+ * @param end end angle
+ * @param color
+ */
+void hagl_fill_ring(
+    void const *surface, int16_t x0, int16_t y0, int16_t r0, int16_t r1, int32_t start,
+    int32_t end, hagl_color_t color
+);
+
+/**
+ * Fill a ring with a span callback
+ *
+ * Ring is drawn in one pass from top to bottom. Each row has at most
+ * three spans which are passed to the callback from left to right. Rows
+ * outside of the clip window are skipped, spans are not clipped
+ * horizontally.
+ *
+ * @param surface
+ * @param x0 center X
+ * @param y0 center Y
+ * @param r0 inner radius
+ * @param r1 outer radius
+ * @param start start angle
+ * @param end end angle
+ * @param span span callback
+ * @param paint passed to the span callback
+ */
+void hagl_fill_ring_span(
+    void const *surface, int16_t x0, int16_t y0, int16_t r0, int16_t r1, int32_t start,
+    int32_t end, hagl_span_t span, const void *paint
+);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HAGL_ARC_H */
@@ -62,6 +62,10 @@ typedef struct {
     void (*vline)(
         void *self, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color
     );
+    void (*blend_hline)(
+        void *self, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color,
+        uint8_t alpha
+    );
 
     /* Specific to backend. */
     size_t (*flush)(void *self);
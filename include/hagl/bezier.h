@@ -0,0 +1,227 @@
+
+/*
+
+MIT License
+
+Copyright (c) 2018-2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef HAGL_BEZIER_H
+#define HAGL_BEZIER_H
+
+#include <stdint.h>
+
+#include "hagl/color.h"
+#include "hagl/span.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+Tolerance is the maximum distance between the curve and the lines it is
+drawn with, in 1/256 pixels. Smaller tolerance means more lines.
+*/
+#ifndef HAGL_BEZIER_TOLERANCE
+#define HAGL_BEZIER_TOLERANCE (64)
+#endif
+
+/*
+Path is a single outline built from lines and curves into a caller given
+vertex buffer. Curves are flattened to lines when they are added. Path
+can then be drawn as a polyline or filled as a polygon. Size is the
+capacity of the buffer in vertices, each vertex takes two int16_t.
+*/
+typedef struct {
+    int16_t *vertices;
+    int16_t size;
+    int16_t amount;
+    uint16_t tolerance;
+} hagl_path_t;
+
+/**
+ * Draw a quadratic Bézier curve
+ *
+ * Curve is flattened to lines with adaptive forward differencing.
+ * Output will be clipped to the current clip window.
+ *
+ * @param surface
+ * @param x0 start X
+ * @param y0 start Y
+ * @param x1 control point X
+ * @param y1 control point Y
+ * @param x2 end X
+ * @param y2 end Y
+ * @param tolerance in 1/256 pixels
+ * @param color
+ */
+void hagl_draw_quadratic(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+    int16_t y2, uint16_t tolerance, hagl_color_t color
+);
+
+/**
+ * Draw a cubic Bézier curve
+ *
+ * Curve is flattened to lines with adaptive forward differencing.
+ * Output will be clipped to the current clip window.
+ *
+ * @param surface
+ * @param x0 start X
+ * @param y0 start Y
+ * @param x1 first control point X
+ * @param y1 first control point Y
+ * @param x2 second control point X
+ * @param y2 second control point Y
+ * @param x3 end X
+ * @param y3 end Y
+ * @param tolerance in 1/256 pixels
+ * @param color
+ */
+void hagl_draw_cubic(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+    int16_t y2, int16_t x3, int16_t y3, uint16_t tolerance, hagl_color_t color
+);
+
+/**
+ * Initialise a path
+ *
+ * Buffer must stay valid as long as the path is used.
+ *
+ * @param path
+ * @param vertices buffer for vertices
+ * @param size capacity of the buffer in vertices
+ * @param tolerance in 1/256 pixels
+ */
+void hagl_path_init(
+    hagl_path_t *path, int16_t *vertices, int16_t size, uint16_t tolerance
+);
+
+/**
+ * Start a path
+ *
+ * Removes all vertices and sets the first one.
+ *
+ * @param path
+ * @param x
+ * @param y
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_path_move_to(hagl_path_t *path, int16_t x, int16_t y);
+
+/**
+ * Add a line to a path
+ *
+ * Line starts from the last vertex. Vertices which do not fit the buffer
+ * are dropped and error is returned.
+ *
+ * @param path
+ * @param x
+ * @param y
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_path_line_to(hagl_path_t *path, int16_t x, int16_t y);
+
+/**
+ * Add a quadratic Bézier curve to a path
+ *
+ * Curve starts from the last vertex.
+ *
+ * @param path
+ * @param x1 control point X
+ * @param y1 control point Y
+ * @param x2 end X
+ * @param y2 end Y
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_path_quadratic_to(
+    hagl_path_t *path, int16_t x1, int16_t y1, int16_t x2, int16_t y2
+);
+
+/**
+ * Add a cubic Bézier curve to a path
+ *
+ * Curve starts from the last vertex.
+ *
+ * @param path
+ * @param x1 first control point X
+ * @param y1 first control point Y
+ * @param x2 second control point X
+ * @param y2 second control point Y
+ * @param x3 end X
+ * @param y3 end Y
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_path_cubic_to(
+    hagl_path_t *path, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3,
+    int16_t y3
+);
+
+/**
+ * Draw a path
+ *
+ * Path is drawn as an open polyline. Output will be clipped to the
+ * current clip window.
+ *
+ * @param surface
+ * @param path
+ * @param color
+ */
+void hagl_draw_path(void const *surface, const hagl_path_t *path, hagl_color_t color);
+
+/**
+ * Draw a filled path
+ *
+ * Path is closed and filled as a polygon. Output will be clipped to the
+ * current clip window.
+ *
+ * @param surface
+ * @param path
+ * @param color
+ */
+void hagl_fill_path(void const *surface, const hagl_path_t *path, hagl_color_t color);
+
+/**
+ * Fill a path with a span callback
+ *
+ * @param surface
+ * @param path
+ * @param span span callback
+ * @param paint passed to the span callback
+ */
+void hagl_fill_path_span(
+    void const *surface, const hagl_path_t *path, hagl_span_t span, const void *paint
+);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HAGL_BEZIER_H */
@@ -37,6 +37,7 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/color.h"
+#include "hagl/format.h"
 #include "hagl/window.h"
 
 #ifdef __cplusplus
@@ -44,10 +45,16 @@ extern "C" {
 #endif /* __cplusplus */
 
 #define BITMAP_SIZE(width, height, depth) (width * (depth / 8) * height)
+#define INDEXED_BITMAP_SIZE(width, height, depth)                                      \
+    ((((width) * (depth) + 7) / 8) * (height))
 
 /*
 Pitch is bytes per row. Depth is number of bits per pixel. Size is size
-in bytes.
+in bytes. Indexed bitmaps have a palette and 1, 2, 4 or 8 bits per pixel.
+Pixels are packed MSB first and rows are padded to full bytes. Format is
+the pixel format, by default native colors of the given depth. Blit reads
+palette and format of every source so bitmaps filled by hand must zero
+them, or better be initialised with one of the init functions below.
 */
 typedef struct {
     uint16_t width;
@@ -65,16 +72,90 @@ typedef struct {
     void (*vline)(
         void *self, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color
     );
+    void (*blend_hline)(
+        void *self, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color,
+        uint8_t alpha
+    );
 
     uint16_t pitch;
     uint32_t size;
     uint8_t *buffer;
+    const hagl_color_t *palette;
+    uint8_t format;
 } hagl_bitmap_t;
 
 void hagl_bitmap_init(
     hagl_bitmap_t *bitmap, int16_t width, uint16_t height, uint8_t depth, void *buffer
 );
 
+/**
+ * Initialise a bitmap with given pixel format
+ *
+ * Blitting converts between formats. Drawing to the bitmap is possible
+ * only when format has the same depth as hagl_color_t. Colors are then
+ * written as is.
+ *
+ * @param bitmap
+ * @param width
+ * @param height
+ * @param format one of HAGL_FORMAT_*
+ * @param buffer
+ */
+void hagl_bitmap_init_format(
+    hagl_bitmap_t *bitmap, int16_t width, uint16_t height, uint8_t format, void *buffer
+);
+
+/**
+ * Get pixel format of a bitmap
+ *
+ * @param bitmap
+ * @return format, never HAGL_FORMAT_NATIVE
+ */
+static inline uint8_t hagl_bitmap_format(const hagl_bitmap_t *bitmap) {
+    if (HAGL_FORMAT_NATIVE == bitmap->format) {
+        return hagl_native_format(bitmap->depth);
+    }
+    return bitmap->format;
+}
+
+/**
+ * Initialise an indexed bitmap
+ *
+ * Drawing to an indexed bitmap uses palette indices as colors. When
+ * blitted to a surface the indices are expanded through the palette.
+ * Palette must have 1 << depth colors and stay valid as long as the
+ * bitmap is used.
+ *
+ * @param bitmap
+ * @param width
+ * @param height
+ * @param depth 1, 2, 4 or 8 bits per pixel
+ * @param buffer at least INDEXED_BITMAP_SIZE() bytes
+ * @param palette
+ */
+void hagl_bitmap_init_indexed(
+    hagl_bitmap_t *bitmap, int16_t width, uint16_t height, uint8_t depth, void *buffer,
+    const hagl_color_t *palette
+);
+
+/**
+ * Get palette index of a pixel in an indexed bitmap
+ *
+ * Does not do any bounds checking.
+ *
+ * @param bitmap
+ * @param x0
+ * @param y0
+ * @return palette index
+ */
+static inline uint8_t
+hagl_bitmap_index(const hagl_bitmap_t *bitmap, uint16_t x0, uint16_t y0) {
+    uint32_t bit = (uint32_t)x0 * bitmap->depth;
+    uint8_t byte = bitmap->buffer[bitmap->pitch * y0 + (bit >> 3)];
+    uint8_t shift = 8 - bitmap->depth - (bit & 7);
+    return (byte >> shift) & ((1 << bitmap->depth) - 1);
+}
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
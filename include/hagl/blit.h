@@ -40,15 +40,22 @@ SPDX-License-Identifier: MIT
 #include <stdlib.h>
 
 #include "hagl/bitmap.h"
+#include "hagl/format.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
+/* Stack buffer for expanding indexed bitmaps, longer rows are split. */
+#ifndef HAGL_BLIT_BUFFER_SIZE
+#define HAGL_BLIT_BUFFER_SIZE (256)
+#endif
+
 /**
  * Blit a bitmap to a surface
  *
- * Output will be clipped to the current clip window.
+ * Output will be clipped to the current clip window. Indexed bitmaps
+ * are expanded through their palette one row at a time.
  *
  * @param surface
  * @param x0
@@ -75,7 +82,8 @@ hagl_blit(void const *surface, int16_t x0, int16_t y0, hagl_bitmap_t *source) {
 /**
  * Blit and scale a bitmap to a surface
  *
- * Output will be clipped to the current clip window.
+ * Output will be clipped to the current clip window. Indexed bitmaps
+ * are expanded through their palette one row at a time.
  *
  * @param surface
  * @param x0
@@ -112,6 +120,40 @@ static inline void hagl_blit_xyxy(
     hagl_blit_xywh(surface, min_x, min_y, max_x - min_x + 1, max_y - min_y + 1, source);
 }
 
+/**
+ * Blit a bitmap to a surface with dithering
+ *
+ * Bitmaps of a deeper format than the surface are dithered while they
+ * are converted. With error diffusion the error buffer must fit the
+ * width of the bitmap. Dithering state is reset before blitting. Output
+ * will be clipped to the current clip window.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param source pointer to a bitmap
+ * @param dither dithering state initialised with hagl_dither_init()
+ */
+void hagl_blit_dither(
+    void const *surface, int16_t x0, int16_t y0, hagl_bitmap_t *source,
+    hagl_dither_t *dither
+);
+
+/**
+ * Blit a run length encoded bitmap to a surface
+ *
+ * Runs are drawn as horizontal lines and runs of the transparent color
+ * are skipped. Bitmap must have the same depth as the surface. Output
+ * will be clipped to the current clip window.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param rle pointer to a HRLE bitmap
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_blit_rle(void const *surface, int16_t x0, int16_t y0, const uint8_t *rle);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
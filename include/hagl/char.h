@@ -52,13 +52,17 @@ extern "C" {
  *
  * https://github.com/tuupola/embedded-fonts
  *
+ * Both fixed width FONTX and proportional HFNT fonts are supported.
+ * FONTX glyphs are drawn with black background. HFNT glyphs leave the
+ * background untouched and antialiased edges are blended with it.
+ *
  * @param surface
  * @param code  unicode code point
  * @param x0
  * @param y0
  * @param color
- * @param font  pointer to a FONTX font
- * @return width of the drawn character
+ * @param font  pointer to a FONTX or HFNT font
+ * @return advance width of the drawn character
  */
 uint8_t hagl_put_char(
     void const *surface, wchar_t code, int16_t x0, int16_t y0, hagl_color_t color,
@@ -78,7 +82,7 @@ uint8_t hagl_put_char(
  * @param x0
  * @param y0
  * @param color
- * @param font pointer to a FONTX font
+ * @param font pointer to a FONTX or HFNT font
  * @return width of the drawn string
  */
 uint16_t hagl_put_text(
@@ -86,6 +90,43 @@ uint16_t hagl_put_text(
     const unsigned char *font
 );
 
+/**
+ * Draw a single character scaled by an integer factor
+ *
+ * Each glyph pixel becomes a scale x scale block. Runs of equal pixels
+ * are drawn as filled rectangles instead of individual pixels.
+ *
+ * @param surface
+ * @param code  unicode code point
+ * @param x0
+ * @param y0
+ * @param color
+ * @param font  pointer to a FONTX or HFNT font
+ * @param scale  scaling factor, 1 draws the character in original size
+ * @return advance width of the drawn character
+ */
+uint16_t hagl_put_char_scaled(
+    void const *surface, wchar_t code, int16_t x0, int16_t y0, hagl_color_t color,
+    const unsigned char *font, uint8_t scale
+);
+
+/**
+ * Draw a string scaled by an integer factor
+ *
+ * @param surface
+ * @param str pointer to an wide char string
+ * @param x0
+ * @param y0
+ * @param color
+ * @param font pointer to a FONTX or HFNT font
+ * @param scale scaling factor, 1 draws the string in original size
+ * @return width of the drawn string
+ */
+uint16_t hagl_put_text_scaled(
+    void const *surface, const wchar_t *str, int16_t x0, int16_t y0, hagl_color_t color,
+    const unsigned char *font, uint8_t scale
+);
+
 /**
  * Extract a glyph into a bitmap
  *
@@ -39,6 +39,7 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/color.h"
+#include "hagl/span.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -72,6 +73,41 @@ void hagl_fill_circle(
     void const *surface, int16_t x0, int16_t y0, int16_t r, hagl_color_t color
 );
 
+/**
+ * Fill a circle with a span callback
+ *
+ * Each row of the circle is passed to the callback once, from top to
+ * bottom. Rows outside of the clip window are skipped, spans are not
+ * clipped horizontally.
+ *
+ * @param x0 center X
+ * @param y0 center Y
+ * @param r radius
+ * @param span span callback
+ * @param paint passed to the span callback
+ */
+void hagl_fill_circle_span(
+    void const *surface, int16_t x0, int16_t y0, int16_t r, hagl_span_t span,
+    const void *paint
+);
+
+/**
+ * Draw a translucent filled circle
+ *
+ * Color is blended with the pixels already on the surface. Output will
+ * be clipped to the current clip window.
+ *
+ * @param x0 center X
+ * @param y0 center Y
+ * @param r radius
+ * @param color
+ * @param alpha opacity 0-255
+ */
+void hagl_fill_circle_alpha(
+    void const *surface, int16_t x0, int16_t y0, int16_t r, hagl_color_t color,
+    uint8_t alpha
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
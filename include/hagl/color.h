@@ -36,8 +36,12 @@ SPDX-License-Identifier: MIT
 #ifndef HAGL_COLOR_H
 #define HAGL_COLOR_H
 
+#include <stdint.h>
+
 #include <hagl_hal_color.h>
 
+#include "hagl/format.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -53,6 +57,51 @@ extern "C" {
  */
 hagl_color_t hagl_color(void const *surface, uint8_t r, uint8_t g, uint8_t b);
 
+/**
+ * Pack RGB to a color of the display pixel format
+ *
+ * Used by hagl_color() when the surface has no color callback. Format
+ * is HAGL_PIXEL_FORMAT so packing compiles to a few shifts.
+ *
+ * @param r
+ * @param g
+ * @param b
+ * @return color
+ */
+static inline hagl_color_t hagl_pack_rgb(uint8_t r, uint8_t g, uint8_t b) {
+#if HAGL_PIXEL_FORMAT == HAGL_FORMAT_RGB332
+    return (hagl_color_t)((r & 0xE0) | ((g & 0xE0) >> 3) | (b >> 6));
+#elif HAGL_PIXEL_DEPTH == 16
+    uint16_t color = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+#if HAGL_PIXEL_FORMAT == HAGL_FORMAT_RGB565_SWAPPED
+    color = (uint16_t)((color << 8) | (color >> 8));
+#endif
+    return (hagl_color_t)color;
+#elif HAGL_PIXEL_FORMAT == HAGL_FORMAT_RGB888
+    return (hagl_color_t)(((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
+#else
+    return (hagl_color_t)(0xFF000000 | ((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
+#endif
+}
+
+/**
+ * Blend two colors
+ *
+ * Mixes foreground color over background color. Alpha 0 returns the
+ * background and 255 the foreground. Channel layout is deduced from the
+ * surface depth: 8 bit is RGB332, 16 bit is RGB565 in the byte order of
+ * HAGL_PIXEL_RGB565 and 24 or 32 bit have one byte per channel.
+ *
+ * @param surface
+ * @param foreground
+ * @param background
+ * @param alpha opacity of the foreground 0-255
+ * @return color
+ */
+hagl_color_t hagl_blend(
+    void const *surface, hagl_color_t foreground, hagl_color_t background, uint8_t alpha
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -39,6 +39,7 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/color.h"
+#include "hagl/span.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -52,8 +53,8 @@ extern "C" {
  * @param surface
  * @param x0 center X
  * @param y0 center Y
- * @param a vertical radius
- * @param b horizontal radius
+ * @param a horizontal radius
+ * @param b vertical radius
  * @param color
  */
 void hagl_draw_ellipse(
@@ -68,14 +69,34 @@ void hagl_draw_ellipse(
  * @param surface
  * @param x0 center X
  * @param y0 center Y
- * @param a vertical radius
- * @param b horizontal radius
+ * @param a horizontal radius
+ * @param b vertical radius
  * @param color
  */
 void hagl_fill_ellipse(
     void const *surface, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_color_t color
 );
 
+/**
+ * Fill an ellipse with a span callback
+ *
+ * Each row of the ellipse is passed to the callback once, from top to
+ * bottom. Rows outside of the clip window are skipped, spans are not
+ * clipped horizontally.
+ *
+ * @param surface
+ * @param x0 center X
+ * @param y0 center Y
+ * @param a horizontal radius
+ * @param b vertical radius
+ * @param span span callback
+ * @param paint passed to the span callback
+ */
+void hagl_fill_ellipse_span(
+    void const *surface, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_span_t span,
+    const void *paint
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
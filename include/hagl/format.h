@@ -0,0 +1,245 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef HAGL_FORMAT_H
+#define HAGL_FORMAT_H
+
+#include <stdint.h>
+
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+Pixel formats of bitmaps. Native means the format of colors returned by
+hagl_color() for the given depth. Formats are defined by the pixel value
+stored in native byte order. RGB565 swapped is RGB565 with bytes swapped
+as returned by rgb565(). RGB888 is 0xRRGGBB stored as three bytes, least
+significant first. ARGB8888 is 0xAARRGGBB.
+*/
+#define HAGL_FORMAT_NATIVE (0)
+#define HAGL_FORMAT_RGB332 (1)
+#define HAGL_FORMAT_RGB565 (2)
+#define HAGL_FORMAT_RGB565_SWAPPED (3)
+#define HAGL_FORMAT_RGB888 (4)
+#define HAGL_FORMAT_ARGB8888 (5)
+
+/*
+Pixel format of the display, one of the formats above. It decides what
+hagl_color() returns when the surface has no color callback, byte order
+of rgb565() and decoded jpg images and how 16 bit colors are blended.
+Must match the hagl_color_t defined by the HAL. Everything is resolved
+at compile time so drawing does not need to check or swap bytes.
+*/
+#ifndef HAGL_PIXEL_FORMAT
+#define HAGL_PIXEL_FORMAT HAGL_FORMAT_RGB565_SWAPPED
+#endif
+
+#if HAGL_PIXEL_FORMAT == HAGL_FORMAT_RGB332
+#define HAGL_PIXEL_DEPTH (8)
+#elif HAGL_PIXEL_FORMAT == HAGL_FORMAT_RGB565
+#define HAGL_PIXEL_DEPTH (16)
+#elif HAGL_PIXEL_FORMAT == HAGL_FORMAT_RGB565_SWAPPED
+#define HAGL_PIXEL_DEPTH (16)
+#elif HAGL_PIXEL_FORMAT == HAGL_FORMAT_RGB888
+#define HAGL_PIXEL_DEPTH (24)
+#elif HAGL_PIXEL_FORMAT == HAGL_FORMAT_ARGB8888
+#define HAGL_PIXEL_DEPTH (32)
+#else
+#error "HAGL_PIXEL_FORMAT must be one of HAGL_FORMAT_*"
+#endif
+
+/*
+Byte order of RGB565 colors. Swapped unless the display itself is little
+endian RGB565 so that displays of other depths keep the old behaviour.
+*/
+#if HAGL_PIXEL_FORMAT == HAGL_FORMAT_RGB565
+#define HAGL_PIXEL_RGB565 HAGL_FORMAT_RGB565
+#else
+#define HAGL_PIXEL_RGB565 HAGL_FORMAT_RGB565_SWAPPED
+#ifndef TJPGD_NEEDS_BYTESWAP
+#define TJPGD_NEEDS_BYTESWAP
+#endif /* TJPGD_NEEDS_BYTESWAP */
+#endif
+
+/**
+ * Get number of bits per pixel of a format
+ *
+ * @param format
+ * @return depth in bits or 0 for native format
+ */
+static inline uint8_t hagl_format_depth(uint8_t format) {
+    switch (format) {
+        case HAGL_FORMAT_RGB332:
+            return 8;
+        case HAGL_FORMAT_RGB565:
+        case HAGL_FORMAT_RGB565_SWAPPED:
+            return 16;
+        case HAGL_FORMAT_RGB888:
+            return 24;
+        case HAGL_FORMAT_ARGB8888:
+            return 32;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Get format of native colors with given depth
+ *
+ * @param depth bits per pixel
+ * @return format
+ */
+static inline uint8_t hagl_native_format(uint8_t depth) {
+    switch (depth) {
+        case 8:
+            return HAGL_FORMAT_RGB332;
+        case 16:
+            return HAGL_PIXEL_RGB565;
+        case 24:
+            return HAGL_FORMAT_RGB888;
+        default:
+            return HAGL_FORMAT_ARGB8888;
+    }
+}
+
+/**
+ * Convert pixels from one format to another
+ *
+ * Source and destination must not overlap unless they are the same
+ * buffer with formats of the same depth. Alpha is dropped when converting
+ * to formats without alpha and set to 255 otherwise. Native format can not
+ * be used here, see hagl_native_format().
+ *
+ * @param dst destination pixels
+ * @param dst_format format of destination pixels
+ * @param src source pixels
+ * @param src_format format of source pixels
+ * @param count number of pixels
+ */
+void hagl_convert(
+    void *dst, uint8_t dst_format, const void *src, uint8_t src_format, uint32_t count
+);
+
+/*
+Dithering modes. Ordered dithering adds a threshold from a 4x4 Bayer
+matrix before truncating and needs no memory. Error diffusion spreads
+the truncation error to the neighbouring pixels with Floyd-Steinberg
+weights. It needs an error buffer of HAGL_DITHER_ERRORS(width) values
+which holds one row of errors. Pixels must then be converted row by row,
+left to right. Dithering is applied only when converting to RGB332 or
+RGB565, other formats are converted as is.
+*/
+#define HAGL_DITHER_NONE (0)
+#define HAGL_DITHER_ORDERED (1)
+#define HAGL_DITHER_DIFFUSION (2)
+
+#define HAGL_DITHER_ERRORS(width) (3 * ((width) + 2))
+
+typedef struct {
+    uint8_t mode;
+    int16_t x;
+    int16_t y;
+    uint16_t width;
+    uint16_t column;
+    int16_t *errors;
+    int16_t carry[9];
+} hagl_dither_t;
+
+/**
+ * Initialise dithering state
+ *
+ * Error buffer is cleared. If error diffusion is requested without an
+ * error buffer ordered dithering is used instead.
+ *
+ * @param dither
+ * @param mode HAGL_DITHER_NONE, HAGL_DITHER_ORDERED or HAGL_DITHER_DIFFUSION
+ * @param errors buffer of HAGL_DITHER_ERRORS(width) values or NULL
+ * @param width maximum width of a row
+ */
+void hagl_dither_init(
+    hagl_dither_t *dither, uint8_t mode, int16_t *errors, uint16_t width
+);
+
+/**
+ * Start a new row
+ *
+ * Must be called before converting the first pixels of each row. The
+ * coordinates are the screen position of the first pixel of the row.
+ *
+ * @param dither
+ * @param x0
+ * @param y0
+ */
+void hagl_dither_row(hagl_dither_t *dither, int16_t x0, int16_t y0);
+
+/**
+ * Convert pixels from one format to another with dithering
+ *
+ * Works like hagl_convert() and continues from where the previous call
+ * on the same row ended. Pixels can also be converted in place to a
+ * format of smaller depth. Dither can be NULL.
+ *
+ * @param dst destination pixels
+ * @param dst_format format of destination pixels
+ * @param src source pixels
+ * @param src_format format of source pixels
+ * @param count number of pixels
+ * @param dither dithering state or NULL
+ */
+void hagl_convert_dither(
+    void *dst, uint8_t dst_format, const void *src, uint8_t src_format, uint32_t count,
+    hagl_dither_t *dither
+);
+
+/**
+ * Apply ordered dither to a single color
+ *
+ * Adds the threshold for given screen position so that the color can be
+ * truncated to the given format afterwards.
+ *
+ * @param format format the color will be truncated to
+ * @param x
+ * @param y
+ * @param rgb red, green and blue channels, modified in place
+ */
+void hagl_dither_rgb(uint8_t format, int16_t x, int16_t y, uint8_t *rgb);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HAGL_FORMAT_H */
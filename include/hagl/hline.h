@@ -98,6 +98,45 @@ static inline void hagl_draw_hline(
     hagl_draw_hline_xyw(surface, x0, y0, width, color);
 }
 
+/**
+ * Draw a translucent horizontal line
+ *
+ * Color is blended with the pixels already on the surface. Alpha 0 is
+ * fully transparent and 255 opaque. Uses the blend_hline callback of
+ * the surface if available, otherwise pixels are read back one by one.
+ * Output will be clipped to the current clip window.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param width
+ * @param color
+ * @param alpha opacity 0-255
+ */
+void hagl_draw_hline_alpha_xyw(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color,
+    uint8_t alpha
+);
+
+/**
+ * Draw a translucent horizontal line
+ *
+ * Output will be clipped to the current clip window.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param width
+ * @param color
+ * @param alpha opacity 0-255
+ */
+static inline void hagl_draw_hline_alpha(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color,
+    uint8_t alpha
+) {
+    hagl_draw_hline_alpha_xyw(surface, x0, y0, width, color, alpha);
+}
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
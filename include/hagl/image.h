@@ -36,31 +36,293 @@ SPDX-License-Identifier: MIT
 #ifndef HAGL_IMAGE_H
 #define HAGL_IMAGE_H
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include "hagl/bitmap.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
 #define HAGL_ERR_TJPGD (100)
+#define HAGL_ERR_PNGDEC (200)
+#define HAGL_ERR_QOIDEC (300)
+
+/* Size of the decoder input buffer. Bigger buffer means fewer reads. */
+#ifndef HAGL_IMAGE_BUFFER_SIZE
+#define HAGL_IMAGE_BUFFER_SIZE (512)
+#endif
+
+/* Memory for decoder tables and working buffers excluding input buffer. */
+#ifndef HAGL_IMAGE_WORK_SIZE
+#define HAGL_IMAGE_WORK_SIZE (2600)
+#endif
+
+/* Largest PNG work pool taken from the heap. Fits the 32K window and two long rows. */
+#ifndef HAGL_IMAGE_PNG_WORK_SIZE
+#define HAGL_IMAGE_PNG_WORK_SIZE (40960)
+#endif
+
+/*
+Scale is a descaling factor from 0 to 3, ie. 1/1, 1/2, 1/4 or 1/8. Crop
+rectangle is given in source image pixels. Zero width or height means
+the whole image. Cropped image is drawn with its top left corner at the
+given position.
+
+By default decoder uses a work pool of HAGL_IMAGE_WORK_SIZE plus
+HAGL_IMAGE_BUFFER_SIZE bytes from the stack. Zero buffer size means the
+default. If work is given it is used instead of the stack and must also
+fit the input buffer.
+
+PNG and QOI images are descaled by dropping pixels. Unless work is given
+PNG decoder allocates a pool sized for the image from the heap and frees
+it before returning. Images which would need more than
+HAGL_IMAGE_PNG_WORK_SIZE bytes fail with PNGDEC_ERR_MEMORY. This is the
+only dynamic allocation in the library, see pngdec.h for the pool size.
+Buffer size is ignored for PNG and QOI.
+
+Dither is one of the HAGL_DITHER_* modes in hagl/format.h. Decoded
+colors are dithered before they are truncated to the surface depth.
+Images are always dithered with ordered dithering since jpg images are
+decoded block by block. Error diffusion needs rows in order and is
+available with hagl_blit_dither().
+*/
+typedef struct {
+    uint8_t scale;
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+    uint16_t buffer_size;
+    void *work;
+    uint16_t work_size;
+    uint8_t dither;
+} hagl_image_options_t;
+
+/**
+ * Image stream read callback
+ *
+ * Read at most size bytes into buffer. If buffer is NULL the bytes
+ * should be skipped instead. Short reads are allowed, the callback is
+ * called again for the rest.
+ *
+ * @param user pointer passed to hagl_load_image_stream()
+ * @param buffer destination or NULL for skip
+ * @param size number of bytes to read or skip
+ * @return number of bytes read or skipped, 0 on end of stream or error
+ */
+typedef size_t (*hagl_image_read_t)(void *user, uint8_t *buffer, size_t size);
 
 /**
  * Load an image
  *
  * Output will be clipped to the current clip window. Does not do
- * any scaling. Currently supports only baseline jpg images
- * (i.e. it does not support progressive jpg).
+ * any scaling. Supports baseline jpg (i.e. not progressive jpg), non
+ * interlaced png and qoi images. Format is detected from the file
+ * signature. Transparent png and qoi pixels are blended with the
+ * surface.
  *
  * @param surface
  * @param x0
  * @param y0
- * @param x1
- * @param y1
- * @param color
+ * @param filename path to an image file
+ * @return HAGL_OK or error code
  */
 uint32_t
 hagl_load_image(void const *surface, int16_t x0, int16_t y0, const char *filename);
 
+/**
+ * Load an image with options
+ *
+ * Image can be descaled and cropped. Only the parts of the image which
+ * are inside the crop rectangle and the clip window are decoded. Rest
+ * of the compressed data is skipped as fast as possible.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param filename path to an image file
+ * @param options pointer to options or NULL
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_load_image_ex(
+    void const *surface, int16_t x0, int16_t y0, const char *filename,
+    const hagl_image_options_t *options
+);
+
+/**
+ * Load an image from memory
+ *
+ * Compressed data is decoded in place without copying it to an
+ * intermediate buffer. Data must stay valid until the function returns.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param data pointer to image data
+ * @param size size of the data in bytes
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_load_image_mem(
+    void const *surface, int16_t x0, int16_t y0, const uint8_t *data, size_t size
+);
+
+/**
+ * Load an image from memory with options
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param data pointer to image data
+ * @param size size of the data in bytes
+ * @param options pointer to options or NULL
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_load_image_mem_ex(
+    void const *surface, int16_t x0, int16_t y0, const uint8_t *data, size_t size,
+    const hagl_image_options_t *options
+);
+
+/**
+ * Load an image from a stream
+ *
+ * Data is pulled from the read callback in small chunks as needed.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param read read callback
+ * @param user pointer passed to the read callback
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_load_image_stream(
+    void const *surface, int16_t x0, int16_t y0, hagl_image_read_t read, void *user
+);
+
+/**
+ * Load an image from a stream with options
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param read read callback
+ * @param user pointer passed to the read callback
+ * @param options pointer to options or NULL
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_load_image_stream_ex(
+    void const *surface, int16_t x0, int16_t y0, hagl_image_read_t read, void *user,
+    const hagl_image_options_t *options
+);
+
+/**
+ * Decode an image into a bitmap
+ *
+ * Decoded image can be kept around and blitted to a surface as many
+ * times as needed without decoding it again. Bitmap must be initialised
+ * with hagl_bitmap_init() or hagl_bitmap_init_format(). Pixels are
+ * converted to the format of the bitmap, indexed bitmaps are not
+ * supported. Image is placed to the top left corner and parts which do not fit
+ * the bitmap are ignored. Use hagl_image_size() to find the size of
+ * the needed bitmap.
+ *
+ * @param bitmap target bitmap
+ * @param filename path to an image file
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_decode_image(hagl_bitmap_t *bitmap, const char *filename);
+
+/**
+ * Decode an image into a bitmap with options
+ *
+ * @param bitmap target bitmap
+ * @param filename path to an image file
+ * @param options pointer to options or NULL
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_decode_image_ex(
+    hagl_bitmap_t *bitmap, const char *filename, const hagl_image_options_t *options
+);
+
+/**
+ * Decode an image in memory into a bitmap
+ *
+ * @param bitmap target bitmap
+ * @param data pointer to image data
+ * @param size size of the data in bytes
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_decode_image_mem(hagl_bitmap_t *bitmap, const uint8_t *data, size_t size);
+
+/**
+ * Decode an image in memory into a bitmap with options
+ *
+ * @param bitmap target bitmap
+ * @param data pointer to image data
+ * @param size size of the data in bytes
+ * @param options pointer to options or NULL
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_decode_image_mem_ex(
+    hagl_bitmap_t *bitmap, const uint8_t *data, size_t size,
+    const hagl_image_options_t *options
+);
+
+/**
+ * Get dimensions of an image
+ *
+ * Only the headers are parsed, image data is not decoded.
+ *
+ * @param filename path to an image file
+ * @param width pointer to image width
+ * @param height pointer to image height
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_image_size(const char *filename, uint16_t *width, uint16_t *height);
+
+/**
+ * Get dimensions of an image in memory
+ *
+ * @param data pointer to image data
+ * @param size size of the data in bytes
+ * @param width pointer to image width
+ * @param height pointer to image height
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_image_size_mem(
+    const uint8_t *data, size_t size, uint16_t *width, uint16_t *height
+);
+
+#ifdef HAGL_IMAGE_PARALLEL
+
+#ifndef HAGL_IMAGE_MAX_THREADS
+#define HAGL_IMAGE_MAX_THREADS (16)
+#endif
+
+/**
+ * Decode an image in memory into a bitmap using several threads
+ *
+ * Images with restart markers are split into runs of restart intervals
+ * which are decoded in parallel, each thread writing to its own part of
+ * the bitmap. Images without restart markers and png and qoi images are
+ * decoded in the calling thread. Requires pthreads and is meant for
+ * hosted platforms only.
+ *
+ * @param bitmap target bitmap
+ * @param data pointer to image data
+ * @param size size of the data in bytes
+ * @param options pointer to options or NULL
+ * @param threads maximum number of threads including the calling thread
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_decode_image_mem_parallel(
+    hagl_bitmap_t *bitmap, const uint8_t *data, size_t size,
+    const hagl_image_options_t *options, uint8_t threads
+);
+
+#endif /* HAGL_IMAGE_PARALLEL */
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,129 @@
+
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef HAGL_IMAGE_CACHE_H
+#define HAGL_IMAGE_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hagl/bitmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Maximum number of images kept in the cache. */
+#ifndef HAGL_IMAGE_CACHE_SLOTS
+#define HAGL_IMAGE_CACHE_SLOTS (8)
+#endif
+
+/* Longest cached filename including the terminating zero. */
+#ifndef HAGL_IMAGE_CACHE_PATH_MAX
+#define HAGL_IMAGE_CACHE_PATH_MAX (64)
+#endif
+
+/* Slot is free when used is zero. */
+typedef struct {
+    uint32_t hash;
+    char filename[HAGL_IMAGE_CACHE_PATH_MAX];
+    const uint8_t *data;
+    size_t size;
+    uint32_t used;
+    hagl_bitmap_t bitmap;
+} hagl_image_cache_entry_t;
+
+/*
+Decoded images are stored in a caller provided pool. Pool size is the
+memory budget of the cache. When a new image does not fit the least
+recently used images are evicted. Entries never move between slots,
+only their buffers are moved within the pool.
+*/
+typedef struct {
+    uint8_t *pool;
+    size_t pool_size;
+    size_t pool_used;
+    uint32_t clock;
+    uint8_t count;
+    hagl_image_cache_entry_t entries[HAGL_IMAGE_CACHE_SLOTS];
+} hagl_image_cache_t;
+
+/**
+ * Initialise an image cache
+ *
+ * @param cache
+ * @param pool memory used for storing decoded images
+ * @param size size of the pool in bytes
+ */
+void hagl_image_cache_init(hagl_image_cache_t *cache, void *pool, size_t size);
+
+/**
+ * Get a decoded image by filename
+ *
+ * If image is not already in the cache it is decoded and added. Returned
+ * bitmap stays valid until it is evicted by another call to the cache.
+ * Its buffer may move when other images are evicted, so read it from the
+ * bitmap instead of keeping a copy of the pointer.
+ *
+ * @param cache
+ * @param filename path to a jpg file, shorter than HAGL_IMAGE_CACHE_PATH_MAX
+ * @return pointer to bitmap or NULL on error or if image does not fit
+ */
+hagl_bitmap_t *hagl_image_cache_get(hagl_image_cache_t *cache, const char *filename);
+
+/**
+ * Get a decoded image from memory
+ *
+ * Images are identified by the data pointer and size.
+ *
+ * @param cache
+ * @param data pointer to jpg data
+ * @param size size of the data in bytes
+ * @return pointer to bitmap or NULL on error or if image does not fit
+ */
+hagl_bitmap_t *
+hagl_image_cache_get_mem(hagl_image_cache_t *cache, const uint8_t *data, size_t size);
+
+/**
+ * Remove all images from the cache
+ *
+ * @param cache
+ */
+void hagl_image_cache_clear(hagl_image_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HAGL_IMAGE_CACHE_H */
@@ -0,0 +1,102 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef HAGL_IMAGE_SAVE_H
+#define HAGL_IMAGE_SAVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hagl/bitmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#define HAGL_IMAGE_PPM (0)
+#define HAGL_IMAGE_QOI (1)
+#define HAGL_IMAGE_PNG (2)
+
+/*
+Bitmaps are encoded one row at a time in chunks of this many pixels.
+Memory use does not depend on the image size.
+*/
+#ifndef HAGL_IMAGE_SAVE_CHUNK_SIZE
+#define HAGL_IMAGE_SAVE_CHUNK_SIZE (64)
+#endif
+
+/**
+ * Image stream write callback
+ *
+ * @param user pointer passed to hagl_save_image_stream()
+ * @param buffer data to write
+ * @param size number of bytes to write
+ * @return number of bytes written, anything less than size is an error
+ */
+typedef size_t (*hagl_image_write_t)(void *user, const uint8_t *buffer, size_t size);
+
+/**
+ * Save a bitmap to a stream
+ *
+ * Pixels are converted to RGB888 on the fly. PPM and PNG are written
+ * uncompressed which is the fastest. QOI is almost as fast and usually
+ * much smaller. Backend framebuffer can be saved by wrapping it in a
+ * bitmap with hagl_bitmap_init().
+ *
+ * @param bitmap bitmap with depth of 8, 16, 24 or 32 bits or an indexed bitmap
+ * @param format HAGL_IMAGE_PPM, HAGL_IMAGE_QOI or HAGL_IMAGE_PNG
+ * @param write write callback
+ * @param user pointer passed to the write callback
+ * @return HAGL_OK or error code
+ */
+uint32_t hagl_save_image_stream(
+    const hagl_bitmap_t *bitmap, uint8_t format, hagl_image_write_t write, void *user
+);
+
+/**
+ * Save a bitmap to a file
+ *
+ * @param bitmap bitmap with depth of 8, 16, 24 or 32 bits or an indexed bitmap
+ * @param format HAGL_IMAGE_PPM, HAGL_IMAGE_QOI or HAGL_IMAGE_PNG
+ * @param filename path to the file
+ * @return HAGL_OK or error code
+ */
+uint32_t
+hagl_save_image(const hagl_bitmap_t *bitmap, uint8_t format, const char *filename);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HAGL_IMAGE_SAVE_H */
@@ -39,11 +39,28 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/color.h"
+#include "hagl/span.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
+/**
+ * Draw a polyline
+ *
+ * Consecutive vertices are joined with lines. Unlike with a polygon the
+ * last vertex is not joined to the first one. Output will be clipped to
+ * the current clip window.
+ *
+ * @param surface
+ * @param amount number of vertices
+ * @param vertices pointer to (an array) of vertices
+ * @param color
+ */
+void hagl_draw_polyline(
+    void const *surface, int16_t amount, int16_t *vertices, hagl_color_t color
+);
+
 /**
  * Draw a polygon
  *
@@ -82,6 +99,40 @@ void hagl_fill_polygon(
     void const *surface, int16_t amount, int16_t *vertices, hagl_color_t color
 );
 
+/**
+ * Fill a polygon with a span callback
+ *
+ * Each pixel of the polygon is passed to the callback once. Spans are
+ * not clipped.
+ *
+ * @param surface
+ * @param amount number of vertices
+ * @param vertices pointer to (an array) of vertices
+ * @param span span callback
+ * @param paint passed to the span callback
+ */
+void hagl_fill_polygon_span(
+    void const *surface, int16_t amount, int16_t *vertices, hagl_span_t span,
+    const void *paint
+);
+
+/**
+ * Draw a translucent filled polygon
+ *
+ * Color is blended with the pixels already on the surface. Output will
+ * be clipped to the current clip window.
+ *
+ * @param surface
+ * @param amount number of vertices
+ * @param vertices pointer to (an array) of vertices
+ * @param color
+ * @param alpha opacity 0-255
+ */
+void hagl_fill_polygon_alpha(
+    void const *surface, int16_t amount, int16_t *vertices, hagl_color_t color,
+    uint8_t alpha
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -39,6 +39,7 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/color.h"
+#include "hagl/span.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -154,6 +155,86 @@ static void inline hagl_fill_rectangle_xywh(
     hagl_fill_rectangle_xyxy(surface, x0, y0, x0 + width - 1, y0 + height - 1, color);
 };
 
+/**
+ * Fill a rectangle with a span callback
+ *
+ * Rows are clipped to the current clip window before they are passed
+ * to the callback.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param x1
+ * @param y1
+ * @param span span callback
+ * @param paint passed to the span callback
+ */
+void hagl_fill_rectangle_span(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    hagl_span_t span, const void *paint
+);
+
+/**
+ * Draw a translucent filled rectangle
+ *
+ * Color is blended with the pixels already on the surface. Output will
+ * be clipped to the current clip window.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param x1
+ * @param y1
+ * @param color
+ * @param alpha opacity 0-255
+ */
+void hagl_fill_rectangle_alpha_xyxy(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    hagl_color_t color, uint8_t alpha
+);
+
+/**
+ * Draw a translucent filled rectangle
+ *
+ * Output will be clipped to the current clip window.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param x1
+ * @param y1
+ * @param color
+ * @param alpha opacity 0-255
+ */
+static void inline hagl_fill_rectangle_alpha(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    hagl_color_t color, uint8_t alpha
+) {
+    hagl_fill_rectangle_alpha_xyxy(surface, x0, y0, x1, y1, color, alpha);
+}
+
+/**
+ * Draw a translucent filled rectangle
+ *
+ * Output will be clipped to the current clip window.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param width
+ * @param height
+ * @param color
+ * @param alpha opacity 0-255
+ */
+static void inline hagl_fill_rectangle_alpha_xywh(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, uint16_t height,
+    hagl_color_t color, uint8_t alpha
+) {
+    hagl_fill_rectangle_alpha_xyxy(
+        surface, x0, y0, x0 + width - 1, y0 + height - 1, color, alpha
+    );
+}
+
 /**
  * Draw a rounded rectangle
  *
@@ -274,6 +355,26 @@ static void inline hagl_fill_rounded_rectangle_xywh(
     );
 }
 
+/**
+ * Fill a rounded rectangle with a span callback
+ *
+ * Each row of the rounded rectangle is passed to the callback once.
+ * Spans are not clipped.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param x1
+ * @param y1
+ * @param r corner radius
+ * @param span span callback
+ * @param paint passed to the span callback
+ */
+void hagl_fill_rounded_rectangle_span(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r,
+    hagl_span_t span, const void *paint
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
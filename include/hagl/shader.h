@@ -0,0 +1,172 @@
+
+/*
+
+MIT License
+
+Copyright (c) 2018-2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef HAGL_SHADER_H
+#define HAGL_SHADER_H
+
+#include <stdint.h>
+
+#include "hagl/bitmap.h"
+#include "hagl/color.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Stack buffer for one chunk of shaded pixels, longer spans are split. */
+#ifndef HAGL_SHADER_BUFFER_SIZE
+#define HAGL_SHADER_BUFFER_SIZE (256)
+#endif
+
+#define HAGL_GRADIENT_LINEAR (0)
+#define HAGL_GRADIENT_RADIAL (1)
+
+/*
+Gradient paint for hagl_span_gradient(). Colors are precomputed to a
+table, usually with hagl_gradient_table(), and pixels only look up their
+color. Linear gradient goes from the start point to the end point and
+can have any angle. Radial gradient goes from the center to the radius.
+Pixels before the start and after the end get the first and last color.
+Position is kept as a 16.16 fixed point table index.
+*/
+typedef struct {
+    uint8_t type;
+    int16_t x0;
+    int16_t y0;
+    int32_t dx;
+    int32_t dy;
+    const hagl_color_t *colors;
+    uint16_t count;
+} hagl_gradient_t;
+
+/*
+Pattern paint for hagl_span_pattern(). Bitmap is repeated in both
+directions starting from x0, y0. Bitmap must have native colors with the
+same depth as the surface.
+*/
+typedef struct {
+    const hagl_bitmap_t *bitmap;
+    int16_t x0;
+    int16_t y0;
+} hagl_pattern_t;
+
+/**
+ * Fill a color table with a gradient
+ *
+ * Colors are interpolated in RGB and converted with hagl_color(). Tables
+ * with several color stops can be built by calling this for each part.
+ *
+ * @param surface
+ * @param colors table to fill
+ * @param count number of colors in the table
+ * @param from RGB of the first color
+ * @param to RGB of the last color
+ */
+void hagl_gradient_table(
+    void const *surface, hagl_color_t *colors, uint16_t count, const uint8_t from[3],
+    const uint8_t to[3]
+);
+
+/**
+ * Initialise a linear gradient
+ *
+ * Color changes along the line from start to end point. Color table
+ * must stay valid as long as the gradient is used.
+ *
+ * @param gradient
+ * @param x0 start X
+ * @param y0 start Y
+ * @param x1 end X
+ * @param y1 end Y
+ * @param colors color table
+ * @param count number of colors in the table
+ */
+void hagl_gradient_linear(
+    hagl_gradient_t *gradient, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    const hagl_color_t *colors, uint16_t count
+);
+
+/**
+ * Initialise a radial gradient
+ *
+ * Color table must stay valid as long as the gradient is used.
+ *
+ * @param gradient
+ * @param x0 center X
+ * @param y0 center Y
+ * @param r radius
+ * @param colors color table
+ * @param count number of colors in the table
+ */
+void hagl_gradient_radial(
+    hagl_gradient_t *gradient, int16_t x0, int16_t y0, uint16_t r,
+    const hagl_color_t *colors, uint16_t count
+);
+
+/**
+ * Span callback drawing a gradient
+ *
+ * Spans of vertical linear gradients have one color and are drawn as
+ * horizontal lines. Other spans are collected to a buffer of
+ * HAGL_SHADER_BUFFER_SIZE bytes and blitted.
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param width
+ * @param paint pointer to hagl_gradient_t
+ */
+void hagl_span_gradient(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+);
+
+/**
+ * Span callback drawing a repeating bitmap
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param width
+ * @param paint pointer to hagl_pattern_t
+ */
+void hagl_span_pattern(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HAGL_SHADER_H */
@@ -0,0 +1,95 @@
+
+/*
+
+MIT License
+
+Copyright (c) 2018-2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef HAGL_SPAN_H
+#define HAGL_SPAN_H
+
+#include <stdint.h>
+
+#include "hagl/color.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+Span callback. Filled shapes are drawn by finding their horizontal runs
+of pixels and passing them to a span callback which does the actual
+drawing. Each pixel of a shape is passed exactly once so translucent
+spans are not blended twice. Spans are not clipped, the callback must
+clip them itself or pass them to a function which does. Paint is passed
+to the callback as is.
+*/
+typedef void (*hagl_span_t)(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+);
+
+/* Paint for hagl_span_alpha(). */
+typedef struct {
+    hagl_color_t color;
+    uint8_t alpha;
+} hagl_alpha_t;
+
+/**
+ * Span callback drawing a solid color
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param width
+ * @param paint pointer to hagl_color_t
+ */
+void hagl_span_color(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+);
+
+/**
+ * Span callback blending a color with the surface
+ *
+ * @param surface
+ * @param x0
+ * @param y0
+ * @param width
+ * @param paint pointer to hagl_alpha_t
+ */
+void hagl_span_alpha(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HAGL_SPAN_H */
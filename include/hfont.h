@@ -0,0 +1,133 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef HAGL_HFONT_H
+#define HAGL_HFONT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+Proportional font with optional antialiasing. All multibyte values are
+little endian. Fonts can be generated with tools/hfont.py.
+
+Offset  Size  Description
+0       4     Signature "HFNT"
+4       1     Version
+5       1     Bits per pixel, 1, 2 or 4
+6       1     Line height
+7       1     Ascent, distance from top of the line to the baseline
+8       2     Number of code ranges
+10      2     Number of glyphs
+12      6*n   Code ranges sorted by code: first code, last code, first glyph
+...     8*g   Glyphs: bitmap offset (3 bytes), width, height, x offset,
+              y offset from top of the line, advance
+...           Bitmap data, rows packed MSB first without padding
+*/
+
+#define HFONT_OK (0)
+#define HFONT_ERR_GLYPH_NOT_FOUND (1)
+#define HFONT_ERR_SIGNATURE (2)
+
+#define HFONT_SIGNATURE (0)
+#define HFONT_VERSION (4)
+#define HFONT_BPP (5)
+#define HFONT_HEIGHT (6)
+#define HFONT_ASCENT (7)
+#define HFONT_RANGE_COUNT (8)
+#define HFONT_GLYPH_COUNT (10)
+#define HFONT_RANGE_TABLE_START (12)
+#define HFONT_RANGE_SIZE (6)
+#define HFONT_GLYPH_SIZE (8)
+
+/*
+Offsets are relative to the top left corner of the character cell. Bitmap
+pixels are bpp bits wide and not padded at the end of the row.
+*/
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    int8_t x_offset;
+    int8_t y_offset;
+    uint8_t advance;
+    uint8_t bpp;
+    const uint8_t *buffer;
+} hfont_glyph_t;
+
+typedef struct {
+    uint8_t bpp;
+    uint8_t height;
+    uint8_t ascent;
+    uint16_t ranges;
+    uint16_t glyphs;
+} hfont_meta_t;
+
+/**
+ * Check if given font is in the HFNT format
+ *
+ * @param font pointer to a font
+ * @return true if font has the HFNT signature
+ */
+static inline bool hfont_is_hfont(const uint8_t *font) {
+    return 'H' == font[0] && 'F' == font[1] && 'N' == font[2] && 'T' == font[3];
+}
+
+uint8_t hfont_meta(hfont_meta_t *meta, const uint8_t *font);
+
+/**
+ * Find a glyph
+ *
+ * Text is usually rendered in order and neighbouring characters tend to
+ * live in the same code range. If hint is given the range of the previous
+ * lookup is tried first before falling back to a binary search. Hint should
+ * be initialised to zero.
+ *
+ * @param glyph
+ * @param code unicode code point
+ * @param font pointer to a HFNT font
+ * @param hint pointer to range hint or NULL
+ * @return HFONT_OK or error code
+ */
+uint8_t
+hfont_glyph(hfont_glyph_t *glyph, wchar_t code, const uint8_t *font, uint16_t *hint);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HAGL_HFONT_H */
@@ -0,0 +1,115 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef HAGL_HRLE_H
+#define HAGL_HRLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+Run length encoded bitmap. All multibyte values are little endian. Bitmaps
+can be generated with tools/hrle.py.
+
+Offset  Size  Description
+0       4     Signature "HRLE"
+4       1     Version
+5       1     Bits per pixel, 8, 16, 24 or 32
+6       2     Width
+8       2     Height
+10      1     Flags, bit 0 is set when bitmap has a transparent color
+11      1     Reserved
+12      4     Transparent color
+16            Packets, each row starts with a new packet
+
+Packet starts with a header byte n. If the high bit is set it is a run of
+(n & 0x7f) + 1 pixels followed by a single color. Otherwise it is a literal
+of n + 1 pixels followed by as many colors. Colors are stored as raw pixel
+values of bpp bits.
+*/
+
+#define HRLE_OK (0)
+#define HRLE_ERR_SIGNATURE (1)
+#define HRLE_ERR_DEPTH (2)
+
+#define HRLE_SIGNATURE (0)
+#define HRLE_VERSION (4)
+#define HRLE_DEPTH (5)
+#define HRLE_WIDTH (6)
+#define HRLE_HEIGHT (8)
+#define HRLE_FLAGS (10)
+#define HRLE_TRANSPARENT (12)
+#define HRLE_DATA_START (16)
+
+#define HRLE_FLAG_TRANSPARENT (0x01)
+#define HRLE_RUN (0x80)
+#define HRLE_MAX_COUNT (128)
+
+typedef struct {
+    uint8_t depth;
+    uint16_t width;
+    uint16_t height;
+    bool transparent;
+    uint32_t color;
+    const uint8_t *data;
+} hrle_meta_t;
+
+/**
+ * Check if given bitmap is in the HRLE format
+ *
+ * @param rle pointer to a bitmap
+ * @return true if bitmap has the HRLE signature
+ */
+static inline bool hrle_is_hrle(const uint8_t *rle) {
+    return 'H' == rle[0] && 'R' == rle[1] && 'L' == rle[2] && 'E' == rle[3];
+}
+
+/**
+ * Read the header of a HRLE bitmap
+ *
+ * @param meta
+ * @param rle pointer to a HRLE bitmap
+ * @return HRLE_OK or error code
+ */
+uint8_t hrle_meta(hrle_meta_t *meta, const uint8_t *rle);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HAGL_HRLE_H */
@@ -35,6 +35,9 @@ SPDX-License-Identifier: MIT
 #ifndef _HSL_H
 #define _HSL_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -45,10 +48,27 @@ typedef struct {
     double l;
 } hsl_t;
 
+/* Integer HSL where all channels go from 0 to 255. */
+typedef struct {
+    uint8_t h;
+    uint8_t s;
+    uint8_t l;
+} hsl8_t;
+
 #include "rgb888.h"
 
 rgb_t hsl_to_rgb888(hsl_t *hsl);
 
+/* Fixed point versions, same result as the float version within one. */
+rgb_t hsl8_to_rgb888(const hsl8_t *hsl);
+void hsl8_to_rgb888_array(rgb_t *output, const hsl8_t *input, size_t count);
+
+/*
+ * Fill a table of 256 colors with all hues of given saturation and
+ * lightness. Color cycling effects can then look up the color by hue.
+ */
+void hsl8_hue_table(rgb_t *table, uint8_t s, uint8_t l);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,202 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef HAGL_PNGDEC_H
+#define HAGL_PNGDEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+Row streaming PNG decoder. Supports all non interlaced images, ie. gray,
+truecolor, indexed, gray with alpha and truecolor with alpha in all bit
+depths. Sixteen bit samples are truncated to eight bits. Transparency is
+read from the alpha channel or the tRNS chunk.
+
+Compressed data is inflated one scanline at a time. Decoder needs a work
+pool for the LZ77 window and two scanlines. Window is what the zlib header
+asks for, usually 32K, but never more than the whole uncompressed image.
+Scanlines are (width * bits per pixel + 7) / 8 + 1 bytes each. Checksums
+are not verified.
+*/
+
+#define PNGDEC_OK (0)
+#define PNGDEC_ERR_INPUT (1)
+#define PNGDEC_ERR_SIGNATURE (2)
+#define PNGDEC_ERR_FORMAT (3)
+#define PNGDEC_ERR_UNSUPPORTED (4)
+#define PNGDEC_ERR_MEMORY (5)
+#define PNGDEC_ERR_INTERRUPTED (6)
+
+#define PNGDEC_SIGNATURE_SIZE (8)
+
+#define PNGDEC_COLOR_GRAY (0)
+#define PNGDEC_COLOR_RGB (2)
+#define PNGDEC_COLOR_INDEXED (3)
+#define PNGDEC_COLOR_GRAY_ALPHA (4)
+#define PNGDEC_COLOR_RGBA (6)
+
+/* Size of the input buffer. */
+#ifndef PNGDEC_BUFFER_SIZE
+#define PNGDEC_BUFFER_SIZE (256)
+#endif
+
+/* Maximum number of pixels passed to the output callback at once. */
+#ifndef PNGDEC_CHUNK_SIZE
+#define PNGDEC_CHUNK_SIZE (64)
+#endif
+
+/**
+ * Input callback
+ *
+ * @param device pointer passed to pngdec_prepare()
+ * @param buffer destination
+ * @param size maximum number of bytes to read
+ * @return number of bytes read, 0 on end of input or error
+ */
+typedef size_t (*pngdec_read_t)(void *device, uint8_t *buffer, size_t size);
+
+/**
+ * Output callback
+ *
+ * @param device pointer passed to pngdec_prepare()
+ * @param rgba width pixels of RGBA8888
+ * @param x0
+ * @param y0
+ * @param width number of pixels
+ * @return 1 to continue, 0 to interrupt decoding
+ */
+typedef uint8_t (*pngdec_write_t)(
+    void *device, const uint8_t *rgba, uint16_t x0, uint16_t y0, uint16_t width
+);
+
+/* Canonical Huffman code as number of codes per length and sorted symbols. */
+typedef struct {
+    uint16_t count[16];
+    uint16_t symbol[288];
+} pngdec_huffman_t;
+
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint8_t depth;
+    uint8_t color_type;
+    uint8_t channels;
+    uint8_t bpp;
+    uint32_t row_size;
+    pngdec_read_t read;
+    pngdec_write_t write;
+    void *device;
+    uint8_t status;
+    size_t offset;
+    size_t available;
+    uint8_t buffer[PNGDEC_BUFFER_SIZE];
+    uint32_t chunk;
+    uint32_t bits;
+    uint8_t bit_count;
+    uint8_t *window;
+    uint32_t window_mask;
+    uint32_t window_position;
+    uint32_t window_filled;
+    uint8_t *row;
+    uint8_t *previous;
+    uint32_t row_position;
+    uint16_t y;
+    uint16_t palette_size;
+    uint8_t palette[256 * 4];
+    uint8_t has_key;
+    uint16_t key[3];
+    pngdec_huffman_t lencode;
+    pngdec_huffman_t distcode;
+    uint8_t pixels[PNGDEC_CHUNK_SIZE * 4];
+} pngdec_t;
+
+/**
+ * Check if given data starts with the PNG signature
+ *
+ * @param data at least four bytes
+ * @return 1 if data has the signature
+ */
+static inline uint8_t pngdec_is_png(const uint8_t *data) {
+    return 0x89 == data[0] && 'P' == data[1] && 'N' == data[2] && 'G' == data[3];
+}
+
+/**
+ * Read chunks up to the start of the image data
+ *
+ * Image dimensions are known after this call.
+ *
+ * @param decoder
+ * @param read input callback
+ * @param device pointer passed to the callbacks
+ * @return PNGDEC_OK or error code
+ */
+uint8_t pngdec_prepare(pngdec_t *decoder, pngdec_read_t read, void *device);
+
+/**
+ * Decode the image
+ *
+ * Rows are output top to bottom, each row left to right. Decoding stops
+ * after the last row, rest of the input is not read. Fails with
+ * PNGDEC_ERR_MEMORY if the pool is too small for the window and
+ * scanlines.
+ *
+ * @param decoder prepared decoder
+ * @param write output callback
+ * @param pool work pool
+ * @param size size of the work pool in bytes
+ * @return PNGDEC_OK or error code
+ */
+uint8_t pngdec_decode(pngdec_t *decoder, pngdec_write_t write, void *pool, size_t size);
+
+/**
+ * Get the largest work pool the prepared image can need
+ *
+ * Window size is known only when decoding starts so 32K is assumed
+ * unless the uncompressed image is smaller.
+ *
+ * @param decoder prepared decoder
+ * @return size of the work pool in bytes
+ */
+size_t pngdec_work_size(const pngdec_t *decoder);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HAGL_PNGDEC_H */
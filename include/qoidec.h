@@ -0,0 +1,154 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef HAGL_QOIDEC_H
+#define HAGL_QOIDEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+Streaming decoder for the Quite OK Image format. All multibyte values are
+big endian. See https://qoiformat.org/ for the full specification.
+
+Offset  Size  Description
+0       4     Signature "qoif"
+4       4     Width
+8       4     Height
+12      1     Channels, 3 or 4
+13      1     Colorspace, 0 sRGB with linear alpha, 1 all linear
+14            Chunks followed by end marker of seven 0x00 bytes and 0x01
+
+Decoder keeps no image data besides the 64 entry color index. Pixels are
+handed out as RGBA8888 row fragments of at most QOIDEC_CHUNK_SIZE pixels.
+*/
+
+#define QOIDEC_OK (0)
+#define QOIDEC_ERR_INPUT (1)
+#define QOIDEC_ERR_SIGNATURE (2)
+#define QOIDEC_ERR_FORMAT (3)
+#define QOIDEC_ERR_INTERRUPTED (4)
+
+#define QOIDEC_HEADER_SIZE (14)
+
+/* Size of the input buffer. */
+#ifndef QOIDEC_BUFFER_SIZE
+#define QOIDEC_BUFFER_SIZE (256)
+#endif
+
+/* Maximum number of pixels passed to the output callback at once. */
+#ifndef QOIDEC_CHUNK_SIZE
+#define QOIDEC_CHUNK_SIZE (64)
+#endif
+
+/**
+ * Input callback
+ *
+ * @param device pointer passed to qoidec_prepare()
+ * @param buffer destination
+ * @param size maximum number of bytes to read
+ * @return number of bytes read, 0 on end of input or error
+ */
+typedef size_t (*qoidec_read_t)(void *device, uint8_t *buffer, size_t size);
+
+/**
+ * Output callback
+ *
+ * @param device pointer passed to qoidec_prepare()
+ * @param rgba width pixels of RGBA8888
+ * @param x0
+ * @param y0
+ * @param width number of pixels
+ * @return 1 to continue, 0 to interrupt decoding
+ */
+typedef uint8_t (*qoidec_write_t)(
+    void *device, const uint8_t *rgba, uint16_t x0, uint16_t y0, uint16_t width
+);
+
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint8_t channels;
+    uint8_t colorspace;
+    qoidec_read_t read;
+    void *device;
+    size_t offset;
+    size_t available;
+    uint8_t buffer[QOIDEC_BUFFER_SIZE];
+    uint8_t index[64 * 4];
+    uint8_t pixels[QOIDEC_CHUNK_SIZE * 4];
+} qoidec_t;
+
+/**
+ * Check if given data starts with the QOI signature
+ *
+ * @param data at least four bytes
+ * @return 1 if data has the signature
+ */
+static inline uint8_t qoidec_is_qoi(const uint8_t *data) {
+    return 'q' == data[0] && 'o' == data[1] && 'i' == data[2] && 'f' == data[3];
+}
+
+/**
+ * Read and validate the header
+ *
+ * Images wider or higher than 65535 pixels are rejected.
+ *
+ * @param decoder
+ * @param read input callback
+ * @param device pointer passed to the callbacks
+ * @return QOIDEC_OK or error code
+ */
+uint8_t qoidec_prepare(qoidec_t *decoder, qoidec_read_t read, void *device);
+
+/**
+ * Decode the image
+ *
+ * Rows are output top to bottom, each row left to right.
+ *
+ * @param decoder prepared decoder
+ * @param write output callback
+ * @return QOIDEC_OK or error code
+ */
+uint8_t qoidec_decode(qoidec_t *decoder, qoidec_write_t write);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HAGL_QOIDEC_H */
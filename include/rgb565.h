@@ -34,6 +34,8 @@ SPDX-License-Identifier: MIT
 #ifndef _RGB565_H
 #define _RGB565_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "rgb888.h"
@@ -42,9 +44,23 @@ SPDX-License-Identifier: MIT
 extern "C" {
 #endif /* __cplusplus */
 
+/*
+ * Bytes are swapped unless HAGL_PIXEL_FORMAT is HAGL_FORMAT_RGB565, see
+ * HAGL_PIXEL_RGB565 in hagl/format.h.
+ */
 uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b);
 rgb_t rgb565_to_rgb888(uint16_t *input);
 
+/*
+ * Convert arrays of pixels. Uses SSSE3 or NEON when available. Packing
+ * truncates like rgb565() and can be done in place. Swap means RGB565
+ * with bytes swapped like returned by rgb565() by default. BGR888 is the
+ * same as HAGL_FORMAT_RGB888, ie. blue is the first byte.
+ */
+void rgb888_to_rgb565_n(uint16_t *output, const rgb_t *input, size_t count, bool swap);
+void bgr888_to_rgb565_n(uint16_t *output, const uint8_t *input, size_t count, bool swap);
+void rgb565_to_rgb888_n(rgb_t *output, const uint16_t *input, size_t count, bool swap);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
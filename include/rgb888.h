@@ -35,6 +35,9 @@ SPDX-License-Identifier: MIT
 #ifndef _RGB888_H
 #define _RGB888_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -48,6 +51,8 @@ typedef struct {
 #include "hsl.h"
 
 hsl_t rgb888_to_hsl(rgb_t *rgb);
+hsl8_t rgb888_to_hsl8(const rgb_t *rgb);
+void rgb888_to_hsl8_array(hsl8_t *output, const rgb_t *input, size_t count);
 uint16_t rgb888_to_rgb565(rgb_t *input);
 
 static inline int min(int a, int b) {
@@ -7,7 +7,7 @@
 /*---------------------------------------------------------------------------*/
 /* System Configurations */
 
-#define	JD_SZBUF		512	/* Size of stream input buffer */
+#define	JD_SZBUF		512	/* Default size of stream input buffer */
 #define JD_FORMAT		1	/* Output pixel format 0:RGB888 (3 BYTE/pix), 1:RGB565 (1 WORD/pix) */
 #define	JD_USE_SCALE	1	/* Use descaling feature for output */
 #define JD_TBLCLIP		1	/* Use table for saturation (might be a bit faster but increases 1K bytes of code size) */
@@ -54,10 +54,13 @@ typedef struct {
 typedef struct JDEC JDEC;
 struct JDEC {
     uint16_t dctr;				/* Number of bytes available in the input buffer */
-    uint8_t* dptr;				/* Current data read ptr */
+    const uint8_t* dptr;		/* Current data read ptr */
     uint8_t* inbuf;				/* Bit stream input buffer */
+    uint16_t sz_buf;			/* Size of bit stream input buffer */
     uint8_t dmsk;				/* Current bit in the current read byte */
+    uint8_t dbyte;				/* Current read byte */
     uint8_t scale;				/* Output scaling ratio */
+    uint8_t format;				/* Output pixel format, JD_FORMAT unless changed after jd_prepare() */
     uint8_t msx, msy;			/* MCU size in unit of block (width, height) */
     uint8_t qtid[3];			/* Quantization table ID of each component */
     int16_t dcv[3];				/* Previous DC element of each component */
@@ -72,6 +75,7 @@ struct JDEC {
     void* pool;					/* Pointer to available memory pool */
     uint16_t sz_pool;			/* Size of momory pool (bytes available) */
     uint16_t (*infunc)(JDEC*, uint8_t*, uint16_t);/* Pointer to jpeg stream input function */
+    uint16_t (*inref)(JDEC*, const uint8_t**);/* Pointer to zero-copy bit stream input function or NULL */
     void* device;				/* Pointer to I/O device identifiler for the session */
 };
 
@@ -79,7 +83,11 @@ struct JDEC {
 
 /* TJpgDec API functions */
 JRESULT jd_prepare (JDEC*, uint16_t(*)(JDEC*,uint8_t*,uint16_t), void*, uint16_t, void*);
+JRESULT jd_prepare_ex (JDEC*, uint16_t(*)(JDEC*,uint8_t*,uint16_t), void*, uint16_t, uint16_t, void*);
 JRESULT jd_decomp (JDEC*, uint16_t(*)(JDEC*,void*,JRECT*), uint8_t);
+JRESULT jd_decomp_rect (JDEC*, uint16_t(*)(JDEC*,void*,JRECT*), uint8_t, const JRECT*);
+JRESULT jd_decomp_range (JDEC*, uint16_t(*)(JDEC*,void*,JRECT*), uint8_t, const JRECT*, uint32_t, uint32_t);
+JRESULT jd_clone (JDEC*, const JDEC*, void*, uint16_t, void*);
 
 
 #ifdef __cplusplus
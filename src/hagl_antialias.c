@@ -0,0 +1,293 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "hagl/antialias.h"
+#include "hagl/color.h"
+#include "hagl/rectangle.h"
+
+#include "hagl_math.h"
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+/*
+Shape is four quadrants of an ellipse around the corner centers x0, y0
+and x1, y1. Circles and ellipses have a single center. Rows and columns
+between the centers are straight. Radii are kept in half pixels so that
+the edge is at the outer side of the outermost pixels of the aliased
+shape.
+*/
+typedef struct {
+    hagl_color_t color;
+    bool outline;
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+    int32_t a;
+    int32_t b;
+    /* Rows currently being drawn. */
+    int16_t top[2];
+    int16_t bottom[2];
+    uint8_t bands;
+} shape_t;
+
+/*
+Signed distance of pixel x, y from the edge in 1/256 pixels, negative
+inside. Exact for circles. For ellipses the implicit function is divided
+by its gradient which is accurate close to the edge.
+*/
+static int32_t distance(const shape_t *shape, int32_t x, int32_t y) {
+    int64_t xx = 2 * x;
+    int64_t yy = 2 * y;
+    int64_t a2 = (int64_t)shape->a * shape->a;
+    int64_t b2 = (int64_t)shape->b * shape->b;
+
+    if (shape->a == shape->b) {
+        return (int32_t)isqrt((xx * xx + yy * yy) << 14) - shape->a * 128;
+    }
+
+    int64_t f = b2 * xx * xx + a2 * yy * yy - a2 * b2;
+    int64_t gx = b2 * xx;
+    int64_t gy = a2 * yy;
+    uint8_t shift = 0;
+
+    /* Keep the sum of squares in 64 bits. */
+    while (gx > INT32_MAX || gy > INT32_MAX) {
+        gx >>= 1;
+        gy >>= 1;
+        shift++;
+    }
+
+    int64_t g = (int64_t)isqrt(gx * gx + gy * gy) << shift;
+    if (0 == g) {
+        return -MIN(shape->a, shape->b) * 128;
+    }
+    return (int32_t)(f * 64 / g);
+}
+
+/* Coverage of pixel x, y from 0 to 255. */
+static uint8_t coverage(const shape_t *shape, int32_t x, int32_t y) {
+    int32_t d = distance(shape, x, y);
+    int32_t alpha;
+
+    if (shape->outline) {
+        /* One pixel wide line centered half a pixel inside the edge. */
+        alpha = 256 - abs(d + 128);
+    } else {
+        alpha = 128 - d;
+    }
+
+    return MAX(0, MIN(alpha, 255));
+}
+
+/* Last pixel inside the edge on row y or -1. */
+static int32_t edge(const shape_t *shape, int32_t y) {
+    int64_t yy = 2 * y;
+    int64_t a2 = (int64_t)shape->a * shape->a;
+    int64_t b2 = (int64_t)shape->b * shape->b;
+
+    if (yy > shape->b) {
+        return -1;
+    }
+    return isqrt(a2 * (b2 - yy * yy) / b2) / 2;
+}
+
+/* Draw columns x0...x1 on the current rows. */
+static void
+put(const void *surface, const shape_t *shape, int16_t x0, int16_t x1, uint8_t alpha) {
+    for (uint8_t i = 0; i < shape->bands; i++) {
+        hagl_fill_rectangle_alpha_xyxy(
+            surface, x0, shape->top[i], x1, shape->bottom[i], shape->color, alpha
+        );
+    }
+}
+
+/* Draw pixel x of every quadrant. Pixel 0 also covers the straight part. */
+static void
+put_pixel(const void *surface, const shape_t *shape, int32_t x, uint8_t alpha) {
+    if (0 == x) {
+        put(surface, shape, shape->x0, shape->x1, alpha);
+    } else {
+        put(surface, shape, shape->x0 - x, shape->x0 - x, alpha);
+        put(surface, shape, shape->x1 + x, shape->x1 + x, alpha);
+    }
+}
+
+/*
+Walk from the edge inwards and outwards over the partially covered
+pixels of row y. Rest of the filled row is solid.
+*/
+static void draw_row(const void *surface, const shape_t *shape, int32_t y) {
+    int32_t start = edge(shape, y);
+    int32_t x;
+
+    for (x = start; x >= 0; x--) {
+        uint8_t alpha = coverage(shape, x, y);
+        if ((shape->outline && 0 == alpha) || (!shape->outline && 255 == alpha)) {
+            break;
+        }
+        put_pixel(surface, shape, x, alpha);
+    }
+
+    if (x >= 0 && !shape->outline) {
+        put(surface, shape, shape->x0 - x, shape->x1 + x, 255);
+    }
+
+    for (x = start + 1;; x++) {
+        uint8_t alpha = coverage(shape, x, y);
+        if (0 == alpha) {
+            break;
+        }
+        put_pixel(surface, shape, x, alpha);
+    }
+}
+
+static void draw_shape(const void *surface, shape_t *shape) {
+    /* Center row is repeated between the centers. */
+    shape->top[0] = shape->y0;
+    shape->bottom[0] = shape->y1;
+    shape->bands = 1;
+    draw_row(surface, shape, 0);
+
+    shape->bands = 2;
+    for (int32_t y = 1;; y++) {
+        if (2 * y > shape->b && 0 == coverage(shape, 0, y)) {
+            break;
+        }
+        shape->top[0] = shape->bottom[0] = shape->y0 - y;
+        shape->top[1] = shape->bottom[1] = shape->y1 + y;
+        draw_row(surface, shape, y);
+    }
+}
+
+static void ellipse(
+    void const *surface, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_color_t color,
+    bool outline
+) {
+    if (a < 0 || b < 0) {
+        return;
+    }
+
+    shape_t shape = {
+        .color = color,
+        .outline = outline,
+        .x0 = x0,
+        .y0 = y0,
+        .x1 = x0,
+        .y1 = y0,
+        .a = 2 * a + 1,
+        .b = 2 * b + 1,
+    };
+    draw_shape(surface, &shape);
+}
+
+static void rounded_rectangle(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r,
+    hagl_color_t color, bool outline
+) {
+    int16_t left = MIN(x0, x1);
+    int16_t right = MAX(x0, x1);
+    int16_t top = MIN(y0, y1);
+    int16_t bottom = MAX(y0, y1);
+
+    /* Corner centers must not cross. */
+    r = MIN(r, (MIN(right - left, bottom - top)) / 2);
+    r = MAX(r, 0);
+
+    /* Without corners edges are on pixel boundaries. */
+    if (0 == r) {
+        if (outline) {
+            hagl_draw_rectangle_xyxy(surface, left, top, right, bottom, color);
+        } else {
+            hagl_fill_rectangle_xyxy(surface, left, top, right, bottom, color);
+        }
+        return;
+    }
+
+    shape_t shape = {
+        .color = color,
+        .outline = outline,
+        .x0 = left + r,
+        .y0 = top + r,
+        .x1 = right - r,
+        .y1 = bottom - r,
+        .a = 2 * r + 1,
+        .b = 2 * r + 1,
+    };
+    draw_shape(surface, &shape);
+}
+
+void hagl_draw_circle_aa(
+    void const *surface, int16_t x0, int16_t y0, int16_t r, hagl_color_t color
+) {
+    ellipse(surface, x0, y0, r, r, color, true);
+}
+
+void hagl_fill_circle_aa(
+    void const *surface, int16_t x0, int16_t y0, int16_t r, hagl_color_t color
+) {
+    ellipse(surface, x0, y0, r, r, color, false);
+}
+
+void hagl_draw_ellipse_aa(
+    void const *surface, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_color_t color
+) {
+    ellipse(surface, x0, y0, a, b, color, true);
+}
+
+void hagl_fill_ellipse_aa(
+    void const *surface, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_color_t color
+) {
+    ellipse(surface, x0, y0, a, b, color, false);
+}
+
+void hagl_draw_rounded_rectangle_aa_xyxy(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r,
+    hagl_color_t color
+) {
+    rounded_rectangle(surface, x0, y0, x1, y1, r, color, true);
+}
+
+void hagl_fill_rounded_rectangle_aa_xyxy(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r,
+    hagl_color_t color
+) {
+    rounded_rectangle(surface, x0, y0, x1, y1, r, color, false);
+}
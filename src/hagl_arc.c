@@ -0,0 +1,281 @@
+
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hagl/arc.h"
+#include "hagl/color.h"
+#include "hagl/span.h"
+#include "hagl/surface.h"
+
+#include "hagl_math.h"
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+#define HALF_TURN (180 << 16)
+#define FULL_TURN (360 << 16)
+
+/* Further than any pixel of a row. */
+#define FAR (1 << 20)
+
+/* Sine of 0-90 degrees scaled by 16384. */
+static const int16_t SINE[91] = {
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563, 2845, 3126, 3406, 3686,
+    3964, 4240, 4516, 4790, 5063, 5334, 5604, 5872, 6138, 6402, 6664, 6924, 7182,
+    7438, 7692, 7943, 8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365, 12551,
+    12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044, 14189, 14330,
+    14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296, 15396, 15491, 15582,
+    15668, 15749, 15826, 15897, 15964, 16026, 16083, 16135, 16182, 16225, 16262,
+    16294, 16322, 16344, 16362, 16374, 16382, 16384
+};
+
+/* Pixels of a row from x0 to x1. Empty when x0 is bigger than x1. */
+typedef struct {
+    int32_t x0;
+    int32_t x1;
+} interval_t;
+
+/* Sine of 16.16 fixed point angle from 0 to 360 degrees scaled by 16384. */
+static int32_t sine(int32_t angle) {
+    int32_t sign = 1;
+
+    if (angle >= HALF_TURN) {
+        angle -= HALF_TURN;
+        sign = -1;
+    }
+    if (angle > HALF_TURN / 2) {
+        angle = HALF_TURN - angle;
+    }
+
+    int32_t i = angle >> 16;
+    int32_t fraction = angle & 0xffff;
+
+    if (90 == i) {
+        return sign * SINE[90];
+    }
+    return sign * (SINE[i] + (((SINE[i + 1] - SINE[i]) * fraction) >> 16));
+}
+
+static inline int32_t floor_div(int32_t a, int32_t b) {
+    int32_t q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) {
+        q--;
+    }
+    return q;
+}
+
+/* Pixels of a row which satisfy s * x <= m. */
+static interval_t half_plane(int32_t s, int32_t m) {
+    interval_t interval = {-FAR, FAR};
+
+    if (s > 0) {
+        interval.x1 = MIN(floor_div(m, s), FAR);
+    } else if (s < 0) {
+        interval.x0 = MAX(-floor_div(m, -s), -FAR);
+    } else if (m < 0) {
+        interval.x0 = FAR;
+        interval.x1 = -FAR;
+    }
+
+    return interval;
+}
+
+/*
+ * Angle limits are half planes through the center. Pixel is on the
+ * clockwise side of the start ray when cross product of the ray and the
+ * pixel is positive, and on the counterclockwise side of the end ray when
+ * it is negative. Sector of up to a half turn is the intersection of the
+ * two half planes and a bigger one is their union, so each row has at
+ * most two intervals of pixels inside the angle.
+ */
+static uint8_t angle_row(
+    interval_t *out, int32_t k, bool full, int32_t sweep, int32_t cs, int32_t ss,
+    int32_t ce, int32_t se
+) {
+    if (full) {
+        out[0].x0 = -FAR;
+        out[0].x1 = FAR;
+        return 1;
+    }
+
+    interval_t a = half_plane(ss, cs * k);
+    interval_t b = half_plane(-se, -ce * k);
+
+    if (sweep <= HALF_TURN) {
+        out[0].x0 = MAX(a.x0, b.x0);
+        out[0].x1 = MIN(a.x1, b.x1);
+        return 1;
+    }
+
+    if (a.x0 > a.x1) {
+        out[0] = b;
+        return 1;
+    }
+    if (b.x0 > b.x1) {
+        out[0] = a;
+        return 1;
+    }
+    if (a.x0 > b.x0) {
+        interval_t swap = a;
+        a = b;
+        b = swap;
+    }
+    if (b.x0 <= a.x1 + 1) {
+        out[0].x0 = a.x0;
+        out[0].x1 = MAX(a.x1, b.x1);
+        return 1;
+    }
+
+    out[0] = a;
+    out[1] = b;
+    return 2;
+}
+
+/*
+ * Inner circle gives the pixels removed from the middle of each row.
+ * Rings remove the filled circle with radius one less than the inner
+ * radius. Outlines remove the row next to the current one further away
+ * from the center but always keep the outermost pixel.
+ */
+static void arc_span(
+    const hagl_surface_t *surface, int16_t x0, int16_t y0, int16_t r0, int16_t r1,
+    int32_t start, int32_t end, bool outline, hagl_span_t span, const void *paint
+) {
+    int64_t sweep = (int64_t)end - start;
+    bool full = sweep >= FULL_TURN;
+
+    if (r1 < 0) {
+        return;
+    }
+
+    sweep %= FULL_TURN;
+    if (sweep < 0) {
+        sweep += FULL_TURN;
+    }
+    if (!full && 0 == sweep) {
+        return;
+    }
+
+    start %= FULL_TURN;
+    if (start < 0) {
+        start += FULL_TURN;
+    }
+    end = (start + sweep) % FULL_TURN;
+
+    /* Ray directions scaled by 16384. */
+    int32_t cs = sine((start + HALF_TURN / 2) % FULL_TURN);
+    int32_t ss = sine(start);
+    int32_t ce = sine((end + HALF_TURN / 2) % FULL_TURN);
+    int32_t se = sine(end);
+
+    /* Rows outside of the clip window are skipped. */
+    int32_t top = MAX(-r1, surface->clip.y0 - y0);
+    int32_t bottom = MIN(r1, surface->clip.y1 - y0);
+
+    circle_row_t outer;
+    circle_row_t inner;
+    circle_row_init(&outer, r1, top);
+    if (outline) {
+        circle_row_init(&inner, r1, (top < 0 ? -top : top) + 1);
+    } else {
+        circle_row_init(&inner, r0 - 1, top);
+    }
+
+    for (int32_t y = top; y <= bottom; y++) {
+        int32_t width = circle_row_width(&outer, y);
+        int32_t hole;
+
+        if (width < 0) {
+            continue;
+        }
+
+        if (outline) {
+            hole = MIN(circle_row_width(&inner, (y < 0 ? -y : y) + 1), width - 1);
+        } else {
+            hole = circle_row_width(&inner, y);
+        }
+
+        interval_t shape[2] = {{-width, -hole - 1}, {hole + 1, width}};
+        uint8_t shapes = 2;
+        if (hole < 0) {
+            shape[0].x1 = width;
+            shapes = 1;
+        }
+
+        interval_t angle[2];
+        uint8_t angles = angle_row(angle, y, full, sweep, cs, ss, ce, se);
+
+        for (uint8_t i = 0; i < shapes; i++) {
+            for (uint8_t j = 0; j < angles; j++) {
+                int32_t left = MAX(shape[i].x0, angle[j].x0);
+                int32_t right = MIN(shape[i].x1, angle[j].x1);
+                if (left <= right) {
+                    span(surface, x0 + left, y0 + y, right - left + 1, paint);
+                }
+            }
+        }
+    }
+}
+
+void hagl_draw_arc(
+    void const *surface, int16_t x0, int16_t y0, int16_t r, int32_t start, int32_t end,
+    hagl_color_t color
+) {
+    arc_span(surface, x0, y0, r, r, start, end, true, hagl_span_color, &color);
+}
+
+void hagl_fill_pie(
+    void const *surface, int16_t x0, int16_t y0, int16_t r, int32_t start, int32_t end,
+    hagl_color_t color
+) {
+    arc_span(surface, x0, y0, 0, r, start, end, false, hagl_span_color, &color);
+}
+
+void hagl_fill_ring(
+    void const *surface, int16_t x0, int16_t y0, int16_t r0, int16_t r1, int32_t start,
+    int32_t end, hagl_color_t color
+) {
+    arc_span(surface, x0, y0, r0, r1, start, end, false, hagl_span_color, &color);
+}
+
+void hagl_fill_ring_span(
+    void const *surface, int16_t x0, int16_t y0, int16_t r0, int16_t r1, int32_t start,
+    int32_t end, hagl_span_t span, const void *paint
+) {
+    arc_span(surface, x0, y0, r0, r1, start, end, false, span, paint);
+}
@@ -0,0 +1,309 @@
+
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+
+#include "hagl.h"
+#include "hagl/bezier.h"
+#include "hagl/color.h"
+#include "hagl/line.h"
+#include "hagl/polygon.h"
+#include "hagl/span.h"
+
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#define ABS(x) ((x) > 0 ? (x) : -(x))
+
+/* Differences are kept in 32.32 fixed point. */
+#define FRACTION (32)
+
+/* Curve is split at most to 2^MAX_DEPTH lines. */
+#define MAX_DEPTH (10)
+#define FULL (1 << MAX_DEPTH)
+
+typedef void (*emit_t)(void *user, int16_t x, int16_t y);
+
+/* Polynomial a*t^3 + b*t^2 + c*t + d from t = 0 to 1. */
+typedef struct {
+    int32_t a[2];
+    int32_t b[2];
+    int32_t c[2];
+    int16_t start[2];
+    int16_t end[2];
+} curve_t;
+
+typedef struct {
+    void const *surface;
+    int16_t x;
+    int16_t y;
+    hagl_color_t color;
+} line_t;
+
+static inline int64_t norm(int64_t x, int64_t y) {
+    return ABS(x) + ABS(y);
+}
+
+/* Second derivative is d2 - d3 at the start of the step and d2 at the end. */
+static inline int64_t error(const int64_t d2[2], const int64_t d3[2]) {
+    int64_t start = norm(d2[0] - d3[0], d2[1] - d3[1]);
+    int64_t end = norm(d2[0], d2[1]);
+    return MAX(start, end);
+}
+
+/* Doubled step would have 4 * (d2 - d3) and 4 * (d2 + d3). */
+static inline int64_t doubled_error(const int64_t d2[2], const int64_t d3[2]) {
+    int64_t start = norm(d2[0] - d3[0], d2[1] - d3[1]);
+    int64_t end = norm(d2[0] + d3[0], d2[1] + d3[1]);
+    return 4 * MAX(start, end);
+}
+
+/*
+ * Adaptive forward differencing. Curve is stepped with the forward
+ * differences of the polynomial. Line of one step is at most 1/8 of the
+ * second derivative away from the curve and second derivative at both
+ * ends of the step is known from the differences. Step is halved while
+ * the error is too big and doubled while the doubled step would still
+ * be within the tolerance, so flat parts of the curve get long lines.
+ */
+static void flatten(const curve_t *curve, uint16_t tolerance, emit_t emit, void *user) {
+    int64_t f[2], d1[2], d2[2], d3[2];
+    int16_t last[2] = {curve->start[0], curve->start[1]};
+
+    for (uint8_t i = 0; i < 2; i++) {
+        f[i] = (int64_t)curve->start[i] << FRACTION;
+        d1[i] = (int64_t)(curve->a[i] + curve->b[i] + curve->c[i]) << FRACTION;
+        d2[i] = (int64_t)(6 * curve->a[i] + 2 * curve->b[i]) << FRACTION;
+        d3[i] = (int64_t)(6 * curve->a[i]) << FRACTION;
+    }
+
+    /* Eight times the tolerance in 32.32 fixed point. */
+    int64_t limit = (int64_t)MAX(tolerance, 1) << (FRACTION - 8 + 3);
+    uint32_t step = FULL;
+    uint32_t t = 0;
+
+    while (t < FULL) {
+        while (step > 1 && error(d2, d3) > limit) {
+            for (uint8_t i = 0; i < 2; i++) {
+                d1[i] = (d1[i] >> 1) - (d2[i] >> 3) + (d3[i] >> 4);
+                d2[i] = (d2[i] >> 2) - (d3[i] >> 3);
+                d3[i] = d3[i] >> 3;
+            }
+            step >>= 1;
+        }
+
+        /* Step can only grow at multiples of the doubled step. */
+        while (step < FULL && 0 == (t & (step * 2 - 1)) &&
+               doubled_error(d2, d3) <= limit) {
+            for (uint8_t i = 0; i < 2; i++) {
+                d1[i] = 2 * d1[i] + d2[i];
+                d2[i] = 4 * d2[i] + 4 * d3[i];
+                d3[i] = 8 * d3[i];
+            }
+            step <<= 1;
+        }
+
+        for (uint8_t i = 0; i < 2; i++) {
+            f[i] += d1[i];
+            d1[i] += d2[i];
+            d2[i] += d3[i];
+        }
+        t += step;
+
+        int16_t x = curve->end[0];
+        int16_t y = curve->end[1];
+        if (t < FULL) {
+            x = (f[0] + ((int64_t)1 << (FRACTION - 1))) >> FRACTION;
+            y = (f[1] + ((int64_t)1 << (FRACTION - 1))) >> FRACTION;
+        }
+
+        if (x != last[0] || y != last[1]) {
+            emit(user, x, y);
+            last[0] = x;
+            last[1] = y;
+        }
+    }
+}
+
+static void quadratic(
+    curve_t *curve, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+    int16_t y2
+) {
+    curve->a[0] = 0;
+    curve->a[1] = 0;
+    curve->b[0] = x0 - 2 * x1 + x2;
+    curve->b[1] = y0 - 2 * y1 + y2;
+    curve->c[0] = 2 * (x1 - x0);
+    curve->c[1] = 2 * (y1 - y0);
+    curve->start[0] = x0;
+    curve->start[1] = y0;
+    curve->end[0] = x2;
+    curve->end[1] = y2;
+}
+
+static void cubic(
+    curve_t *curve, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+    int16_t y2, int16_t x3, int16_t y3
+) {
+    curve->a[0] = -x0 + 3 * x1 - 3 * x2 + x3;
+    curve->a[1] = -y0 + 3 * y1 - 3 * y2 + y3;
+    curve->b[0] = 3 * x0 - 6 * x1 + 3 * x2;
+    curve->b[1] = 3 * y0 - 6 * y1 + 3 * y2;
+    curve->c[0] = 3 * (x1 - x0);
+    curve->c[1] = 3 * (y1 - y0);
+    curve->start[0] = x0;
+    curve->start[1] = y0;
+    curve->end[0] = x3;
+    curve->end[1] = y3;
+}
+
+static void emit_line(void *user, int16_t x, int16_t y) {
+    line_t *line = user;
+
+    hagl_draw_line(line->surface, line->x, line->y, x, y, line->color);
+    line->x = x;
+    line->y = y;
+}
+
+static void emit_vertex(void *user, int16_t x, int16_t y) {
+    hagl_path_t *path = user;
+
+    /* Amount keeps counting so that overflow can be detected. */
+    if (path->amount < path->size) {
+        path->vertices[(path->amount << 1) + 0] = x;
+        path->vertices[(path->amount << 1) + 1] = y;
+    }
+    if (path->amount < INT16_MAX) {
+        path->amount++;
+    }
+}
+
+void hagl_draw_quadratic(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+    int16_t y2, uint16_t tolerance, hagl_color_t color
+) {
+    curve_t curve;
+    line_t line = {surface, x0, y0, color};
+
+    quadratic(&curve, x0, y0, x1, y1, x2, y2);
+    flatten(&curve, tolerance, emit_line, &line);
+}
+
+void hagl_draw_cubic(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+    int16_t y2, int16_t x3, int16_t y3, uint16_t tolerance, hagl_color_t color
+) {
+    curve_t curve;
+    line_t line = {surface, x0, y0, color};
+
+    cubic(&curve, x0, y0, x1, y1, x2, y2, x3, y3);
+    flatten(&curve, tolerance, emit_line, &line);
+}
+
+void hagl_path_init(
+    hagl_path_t *path, int16_t *vertices, int16_t size, uint16_t tolerance
+) {
+    path->vertices = vertices;
+    path->size = size;
+    path->amount = 0;
+    path->tolerance = tolerance;
+}
+
+/* Drop the vertices which did not fit and report an error. */
+static uint32_t path_status(hagl_path_t *path) {
+    if (path->amount > path->size) {
+        path->amount = path->size;
+        return HAGL_ERR_GENERAL;
+    }
+    return HAGL_OK;
+}
+
+uint32_t hagl_path_move_to(hagl_path_t *path, int16_t x, int16_t y) {
+    path->amount = 0;
+    emit_vertex(path, x, y);
+    return path_status(path);
+}
+
+uint32_t hagl_path_line_to(hagl_path_t *path, int16_t x, int16_t y) {
+    emit_vertex(path, x, y);
+    return path_status(path);
+}
+
+uint32_t hagl_path_quadratic_to(
+    hagl_path_t *path, int16_t x1, int16_t y1, int16_t x2, int16_t y2
+) {
+    curve_t curve;
+
+    if (0 == path->amount) {
+        return HAGL_ERR_GENERAL;
+    }
+
+    int16_t x0 = path->vertices[(path->amount << 1) - 2];
+    int16_t y0 = path->vertices[(path->amount << 1) - 1];
+
+    quadratic(&curve, x0, y0, x1, y1, x2, y2);
+    flatten(&curve, path->tolerance, emit_vertex, path);
+    return path_status(path);
+}
+
+uint32_t hagl_path_cubic_to(
+    hagl_path_t *path, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3,
+    int16_t y3
+) {
+    curve_t curve;
+
+    if (0 == path->amount) {
+        return HAGL_ERR_GENERAL;
+    }
+
+    int16_t x0 = path->vertices[(path->amount << 1) - 2];
+    int16_t y0 = path->vertices[(path->amount << 1) - 1];
+
+    cubic(&curve, x0, y0, x1, y1, x2, y2, x3, y3);
+    flatten(&curve, path->tolerance, emit_vertex, path);
+    return path_status(path);
+}
+
+void hagl_draw_path(void const *surface, const hagl_path_t *path, hagl_color_t color) {
+    hagl_draw_polyline(surface, path->amount, path->vertices, color);
+}
+
+void hagl_fill_path(void const *surface, const hagl_path_t *path, hagl_color_t color) {
+    hagl_fill_polygon(surface, path->amount, path->vertices, color);
+}
+
+void hagl_fill_path_span(
+    void const *surface, const hagl_path_t *path, hagl_span_t span, const void *paint
+) {
+    hagl_fill_polygon_span(surface, path->amount, path->vertices, span, paint);
+}
@@ -33,11 +33,14 @@ SPDX-License-Identifier: MIT
 */
 
 #include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "hagl/bitmap.h"
+#include "hagl/color.h"
+#include "hagl/format.h"
 
 #include "hagl_hal.h"
 #include <stdio.h>
@@ -77,6 +80,120 @@ void vline(void *_bitmap, int16_t x0, int16_t y0, uint16_t height, hagl_color_t
     }
 }
 
+/*
+ * Blend two RGB565 pixels at once. Each channel of both pixels is moved
+ * to its own half of a 32 bit word so products do not overflow to the
+ * next channel. Foreground is premultiplied with alpha beforehand.
+ */
+static inline uint32_t blend_pair(uint32_t bg, const uint32_t fg[3], uint32_t ia) {
+    uint32_t r = ((((bg >> 11) & 0x001F001F) * ia + fg[0]) >> 5) & 0x001F001F;
+    uint32_t g = ((((bg >> 5) & 0x003F003F) * ia + fg[1]) >> 5) & 0x003F003F;
+    uint32_t b = (((bg & 0x001F001F) * ia + fg[2]) >> 5) & 0x001F001F;
+
+    return (r << 11) | (g << 5) | b;
+}
+
+static inline uint32_t swap_pair(uint32_t pixels) {
+    return ((pixels & 0x00FF00FF) << 8) | ((pixels >> 8) & 0x00FF00FF);
+}
+
+/*
+ * Blend a horizontal line. RGB565 is blended two pixels per 32 bit word
+ * with the same precision as hagl_blend(). Other depths are blended one
+ * pixel at a time.
+ */
+static void blend_hline(
+    void *_bitmap, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color,
+    uint8_t alpha
+) {
+    hagl_bitmap_t *bitmap = _bitmap;
+    uint8_t *ptr = bitmap->buffer + bitmap->pitch * y0 + (bitmap->depth / 8) * x0;
+
+    if (16 != bitmap->depth) {
+        for (uint16_t x = 0; x < width; x++) {
+            hagl_color_t *pixel = (hagl_color_t *)ptr;
+            *pixel = hagl_blend(bitmap, color, *pixel, alpha);
+            ptr += bitmap->depth / 8;
+        }
+        return;
+    }
+
+    bool swapped = HAGL_FORMAT_RGB565_SWAPPED == hagl_bitmap_format(bitmap);
+    uint32_t a = ((uint32_t)alpha + 4) >> 3;
+    uint32_t ia = 32 - a;
+    uint32_t pair = swapped ? swap_pair(color) : (uint16_t)color;
+    uint32_t fg[3] = {
+        ((pair >> 11) & 0x1F) * 0x00010001 * a,
+        ((pair >> 5) & 0x3F) * 0x00010001 * a,
+        (pair & 0x1F) * 0x00010001 * a
+    };
+    uint32_t pixels;
+    uint16_t pixel;
+
+    /* Single pixel until the pointer is aligned for whole words. */
+    if (width && ((uintptr_t)ptr & 2)) {
+        memcpy(&pixel, ptr, 2);
+        pixel = blend_pair(swapped ? swap_pair(pixel) : pixel, fg, ia);
+        pixel = swapped ? swap_pair(pixel) : pixel;
+        memcpy(ptr, &pixel, 2);
+        ptr += 2;
+        width--;
+    }
+
+    for (; width >= 2; width -= 2) {
+        memcpy(&pixels, ptr, 4);
+        if (swapped) {
+            pixels = swap_pair(blend_pair(swap_pair(pixels), fg, ia));
+        } else {
+            pixels = blend_pair(pixels, fg, ia);
+        }
+        memcpy(ptr, &pixels, 4);
+        ptr += 4;
+    }
+
+    if (width) {
+        memcpy(&pixel, ptr, 2);
+        pixel = blend_pair(swapped ? swap_pair(pixel) : pixel, fg, ia);
+        pixel = swapped ? swap_pair(pixel) : pixel;
+        memcpy(ptr, &pixel, 2);
+    }
+}
+
+/*
+ * Indexed bitmaps use the color as palette index.
+ */
+
+static void
+put_pixel_indexed(void *_bitmap, int16_t x0, int16_t y0, hagl_color_t color) {
+    hagl_bitmap_t *bitmap = _bitmap;
+
+    uint32_t bit = (uint32_t)x0 * bitmap->depth;
+    uint8_t *ptr = bitmap->buffer + bitmap->pitch * y0 + (bit >> 3);
+    uint8_t shift = 8 - bitmap->depth - (bit & 7);
+    uint8_t mask = ((1 << bitmap->depth) - 1) << shift;
+
+    *ptr = (*ptr & ~mask) | ((color << shift) & mask);
+}
+
+static hagl_color_t get_pixel_indexed(void *_bitmap, int16_t x0, int16_t y0) {
+    return hagl_bitmap_index(_bitmap, x0, y0);
+}
+
+static void
+hline_indexed(void *_bitmap, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color) {
+    for (uint16_t x = 0; x < width; x++) {
+        put_pixel_indexed(_bitmap, x0 + x, y0, color);
+    }
+}
+
+static void vline_indexed(
+    void *_bitmap, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color
+) {
+    for (uint16_t y = 0; y < height; y++) {
+        put_pixel_indexed(_bitmap, x0, y0 + y, color);
+    }
+}
+
 /*
  * Blit source bitmap to a destination bitmap->
  */
@@ -124,20 +241,20 @@ static void blit(void *_dst, int16_t x0, int16_t y0, void *_src) {
         return;
     }
 
-    uint8_t *dstptr =
-        (uint8_t *)(dst->buffer + (dst->pitch * y0) + ((dst->depth / 8) * x0));
-    uint8_t *srcptr =
-        (uint8_t *)(src->buffer + (src->pitch * y1) + ((dst->depth / 8) * x1));
+    uint8_t dst_format = hagl_bitmap_format(dst);
+    uint8_t src_format = hagl_bitmap_format(src);
+    uint8_t *dstptr = dst->buffer + (dst->pitch * y0) + ((dst->depth / 8) * x0);
+    uint8_t *srcptr = src->buffer + (src->pitch * y1) + ((src->depth / 8) * x1);
 
-    /* Bytes per pixel. */
-    uint8_t bytes = dst->depth / 8;
+    /* Rows of the same format are copied, others converted. */
     for (uint16_t y = 0; y < srch; y++) {
-        for (uint16_t x = 0; x < srcw; x++) {
-            for (uint16_t z = 0; z < bytes; z++) {
-                *(dstptr++) = *(srcptr++);
-            }
+        if (dst_format == src_format) {
+            memcpy(dstptr, srcptr, srcw * (dst->depth / 8));
+        } else {
+            hagl_convert(dstptr, dst_format, srcptr, src_format, srcw);
         }
-        dstptr += (dst->pitch / (dst->depth / 8) - srcw) * bytes;
+        dstptr += dst->pitch;
+        srcptr += src->pitch;
     }
 }
 
@@ -158,6 +275,8 @@ scale_blit(void *_dst, int16_t x0, int16_t y0, uint16_t dstw, uint16_t dsth, voi
 
     uint16_t srcw = src->width;
     uint16_t srch = src->height;
+    uint16_t x1 = 0;
+    uint16_t y1 = 0;
     uint32_t x_ratio = (uint32_t)((srcw << 16) / dstw);
     uint32_t y_ratio = (uint32_t)((srch << 16) / dsth);
 
@@ -166,15 +285,22 @@ scale_blit(void *_dst, int16_t x0, int16_t y0, uint16_t dstw, uint16_t dsth, voi
         return;
     }
 
+    /* Everything left or above of screen, nothing to do. */
+    if ((x0 + dstw <= 0) || (y0 + dsth <= 0)) {
+        return;
+    }
+
     /* x0 is negative, ignore parts outside of screen. */
     if (x0 < 0) {
         dstw = dstw + x0;
+        x1 = abs(x0);
         x0 = 0;
     }
 
     /* y0 is negative, ignore parts outside of screen. */
     if (y0 < 0) {
         dsth = dsth + y0;
+        y1 = abs(y0);
         y0 = 0;
     }
 
@@ -190,33 +316,38 @@ scale_blit(void *_dst, int16_t x0, int16_t y0, uint16_t dstw, uint16_t dsth, voi
 
     /* Bytes per pixel. */
     uint8_t bytes = dst->depth / 8;
+    uint8_t src_bytes = src->depth / 8;
+    uint8_t dst_format = hagl_bitmap_format(dst);
+    uint8_t src_format = hagl_bitmap_format(src);
 
-    /* If sentence here is not the most elegant thing, but makes */
-    /* the pointer maths much more easy to read. */
-    if (2 == bytes) {
-        uint16_t *dstptr =
-            (uint16_t *)(dst->buffer + dst->pitch * y0 + (dst->depth / 8) * x0);
-        uint16_t *srcptr = (uint16_t *)src->buffer;
-        for (uint16_t y = 0; y < dsth; y++) {
+    /* Different formats are converted pixel by pixel. */
+    for (uint16_t y = 0; y < dsth; y++) {
+        py = (((y + y1) * y_ratio) >> 16);
+        uint8_t *srcptr = src->buffer + src->pitch * py;
+        uint8_t *dstptr = dst->buffer + dst->pitch * (y0 + y) + bytes * x0;
+
+        if (dst_format != src_format) {
             for (uint16_t x = 0; x < dstw; x++) {
-                px = ((x * x_ratio) >> 16);
-                py = ((y * y_ratio) >> 16);
-                *(dstptr++) = srcptr[(uint8_t)((py * srcw) + px)];
+                px = (((x + x1) * x_ratio) >> 16);
+                hagl_convert(
+                    dstptr + x * bytes, dst_format, srcptr + px * src_bytes, src_format, 1
+                );
             }
-            dstptr += dst->pitch / (dst->depth / 8) - dstw;
-        }
-    } else {
-        /* Assume 1 byte per pixel. */
-        uint8_t *dstptr =
-            (uint8_t *)(dst->buffer + dst->pitch * y0 + (dst->depth / 8) * x0);
-        uint8_t *srcptr = (uint8_t *)src->buffer;
-        for (uint16_t y = 0; y < dsth; y++) {
+        } else if (2 == bytes) {
+            for (uint16_t x = 0; x < dstw; x++) {
+                px = (((x + x1) * x_ratio) >> 16);
+                ((uint16_t *)dstptr)[x] = ((uint16_t *)srcptr)[px];
+            }
+        } else if (1 == bytes) {
+            for (uint16_t x = 0; x < dstw; x++) {
+                px = (((x + x1) * x_ratio) >> 16);
+                dstptr[x] = srcptr[px];
+            }
+        } else {
             for (uint16_t x = 0; x < dstw; x++) {
-                px = ((x * x_ratio) >> 16);
-                py = ((y * y_ratio) >> 16);
-                *(dstptr++) = srcptr[(uint8_t)((py * srcw) + px)];
+                px = (((x + x1) * x_ratio) >> 16);
+                memcpy(dstptr + x * bytes, srcptr + px * bytes, bytes);
             }
-            dstptr += dst->pitch / (dst->depth / 8) - dstw;
         }
     }
 }
@@ -242,6 +373,38 @@ void hagl_bitmap_init(
     bitmap->get_pixel = get_pixel;
     bitmap->hline = hline;
     bitmap->vline = vline;
+    bitmap->blend_hline = blend_hline;
     bitmap->blit = blit;
     bitmap->scale_blit = scale_blit;
+    bitmap->palette = NULL;
+    bitmap->format = HAGL_FORMAT_NATIVE;
+}
+
+/* Initialise bitmap with given buffer and pixel format. */
+void hagl_bitmap_init_format(
+    hagl_bitmap_t *bitmap, int16_t width, uint16_t height, uint8_t format, void *buffer
+) {
+    hagl_bitmap_init(bitmap, width, height, hagl_format_depth(format), buffer);
+    bitmap->format = format;
+}
+
+/* Initialise indexed bitmap with given buffer and palette. */
+void hagl_bitmap_init_indexed(
+    hagl_bitmap_t *bitmap, int16_t width, uint16_t height, uint8_t depth, void *buffer,
+    const hagl_color_t *palette
+) {
+    hagl_bitmap_init(bitmap, width, height, depth, buffer);
+
+    bitmap->pitch = (bitmap->width * depth + 7) / 8;
+    bitmap->size = bitmap->pitch * bitmap->height;
+    bitmap->palette = palette;
+
+    /* Blitting to an indexed bitmap falls back to putting pixels. */
+    bitmap->put_pixel = put_pixel_indexed;
+    bitmap->get_pixel = get_pixel_indexed;
+    bitmap->hline = hline_indexed;
+    bitmap->vline = vline_indexed;
+    bitmap->blend_hline = NULL;
+    bitmap->blit = NULL;
+    bitmap->scale_blit = NULL;
 }
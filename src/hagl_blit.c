@@ -32,16 +32,144 @@ SPDX-License-Identifier: MIT
 
 */
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#include "config.h"
+#include "hagl.h"
 #include "hagl/bitmap.h"
+#include "hagl/blit.h"
 #include "hagl/color.h"
+#include "hagl/format.h"
+#include "hagl/hline.h"
 #include "hagl/pixel.h"
 #include "hagl/surface.h"
+#include "hrle.h"
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+/* Unpack consecutive indices of a row and look up their colors. */
+static void expand_row(
+    const hagl_bitmap_t *source, uint16_t x0, uint16_t y0, uint16_t count,
+    hagl_color_t *colors
+) {
+    const hagl_color_t *palette = source->palette;
+    uint8_t depth = source->depth;
+    uint32_t bit = (uint32_t)x0 * depth;
+    const uint8_t *ptr = source->buffer + source->pitch * y0 + (bit >> 3);
+    uint8_t mask = (1 << depth) - 1;
+    int8_t shift = 8 - depth - (bit & 7);
+    uint8_t byte = *ptr;
+
+    for (uint16_t i = 0; i < count; i++) {
+        /* Load the next byte only when needed to avoid reading past the row. */
+        if (shift < 0) {
+            shift = 8 - depth;
+            byte = *(++ptr);
+        }
+        colors[i] = palette[(byte >> shift) & mask];
+        shift -= depth;
+    }
+}
+
+/* HAL blit can only handle bitmaps with native colors. */
+static inline bool
+needs_convert(const hagl_surface_t *surface, const hagl_bitmap_t *source) {
+    return source->palette ||
+           hagl_bitmap_format(source) != hagl_native_format(surface->depth);
+}
+
+/*
+ * Expand an indexed bitmap through the palette or convert a bitmap of
+ * another format to native colors. Output is collected to a stack buffer
+ * in strips of as many rows as fit. Rows wider than the buffer are split.
+ * Strips are clipped beforehand so they can always be passed to the HAL
+ * blit. Rows are visited left to right, top to bottom so they can be
+ * dithered.
+ */
+static void blit_convert(
+    const hagl_surface_t *surface, int16_t x0, int16_t y0, uint16_t w, uint16_t h,
+    const hagl_bitmap_t *source, hagl_dither_t *dither
+) {
+    hagl_color_t buffer[HAGL_BLIT_BUFFER_SIZE / sizeof(hagl_color_t)];
+    uint16_t size = sizeof(buffer) / sizeof(hagl_color_t);
+    uint32_t x_ratio = (uint32_t)((source->width << 16) / w);
+    uint32_t y_ratio = (uint32_t)((source->height << 16) / h);
+    int32_t left = MAX(x0, surface->clip.x0);
+    int32_t top = MAX(y0, surface->clip.y0);
+    int32_t right = MIN(x0 + w - 1, surface->clip.x1);
+    int32_t bottom = MIN(y0 + h - 1, surface->clip.y1);
+    uint8_t format = hagl_bitmap_format(source);
+    uint8_t native = hagl_native_format(surface->depth);
+    uint8_t bytes = source->depth / 8;
+    uint8_t native_bytes = hagl_format_depth(native) / 8;
+    hagl_bitmap_t strip;
+
+    /* Everything outside clip window, nothing to do. */
+    if (left > right || top > bottom) {
+        return;
+    }
+
+    uint16_t rows = size / MIN(right - left + 1, size);
+
+    for (int32_t y = top; y <= bottom; y += rows) {
+        uint16_t height = MIN(bottom - y + 1, rows);
+        uint16_t width;
+
+        for (int32_t x = left; x <= right; x += width) {
+            width = MIN(right - x + 1, size);
+
+            /* Rows are packed the way the strip bitmap below expects. */
+            for (uint16_t row = 0; row < height; row++) {
+                hagl_color_t *colors =
+                    (hagl_color_t *)((uint8_t *)buffer + row * width * native_bytes);
+                uint16_t py = ((uint32_t)(y + row - y0) * y_ratio) >> 16;
+                const uint8_t *pixels = source->buffer + source->pitch * py;
+
+                if (source->palette && w == source->width) {
+                    expand_row(source, x - x0, py, width, colors);
+                } else if (source->palette) {
+                    for (uint16_t i = 0; i < width; i++) {
+                        uint16_t px = ((uint32_t)(x - x0 + i) * x_ratio) >> 16;
+                        colors[i] = source->palette[hagl_bitmap_index(source, px, py)];
+                    }
+                } else if (w == source->width) {
+                    pixels += (x - x0) * bytes;
+                    if (dither && x == left) {
+                        hagl_dither_row(dither, x, y + row);
+                    }
+                    hagl_convert_dither(colors, native, pixels, format, width, dither);
+                } else {
+                    for (uint16_t i = 0; i < width; i++) {
+                        uint16_t px = ((uint32_t)(x - x0 + i) * x_ratio) >> 16;
+                        hagl_convert(&colors[i], native, pixels + px * bytes, format, 1);
+                    }
+                }
+            }
+
+            if (surface->blit) {
+                hagl_bitmap_init(&strip, width, height, surface->depth, buffer);
+                surface->blit((void *)surface, x, y, &strip);
+            } else {
+                for (uint16_t i = 0; i < width * height; i++) {
+                    surface->put_pixel(
+                        (void *)surface, x + i % width, y + i / width, buffer[i]
+                    );
+                }
+            }
+        }
+    }
+}
 
 void hagl_blit_xy(void const *_surface, int16_t x0, int16_t y0, hagl_bitmap_t *source) {
     const hagl_surface_t *surface = _surface;
 
+    if (needs_convert(surface, source)) {
+        blit_convert(surface, x0, y0, source->width, source->height, source, NULL);
+        return;
+    }
+
     if (surface->blit) {
         /* Check if bitmap is inside clip windows bounds */
         if ((x0 < surface->clip.x0) || (y0 < surface->clip.y0) ||
@@ -84,6 +212,11 @@ void hagl_blit_xywh(
         return;
     }
 
+    if (needs_convert(surface, source)) {
+        blit_convert(surface, x0, y0, w, h, source, NULL);
+        return;
+    }
+
     if (surface->scale_blit) {
         surface->scale_blit((void *)_surface, x0, y0, w, h, source);
     } else {
@@ -102,3 +235,85 @@ void hagl_blit_xywh(
         }
     }
 }
+
+void hagl_blit_dither(
+    void const *_surface, int16_t x0, int16_t y0, hagl_bitmap_t *source,
+    hagl_dither_t *dither
+) {
+    const hagl_surface_t *surface = _surface;
+
+    if (!needs_convert(surface, source)) {
+        hagl_blit_xy(surface, x0, y0, source);
+        return;
+    }
+
+    /* Errors from the previous blit do not belong to this one. */
+    hagl_dither_init(dither, dither->mode, dither->errors, dither->width);
+    blit_convert(surface, x0, y0, source->width, source->height, source, dither);
+}
+
+static inline hagl_color_t rle_color(const uint8_t *ptr, uint8_t bytes) {
+    switch (bytes) {
+        case 1:
+            return ptr[0];
+        case 2:
+            return (hagl_color_t)(ptr[0] | (ptr[1] << 8));
+        case 3:
+            return (hagl_color_t)(ptr[0] | (ptr[1] << 8) | ((uint32_t)ptr[2] << 16));
+        default:
+            return (hagl_color_t)(ptr[0] | (ptr[1] << 8) | ((uint32_t)ptr[2] << 16) |
+                                  ((uint32_t)ptr[3] << 24));
+    }
+}
+
+uint32_t hagl_blit_rle(void const *_surface, int16_t x0, int16_t y0, const uint8_t *rle) {
+    const hagl_surface_t *surface = _surface;
+    hrle_meta_t meta;
+
+    if (HRLE_OK != hrle_meta(&meta, rle) || meta.depth != surface->depth) {
+        return HAGL_ERR_GENERAL;
+    }
+
+    const uint8_t *ptr = meta.data;
+    uint8_t bytes = meta.depth / 8;
+
+    for (uint16_t y = 0; y < meta.height; y++) {
+        int16_t y1 = y0 + y;
+
+        /* Rows are not indexed. Rows above the clip window are parsed but not drawn. */
+        bool visible = (y1 >= surface->clip.y0);
+
+        /* Below the clip window, nothing more to do. */
+        if (y1 > surface->clip.y1) {
+            break;
+        }
+
+        for (uint16_t x = 0; x < meta.width;) {
+            uint8_t header = *(ptr++);
+            uint8_t count = (header & ~HRLE_RUN) + 1;
+
+            if (header & HRLE_RUN) {
+                hagl_color_t color = rle_color(ptr, bytes);
+                ptr += bytes;
+
+                /* Transparent runs are skipped, others are drawn as a single span. */
+                if (visible && !(meta.transparent && color == meta.color)) {
+                    hagl_draw_hline_xyw(surface, x0 + x, y1, count, color);
+                }
+            } else {
+                if (visible) {
+                    for (uint8_t i = 0; i < count; i++) {
+                        hagl_color_t color = rle_color(ptr + i * bytes, bytes);
+                        if (!(meta.transparent && color == meta.color)) {
+                            hagl_put_pixel(surface, x0 + x + i, y1, color);
+                        }
+                    }
+                }
+                ptr += count * bytes;
+            }
+            x += count;
+        }
+    }
+
+    return HAGL_OK;
+}
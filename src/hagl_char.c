@@ -32,11 +32,158 @@ SPDX-License-Identifier: MIT
 
 */
 
+#include <string.h>
+
+#include "config.h"
 #include "fontx.h"
 #include "hagl.h"
 #include "hagl/bitmap.h"
 #include "hagl/blit.h"
 #include "hagl/color.h"
+#include "hagl/hline.h"
+#include "hagl/pixel.h"
+#include "hagl/rectangle.h"
+#include "hfont.h"
+
+/* Span of scaled pixels, single row unscaled is a plain horizontal line. */
+static void fill_span(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, uint16_t height,
+    hagl_color_t color
+) {
+    if (1 == height) {
+        hagl_draw_hline(surface, x0, y0, width, color);
+    } else {
+        hagl_fill_rectangle_xywh(surface, x0, y0, width, height, color);
+    }
+}
+
+/*
+ * Draw a HFNT glyph. Background is left untouched. Fully covered pixels
+ * are collected to horizontal spans, partially covered pixels are
+ * blended with the current contents of the surface.
+ */
+static uint16_t put_char_hfont(
+    void const *surface, wchar_t code, int16_t x0, int16_t y0, hagl_color_t color,
+    const uint8_t *font, uint8_t scale, uint16_t *hint
+) {
+    hfont_glyph_t glyph;
+    uint8_t status;
+
+    status = hfont_glyph(&glyph, code, font, hint);
+    if (HFONT_OK != status) {
+        return 0;
+    }
+
+    const uint8_t mask = (1 << glyph.bpp) - 1;
+    const uint8_t alpha = 255 / mask;
+    uint32_t bit = 0;
+
+    x0 += glyph.x_offset * scale;
+    y0 += glyph.y_offset * scale;
+
+    for (uint8_t y = 0; y < glyph.height; y++) {
+        int16_t span = -1;
+        int16_t y1 = y0 + y * scale;
+
+        for (uint8_t x = 0; x < glyph.width; x++) {
+            uint8_t shift = 8 - glyph.bpp - (bit & 7);
+            uint8_t coverage = (glyph.buffer[bit >> 3] >> shift) & mask;
+            bit += glyph.bpp;
+
+            if (mask == coverage) {
+                if (span < 0) {
+                    span = x;
+                }
+                continue;
+            }
+
+            if (span >= 0) {
+                fill_span(
+                    surface, x0 + span * scale, y1, (x - span) * scale, scale, color
+                );
+                span = -1;
+            }
+
+            if (coverage) {
+                int16_t x1 = x0 + x * scale;
+                for (uint8_t j = 0; j < scale; j++) {
+                    for (uint8_t i = 0; i < scale; i++) {
+                        hagl_color_t background =
+                            hagl_get_pixel(surface, x1 + i, y1 + j);
+                        hagl_put_pixel(
+                            surface,
+                            x1 + i,
+                            y1 + j,
+                            hagl_blend(surface, color, background, coverage * alpha)
+                        );
+                    }
+                }
+            }
+        }
+
+        if (span >= 0) {
+            fill_span(
+                surface,
+                x0 + span * scale,
+                y1,
+                (glyph.width - span) * scale,
+                scale,
+                color
+            );
+        }
+    }
+
+    return glyph.advance * scale;
+}
+
+/*
+ * Draw a scaled FONTX glyph. Each run of equal bits becomes a single
+ * rectangle and identical consecutive rows are merged into one.
+ */
+static uint16_t put_char_fontx_scaled(
+    void const *surface, wchar_t code, int16_t x0, int16_t y0, hagl_color_t color,
+    const uint8_t *font, uint8_t scale
+) {
+    fontx_glyph_t glyph;
+    uint8_t status;
+
+    status = fontx_glyph(&glyph, code, font);
+    if (0 != status) {
+        return 0;
+    }
+
+    for (uint8_t y = 0; y < glyph.height;) {
+        const uint8_t *row = glyph.buffer + y * glyph.pitch;
+        uint8_t rows = 1;
+
+        while (y + rows < glyph.height &&
+               0 == memcmp(row, row + rows * glyph.pitch, glyph.pitch)) {
+            rows++;
+        }
+
+        for (uint8_t x = 0; x < glyph.width;) {
+            uint8_t set = row[x / 8] & (0x80 >> (x % 8));
+            uint8_t start = x;
+
+            do {
+                x++;
+            } while (x < glyph.width && !set == !(row[x / 8] & (0x80 >> (x % 8))));
+
+            hagl_fill_rectangle_xywh(
+                surface,
+                x0 + start * scale,
+                y0 + y * scale,
+                (x - start) * scale,
+                rows * scale,
+                set ? color : 0x0000
+            );
+        }
+
+        y += rows;
+    }
+
+    return glyph.width * scale;
+}
 
 uint8_t hagl_get_glyph(
     void const *_surface, wchar_t code, hagl_color_t color, hagl_bitmap_t *bitmap,
@@ -58,6 +205,8 @@ uint8_t hagl_get_glyph(
     bitmap->height = glyph.height;
     bitmap->pitch = bitmap->width * (bitmap->depth / 8);
     bitmap->size = bitmap->pitch * bitmap->height;
+    bitmap->palette = NULL;
+    bitmap->format = HAGL_FORMAT_NATIVE;
 
     hagl_color_t *ptr = (hagl_color_t *)bitmap->buffer;
 
@@ -80,62 +229,113 @@ uint8_t hagl_put_char(
     void const *_surface, wchar_t code, int16_t x0, int16_t y0, hagl_color_t color,
     const uint8_t *font
 ) {
-    static uint8_t *buffer = NULL;
+    /* Scratch buffer lives on the stack so concurrent calls do not race. */
+    hagl_color_t buffer[HAGL_CHAR_BUFFER_SIZE / sizeof(hagl_color_t)];
     const hagl_surface_t *surface = _surface;
     uint8_t set, status;
+    uint16_t rows;
     hagl_bitmap_t bitmap;
     fontx_glyph_t glyph;
 
+    if (hfont_is_hfont(font)) {
+        return put_char_hfont(surface, code, x0, y0, color, font, 1, NULL);
+    }
+
     status = fontx_glyph(&glyph, code, font);
 
     if (0 != status) {
         return 0;
     }
 
-    /* Initialize character buffer when first called. */
-    if (NULL == buffer) {
-        buffer = calloc(HAGL_CHAR_BUFFER_SIZE, sizeof(uint8_t));
+    /* Glyphs bigger than the buffer are blitted in horizontal strips. */
+    size_t fit = sizeof(buffer) / (glyph.width * sizeof(hagl_color_t));
+    rows = fit > glyph.height ? glyph.height : fit;
+
+    /* Not even a single row fits so draw pixel by pixel. */
+    if (0 == rows) {
+        for (uint8_t y = 0; y < glyph.height; y++) {
+            for (uint8_t x = 0; x < glyph.width; x++) {
+                set = *(glyph.buffer + x / 8) & (0x80 >> (x % 8));
+                hagl_put_pixel(surface, x0 + x, y0 + y, set ? color : 0x0000);
+            }
+            glyph.buffer += glyph.pitch;
+        }
+        return glyph.width;
     }
 
-    hagl_bitmap_init(
-        &bitmap, glyph.width, glyph.height, surface->depth, (uint8_t *)buffer
-    );
+    for (uint16_t top = 0; top < glyph.height; top += rows) {
+        uint16_t height = glyph.height - top;
+        if (height > rows) {
+            height = rows;
+        }
 
-    hagl_color_t *ptr = (hagl_color_t *)bitmap.buffer;
+        hagl_bitmap_init(
+            &bitmap, glyph.width, height, surface->depth, (uint8_t *)buffer
+        );
 
-    for (uint8_t y = 0; y < glyph.height; y++) {
-        for (uint8_t x = 0; x < glyph.width; x++) {
-            set = *(glyph.buffer + x / 8) & (0x80 >> (x % 8));
-            if (set) {
-                *(ptr++) = color;
-            } else {
-                *(ptr++) = 0x0000;
+        hagl_color_t *ptr = buffer;
+
+        for (uint16_t y = 0; y < height; y++) {
+            for (uint8_t x = 0; x < glyph.width; x++) {
+                set = *(glyph.buffer + x / 8) & (0x80 >> (x % 8));
+                if (set) {
+                    *(ptr++) = color;
+                } else {
+                    *(ptr++) = 0x0000;
+                }
             }
+            glyph.buffer += glyph.pitch;
         }
-        glyph.buffer += glyph.pitch;
+
+        hagl_blit(surface, x0, y0 + top, &bitmap);
     }
 
-    hagl_blit(surface, x0, y0, &bitmap);
+    return glyph.width;
+}
+
+uint16_t hagl_put_char_scaled(
+    void const *surface, wchar_t code, int16_t x0, int16_t y0, hagl_color_t color,
+    const uint8_t *font, uint8_t scale
+) {
+    if (0 == scale) {
+        return 0;
+    }
 
-    return bitmap.width;
+    if (hfont_is_hfont(font)) {
+        return put_char_hfont(surface, code, x0, y0, color, font, scale, NULL);
+    }
+
+    if (1 == scale) {
+        return hagl_put_char(surface, code, x0, y0, color, font);
+    }
+
+    return put_char_fontx_scaled(surface, code, x0, y0, color, font, scale);
 }
 
 /*
- * Write a string of text by calling hagl_put_char() repeadetly. CR and LF
+ * Write a string of text by drawing the characters one by one. CR and LF
  * continue from the next line.
  */
-
-uint16_t hagl_put_text(
+static uint16_t put_text(
     void const *surface, const wchar_t *str, int16_t x0, int16_t y0, hagl_color_t color,
-    const unsigned char *font
+    const unsigned char *font, uint8_t scale
 ) {
     wchar_t temp;
-    uint8_t status;
+    uint8_t status, height;
     uint16_t original = x0;
-    fontx_meta_t meta;
+    uint16_t hint = 0;
+
+    if (hfont_is_hfont(font)) {
+        hfont_meta_t meta;
+        status = hfont_meta(&meta, font);
+        height = meta.height;
+    } else {
+        fontx_meta_t meta;
+        status = fontx_meta(&meta, font);
+        height = meta.height;
+    }
 
-    status = fontx_meta(&meta, font);
-    if (0 != status) {
+    if (0 != status || 0 == scale) {
         return 0;
     }
 
@@ -143,11 +343,29 @@ uint16_t hagl_put_text(
         temp = *str++;
         if (13 == temp || 10 == temp) {
             x0 = 0;
-            y0 += meta.height;
-        } else {
+            y0 += height * scale;
+        } else if (hfont_is_hfont(font)) {
+            x0 += put_char_hfont(surface, temp, x0, y0, color, font, scale, &hint);
+        } else if (1 == scale) {
             x0 += hagl_put_char(surface, temp, x0, y0, color, font);
+        } else {
+            x0 += put_char_fontx_scaled(surface, temp, x0, y0, color, font, scale);
         }
     } while (*str != 0);
 
     return x0 - original;
 }
+
+uint16_t hagl_put_text(
+    void const *surface, const wchar_t *str, int16_t x0, int16_t y0, hagl_color_t color,
+    const unsigned char *font
+) {
+    return put_text(surface, str, x0, y0, color, font, 1);
+}
+
+uint16_t hagl_put_text_scaled(
+    void const *surface, const wchar_t *str, int16_t x0, int16_t y0, hagl_color_t color,
+    const unsigned char *font, uint8_t scale
+) {
+    return put_text(surface, str, x0, y0, color, font, scale);
+}
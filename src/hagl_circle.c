@@ -32,74 +32,154 @@ SPDX-License-Identifier: MIT
 
 */
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#include "hagl/circle.h"
 #include "hagl/color.h"
 #include "hagl/hline.h"
 #include "hagl/pixel.h"
+#include "hagl/span.h"
+#include "hagl/surface.h"
+#include "hagl/vline.h"
 
+#include "hagl_math.h"
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+/*
+ * Draw a horizontal or vertical run. When the whole shape is inside the
+ * clip window the run is passed to the HAL without clipping.
+ */
+static void put_run(
+    const hagl_surface_t *surface, int16_t x0, int16_t y0, int16_t w, int16_t h,
+    hagl_color_t color, bool inside
+) {
+    if (1 == w && 1 == h) {
+        if (inside) {
+            surface->put_pixel((void *)surface, x0, y0, color);
+        } else {
+            hagl_put_pixel(surface, x0, y0, color);
+        }
+    } else if (1 == h) {
+        if (inside && surface->hline) {
+            surface->hline((void *)surface, x0, y0, w, color);
+        } else {
+            hagl_draw_hline_xyw(surface, x0, y0, w, color);
+        }
+    } else {
+        if (inside && surface->vline) {
+            surface->vline((void *)surface, x0, y0, h, color);
+        } else {
+            hagl_draw_vline_xyh(surface, x0, y0, h, color);
+        }
+    }
+}
+
+/*
+ * Same pixels as with eight hagl_put_pixel() calls per step. Steps with
+ * the same y are collected to a run which is drawn as horizontal lines in
+ * the flat octants and vertical lines in the steep octants.
+ */
 void hagl_draw_circle(
-    void const *surface, int16_t xc, int16_t yc, int16_t r, hagl_color_t color
+    void const *_surface, int16_t xc, int16_t yc, int16_t r, hagl_color_t color
 ) {
+    const hagl_surface_t *surface = _surface;
+    int16_t size = r < 0 ? -r : r;
+
+    /* Bounding box outside of the clip window, nothing to do. */
+    if ((xc + size < surface->clip.x0) || (xc - size > surface->clip.x1) ||
+        (yc + size < surface->clip.y0) || (yc - size > surface->clip.y1)) {
+        return;
+    }
+
+    bool inside = (xc - size >= surface->clip.x0) && (xc + size <= surface->clip.x1) &&
+                  (yc - size >= surface->clip.y0) && (yc + size <= surface->clip.y1);
+
     if (0 == r) {
-        hagl_put_pixel(surface, xc, yc, color);
+        put_run(surface, xc, yc, 1, 1, color, inside);
         return;
     }
 
     int16_t x = 0;
     int16_t y = r;
     int16_t d = 3 - 2 * r;
-
-    hagl_put_pixel(surface, xc + x, yc + y, color);
-    hagl_put_pixel(surface, xc - x, yc + y, color);
-    hagl_put_pixel(surface, xc + x, yc - y, color);
-    hagl_put_pixel(surface, xc - x, yc - y, color);
-    hagl_put_pixel(surface, xc + y, yc + x, color);
-    hagl_put_pixel(surface, xc - y, yc + x, color);
-    hagl_put_pixel(surface, xc + y, yc - x, color);
-    hagl_put_pixel(surface, xc - y, yc - x, color);
-
-    while (y >= x) {
-        if (d > 0) {
-            d = d + 4 * (x - y) + 10;
-            y--;
-            x++;
-        } else {
-            d = d + 4 * x + 6;
-            x++;
+    int16_t start = 0;
+
+    while (1) {
+        bool last = (y < x);
+        int16_t end = x;
+        int16_t run_y = y;
+
+        if (!last) {
+            if (d > 0) {
+                d = d + 4 * (x - y) + 10;
+                y--;
+                x++;
+            } else {
+                d = d + 4 * x + 6;
+                x++;
+            }
         }
 
-        hagl_put_pixel(surface, xc + x, yc + y, color);
-        hagl_put_pixel(surface, xc - x, yc + y, color);
-        hagl_put_pixel(surface, xc + x, yc - y, color);
-        hagl_put_pixel(surface, xc - x, yc - y, color);
-        hagl_put_pixel(surface, xc + y, yc + x, color);
-        hagl_put_pixel(surface, xc - y, yc + x, color);
-        hagl_put_pixel(surface, xc + y, yc - x, color);
-        hagl_put_pixel(surface, xc - y, yc - x, color);
+        /* Run ends when y changes or after the last step. */
+        if (last || y != run_y) {
+            int16_t length = end - start + 1;
+
+            put_run(surface, xc + start, yc + run_y, length, 1, color, inside);
+            put_run(surface, xc - end, yc + run_y, length, 1, color, inside);
+            put_run(surface, xc + start, yc - run_y, length, 1, color, inside);
+            put_run(surface, xc - end, yc - run_y, length, 1, color, inside);
+            put_run(surface, xc + run_y, yc + start, 1, length, color, inside);
+            put_run(surface, xc - run_y, yc + start, 1, length, color, inside);
+            put_run(surface, xc + run_y, yc - end, 1, length, color, inside);
+            put_run(surface, xc - run_y, yc - end, 1, length, color, inside);
+
+            if (last) {
+                break;
+            }
+            start = x;
+        }
     }
 }
 
 void hagl_fill_circle(
     void const *surface, int16_t x0, int16_t y0, int16_t r, hagl_color_t color
 ) {
-    int16_t x = 0;
-    int16_t y = r;
-    int16_t d = 3 - 2 * r;
+    hagl_fill_circle_span(surface, x0, y0, r, hagl_span_color, &color);
+}
+
+/* Rows are computed with circle_row_t, see hagl_math.h for the details. */
+void hagl_fill_circle_span(
+    void const *_surface, int16_t x0, int16_t y0, int16_t r, hagl_span_t span,
+    const void *paint
+) {
+    const hagl_surface_t *surface = _surface;
+    circle_row_t circle;
 
-    while (y >= x) {
-        hagl_draw_hline(surface, x0 - x, y0 + y, x * 2 + 1, color);
-        hagl_draw_hline(surface, x0 - x, y0 - y, x * 2 + 1, color);
-        hagl_draw_hline(surface, x0 - y, y0 + x, y * 2 + 1, color);
-        hagl_draw_hline(surface, x0 - y, y0 - x, y * 2 + 1, color);
+    if (r < 0) {
+        return;
+    }
 
-        if (d <= 0) {
-            d = d + 4 * x + 6;
-            x++;
-        } else {
-            d = d + 4 * (x - y) + 10;
-            x++;
-            y--;
+    /* Rows outside of the clip window are skipped. */
+    int32_t top = MAX(-r, surface->clip.y0 - y0);
+    int32_t bottom = MIN(r, surface->clip.y1 - y0);
+
+    circle_row_init(&circle, r, top);
+
+    for (int32_t y = top; y <= bottom; y++) {
+        int32_t width = circle_row_width(&circle, y);
+        if (width >= 0) {
+            span(surface, x0 - width, y0 + y, width * 2 + 1, paint);
         }
     }
 }
+
+void hagl_fill_circle_alpha(
+    void const *surface, int16_t x0, int16_t y0, int16_t r, hagl_color_t color,
+    uint8_t alpha
+) {
+    hagl_alpha_t paint = {color, alpha};
+    hagl_fill_circle_span(surface, x0, y0, r, hagl_span_alpha, &paint);
+}
@@ -34,7 +34,6 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/surface.h"
-#include "rgb565.h"
 
 hagl_color_t hagl_color(void const *_surface, uint8_t r, uint8_t g, uint8_t b) {
     const hagl_surface_t *surface = _surface;
@@ -42,5 +41,61 @@ hagl_color_t hagl_color(void const *_surface, uint8_t r, uint8_t g, uint8_t b) {
     if (surface->color) {
         return surface->color((void *)_surface, r, g, b);
     }
-    return rgb565(r, g, b);
+    return hagl_pack_rgb(r, g, b);
+}
+
+hagl_color_t hagl_blend(
+    void const *_surface, hagl_color_t foreground, hagl_color_t background, uint8_t alpha
+) {
+    const hagl_surface_t *surface = _surface;
+
+    if (255 == alpha) {
+        return foreground;
+    }
+    if (0 == alpha) {
+        return background;
+    }
+
+    if (16 == surface->depth) {
+#if HAGL_PIXEL_RGB565 == HAGL_FORMAT_RGB565_SWAPPED
+        foreground = (uint16_t)((foreground << 8) | (foreground >> 8));
+        background = (uint16_t)((background << 8) | (background >> 8));
+#endif
+        /* Spread RGB565 to 0b00000gggggg00000rrrrr000000bbbbb and */
+        /* blend all three channels with one multiplication. */
+        uint32_t fg = ((uint32_t)foreground | ((uint32_t)foreground << 16)) & 0x07E0F81F;
+        uint32_t bg = ((uint32_t)background | ((uint32_t)background << 16)) & 0x07E0F81F;
+        uint32_t a = ((uint32_t)alpha + 4) >> 3;
+
+        bg += ((fg - bg) * a) >> 5;
+        bg &= 0x07E0F81F;
+        bg = (bg | (bg >> 16)) & 0xFFFF;
+
+#if HAGL_PIXEL_RGB565 == HAGL_FORMAT_RGB565_SWAPPED
+        bg = ((bg << 8) | (bg >> 8)) & 0xFFFF;
+#endif
+        return (hagl_color_t)bg;
+    }
+
+    if (8 == surface->depth) {
+        /* RGB332 has different amount of bits per channel. */
+        uint8_t fr = foreground >> 5, fg = (foreground >> 2) & 0x07, fb = foreground & 0x03;
+        uint8_t br = background >> 5, bg = (background >> 2) & 0x07, bb = background & 0x03;
+        uint8_t r = (fr * alpha + br * (255 - alpha) + 127) / 255;
+        uint8_t g = (fg * alpha + bg * (255 - alpha) + 127) / 255;
+        uint8_t b = (fb * alpha + bb * (255 - alpha) + 127) / 255;
+
+        return (hagl_color_t)((r << 5) | (g << 2) | b);
+    }
+
+    /* One byte per channel. */
+    hagl_color_t color = 0;
+    for (uint8_t shift = 0; shift < surface->depth; shift += 8) {
+        uint16_t fg = (foreground >> shift) & 0xFF;
+        uint16_t bg = (background >> shift) & 0xFF;
+        uint16_t channel = (fg * alpha + bg * (255 - alpha) + 127) / 255;
+        color |= (hagl_color_t)channel << shift;
+    }
+
+    return color;
 }
@@ -32,35 +32,94 @@ SPDX-License-Identifier: MIT
 
 */
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hagl/ellipse.h"
 #include "hagl/color.h"
 #include "hagl/hline.h"
 #include "hagl/pixel.h"
+#include "hagl/span.h"
+#include "hagl/surface.h"
+#include "hagl/vline.h"
+
+#include "hagl_math.h"
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+/*
+ * Draw a horizontal or vertical run. When the whole shape is inside the
+ * clip window the run is passed to the HAL without clipping.
+ */
+static void put_run(
+    const hagl_surface_t *surface, int16_t x0, int16_t y0, int16_t w, int16_t h,
+    hagl_color_t color, bool inside
+) {
+    if (1 == w && 1 == h) {
+        if (inside) {
+            surface->put_pixel((void *)surface, x0, y0, color);
+        } else {
+            hagl_put_pixel(surface, x0, y0, color);
+        }
+    } else if (1 == h) {
+        if (inside && surface->hline) {
+            surface->hline((void *)surface, x0, y0, w, color);
+        } else {
+            hagl_draw_hline_xyw(surface, x0, y0, w, color);
+        }
+    } else {
+        if (inside && surface->vline) {
+            surface->vline((void *)surface, x0, y0, h, color);
+        } else {
+            hagl_draw_vline_xyh(surface, x0, y0, h, color);
+        }
+    }
+}
 
+/*
+ * Steps with the same y in the flat part and with the same x in the steep
+ * part are collected to runs and drawn as horizontal and vertical lines.
+ */
 void hagl_draw_ellipse(
-    void const *surface, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_color_t color
+    void const *_surface, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_color_t color
 ) {
+    const hagl_surface_t *surface = _surface;
     int16_t wx, wy;
     int32_t xa, ya;
     int32_t t;
     int32_t asq = a * a;
     int32_t bsq = b * b;
+    int16_t start;
+    int16_t sa = a < 0 ? -a : a;
+    int16_t sb = b < 0 ? -b : b;
+
+    /* Bounding box outside of the clip window, nothing to do. */
+    if ((x0 + sa < surface->clip.x0) || (x0 - sa > surface->clip.x1) ||
+        (y0 + sb < surface->clip.y0) || (y0 - sb > surface->clip.y1)) {
+        return;
+    }
+
+    bool inside = (x0 - sa >= surface->clip.x0) && (x0 + sa <= surface->clip.x1) &&
+                  (y0 - sb >= surface->clip.y0) && (y0 + sb <= surface->clip.y1);
 
     /* Zero radius ellipse should output a single pixel */
     if (0 == a && 0 == b) {
-        hagl_put_pixel(surface, x0, y0, color);
+        put_run(surface, x0, y0, 1, 1, color, inside);
         return;
     }
 
-    hagl_put_pixel(surface, x0, y0 + b, color);
-    hagl_put_pixel(surface, x0, y0 - b, color);
-
     wx = 0;
     wy = b;
     xa = 0;
     ya = asq * 2 * b;
     t = asq / 4 - asq * b;
+    start = 0;
 
     while (1) {
+        int16_t end = wx;
+        int16_t run = wy;
+
         t += xa + bsq;
 
         if (t >= 0) {
@@ -72,18 +131,22 @@ void hagl_draw_ellipse(
         xa += bsq * 2;
         wx++;
 
-        if (xa >= ya) {
-            break;
-        }
+        bool last = (xa >= ya);
 
-        hagl_put_pixel(surface, x0 + wx, y0 - wy, color);
-        hagl_put_pixel(surface, x0 - wx, y0 - wy, color);
-        hagl_put_pixel(surface, x0 + wx, y0 + wy, color);
-        hagl_put_pixel(surface, x0 - wx, y0 + wy, color);
-    }
+        if (last || wy != run) {
+            int16_t length = end - start + 1;
 
-    hagl_put_pixel(surface, x0 + a, y0, color);
-    hagl_put_pixel(surface, x0 - a, y0, color);
+            put_run(surface, x0 + start, y0 - run, length, 1, color, inside);
+            put_run(surface, x0 - end, y0 - run, length, 1, color, inside);
+            put_run(surface, x0 + start, y0 + run, length, 1, color, inside);
+            put_run(surface, x0 - end, y0 + run, length, 1, color, inside);
+
+            if (last) {
+                break;
+            }
+            start = wx;
+        }
+    }
 
     wx = a;
     wy = 0;
@@ -91,8 +154,12 @@ void hagl_draw_ellipse(
 
     ya = 0;
     t = bsq / 4 - bsq * a;
+    start = 0;
 
     while (1) {
+        int16_t end = wy;
+        int16_t run = wx;
+
         t += ya + asq;
 
         if (t >= 0) {
@@ -104,87 +171,104 @@ void hagl_draw_ellipse(
         ya += asq * 2;
         wy++;
 
-        if (ya > xa) {
-            break;
-        }
+        bool last = (ya > xa);
+
+        if (last || wx != run) {
+            int16_t length = end - start + 1;
+
+            put_run(surface, x0 + run, y0 - end, 1, length, color, inside);
+            put_run(surface, x0 - run, y0 - end, 1, length, color, inside);
+            put_run(surface, x0 + run, y0 + start, 1, length, color, inside);
+            put_run(surface, x0 - run, y0 + start, 1, length, color, inside);
 
-        hagl_put_pixel(surface, x0 + wx, y0 - wy, color);
-        hagl_put_pixel(surface, x0 - wx, y0 - wy, color);
-        hagl_put_pixel(surface, x0 + wx, y0 + wy, color);
-        hagl_put_pixel(surface, x0 - wx, y0 + wy, color);
+            if (last) {
+                break;
+            }
+            start = wy;
+        }
     }
 }
 
 void hagl_fill_ellipse(
     void const *surface, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_color_t color
 ) {
-    int16_t wx, wy;
-    int32_t xa, ya;
-    int32_t t;
-    int32_t asq = a * a;
-    int32_t bsq = b * b;
+    hagl_fill_ellipse_span(surface, x0, y0, a, b, hagl_span_color, &color);
+}
 
-    /* Zero radius ellipse should output a single pixel */
-    if (0 == a && 0 == b) {
-        hagl_put_pixel(surface, x0, y0, color);
+/*
+ * Rows are computed directly from the decision variables of the midpoint
+ * algorithm. In the flat part y is kept while 4b^2x^2 + a^2(2y - 1)^2 is
+ * below 4a^2b^2 + a^2 % 4, in the steep part x is kept while
+ * 4a^2y^2 + b^2(2x - 1)^2 is below 4a^2b^2 + b^2 % 4. Each part only covers
+ * the steps before the slope changes. Rows where neither part has a step
+ * get the center pixel so that thin ellipses do not have holes.
+ */
+void hagl_fill_ellipse_span(
+    void const *_surface, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_span_t span,
+    const void *paint
+) {
+    const hagl_surface_t *surface = _surface;
+    int64_t asq = (int64_t)a * a;
+    int64_t bsq = (int64_t)b * b;
+    int64_t flat_limit = 4 * asq * bsq + asq % 4;
+    int64_t steep_limit = 4 * asq * bsq + bsq % 4;
+
+    if (a < 0 || b < 0) {
         return;
     }
 
-    hagl_put_pixel(surface, x0, y0 + b, color);
-    hagl_put_pixel(surface, x0, y0 - b, color);
-
-    wx = 0;
-    wy = b;
-    xa = 0;
-    ya = asq * 2 * b;
-    t = asq / 4 - asq * b;
+    /* Rows outside of the clip window are skipped. */
+    int32_t top = MAX(-b, surface->clip.y0 - y0);
+    int32_t bottom = MIN(b, surface->clip.y1 - y0);
 
-    while (1) {
-        t += xa + bsq;
+    /* Widths change little between rows, start from the first one. */
+    int64_t flat = 0;
+    int64_t steep = 0;
 
-        if (t >= 0) {
-            ya -= asq * 2;
-            t -= ya;
-            wy--;
+    if (b > 0) {
+        int64_t k = top < 0 ? -top : top;
+        int64_t limit = flat_limit - asq * (2 * k - 1) * (2 * k - 1) - 1;
+        if (limit >= 0) {
+            flat = isqrt(limit / (4 * bsq));
         }
-
-        xa += bsq * 2;
-        wx++;
-
-        if (xa >= ya) {
-            break;
+        limit = steep_limit - 4 * asq * k * k - 1;
+        if (limit >= 0) {
+            steep = (isqrt(limit / bsq) + 1) / 2;
         }
-
-        hagl_draw_hline(surface, x0 - wx, y0 - wy, wx * 2 + 1, color);
-        hagl_draw_hline(surface, x0 - wx, y0 + wy, wx * 2 + 1, color);
     }
 
-    hagl_draw_hline(surface, x0 - a, y0, a * 2 + 1, color);
-
-    wx = a;
-    wy = 0;
-    xa = bsq * 2 * a;
-
-    ya = 0;
-    t = bsq / 4 - bsq * a;
-
-    while (1) {
-        t += ya + asq;
-
-        if (t >= 0) {
-            xa -= bsq * 2;
-            t = t - xa;
-            wx--;
-        }
-
-        ya += asq * 2;
-        wy++;
-
-        if (ya > xa) {
-            break;
+    for (int32_t y = top; y <= bottom; y++) {
+        int64_t k = y < 0 ? -y : y;
+        int64_t width = 0;
+
+        if (0 == k) {
+            width = a;
+        } else {
+            /* Flat part, widest x with 4b^2x^2 <= limit. */
+            int64_t limit = flat_limit - asq * (2 * k - 1) * (2 * k - 1) - 1;
+            while (4 * bsq * (flat + 1) * (flat + 1) <= limit) {
+                flat++;
+            }
+            while (flat > 0 && 4 * bsq * flat * flat > limit) {
+                flat--;
+            }
+            if (limit >= 0) {
+                width = MIN(flat, (asq * k - 1) / bsq);
+            }
+
+            /* Steep part, widest x with b^2(2x - 1)^2 <= limit. */
+            limit = steep_limit - 4 * asq * k * k - 1;
+            while (bsq * (2 * steep + 1) * (2 * steep + 1) <= limit) {
+                steep++;
+            }
+            while (steep > 0 && bsq * (2 * steep - 1) * (2 * steep - 1) > limit) {
+                steep--;
+            }
+            if (steep > 0 && asq * k <= bsq * steep) {
+                width = MAX(width, steep);
+            }
         }
 
-        hagl_draw_hline(surface, x0 - wx, y0 - wy, wx * 2 + 1, color);
-        hagl_draw_hline(surface, x0 - wx, y0 + wy, wx * 2 + 1, color);
+        span(surface, x0 - width, y0 + y, width * 2 + 1, paint);
     }
 }
@@ -0,0 +1,372 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "hagl/format.h"
+#include "rgb565.h"
+
+/* Pixels are converted through ARGB8888 in chunks of this many pixels. */
+#define CHUNK_SIZE (64)
+
+#define SWAP16(value) ((uint16_t)(((value) << 8) | ((value) >> 8)))
+
+/*
+ * Simple loops over plain arrays so that compilers can vectorise them.
+ * Narrow channels are widened by replicating the high bits. Narrowing
+ * truncates like rgb565() does.
+ */
+
+static void
+to_argb8888(uint32_t *argb, const uint8_t *src, uint8_t format, uint16_t count) {
+    switch (format) {
+        case HAGL_FORMAT_RGB332:
+            for (uint16_t i = 0; i < count; i++) {
+                uint32_t r = src[i] >> 5;
+                uint32_t g = (src[i] >> 2) & 0x07;
+                uint32_t b = src[i] & 0x03;
+                r = (r << 5) | (r << 2) | (r >> 1);
+                g = (g << 5) | (g << 2) | (g >> 1);
+                b = b * 0x55;
+                argb[i] = 0xFF000000 | (r << 16) | (g << 8) | b;
+            }
+            break;
+        case HAGL_FORMAT_RGB565:
+        case HAGL_FORMAT_RGB565_SWAPPED:
+            for (uint16_t i = 0; i < count; i++) {
+                uint16_t pixel;
+                memcpy(&pixel, src + i * 2, 2);
+                if (HAGL_FORMAT_RGB565_SWAPPED == format) {
+                    pixel = SWAP16(pixel);
+                }
+                uint32_t r = pixel >> 11;
+                uint32_t g = (pixel >> 5) & 0x3F;
+                uint32_t b = pixel & 0x1F;
+                r = (r << 3) | (r >> 2);
+                g = (g << 2) | (g >> 4);
+                b = (b << 3) | (b >> 2);
+                argb[i] = 0xFF000000 | (r << 16) | (g << 8) | b;
+            }
+            break;
+        case HAGL_FORMAT_RGB888:
+            for (uint16_t i = 0; i < count; i++) {
+                const uint8_t *pixel = src + i * 3;
+                argb[i] = 0xFF000000 | ((uint32_t)pixel[2] << 16) |
+                          ((uint32_t)pixel[1] << 8) | pixel[0];
+            }
+            break;
+        default:
+            memcpy(argb, src, count * 4);
+            break;
+    }
+}
+
+static void
+from_argb8888(uint8_t *dst, uint8_t format, const uint32_t *argb, uint16_t count) {
+    switch (format) {
+        case HAGL_FORMAT_RGB332:
+            for (uint16_t i = 0; i < count; i++) {
+                uint32_t pixel = argb[i];
+                dst[i] = ((pixel >> 16) & 0xE0) | ((pixel >> 11) & 0x1C) |
+                         ((pixel >> 6) & 0x03);
+            }
+            break;
+        case HAGL_FORMAT_RGB565:
+        case HAGL_FORMAT_RGB565_SWAPPED:
+            for (uint16_t i = 0; i < count; i++) {
+                uint32_t pixel = argb[i];
+                uint16_t color = ((pixel >> 8) & 0xF800) | ((pixel >> 5) & 0x07E0) |
+                                 ((pixel >> 3) & 0x001F);
+                if (HAGL_FORMAT_RGB565_SWAPPED == format) {
+                    color = SWAP16(color);
+                }
+                memcpy(dst + i * 2, &color, 2);
+            }
+            break;
+        case HAGL_FORMAT_RGB888:
+            for (uint16_t i = 0; i < count; i++) {
+                uint8_t *pixel = dst + i * 3;
+                pixel[0] = argb[i];
+                pixel[1] = argb[i] >> 8;
+                pixel[2] = argb[i] >> 16;
+            }
+            break;
+        default:
+            for (uint16_t i = 0; i < count; i++) {
+                uint32_t pixel = argb[i] | 0xFF000000;
+                memcpy(dst + i * 4, &pixel, 4);
+            }
+            break;
+    }
+}
+
+void hagl_convert(
+    void *_dst, uint8_t dst_format, const void *_src, uint8_t src_format, uint32_t count
+) {
+    uint8_t *dst = _dst;
+    const uint8_t *src = _src;
+    uint8_t dst_bytes = hagl_format_depth(dst_format) / 8;
+    uint8_t src_bytes = hagl_format_depth(src_format) / 8;
+    uint32_t argb[CHUNK_SIZE];
+
+    if (0 == dst_bytes || 0 == src_bytes) {
+        return;
+    }
+
+    if (dst_format == src_format) {
+        memmove(dst, src, count * dst_bytes);
+        return;
+    }
+
+    /* Most common conversion when assets are RGB888 and display is RGB565. */
+    if (HAGL_FORMAT_RGB888 == src_format && 2 == dst_bytes) {
+        bgr888_to_rgb565_n(
+            (uint16_t *)dst, src, count, HAGL_FORMAT_RGB565_SWAPPED == dst_format
+        );
+        return;
+    }
+
+    /* Only byte order differs. */
+    if (2 == src_bytes && 2 == dst_bytes) {
+        for (uint32_t i = 0; i < count; i++) {
+            uint16_t pixel;
+            memcpy(&pixel, src + i * 2, 2);
+            pixel = SWAP16(pixel);
+            memcpy(dst + i * 2, &pixel, 2);
+        }
+        return;
+    }
+
+    while (count) {
+        uint16_t chunk = count < CHUNK_SIZE ? count : CHUNK_SIZE;
+
+        to_argb8888(argb, src, src_format, chunk);
+        from_argb8888(dst, dst_format, argb, chunk);
+
+        src += chunk * src_bytes;
+        dst += chunk * dst_bytes;
+        count -= chunk;
+    }
+}
+
+static const uint8_t BAYER[4][4] = {
+    {0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}
+};
+
+/* Bits of red, green and blue channels. Returns 0 for formats not dithered. */
+static uint8_t dither_bits(uint8_t format, uint8_t *bits) {
+    switch (format) {
+        case HAGL_FORMAT_RGB332:
+            bits[0] = 3;
+            bits[1] = 3;
+            bits[2] = 2;
+            return 1;
+        case HAGL_FORMAT_RGB565:
+        case HAGL_FORMAT_RGB565_SWAPPED:
+            bits[0] = 5;
+            bits[1] = 6;
+            bits[2] = 5;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Threshold is scaled to the size of one step of the truncated channel. */
+static inline uint8_t ordered(uint8_t value, uint8_t threshold, uint8_t bits) {
+    uint16_t result = value + ((threshold << 4) >> bits);
+    return result > 255 ? 255 : result;
+}
+
+/* Value the channel will have when it is truncated and widened again. */
+static inline int16_t truncated(int16_t value, uint8_t bits) {
+    uint8_t high = value >> (8 - bits);
+    int16_t result = 0;
+
+    for (int8_t shift = 8 - bits; shift > -bits; shift -= bits) {
+        result |= shift >= 0 ? high << shift : high >> -shift;
+    }
+    return result;
+}
+
+static void dither_ordered(
+    hagl_dither_t *dither, uint32_t *argb, const uint8_t *bits, uint16_t count
+) {
+    const uint8_t *row = BAYER[dither->y & 3];
+
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t threshold = row[(dither->x + dither->column + i) & 3];
+        uint32_t pixel = argb[i];
+        uint32_t result = pixel & 0xFF000000;
+
+        for (uint8_t c = 0; c < 3; c++) {
+            uint8_t shift = 16 - c * 8;
+            uint8_t value = pixel >> shift;
+            result |= (uint32_t)ordered(value, threshold, bits[c]) << shift;
+        }
+        argb[i] = result;
+    }
+}
+
+/*
+ * Floyd-Steinberg with a single row of errors. Slot x + 1 holds the error
+ * for column x of the next row. It is read before it is overwritten with
+ * the error for column x - 1. Carry holds the error to the right and the
+ * partial sums below, to the bottom left and to the bottom right of the
+ * current pixel for each channel.
+ */
+static void dither_diffusion(
+    hagl_dither_t *dither, uint32_t *argb, const uint8_t *bits, uint16_t count
+) {
+    int16_t *carry = dither->carry;
+
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t column = dither->column + i;
+
+        /* Wider rows than the error buffer are only truncated. */
+        if (column >= dither->width) {
+            break;
+        }
+
+        int16_t *below = dither->errors + column * 3;
+        uint32_t pixel = argb[i];
+        uint32_t result = pixel & 0xFF000000;
+
+        for (uint8_t c = 0; c < 3; c++) {
+            uint8_t shift = 16 - c * 8;
+            int16_t value = ((pixel >> shift) & 0xFF) + carry[c] + below[3 + c];
+
+            value = value < 0 ? 0 : (value > 255 ? 255 : value);
+
+            int16_t error = value - truncated(value, bits[c]);
+            int16_t right = error * 7 / 16;
+            int16_t left = error * 3 / 16;
+            int16_t down = error * 5 / 16;
+
+            /* Rounding leftovers go to the last neighbour so no error is lost. */
+            below[c] = carry[3 + c] + left;
+            carry[3 + c] = carry[6 + c] + down;
+            carry[6 + c] = error - right - left - down;
+            carry[c] = right;
+
+            result |= (uint32_t)value << shift;
+        }
+        argb[i] = result;
+    }
+}
+
+void hagl_dither_init(
+    hagl_dither_t *dither, uint8_t mode, int16_t *errors, uint16_t width
+) {
+    if (HAGL_DITHER_DIFFUSION == mode && !errors) {
+        mode = HAGL_DITHER_ORDERED;
+    }
+
+    dither->mode = mode;
+    dither->errors = errors;
+    dither->width = width;
+    dither->column = 0;
+    dither->x = 0;
+    dither->y = 0;
+    memset(dither->carry, 0, sizeof(dither->carry));
+
+    if (errors) {
+        memset(errors, 0, HAGL_DITHER_ERRORS(width) * sizeof(int16_t));
+    }
+}
+
+void hagl_dither_row(hagl_dither_t *dither, int16_t x0, int16_t y0) {
+    /* Store the pending error below the last pixel of the previous row. */
+    if (HAGL_DITHER_DIFFUSION == dither->mode && dither->column) {
+        uint16_t column = dither->column < dither->width ? dither->column : dither->width;
+        for (uint8_t c = 0; c < 3; c++) {
+            dither->errors[column * 3 + c] = dither->carry[3 + c];
+        }
+    }
+
+    dither->x = x0;
+    dither->y = y0;
+    dither->column = 0;
+    memset(dither->carry, 0, sizeof(dither->carry));
+}
+
+void hagl_convert_dither(
+    void *_dst, uint8_t dst_format, const void *_src, uint8_t src_format, uint32_t count,
+    hagl_dither_t *dither
+) {
+    uint8_t *dst = _dst;
+    const uint8_t *src = _src;
+    uint8_t dst_bytes = hagl_format_depth(dst_format) / 8;
+    uint8_t src_bytes = hagl_format_depth(src_format) / 8;
+    uint32_t argb[CHUNK_SIZE];
+    uint8_t bits[3];
+
+    if (!dither || HAGL_DITHER_NONE == dither->mode || !dither_bits(dst_format, bits) ||
+        0 == src_bytes) {
+        hagl_convert(_dst, dst_format, _src, src_format, count);
+        return;
+    }
+
+    /* Whole chunk is read before it is written so in place narrowing works. */
+    while (count) {
+        uint16_t chunk = count < CHUNK_SIZE ? count : CHUNK_SIZE;
+
+        to_argb8888(argb, src, src_format, chunk);
+        if (HAGL_DITHER_DIFFUSION == dither->mode) {
+            dither_diffusion(dither, argb, bits, chunk);
+        } else {
+            dither_ordered(dither, argb, bits, chunk);
+        }
+        from_argb8888(dst, dst_format, argb, chunk);
+
+        dither->column += chunk;
+        src += chunk * src_bytes;
+        dst += chunk * dst_bytes;
+        count -= chunk;
+    }
+}
+
+void hagl_dither_rgb(uint8_t format, int16_t x, int16_t y, uint8_t *rgb) {
+    uint8_t threshold = BAYER[y & 3][x & 3];
+    uint8_t bits[3];
+
+    if (!dither_bits(format, bits)) {
+        return;
+    }
+
+    for (uint8_t c = 0; c < 3; c++) {
+        rgb[c] = ordered(rgb[c], threshold, bits[c]);
+    }
+}
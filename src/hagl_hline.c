@@ -34,6 +34,7 @@ SPDX-License-Identifier: MIT
 
 #include "hagl/color.h"
 #include "hagl/line.h"
+#include "hagl/pixel.h"
 #include "hagl/surface.h"
 
 void hagl_draw_hline_xyw(
@@ -71,3 +72,53 @@ void hagl_draw_hline_xyw(
         hagl_draw_line(surface, x0, y0, x0 + w - 1, y0, color);
     }
 }
+
+void hagl_draw_hline_alpha_xyw(
+    void const *_surface, int16_t x0, int16_t y0, uint16_t w, hagl_color_t color,
+    uint8_t alpha
+) {
+    const hagl_surface_t *surface = _surface;
+    int16_t width = w;
+
+    if (0 == alpha) {
+        return;
+    }
+    if (255 == alpha) {
+        hagl_draw_hline_xyw(_surface, x0, y0, w, color);
+        return;
+    }
+
+    /* x0 or y0 is over the edge, nothing to do. */
+    if ((x0 > surface->clip.x1) || (y0 > surface->clip.y1) || (y0 < surface->clip.y0)) {
+        return;
+    }
+
+    /* x0 is left of clip window, ignore start part. */
+    if (x0 < surface->clip.x0) {
+        width = width - (surface->clip.x0 - x0);
+        x0 = surface->clip.x0;
+    }
+
+    /* Cut anything going over right edge of clip window. */
+    if ((x0 + width - 1) > surface->clip.x1) {
+        width = surface->clip.x1 - x0 + 1;
+    }
+
+    /* Everything outside clip window, nothing to do. */
+    if (width <= 0) {
+        return;
+    }
+
+    if (surface->blend_hline) {
+        surface->blend_hline((void *)_surface, x0, y0, width, color, alpha);
+        return;
+    }
+
+    /* Slow path, read back and blend every pixel. */
+    for (int16_t x = x0; x < x0 + width; x++) {
+        hagl_color_t background = hagl_get_pixel(_surface, x, y0);
+        surface->put_pixel(
+            (void *)_surface, x, y0, hagl_blend(surface, color, background, alpha)
+        );
+    }
+}
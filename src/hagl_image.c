@@ -32,46 +32,265 @@ SPDX-License-Identifier: MIT
 
 */
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* __linux__ */
+
+#ifdef HAGL_IMAGE_PARALLEL
+#include <pthread.h>
+#endif /* HAGL_IMAGE_PARALLEL */
+
+#include "config.h"
 #include "hagl.h"
+#include "hagl/format.h"
 #include "hagl/image.h"
 #include "hagl/surface.h"
+#include "pngdec.h"
+#include "qoidec.h"
+#include "rgb565.h"
 #include "tjpgd.h"
 
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+#define IMAGE_JPEG (0)
+#define IMAGE_PNG (1)
+#define IMAGE_QOI (2)
+
+#define RGBA_CHUNK_SIZE MAX(QOIDEC_CHUNK_SIZE, PNGDEC_CHUNK_SIZE)
+
 typedef struct {
     FILE *fp;
+    const uint8_t *data;
+    size_t size;
+    size_t offset;
+    hagl_image_read_t read;
+    void *user;
     int16_t x0;
     int16_t y0;
     const hagl_surface_t *surface;
+    hagl_bitmap_t *bitmap;
+    JRECT crop;
+    JRECT roi;
+    uint8_t scale;
+    uint8_t dither;
+    uint8_t peek[4];
+    uint8_t peek_size;
+    uint8_t peeked;
 } tjpgd_iodev_t;
 
-static uint16_t tjpgd_data_reader(JDEC *decoder, uint8_t *buffer, uint16_t size) {
-    tjpgd_iodev_t *device = (tjpgd_iodev_t *)decoder->device;
+/*
+ * Read from memory, file or stream. Bytes which were peeked when detecting
+ * the image format are handed out first. If buffer is NULL bytes are
+ * skipped instead.
+ */
+static size_t device_read(tjpgd_iodev_t *device, uint8_t *buffer, size_t size) {
+    size_t total = 0;
 
+    while (total < size && device->peeked < device->peek_size) {
+        if (buffer) {
+            buffer[total] = device->peek[device->peeked];
+        }
+        device->peeked++;
+        total++;
+    }
     if (buffer) {
-        /* Read bytes from input stream. */
-        return (uint16_t)fread(buffer, 1, size, device->fp);
-    } else {
+        buffer += total;
+    }
+    size -= total;
+
+    if (device->data) {
+        size_t available = device->size - device->offset;
+
+        if (size > available) {
+            size = available;
+        }
+        if (buffer) {
+            memcpy(buffer, device->data + device->offset, size);
+        }
+        device->offset += size;
+        return total + size;
+    }
+
+    if (device->fp) {
+        if (buffer) {
+            /* Read bytes from input stream. */
+            return total + fread(buffer, 1, size, device->fp);
+        }
         /* Skip bytes from input stream. */
-        return fseek(device->fp, size, SEEK_CUR) ? 0 : size;
+        return fseek(device->fp, size, SEEK_CUR) ? total : total + size;
+    }
+
+    /* Stream may return less than asked, keep reading until done or error. */
+    while (size) {
+        size_t count = device->read(device->user, buffer, size);
+        if (0 == count) {
+            break;
+        }
+        if (buffer) {
+            buffer += count;
+        }
+        total += count;
+        size -= count;
+    }
+
+    return total;
+}
+
+static uint16_t tjpgd_reader(JDEC *decoder, uint8_t *buffer, uint16_t size) {
+    return (uint16_t)device_read(decoder->device, buffer, size);
+}
+
+/* Hand out pointer to the remaining data instead of copying it. */
+static uint16_t tjpgd_mem_referencer(JDEC *decoder, const uint8_t **data) {
+    tjpgd_iodev_t *device = (tjpgd_iodev_t *)decoder->device;
+    size_t available = device->size - device->offset;
+
+    if (available > UINT16_MAX) {
+        available = UINT16_MAX;
+    }
+    *data = device->data + device->offset;
+    device->offset += available;
+
+    return (uint16_t)available;
+}
+
+static size_t rgba_reader(void *device, uint8_t *buffer, size_t size) {
+    return device_read(device, buffer, size);
+}
+
+/*
+ * Detect image format from the signature. Memory is inspected in place,
+ * from files and streams the first bytes are peeked.
+ */
+static uint8_t image_format(tjpgd_iodev_t *device) {
+    const uint8_t *signature = device->peek;
+
+    if (device->data) {
+        if (device->size - device->offset < sizeof(device->peek)) {
+            return IMAGE_JPEG;
+        }
+        signature = device->data + device->offset;
+    } else {
+        device->peek_size = device_read(device, device->peek, sizeof(device->peek));
+        device->peeked = 0;
+        if (device->peek_size < sizeof(device->peek)) {
+            return IMAGE_JPEG;
+        }
+    }
+
+    if (pngdec_is_png(signature)) {
+        return IMAGE_PNG;
+    }
+    if (qoidec_is_qoi(signature)) {
+        return IMAGE_QOI;
+    }
+
+    /* Everything else is left for tjpgd to reject. */
+    return IMAGE_JPEG;
+}
+
+/*
+ * Clip decoded block to the crop rectangle. Pixels inside the crop are
+ * compacted to the beginning of the block and the rectangle is converted
+ * to coordinates relative to the crop origin.
+ */
+static uint8_t crop_block(tjpgd_iodev_t *device, uint16_t *pixels, JRECT *rectangle) {
+    const JRECT *crop = &device->crop;
+    uint16_t pitch = (rectangle->right - rectangle->left) + 1;
+    JRECT clipped;
+
+    if (rectangle->left > crop->right || rectangle->right < crop->left ||
+        rectangle->top > crop->bottom || rectangle->bottom < crop->top) {
+        return 0;
+    }
+
+    clipped.left = MAX(rectangle->left, crop->left);
+    clipped.right = MIN(rectangle->right, crop->right);
+    clipped.top = MAX(rectangle->top, crop->top);
+    clipped.bottom = MIN(rectangle->bottom, crop->bottom);
+
+    uint16_t width = (clipped.right - clipped.left) + 1;
+    uint16_t height = (clipped.bottom - clipped.top) + 1;
+
+    if (width != pitch || clipped.top != rectangle->top) {
+        uint16_t *src = pixels + (clipped.top - rectangle->top) * pitch +
+                        (clipped.left - rectangle->left);
+        uint16_t *dst = pixels;
+        for (uint16_t y = 0; y < height; y++) {
+            memmove(dst, src, width * 2);
+            dst += width;
+            src += pitch;
+        }
+    }
+
+    rectangle->left = clipped.left - crop->left;
+    rectangle->right = clipped.right - crop->left;
+    rectangle->top = clipped.top - crop->top;
+    rectangle->bottom = clipped.bottom - crop->top;
+
+    return 1;
+}
+
+/*
+ * When dithering tjpgd outputs RGB888. Convert the block in place to the
+ * same RGB565 tjpgd would have output. Dithering is done for the format
+ * of the target so the dithered bits survive truncation to RGB332. Blocks
+ * arrive in MCU order so only ordered dithering is possible.
+ */
+static void dither_block(tjpgd_iodev_t *device, uint8_t *pixels, JRECT *rectangle) {
+    uint8_t format = device->bitmap ? hagl_bitmap_format(device->bitmap)
+                                    : hagl_native_format(device->surface->depth);
+    uint16_t width = (rectangle->right - rectangle->left) + 1;
+    uint16_t height = (rectangle->bottom - rectangle->top) + 1;
+    int16_t x0 = rectangle->left - device->crop.left + device->x0;
+    int16_t y0 = rectangle->top - device->crop.top + device->y0;
+    uint8_t *rgb = pixels;
+
+    for (uint16_t y = 0; y < height; y++) {
+        for (uint16_t x = 0; x < width; x++) {
+            hagl_dither_rgb(format, x0 + x, y0 + y, rgb);
+
+            uint16_t color =
+                ((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3);
+#ifdef TJPGD_NEEDS_BYTESWAP
+            color = (color >> 8) | (color << 8);
+#endif /* TJPGD_NEEDS_BYTESWAP */
+            memcpy(pixels, &color, 2);
+
+            pixels += 2;
+            rgb += 3;
+        }
     }
 }
 
 static uint16_t tjpgd_data_writer(JDEC *decoder, void *bitmap, JRECT *rectangle) {
     tjpgd_iodev_t *device = (tjpgd_iodev_t *)decoder->device;
-    uint8_t width = (rectangle->right - rectangle->left) + 1;
-    uint8_t height = (rectangle->bottom - rectangle->top) + 1;
-
-    hagl_bitmap_t block = {
-        .width = width,
-        .height = height,
-        .depth = device->surface->depth,
-        .pitch = width * (device->surface->depth / 8),
-        .size = width * (device->surface->depth / 8) * height,
-        .buffer = (uint8_t *)bitmap
-    };
+
+    if (device->dither) {
+        dither_block(device, bitmap, rectangle);
+    }
+
+    if (!crop_block(device, bitmap, rectangle)) {
+        return 1;
+    }
+
+    uint16_t width = (rectangle->right - rectangle->left) + 1;
+    uint16_t height = (rectangle->bottom - rectangle->top) + 1;
+
+    /* Blocks are RGB565, blit converts them if the surface is not. */
+    hagl_bitmap_t block;
+
+    hagl_bitmap_init_format(&block, width, height, HAGL_PIXEL_RGB565, bitmap);
 
     hagl_blit(
         device->surface, rectangle->left + device->x0, rectangle->top + device->y0, &block
@@ -80,33 +299,886 @@ static uint16_t tjpgd_data_writer(JDEC *decoder, void *bitmap, JRECT *rectangle)
     return 1;
 }
 
-uint32_t
-hagl_load_image(void const *surface, int16_t x0, int16_t y0, const char *filename) {
-    uint8_t work[3100];
+/*
+ * Copy decoded block to the bitmap buffer row by row. Rows are copied as
+ * is when the bitmap has the same format as tjpgd and converted otherwise.
+ */
+static uint16_t tjpgd_bitmap_writer(JDEC *decoder, void *bitmap, JRECT *rectangle) {
+    tjpgd_iodev_t *device = (tjpgd_iodev_t *)decoder->device;
+    hagl_bitmap_t *target = device->bitmap;
+    uint8_t format = hagl_bitmap_format(target);
+    uint8_t bytes = target->depth / 8;
+
+    if (device->dither) {
+        dither_block(device, bitmap, rectangle);
+    }
+
+    if (!crop_block(device, bitmap, rectangle)) {
+        return 1;
+    }
+
+    uint16_t width = (rectangle->right - rectangle->left) + 1;
+    uint16_t height = (rectangle->bottom - rectangle->top) + 1;
+    uint16_t pitch = width * 2;
+    const uint8_t *src = (const uint8_t *)bitmap;
+
+    /* Ignore everything going over right or bottom edge. */
+    if (rectangle->left >= target->width || rectangle->top >= target->height) {
+        return 1;
+    }
+    if (rectangle->left + width > target->width) {
+        width = target->width - rectangle->left;
+    }
+    if (rectangle->top + height > target->height) {
+        height = target->height - rectangle->top;
+    }
+
+    uint8_t *dst =
+        target->buffer + target->pitch * rectangle->top + rectangle->left * bytes;
+
+    for (uint16_t y = 0; y < height; y++) {
+        hagl_convert(dst, format, src, HAGL_PIXEL_RGB565, width);
+        dst += target->pitch;
+        src += pitch;
+    }
+
+    return 1;
+}
+
+/*
+ * Opaque pixels collected for one run. Surfaces take native colors.
+ * Bitmaps can be wider than hagl_color_t so they take RGB888 which is
+ * converted to the format of the bitmap when flushed.
+ */
+typedef union {
+    hagl_color_t colors[RGBA_CHUNK_SIZE];
+    uint8_t rgb[RGBA_CHUNK_SIZE * 3];
+} rgba_run_t;
+
+static inline void
+rgba_dither(tjpgd_iodev_t *device, uint8_t *rgb, int16_t x, int16_t y) {
+    if (device->dither) {
+        uint8_t format = device->bitmap ? hagl_bitmap_format(device->bitmap)
+                                        : hagl_native_format(device->surface->depth);
+        hagl_dither_rgb(format, x, y, rgb);
+    }
+}
+
+/* Add an opaque pixel to the run. */
+static inline void rgba_store(
+    tjpgd_iodev_t *device, rgba_run_t *run, uint16_t index, const uint8_t *rgba,
+    int16_t x, int16_t y
+) {
+    uint8_t rgb[3] = {rgba[0], rgba[1], rgba[2]};
+
+    rgba_dither(device, rgb, x, y);
+
+    if (device->bitmap) {
+        /* RGB888 is stored blue first. */
+        run->rgb[index * 3] = rgb[2];
+        run->rgb[index * 3 + 1] = rgb[1];
+        run->rgb[index * 3 + 2] = rgb[0];
+        return;
+    }
+    run->colors[index] = hagl_color(device->surface, rgb[0], rgb[1], rgb[2]);
+}
+
+/* Draw a run of opaque pixels. */
+static void rgba_flush(
+    tjpgd_iodev_t *device, int16_t x0, int16_t y0, const rgba_run_t *run, uint16_t count
+) {
+    if (0 == count) {
+        return;
+    }
+
+    if (device->bitmap) {
+        /* Region of interest is already limited to the bitmap. */
+        hagl_bitmap_t *target = device->bitmap;
+        uint8_t *dst = target->buffer + target->pitch * y0 + x0 * (target->depth / 8);
+
+        hagl_convert(
+            dst, hagl_bitmap_format(target), run->rgb, HAGL_FORMAT_RGB888, count
+        );
+        return;
+    }
+
+    uint8_t depth = device->surface->depth;
+
+    if (sizeof(hagl_color_t) * 8 != depth) {
+        for (uint16_t i = 0; i < count; i++) {
+            hagl_put_pixel(device->surface, x0 + i, y0, run->colors[i]);
+        }
+        return;
+    }
+
+    hagl_bitmap_t block;
+
+    hagl_bitmap_init(&block, count, 1, depth, (void *)run->colors);
+    hagl_blit(device->surface, x0, y0, &block);
+}
+
+/*
+ * Blend a translucent pixel with the background. Bitmaps in the same
+ * format as tjpgd use hagl_blend() so they match what is drawn to a
+ * surface. Other bitmaps are blended channel by channel in RGB888.
+ */
+static void rgba_blend(
+    tjpgd_iodev_t *device, int16_t x0, int16_t y0, const uint8_t *rgba, uint8_t alpha
+) {
+    uint8_t rgb[3] = {rgba[0], rgba[1], rgba[2]};
+
+    rgba_dither(device, rgb, x0, y0);
+
+    if (device->bitmap) {
+        hagl_bitmap_t *target = device->bitmap;
+        uint8_t format = hagl_bitmap_format(target);
+        uint8_t *dst = target->buffer + target->pitch * y0 + x0 * (target->depth / 8);
+        uint8_t bgr[3];
+
+        if (HAGL_PIXEL_RGB565 == format) {
+            uint16_t pixel;
+
+            memcpy(&pixel, dst, 2);
+            pixel = (uint16_t)hagl_blend(
+                target, rgb565(rgb[0], rgb[1], rgb[2]), pixel, alpha
+            );
+            memcpy(dst, &pixel, 2);
+            return;
+        }
+
+        hagl_convert(bgr, HAGL_FORMAT_RGB888, dst, format, 1);
+        for (uint8_t i = 0; i < 3; i++) {
+            bgr[i] = (rgb[2 - i] * alpha + bgr[i] * (255 - alpha) + 127) / 255;
+        }
+        hagl_convert(dst, format, bgr, HAGL_FORMAT_RGB888, 1);
+        return;
+    }
+
+    hagl_color_t color = hagl_color(device->surface, rgb[0], rgb[1], rgb[2]);
+    hagl_color_t background = hagl_get_pixel(device->surface, x0, y0);
+    hagl_put_pixel(
+        device->surface, x0, y0, hagl_blend(device->surface, color, background, alpha)
+    );
+}
+
+/*
+ * Draw a row fragment from the PNG or QOI decoder. Opaque pixels are
+ * blitted in runs, translucent pixels are blended with the background
+ * and fully transparent pixels are skipped. Descaling drops rows and
+ * columns. Returns 0 to stop the decoder after the last visible row.
+ */
+static uint8_t rgba_writer(
+    void *arg, const uint8_t *rgba, uint16_t x0, uint16_t y0, uint16_t width
+) {
+    tjpgd_iodev_t *device = (tjpgd_iodev_t *)arg;
+    const JRECT *roi = &device->roi;
+    uint8_t scale = device->scale;
+    uint16_t step = 1 << scale;
+    rgba_run_t run;
+    uint16_t count = 0;
+
+    if (y0 > roi->bottom) {
+        return 0;
+    }
+    if (y0 < roi->top || (y0 & (step - 1)) || x0 > roi->right ||
+        x0 + width - 1 < roi->left) {
+        return 1;
+    }
+
+    /* First and last visible column which survive descaling. */
+    uint16_t left = MAX(x0, roi->left);
+    uint16_t right = MIN(x0 + width - 1, roi->right);
+    left = (left + step - 1) & ~(step - 1);
+    if (left > right) {
+        return 1;
+    }
+
+    uint16_t pixels = (right - left) / step + 1;
+    int16_t x = (left >> scale) - device->crop.left + device->x0;
+    int16_t y = (y0 >> scale) - device->crop.top + device->y0;
+    int16_t start = x;
+
+    for (uint16_t i = 0; i < pixels; i++) {
+        const uint8_t *pixel = rgba + (left - x0 + i * step) * 4;
+
+        if (255 == pixel[3]) {
+            rgba_store(device, &run, count++, pixel, x + i, y);
+            continue;
+        }
+
+        rgba_flush(device, start, y, &run, count);
+        count = 0;
+        start = x + i + 1;
+
+        if (pixel[3]) {
+            rgba_blend(device, x + i, y, pixel, pixel[3]);
+        }
+    }
+
+    rgba_flush(device, start, y, &run, count);
+
+    return 1;
+}
+
+/*
+ * Compute the crop rectangle in output coordinates and the region of
+ * interest in source coordinates. Region of interest is further limited
+ * to the part which ends up inside the clip window so the decoder can
+ * skip all MCUs which would not be visible. Returns 0 if nothing is
+ * visible.
+ */
+static uint8_t prepare_crop(
+    tjpgd_iodev_t *device, uint16_t width, uint16_t height, uint8_t scale,
+    const hagl_image_options_t *options, JRECT *roi
+) {
+    int32_t left = 0, top = 0;
+    int32_t right = width - 1;
+    int32_t bottom = height - 1;
+    int32_t x0, y0, x1, y1;
+
+    if (options && options->width && options->height) {
+        left = options->x;
+        top = options->y;
+        right = MIN(right, left + options->width - 1);
+        bottom = MIN(bottom, top + options->height - 1);
+    }
+
+    if (left > right || top > bottom) {
+        return 0;
+    }
+
+    device->crop.left = left >> scale;
+    device->crop.top = top >> scale;
+    device->crop.right = right >> scale;
+    device->crop.bottom = bottom >> scale;
+
+    /* Visible area in output coordinates relative to the crop origin. */
+    if (device->bitmap) {
+        x0 = 0;
+        y0 = 0;
+        x1 = device->bitmap->width - 1;
+        y1 = device->bitmap->height - 1;
+    } else {
+        x0 = device->surface->clip.x0 - device->x0;
+        y0 = device->surface->clip.y0 - device->y0;
+        x1 = device->surface->clip.x1 - device->x0;
+        y1 = device->surface->clip.y1 - device->y0;
+    }
+
+    /* Convert back to source coordinates. */
+    x0 = (x0 + device->crop.left) * (1 << scale);
+    y0 = (y0 + device->crop.top) * (1 << scale);
+    x1 = (x1 + device->crop.left + 1) * (1 << scale) - 1;
+    y1 = (y1 + device->crop.top + 1) * (1 << scale) - 1;
+
+    left = MAX(left, x0);
+    top = MAX(top, y0);
+    right = MIN(right, x1);
+    bottom = MIN(bottom, y1);
+
+    if (left > right || top > bottom) {
+        return 0;
+    }
+
+    roi->left = left;
+    roi->top = top;
+    roi->right = right;
+    roi->bottom = bottom;
+
+    return 1;
+}
+
+static uint32_t load_jpeg_pool(
+    tjpgd_iodev_t *device, uint16_t (*writer)(JDEC *, void *, JRECT *),
+    const hagl_image_options_t *options, void *pool, uint16_t size
+) {
+    uint8_t scale = options ? options->scale : 0;
+    uint16_t buffer_size = HAGL_IMAGE_BUFFER_SIZE;
     JDEC decoder;
     JRESULT result;
-    tjpgd_iodev_t device;
+    JRECT roi;
+
+    if (options && options->buffer_size) {
+        buffer_size = options->buffer_size;
+    }
+
+    result =
+        jd_prepare_ex(&decoder, tjpgd_reader, pool, size, buffer_size, (void *)device);
+    if (JDR_OK != result) {
+        return HAGL_ERR_TJPGD + result;
+    }
+
+    if (scale > 3) {
+        return HAGL_ERR_TJPGD + JDR_PAR;
+    }
+
+    /* Dithering needs the full precision colors. */
+    if (device->dither) {
+        decoder.format = 0;
+    }
+
+    if (!prepare_crop(device, decoder.width, decoder.height, scale, options, &roi)) {
+        return HAGL_OK;
+    }
+
+    /* Data in memory is referenced in place. */
+    if (device->data) {
+        decoder.inref = tjpgd_mem_referencer;
+    }
+
+    result = jd_decomp_rect(&decoder, writer, scale, &roi);
+    if (JDR_OK != result) {
+        return HAGL_ERR_TJPGD + result;
+    }
+
+    return HAGL_OK;
+}
+
+/* Decode using the caller provided work pool or one from the stack. */
+static uint32_t load_jpeg(
+    tjpgd_iodev_t *device, uint16_t (*writer)(JDEC *, void *, JRECT *),
+    const hagl_image_options_t *options
+) {
+    uint8_t work[HAGL_IMAGE_WORK_SIZE + HAGL_IMAGE_BUFFER_SIZE];
+
+    if (options && options->work) {
+        return load_jpeg_pool(
+            device, writer, options, options->work, options->work_size
+        );
+    }
+
+    return load_jpeg_pool(device, writer, options, work, sizeof(work));
+}
+
+static uint32_t load_qoi(tjpgd_iodev_t *device, const hagl_image_options_t *options) {
+    uint8_t scale = options ? options->scale : 0;
+    qoidec_t decoder;
+    uint8_t result;
+
+    result = qoidec_prepare(&decoder, rgba_reader, device);
+    if (QOIDEC_OK != result) {
+        return HAGL_ERR_QOIDEC + result;
+    }
+
+    if (scale > 3) {
+        return HAGL_ERR_GENERAL;
+    }
+
+    device->scale = scale;
+    if (!prepare_crop(
+            device, decoder.width, decoder.height, scale, options, &device->roi
+        )) {
+        return HAGL_OK;
+    }
+
+    /* Writer interrupts the decoder after the last visible row. */
+    result = qoidec_decode(&decoder, rgba_writer);
+    if (QOIDEC_OK != result && QOIDEC_ERR_INTERRUPTED != result) {
+        return HAGL_ERR_QOIDEC + result;
+    }
+
+    return HAGL_OK;
+}
+
+/*
+ * Without a caller provided work pool one sized for this image is taken
+ * from the heap for the duration of the call. Small images need much
+ * less than the 32K window.
+ */
+static uint32_t load_png(tjpgd_iodev_t *device, const hagl_image_options_t *options) {
+    uint8_t scale = options ? options->scale : 0;
+    uint8_t allocated = !(options && options->work);
+    pngdec_t decoder;
+    uint8_t result;
+    void *pool;
+    size_t size;
+
+    result = pngdec_prepare(&decoder, rgba_reader, device);
+    if (PNGDEC_OK != result) {
+        return HAGL_ERR_PNGDEC + result;
+    }
+
+    if (scale > 3) {
+        return HAGL_ERR_GENERAL;
+    }
+
+    device->scale = scale;
+    if (!prepare_crop(
+            device, decoder.width, decoder.height, scale, options, &device->roi
+        )) {
+        return HAGL_OK;
+    }
+
+    if (allocated) {
+        size = pngdec_work_size(&decoder);
+        pool = size > HAGL_IMAGE_PNG_WORK_SIZE ? NULL : malloc(size);
+        if (!pool) {
+            return HAGL_ERR_PNGDEC + PNGDEC_ERR_MEMORY;
+        }
+    } else {
+        pool = options->work;
+        size = options->work_size;
+    }
+
+    /* Writer interrupts the decoder after the last visible row. */
+    result = pngdec_decode(&decoder, rgba_writer, pool, size);
+
+    if (allocated) {
+        free(pool);
+    }
+
+    if (PNGDEC_OK != result && PNGDEC_ERR_INTERRUPTED != result) {
+        return HAGL_ERR_PNGDEC + result;
+    }
+
+    return HAGL_OK;
+}
+
+static uint32_t load_image(
+    tjpgd_iodev_t *device, uint16_t (*writer)(JDEC *, void *, JRECT *),
+    const hagl_image_options_t *options
+) {
+    device->dither = options ? options->dither : HAGL_DITHER_NONE;
+
+    switch (image_format(device)) {
+        case IMAGE_PNG:
+            return load_png(device, options);
+        case IMAGE_QOI:
+            return load_qoi(device, options);
+        default:
+            return load_jpeg(device, writer, options);
+    }
+}
+
+/*
+ * On Linux the file is memory mapped and the decoder reads it in place.
+ * Otherwise, or if the file cannot be mapped, it is read with stdio.
+ */
+static uint32_t load_image_file(
+    tjpgd_iodev_t *device, const char *filename,
+    uint16_t (*writer)(JDEC *, void *, JRECT *), const hagl_image_options_t *options
+) {
+    uint32_t status;
+
+#ifdef __linux__
+    struct stat st;
+    int fd = open(filename, O_RDONLY);
+
+    if (fd < 0) {
+        return HAGL_ERR_FILE_IO;
+    }
+
+    if (0 == fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED != map) {
+            close(fd);
+            madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+            device->data = map;
+            device->size = st.st_size;
+            status = load_image(device, writer, options);
+
+            munmap(map, st.st_size);
+            return status;
+        }
+    }
+
+    close(fd);
+#endif /* __linux__ */
+
+    device->fp = fopen(filename, "rb");
+
+    if (!device->fp) {
+        return HAGL_ERR_FILE_IO;
+    }
+
+    status = load_image(device, writer, options);
+
+    fclose(device->fp);
+    return status;
+}
+
+/* Parse only the headers. */
+static uint32_t image_size(tjpgd_iodev_t *device, uint16_t *width, uint16_t *height) {
+    uint8_t work[HAGL_IMAGE_WORK_SIZE + HAGL_IMAGE_BUFFER_SIZE];
+    uint8_t format = image_format(device);
+    JDEC decoder;
+    JRESULT result;
+
+    if (IMAGE_PNG == format) {
+        pngdec_t png;
+        uint8_t status = pngdec_prepare(&png, rgba_reader, device);
+        if (PNGDEC_OK != status) {
+            return HAGL_ERR_PNGDEC + status;
+        }
+        *width = png.width;
+        *height = png.height;
+        return HAGL_OK;
+    }
+
+    if (IMAGE_QOI == format) {
+        qoidec_t qoi;
+        uint8_t status = qoidec_prepare(&qoi, rgba_reader, device);
+        if (QOIDEC_OK != status) {
+            return HAGL_ERR_QOIDEC + status;
+        }
+        *width = qoi.width;
+        *height = qoi.height;
+        return HAGL_OK;
+    }
+
+    result = jd_prepare_ex(
+        &decoder, tjpgd_reader, work, sizeof(work), HAGL_IMAGE_BUFFER_SIZE,
+        (void *)device
+    );
+    if (JDR_OK != result) {
+        return HAGL_ERR_TJPGD + result;
+    }
+
+    *width = decoder.width;
+    *height = decoder.height;
+
+    return HAGL_OK;
+}
+
+uint32_t hagl_load_image_ex(
+    void const *surface, int16_t x0, int16_t y0, const char *filename,
+    const hagl_image_options_t *options
+) {
+    tjpgd_iodev_t device = {0};
 
     device.x0 = x0;
     device.y0 = y0;
-    device.fp = fopen(filename, "rb");
     device.surface = surface;
 
-    if (!device.fp) {
-        return HAGL_ERR_FILE_IO;
+    return load_image_file(&device, filename, tjpgd_data_writer, options);
+}
+
+uint32_t
+hagl_load_image(void const *surface, int16_t x0, int16_t y0, const char *filename) {
+    return hagl_load_image_ex(surface, x0, y0, filename, NULL);
+}
+
+uint32_t hagl_load_image_mem_ex(
+    void const *surface, int16_t x0, int16_t y0, const uint8_t *data, size_t size,
+    const hagl_image_options_t *options
+) {
+    tjpgd_iodev_t device = {0};
+
+    device.x0 = x0;
+    device.y0 = y0;
+    device.data = data;
+    device.size = size;
+    device.surface = surface;
+
+    return load_image(&device, tjpgd_data_writer, options);
+}
+
+uint32_t hagl_load_image_mem(
+    void const *surface, int16_t x0, int16_t y0, const uint8_t *data, size_t size
+) {
+    return hagl_load_image_mem_ex(surface, x0, y0, data, size, NULL);
+}
+
+uint32_t hagl_load_image_stream_ex(
+    void const *surface, int16_t x0, int16_t y0, hagl_image_read_t read, void *user,
+    const hagl_image_options_t *options
+) {
+    tjpgd_iodev_t device = {0};
+
+    device.x0 = x0;
+    device.y0 = y0;
+    device.read = read;
+    device.user = user;
+    device.surface = surface;
+
+    return load_image(&device, tjpgd_data_writer, options);
+}
+
+uint32_t hagl_load_image_stream(
+    void const *surface, int16_t x0, int16_t y0, hagl_image_read_t read, void *user
+) {
+    return hagl_load_image_stream_ex(surface, x0, y0, read, user, NULL);
+}
+
+/* Indexed bitmaps and depths without a pixel format cannot be decoded to. */
+static uint8_t decodable(const hagl_bitmap_t *bitmap) {
+    return !bitmap->palette &&
+           hagl_format_depth(hagl_bitmap_format(bitmap)) == bitmap->depth;
+}
+
+uint32_t hagl_decode_image_ex(
+    hagl_bitmap_t *bitmap, const char *filename, const hagl_image_options_t *options
+) {
+    tjpgd_iodev_t device = {0};
+
+    if (!decodable(bitmap)) {
+        return HAGL_ERR_GENERAL;
     }
-    result = jd_prepare(&decoder, tjpgd_data_reader, work, 3100, (void *)&device);
-    if (result == JDR_OK) {
-        result = jd_decomp(&decoder, tjpgd_data_writer, 0);
-        if (JDR_OK != result) {
-            fclose(device.fp);
-            return HAGL_ERR_TJPGD + result;
+
+    device.bitmap = bitmap;
+
+    return load_image_file(&device, filename, tjpgd_bitmap_writer, options);
+}
+
+uint32_t hagl_decode_image(hagl_bitmap_t *bitmap, const char *filename) {
+    return hagl_decode_image_ex(bitmap, filename, NULL);
+}
+
+uint32_t hagl_decode_image_mem_ex(
+    hagl_bitmap_t *bitmap, const uint8_t *data, size_t size,
+    const hagl_image_options_t *options
+) {
+    tjpgd_iodev_t device = {0};
+
+    if (!decodable(bitmap)) {
+        return HAGL_ERR_GENERAL;
+    }
+
+    device.bitmap = bitmap;
+    device.data = data;
+    device.size = size;
+
+    return load_image(&device, tjpgd_bitmap_writer, options);
+}
+
+uint32_t hagl_decode_image_mem(hagl_bitmap_t *bitmap, const uint8_t *data, size_t size) {
+    return hagl_decode_image_mem_ex(bitmap, data, size, NULL);
+}
+
+#ifdef HAGL_IMAGE_PARALLEL
+
+typedef struct {
+    tjpgd_iodev_t device;
+    const JDEC *decoder;
+    const JRECT *roi;
+    uint8_t scale;
+    uint32_t mcu;
+    uint32_t count;
+    JRESULT result;
+} tjpgd_worker_t;
+
+/* Decode a run of consecutive restart intervals with a private decoder. */
+static void *decode_worker(void *arg) {
+    tjpgd_worker_t *worker = arg;
+    uint8_t work[HAGL_IMAGE_WORK_SIZE + HAGL_IMAGE_BUFFER_SIZE];
+    JDEC decoder;
+
+    worker->result =
+        jd_clone(&decoder, worker->decoder, work, sizeof(work), &worker->device);
+    if (JDR_OK != worker->result) {
+        return NULL;
+    }
+
+    decoder.inref = tjpgd_mem_referencer;
+    worker->result = jd_decomp_range(
+        &decoder, tjpgd_bitmap_writer, worker->scale, worker->roi, worker->mcu,
+        worker->count
+    );
+
+    return NULL;
+}
+
+/*
+ * Find where the entropy coded data of the given restart intervals start.
+ * Intervals must be in increasing order. Returns 0 if the markers are not
+ * where they should be.
+ */
+static uint8_t find_intervals(
+    const uint8_t *data, size_t size, size_t offset, const uint32_t *intervals,
+    size_t *offsets, uint8_t count
+) {
+    uint32_t interval = 0;
+    uint8_t found = 0;
+
+    while (found < count && 0 == intervals[found]) {
+        offsets[found++] = offset;
+    }
+
+    while (found < count && offset + 1 < size) {
+        const uint8_t *marker = memchr(data + offset, 0xFF, size - offset - 1);
+        if (!marker) {
+            return 0;
+        }
+        offset = marker - data + 1;
+
+        /* Skip stuffed zero bytes and fill bytes. */
+        if (0x00 == data[offset] || 0xFF == data[offset]) {
+            continue;
+        }
+
+        /* Anything else than RSTn inside the scan is the end of data. */
+        if ((data[offset] & 0xF8) != 0xD0 || (data[offset] & 7) != (interval & 7)) {
+            return 0;
+        }
+
+        offset++;
+        interval++;
+        while (found < count && interval == intervals[found]) {
+            offsets[found++] = offset;
         }
+    }
+
+    return found == count;
+}
+
+uint32_t hagl_decode_image_mem_parallel(
+    hagl_bitmap_t *bitmap, const uint8_t *data, size_t size,
+    const hagl_image_options_t *options, uint8_t threads
+) {
+    tjpgd_worker_t workers[HAGL_IMAGE_MAX_THREADS];
+    pthread_t thread[HAGL_IMAGE_MAX_THREADS];
+    uint32_t intervals[HAGL_IMAGE_MAX_THREADS];
+    size_t offsets[HAGL_IMAGE_MAX_THREADS];
+    tjpgd_iodev_t device = {0};
+    uint8_t scale = options ? options->scale : 0;
+    uint8_t work[HAGL_IMAGE_WORK_SIZE + HAGL_IMAGE_BUFFER_SIZE];
+    uint8_t started = 0;
+    uint32_t status = HAGL_OK;
+    JDEC decoder;
+    JRESULT result;
+    JRECT roi;
+
+    if (!decodable(bitmap)) {
+        return HAGL_ERR_GENERAL;
+    }
+
+    device.bitmap = bitmap;
+    device.data = data;
+    device.size = size;
+    device.dither = options ? options->dither : HAGL_DITHER_NONE;
+
+    if (IMAGE_JPEG != image_format(&device)) {
+        return load_image(&device, tjpgd_bitmap_writer, options);
+    }
+
+    /* Data is referenced in place, bigger input buffer would not help. */
+    if (options && options->work) {
+        result = jd_prepare_ex(
+            &decoder, tjpgd_reader, options->work, options->work_size,
+            HAGL_IMAGE_BUFFER_SIZE, &device
+        );
     } else {
-        fclose(device.fp);
+        result = jd_prepare_ex(
+            &decoder, tjpgd_reader, work, sizeof(work), HAGL_IMAGE_BUFFER_SIZE,
+            &device
+        );
+    }
+    if (JDR_OK != result) {
         return HAGL_ERR_TJPGD + result;
     }
 
+    if (scale > 3) {
+        return HAGL_ERR_TJPGD + JDR_PAR;
+    }
+
+    /* Clones inherit the output format. */
+    if (device.dither) {
+        decoder.format = 0;
+    }
+
+    if (!prepare_crop(&device, decoder.width, decoder.height, scale, options, &roi)) {
+        return HAGL_OK;
+    }
+
+    uint16_t mx = decoder.msx * 8;
+    uint16_t my = decoder.msy * 8;
+    uint32_t nx = (decoder.width + mx - 1) / mx;
+    uint32_t first = 0, last = 0;
+
+    threads = MIN(threads, HAGL_IMAGE_MAX_THREADS);
+
+    if (decoder.nrst) {
+        /* Only the intervals which overlap the visible rows are decoded. */
+        first = (roi.top / my) * nx / decoder.nrst;
+        last = ((roi.bottom / my + 1) * nx - 1) / decoder.nrst;
+        threads = MIN(threads, last - first + 1);
+    } else {
+        threads = 0;
+    }
+
+    /* Entropy coded data starts where the decoder stopped reading headers. */
+    size_t offset = device.offset - decoder.dctr;
+
+    for (uint8_t i = 0; i < threads; i++) {
+        intervals[i] = first + (last - first + 1) * i / threads;
+    }
+
+    if (threads < 2 ||
+        !find_intervals(data, size, offset, intervals, offsets, threads)) {
+        /* Without restart markers the image can be decoded only in one go. */
+        decoder.inref = tjpgd_mem_referencer;
+        result = jd_decomp_rect(&decoder, tjpgd_bitmap_writer, scale, &roi);
+        return (JDR_OK == result) ? HAGL_OK : HAGL_ERR_TJPGD + result;
+    }
+
+    for (uint8_t i = 0; i < threads; i++) {
+        uint32_t next = (i + 1 < threads) ? intervals[i + 1] : last + 1;
+
+        workers[i].device = device;
+        workers[i].device.offset = offsets[i];
+        workers[i].decoder = &decoder;
+        workers[i].roi = &roi;
+        workers[i].scale = scale;
+        workers[i].mcu = intervals[i] * decoder.nrst;
+        workers[i].count = (next - intervals[i]) * decoder.nrst;
+        workers[i].result = JDR_OK;
+    }
+
+    /* Calling thread decodes the first run itself. */
+    for (uint8_t i = 1; i < threads; i++) {
+        if (0 != pthread_create(&thread[i], NULL, decode_worker, &workers[i])) {
+            break;
+        }
+        started++;
+    }
+
+    decode_worker(&workers[0]);
+
+    /* Runs which did not get a thread are decoded here. */
+    for (uint8_t i = started + 1; i < threads; i++) {
+        decode_worker(&workers[i]);
+    }
+
+    for (uint8_t i = 1; i <= started; i++) {
+        pthread_join(thread[i], NULL);
+    }
+
+    for (uint8_t i = 0; i < threads; i++) {
+        if (JDR_OK != workers[i].result) {
+            status = HAGL_ERR_TJPGD + workers[i].result;
+            break;
+        }
+    }
+
+    return status;
+}
+
+#endif /* HAGL_IMAGE_PARALLEL */
+
+uint32_t hagl_image_size(const char *filename, uint16_t *width, uint16_t *height) {
+    tjpgd_iodev_t device = {0};
+    uint32_t status;
+
+    device.fp = fopen(filename, "rb");
+
+    if (!device.fp) {
+        return HAGL_ERR_FILE_IO;
+    }
+
+    status = image_size(&device, width, height);
+
     fclose(device.fp);
-    return HAGL_OK;
+    return status;
+}
+
+uint32_t hagl_image_size_mem(
+    const uint8_t *data, size_t size, uint16_t *width, uint16_t *height
+) {
+    tjpgd_iodev_t device = {0};
+
+    device.data = data;
+    device.size = size;
+
+    return image_size(&device, width, height);
 }
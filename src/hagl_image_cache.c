@@ -0,0 +1,233 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hagl.h"
+#include "hagl/bitmap.h"
+#include "hagl/image.h"
+#include "hagl/image_cache.h"
+
+#define CACHE_DEPTH (16)
+
+/* FNV-1a hash of the filename. */
+static uint32_t hash(const char *str) {
+    uint32_t hash = 2166136261u;
+
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static hagl_bitmap_t *find(
+    hagl_image_cache_t *cache, uint32_t hash, const char *filename, const uint8_t *data,
+    size_t size
+) {
+    for (uint8_t i = 0; i < HAGL_IMAGE_CACHE_SLOTS; i++) {
+        hagl_image_cache_entry_t *entry = &cache->entries[i];
+        if (0 == entry->used || entry->hash != hash || entry->data != data ||
+            entry->size != size) {
+            continue;
+        }
+        /* Different filenames can have the same hash. */
+        if (filename && 0 != strcmp(entry->filename, filename)) {
+            continue;
+        }
+        entry->used = ++cache->clock;
+        return &entry->bitmap;
+    }
+    return NULL;
+}
+
+/*
+ * Free the slot and move the buffers after the evicted one down so free
+ * space is always one continuous block at the end of the pool. Other
+ * entries stay in their slots so bitmaps returned earlier remain valid.
+ */
+static void evict(hagl_image_cache_t *cache, hagl_image_cache_entry_t *entry) {
+    uint8_t *start = entry->bitmap.buffer;
+    uint32_t size = entry->bitmap.size;
+    uint8_t *end = cache->pool + cache->pool_used;
+
+    memmove(start, start + size, end - (start + size));
+    cache->pool_used -= size;
+
+    for (uint8_t i = 0; i < HAGL_IMAGE_CACHE_SLOTS; i++) {
+        hagl_image_cache_entry_t *other = &cache->entries[i];
+        if (other->used && other->bitmap.buffer > start) {
+            other->bitmap.buffer -= size;
+        }
+    }
+    entry->used = 0;
+    cache->count--;
+}
+
+static void evict_lru(hagl_image_cache_t *cache) {
+    hagl_image_cache_entry_t *oldest = NULL;
+
+    for (uint8_t i = 0; i < HAGL_IMAGE_CACHE_SLOTS; i++) {
+        hagl_image_cache_entry_t *entry = &cache->entries[i];
+        if (entry->used && (NULL == oldest || entry->used < oldest->used)) {
+            oldest = entry;
+        }
+    }
+    evict(cache, oldest);
+}
+
+/* Make room for a new image and return pointer to a free slot. */
+static hagl_image_cache_entry_t *
+reserve(hagl_image_cache_t *cache, uint16_t width, uint16_t height) {
+    hagl_image_cache_entry_t *entry = NULL;
+    uint32_t size = BITMAP_SIZE(width, height, CACHE_DEPTH);
+
+    if (size > cache->pool_size) {
+        return NULL;
+    }
+
+    while (cache->count == HAGL_IMAGE_CACHE_SLOTS ||
+           cache->pool_size - cache->pool_used < size) {
+        evict_lru(cache);
+    }
+
+    for (uint8_t i = 0; NULL == entry; i++) {
+        if (0 == cache->entries[i].used) {
+            entry = &cache->entries[i];
+        }
+    }
+
+    hagl_bitmap_init(
+        &entry->bitmap, width, height, CACHE_DEPTH, cache->pool + cache->pool_used
+    );
+
+    /* Transparent png and qoi pixels are blended over black. */
+    memset(entry->bitmap.buffer, 0, size);
+
+    return entry;
+}
+
+static void commit(
+    hagl_image_cache_t *cache, hagl_image_cache_entry_t *entry, uint32_t hash,
+    const char *filename, const uint8_t *data, size_t size
+) {
+    entry->hash = hash;
+    entry->filename[0] = '\0';
+    if (filename) {
+        strcpy(entry->filename, filename);
+    }
+    entry->data = data;
+    entry->size = size;
+    entry->used = ++cache->clock;
+
+    cache->pool_used += entry->bitmap.size;
+    cache->count++;
+}
+
+void hagl_image_cache_init(hagl_image_cache_t *cache, void *pool, size_t size) {
+    memset(cache, 0, sizeof(hagl_image_cache_t));
+    cache->pool = pool;
+    cache->pool_size = size;
+}
+
+void hagl_image_cache_clear(hagl_image_cache_t *cache) {
+    for (uint8_t i = 0; i < HAGL_IMAGE_CACHE_SLOTS; i++) {
+        cache->entries[i].used = 0;
+    }
+    cache->pool_used = 0;
+    cache->count = 0;
+}
+
+hagl_bitmap_t *hagl_image_cache_get(hagl_image_cache_t *cache, const char *filename) {
+    hagl_image_cache_entry_t *entry;
+    hagl_bitmap_t *bitmap;
+    uint16_t width, height;
+    uint32_t key = hash(filename);
+
+    if (strlen(filename) >= HAGL_IMAGE_CACHE_PATH_MAX) {
+        return NULL;
+    }
+
+    bitmap = find(cache, key, filename, NULL, 0);
+    if (bitmap) {
+        return bitmap;
+    }
+
+    if (HAGL_OK != hagl_image_size(filename, &width, &height)) {
+        return NULL;
+    }
+
+    entry = reserve(cache, width, height);
+    if (NULL == entry) {
+        return NULL;
+    }
+
+    if (HAGL_OK != hagl_decode_image(&entry->bitmap, filename)) {
+        return NULL;
+    }
+
+    commit(cache, entry, key, filename, NULL, 0);
+    return &entry->bitmap;
+}
+
+hagl_bitmap_t *
+hagl_image_cache_get_mem(hagl_image_cache_t *cache, const uint8_t *data, size_t size) {
+    hagl_image_cache_entry_t *entry;
+    hagl_bitmap_t *bitmap;
+    uint16_t width, height;
+
+    bitmap = find(cache, 0, NULL, data, size);
+    if (bitmap) {
+        return bitmap;
+    }
+
+    if (HAGL_OK != hagl_image_size_mem(data, size, &width, &height)) {
+        return NULL;
+    }
+
+    entry = reserve(cache, width, height);
+    if (NULL == entry) {
+        return NULL;
+    }
+
+    if (HAGL_OK != hagl_decode_image_mem(&entry->bitmap, data, size)) {
+        return NULL;
+    }
+
+    commit(cache, entry, 0, NULL, data, size);
+    return &entry->bitmap;
+}
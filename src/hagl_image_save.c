@@ -0,0 +1,428 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hagl.h"
+#include "hagl/bitmap.h"
+#include "hagl/format.h"
+#include "hagl/image_save.h"
+#include "rgb565.h"
+
+#define OUTPUT_SIZE (256)
+
+/* Longest row which fits a single stored deflate block. */
+#define PNG_MAX_WIDTH ((65535 - 1) / 3)
+
+#define QOI_OP_INDEX (0x00)
+#define QOI_OP_DIFF (0x40)
+#define QOI_OP_LUMA (0x80)
+#define QOI_OP_RUN (0xC0)
+#define QOI_OP_RGB (0xFE)
+
+#define QOI_HASH(r, g, b, a) (((r) * 3 + (g) * 5 + (b) * 7 + (a) * 11) % 64)
+
+typedef struct {
+    hagl_image_write_t write;
+    void *user;
+    uint8_t error;
+    uint16_t count;
+    uint8_t buffer[OUTPUT_SIZE];
+    uint32_t crc;
+    uint32_t adler;
+    uint8_t index[64 * 4];
+    uint8_t previous[4];
+    uint8_t run;
+} encoder_t;
+
+/* Nibble table for CRC-32 as used by PNG. */
+static const uint32_t crc_table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+    0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+static void flush(encoder_t *encoder) {
+    if (encoder->count && !encoder->error) {
+        if (encoder->write(encoder->user, encoder->buffer, encoder->count) !=
+            encoder->count) {
+            encoder->error = 1;
+        }
+    }
+    encoder->count = 0;
+}
+
+static void emit(encoder_t *encoder, const uint8_t *data, size_t size) {
+    while (size) {
+        size_t count = OUTPUT_SIZE - encoder->count;
+        if (count > size) {
+            count = size;
+        }
+        memcpy(encoder->buffer + encoder->count, data, count);
+        encoder->count += count;
+        data += count;
+        size -= count;
+
+        if (OUTPUT_SIZE == encoder->count) {
+            flush(encoder);
+        }
+    }
+}
+
+static inline void emit_byte(encoder_t *encoder, uint8_t byte) {
+    encoder->buffer[encoder->count++] = byte;
+    if (OUTPUT_SIZE == encoder->count) {
+        flush(encoder);
+    }
+}
+
+static void emit_be32(encoder_t *encoder, uint32_t value) {
+    uint8_t bytes[4] = {value >> 24, value >> 16, value >> 8, value};
+    emit(encoder, bytes, 4);
+}
+
+/*
+ * Convert pixels of given format to red, green and blue bytes. RGB565 has
+ * a vectorised path which also rounds instead of replicating bits. RGB888
+ * format stores blue first so the outer bytes are swapped afterwards.
+ */
+static void
+to_rgb888(const uint8_t *src, uint8_t format, uint16_t count, uint8_t *rgb) {
+    if (HAGL_FORMAT_RGB565 == format || HAGL_FORMAT_RGB565_SWAPPED == format) {
+        rgb565_to_rgb888_n(
+            (rgb_t *)rgb, (const uint16_t *)src, count,
+            HAGL_FORMAT_RGB565_SWAPPED == format
+        );
+        return;
+    }
+
+    hagl_convert(rgb, HAGL_FORMAT_RGB888, src, format, count);
+
+    for (uint16_t i = 0; i < count; i++, rgb += 3) {
+        uint8_t blue = rgb[0];
+        rgb[0] = rgb[2];
+        rgb[2] = blue;
+    }
+}
+
+static void ppm_header(encoder_t *encoder, const hagl_bitmap_t *bitmap) {
+    char header[32];
+    int size = snprintf(
+        header, sizeof(header), "P6\n%u %u\n255\n", bitmap->width, bitmap->height
+    );
+    emit(encoder, (const uint8_t *)header, size);
+}
+
+static void qoi_header(encoder_t *encoder, const hagl_bitmap_t *bitmap) {
+    const uint8_t signature[4] = {'q', 'o', 'i', 'f'};
+    const uint8_t format[2] = {3, 0};
+
+    emit(encoder, signature, 4);
+    emit_be32(encoder, bitmap->width);
+    emit_be32(encoder, bitmap->height);
+    emit(encoder, format, 2);
+
+    memset(encoder->index, 0, sizeof(encoder->index));
+    encoder->previous[0] = 0;
+    encoder->previous[1] = 0;
+    encoder->previous[2] = 0;
+    encoder->previous[3] = 255;
+    encoder->run = 0;
+}
+
+static void qoi_pixels(encoder_t *encoder, const uint8_t *rgb, uint16_t count) {
+    uint8_t *previous = encoder->previous;
+
+    for (uint16_t i = 0; i < count; i++, rgb += 3) {
+        if (rgb[0] == previous[0] && rgb[1] == previous[1] && rgb[2] == previous[2]) {
+            if (62 == ++encoder->run) {
+                emit_byte(encoder, QOI_OP_RUN | (encoder->run - 1));
+                encoder->run = 0;
+            }
+            continue;
+        }
+
+        if (encoder->run) {
+            emit_byte(encoder, QOI_OP_RUN | (encoder->run - 1));
+            encoder->run = 0;
+        }
+
+        uint8_t hash = QOI_HASH(rgb[0], rgb[1], rgb[2], 255);
+        uint8_t *entry = &encoder->index[hash * 4];
+
+        if (rgb[0] == entry[0] && rgb[1] == entry[1] && rgb[2] == entry[2] &&
+            255 == entry[3]) {
+            emit_byte(encoder, QOI_OP_INDEX | hash);
+        } else {
+            int8_t dr = rgb[0] - previous[0];
+            int8_t dg = rgb[1] - previous[1];
+            int8_t db = rgb[2] - previous[2];
+            int8_t dr_dg = dr - dg;
+            int8_t db_dg = db - dg;
+
+            if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+                emit_byte(
+                    encoder, QOI_OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)
+                );
+            } else if (dr_dg > -9 && dr_dg < 8 && dg > -33 && dg < 32 && db_dg > -9 &&
+                       db_dg < 8) {
+                emit_byte(encoder, QOI_OP_LUMA | (dg + 32));
+                emit_byte(encoder, (dr_dg + 8) << 4 | (db_dg + 8));
+            } else {
+                emit_byte(encoder, QOI_OP_RGB);
+                emit(encoder, rgb, 3);
+            }
+
+            entry[0] = rgb[0];
+            entry[1] = rgb[1];
+            entry[2] = rgb[2];
+            entry[3] = 255;
+        }
+
+        previous[0] = rgb[0];
+        previous[1] = rgb[1];
+        previous[2] = rgb[2];
+    }
+}
+
+static void qoi_footer(encoder_t *encoder) {
+    const uint8_t end[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+    if (encoder->run) {
+        emit_byte(encoder, QOI_OP_RUN | (encoder->run - 1));
+    }
+    emit(encoder, end, sizeof(end));
+}
+
+/* Write data which is part of a PNG chunk and covered by its CRC. */
+static void png_emit(encoder_t *encoder, const uint8_t *data, size_t size) {
+    uint32_t crc = encoder->crc;
+
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ crc_table[crc & 0x0F];
+        crc = (crc >> 4) ^ crc_table[crc & 0x0F];
+    }
+    encoder->crc = crc;
+
+    emit(encoder, data, size);
+}
+
+static void png_chunk_begin(encoder_t *encoder, uint32_t size, const char *type) {
+    emit_be32(encoder, size);
+    encoder->crc = 0xFFFFFFFF;
+    png_emit(encoder, (const uint8_t *)type, 4);
+}
+
+static void png_chunk_end(encoder_t *encoder) {
+    emit_be32(encoder, encoder->crc ^ 0xFFFFFFFF);
+}
+
+/* Adler-32 of the uncompressed zlib data. */
+static void png_adler(encoder_t *encoder, const uint8_t *data, size_t size) {
+    uint32_t a = encoder->adler & 0xFFFF;
+    uint32_t b = encoder->adler >> 16;
+
+    for (size_t i = 0; i < size; i++) {
+        a += data[i];
+        b += a;
+    }
+    encoder->adler = (b % 65521) << 16 | (a % 65521);
+}
+
+static void png_header(encoder_t *encoder, const hagl_bitmap_t *bitmap) {
+    const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    /* Eight bit truecolor, no interlace. */
+    const uint8_t format[5] = {8, 2, 0, 0, 0};
+    uint8_t size[8] = {
+        bitmap->width >> 24, bitmap->width >> 16, bitmap->width >> 8, bitmap->width,
+        bitmap->height >> 24, bitmap->height >> 16, bitmap->height >> 8, bitmap->height
+    };
+
+    emit(encoder, signature, sizeof(signature));
+    png_chunk_begin(encoder, 13, "IHDR");
+    png_emit(encoder, size, sizeof(size));
+    png_emit(encoder, format, sizeof(format));
+    png_chunk_end(encoder);
+
+    encoder->adler = 1;
+}
+
+/*
+ * Each row is an IDAT chunk with a single stored deflate block. First
+ * chunk also has the zlib header and the last one the checksum.
+ */
+static void png_row_begin(encoder_t *encoder, const hagl_bitmap_t *bitmap, uint16_t y) {
+    uint16_t length = 1 + bitmap->width * 3;
+    uint8_t first = (0 == y);
+    uint8_t last = (bitmap->height - 1 == y);
+    const uint8_t zlib[2] = {0x78, 0x01};
+    uint8_t block[5] = {last, length, length >> 8, ~length, ~length >> 8};
+    const uint8_t filter = 0;
+
+    png_chunk_begin(
+        encoder, (first ? 2 : 0) + sizeof(block) + length + (last ? 4 : 0), "IDAT"
+    );
+    if (first) {
+        png_emit(encoder, zlib, sizeof(zlib));
+    }
+    png_emit(encoder, block, sizeof(block));
+    png_emit(encoder, &filter, 1);
+    png_adler(encoder, &filter, 1);
+}
+
+static void png_row_end(encoder_t *encoder, const hagl_bitmap_t *bitmap, uint16_t y) {
+    if (bitmap->height - 1 == y) {
+        uint32_t adler = encoder->adler;
+        uint8_t bytes[4] = {adler >> 24, adler >> 16, adler >> 8, adler};
+        png_emit(encoder, bytes, sizeof(bytes));
+    }
+    png_chunk_end(encoder);
+}
+
+static void png_footer(encoder_t *encoder) {
+    png_chunk_begin(encoder, 0, "IEND");
+    png_chunk_end(encoder);
+}
+
+uint32_t hagl_save_image_stream(
+    const hagl_bitmap_t *bitmap, uint8_t format, hagl_image_write_t write, void *user
+) {
+    uint8_t rgb[HAGL_IMAGE_SAVE_CHUNK_SIZE * 3];
+    hagl_color_t colors[HAGL_IMAGE_SAVE_CHUNK_SIZE];
+    uint8_t bytes = bitmap->depth / 8;
+    encoder_t encoder;
+
+    if (bitmap->palette) {
+        if (1 != bitmap->depth && 2 != bitmap->depth && 4 != bitmap->depth &&
+            8 != bitmap->depth) {
+            return HAGL_ERR_GENERAL;
+        }
+    } else if (8 != bitmap->depth && 16 != bitmap->depth && 24 != bitmap->depth &&
+               32 != bitmap->depth) {
+        return HAGL_ERR_GENERAL;
+    }
+    if (format > HAGL_IMAGE_PNG) {
+        return HAGL_ERR_GENERAL;
+    }
+    if (HAGL_IMAGE_PNG == format && bitmap->width > PNG_MAX_WIDTH) {
+        return HAGL_ERR_GENERAL;
+    }
+
+    encoder.write = write;
+    encoder.user = user;
+    encoder.error = 0;
+    encoder.count = 0;
+
+    if (HAGL_IMAGE_PPM == format) {
+        ppm_header(&encoder, bitmap);
+    } else if (HAGL_IMAGE_QOI == format) {
+        qoi_header(&encoder, bitmap);
+    } else {
+        png_header(&encoder, bitmap);
+    }
+
+    for (uint16_t y = 0; y < bitmap->height && !encoder.error; y++) {
+        const uint8_t *src = bitmap->buffer + bitmap->pitch * y;
+
+        if (HAGL_IMAGE_PNG == format) {
+            png_row_begin(&encoder, bitmap, y);
+        }
+
+        for (uint16_t x = 0; x < bitmap->width; x += HAGL_IMAGE_SAVE_CHUNK_SIZE) {
+            uint16_t count = bitmap->width - x;
+            if (count > HAGL_IMAGE_SAVE_CHUNK_SIZE) {
+                count = HAGL_IMAGE_SAVE_CHUNK_SIZE;
+            }
+
+            if (bitmap->palette) {
+                /* Indexed pixels are expanded to colors first. */
+                for (uint16_t i = 0; i < count; i++) {
+                    colors[i] = bitmap->palette[hagl_bitmap_index(bitmap, x + i, y)];
+                }
+                to_rgb888((uint8_t *)colors, HAGL_PIXEL_FORMAT, count, rgb);
+            } else {
+                to_rgb888(src + x * bytes, hagl_bitmap_format(bitmap), count, rgb);
+            }
+
+            if (HAGL_IMAGE_PPM == format) {
+                emit(&encoder, rgb, count * 3);
+            } else if (HAGL_IMAGE_QOI == format) {
+                qoi_pixels(&encoder, rgb, count);
+            } else {
+                png_emit(&encoder, rgb, count * 3);
+                png_adler(&encoder, rgb, count * 3);
+            }
+        }
+
+        if (HAGL_IMAGE_PNG == format) {
+            png_row_end(&encoder, bitmap, y);
+        }
+    }
+
+    if (HAGL_IMAGE_QOI == format) {
+        qoi_footer(&encoder);
+    } else if (HAGL_IMAGE_PNG == format) {
+        png_footer(&encoder);
+    }
+
+    flush(&encoder);
+
+    return encoder.error ? HAGL_ERR_FILE_IO : HAGL_OK;
+}
+
+static size_t file_writer(void *user, const uint8_t *buffer, size_t size) {
+    return fwrite(buffer, 1, size, (FILE *)user);
+}
+
+uint32_t
+hagl_save_image(const hagl_bitmap_t *bitmap, uint8_t format, const char *filename) {
+    uint32_t status;
+    FILE *fp = fopen(filename, "wb");
+
+    if (!fp) {
+        return HAGL_ERR_FILE_IO;
+    }
+
+    status = hagl_save_image_stream(bitmap, format, file_writer, fp);
+
+    if (0 != fclose(fp) && HAGL_OK == status) {
+        status = HAGL_ERR_FILE_IO;
+    }
+
+    return status;
+}
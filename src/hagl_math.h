@@ -0,0 +1,128 @@
+/*
+
+MIT License
+
+Copyright (c) 2018-2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+/*
+Integer helpers shared by the shape and shader code. This header is
+internal to the library and not installed.
+*/
+
+#ifndef HAGL_MATH_H
+#define HAGL_MATH_H
+
+#include <stdint.h>
+
+/* Integer square root rounded down, bit by bit. */
+static inline uint32_t isqrt(uint64_t value) {
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
+
+/*
+ * Rows of a filled circle are computed directly instead of stepping the
+ * midpoint algorithm. Midpoint algorithm keeps y while the midpoint
+ * (x, y - 1/2) is inside the circle with radius squared of r^2 - 1/4.
+ * Half width of a row is the widest of the flat and the steep octant,
+ * which gives the same pixels as drawing four lines per step. Widths
+ * change little between rows so they are stepped from the previous row.
+ */
+typedef struct {
+    int32_t r;
+    int32_t rsq;
+    int32_t flat;
+    int32_t steep;
+} circle_row_t;
+
+/* Start stepping a circle with radius r from the row k. */
+static inline void circle_row_init(circle_row_t *circle, int32_t r, int32_t k) {
+    circle->r = r;
+    circle->rsq = 4 * r * r - 1;
+    circle->flat = -1;
+    circle->steep = -1;
+
+    k = k < 0 ? -k : k;
+    if (r > 0 && circle->rsq - (2 * k - 1) * (2 * k - 1) >= 0) {
+        circle->flat = isqrt((circle->rsq - (2 * k - 1) * (2 * k - 1)) / 4);
+    }
+    if (r > 0 && circle->rsq - 4 * k * k >= 0) {
+        circle->steep = (isqrt(circle->rsq - 4 * k * k) + 1) / 2;
+    }
+}
+
+/* Half width of the row k of a filled circle or -1 if the row is empty. */
+static inline int32_t circle_row_width(circle_row_t *circle, int32_t k) {
+    k = k < 0 ? -k : k;
+
+    if (circle->r <= 0) {
+        return (0 == circle->r && 0 == k) ? 0 : -1;
+    }
+
+    /* Flat octant, widest x with 4x^2 + (2k - 1)^2 <= 4r^2 - 1. */
+    int32_t limit = circle->rsq - (2 * k - 1) * (2 * k - 1);
+    while (4 * (circle->flat + 1) * (circle->flat + 1) <= limit) {
+        circle->flat++;
+    }
+    while (circle->flat >= 0 && 4 * circle->flat * circle->flat > limit) {
+        circle->flat--;
+    }
+
+    /* Steep octant, widest x with 4k^2 + (2x - 1)^2 <= 4r^2 - 1. */
+    limit = circle->rsq - 4 * k * k;
+    while ((2 * circle->steep + 1) * (2 * circle->steep + 1) <= limit) {
+        circle->steep++;
+    }
+    while (circle->steep >= 0 &&
+           (2 * circle->steep - 1) * (2 * circle->steep - 1) > limit) {
+        circle->steep--;
+    }
+
+    return circle->flat > circle->steep ? circle->flat : circle->steep;
+}
+
+#endif /* HAGL_MATH_H */
@@ -32,20 +32,21 @@ SPDX-License-Identifier: MIT
 
 */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "hagl/color.h"
 #include "hagl/hline.h"
 #include "hagl/line.h"
+#include "hagl/span.h"
 #include "hagl/surface.h"
 
-void hagl_draw_polygon(
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+void hagl_draw_polyline(
     void const *surface, int16_t amount, int16_t *vertices, hagl_color_t color
 ) {
-    if (amount < 3) {
-        return;
-    }
-
     for (int16_t i = 0; i < amount - 1; i++) {
         hagl_draw_line(
             surface,
@@ -56,6 +57,16 @@ void hagl_draw_polygon(
             color
         );
     }
+}
+
+void hagl_draw_polygon(
+    void const *surface, int16_t amount, int16_t *vertices, hagl_color_t color
+) {
+    if (amount < 3) {
+        return;
+    }
+
+    hagl_draw_polyline(surface, amount, vertices, color);
     hagl_draw_line(
         surface,
         vertices[0],
@@ -66,12 +77,19 @@ void hagl_draw_polygon(
     );
 }
 
-/* Adapted from http://alienryderflex.com/polygon_fill/ */
-void hagl_fill_polygon(
-    void const *_surface, int16_t amount, int16_t *vertices, hagl_color_t color
+/*
+ * Adapted from http://alienryderflex.com/polygon_fill/ Spans between the
+ * nodes and horizontal edges may overlap. They are merged before passing
+ * them on so that each pixel is passed once. Rows with more than 16
+ * horizontal edges pass the rest unmerged.
+ */
+void hagl_fill_polygon_span(
+    void const *_surface, int16_t amount, int16_t *vertices, hagl_span_t span,
+    const void *paint
 ) {
     const hagl_surface_t *surface = _surface;
     int16_t nodes[64];
+    int16_t edges[32];
     int16_t y, miny, maxy;
     float x0, y0, x1, y1;
 
@@ -82,7 +100,7 @@ void hagl_fill_polygon(
     miny = surface->height;
     maxy = 0;
 
-    for (uint8_t i = 0; i < amount; i++) {
+    for (int16_t i = 0; i < amount; i++) {
         if (miny > vertices[(i << 1) + 1]) {
             miny = vertices[(i << 1) + 1];
         }
@@ -94,8 +112,9 @@ void hagl_fill_polygon(
     /*  Loop through the rows of the image. */
     for (y = miny; y <= maxy; y++) {
 
-        /*  Build a list of nodes. */
+        /*  Build a list of nodes and horizontal edges. */
         int16_t count = 0;
+        int16_t edge_count = 0;
         int16_t j = amount - 1;
 
         for (int16_t i = 0; i < amount; i++) {
@@ -110,7 +129,24 @@ void hagl_fill_polygon(
                     count++;
                 }
             } else if (y == y0 && y == y1) {
-                hagl_draw_hline_xyx(surface, x0, y0, x1, color);
+                int16_t start = (int16_t)MIN(x0, x1);
+                int16_t end = (int16_t)MAX(x0, x1);
+
+                if (edge_count < 32) {
+                    /* Insertion sort by the left end. */
+                    int16_t k = edge_count;
+                    while (k && edges[k - 2] > start) {
+                        edges[k] = edges[k - 2];
+                        edges[k + 1] = edges[k - 1];
+                        k -= 2;
+                    }
+                    edges[k] = start;
+                    edges[k + 1] = end;
+                    edge_count += 2;
+                } else {
+                    /* Buffer is full, pass the edge on without merging. */
+                    span(_surface, start, y, end - start + 1, paint);
+                }
             }
             j = i;
         }
@@ -130,9 +166,53 @@ void hagl_fill_polygon(
             }
         }
 
-        /* Draw lines between nodes. */
-        for (int16_t i = 0; i < count; i += 2) {
-            hagl_draw_hline_xyx(surface, nodes[i], y, nodes[i + 1], color);
+        /* Merge spans between nodes with edges, both are sorted. */
+        int16_t k = 0;
+        int16_t left = 0;
+        int16_t right = 0;
+        bool open = false;
+
+        i = 0;
+        while (i + 1 < count || k < edge_count) {
+            int16_t start, end;
+
+            if (k >= edge_count || (i + 1 < count && nodes[i] <= edges[k])) {
+                start = nodes[i];
+                end = nodes[i + 1];
+                i += 2;
+            } else {
+                start = edges[k];
+                end = edges[k + 1];
+                k += 2;
+            }
+
+            if (open && start <= right + 1) {
+                right = MAX(right, end);
+            } else {
+                if (open) {
+                    span(_surface, left, y, right - left + 1, paint);
+                }
+                left = start;
+                right = end;
+                open = true;
+            }
+        }
+        if (open) {
+            span(_surface, left, y, right - left + 1, paint);
         }
     }
 }
+
+void hagl_fill_polygon(
+    void const *surface, int16_t amount, int16_t *vertices, hagl_color_t color
+) {
+    hagl_fill_polygon_span(surface, amount, vertices, hagl_span_color, &color);
+}
+
+void hagl_fill_polygon_alpha(
+    void const *surface, int16_t amount, int16_t *vertices, hagl_color_t color,
+    uint8_t alpha
+) {
+    hagl_alpha_t paint = {color, alpha};
+    hagl_fill_polygon_span(surface, amount, vertices, hagl_span_alpha, &paint);
+}
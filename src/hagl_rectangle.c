@@ -32,11 +32,13 @@ SPDX-License-Identifier: MIT
 
 */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "hagl/color.h"
 #include "hagl/hline.h"
 #include "hagl/pixel.h"
+#include "hagl/span.h"
 #include "hagl/surface.h"
 #include "hagl/vline.h"
 
@@ -83,41 +85,52 @@ void hagl_draw_rectangle_xyxy(
     hagl_draw_vline(surface, x1, y0, height, color);
 }
 
-void hagl_fill_rectangle_xyxy(
-    void const *_surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
-    hagl_color_t color
+/* Sort and clip the corners. Returns false if nothing is visible. */
+static bool clip_rectangle(
+    const hagl_surface_t *surface, int16_t *x0, int16_t *y0, int16_t *x1, int16_t *y1
 ) {
-    const hagl_surface_t *surface = _surface;
-    uint16_t width, height;
-
     /* Make sure x0 is smaller than x1. */
-    if (x0 > x1) {
-        x0 = x0 + x1;
-        x1 = x0 - x1;
-        x0 = x0 - x1;
+    if (*x0 > *x1) {
+        int16_t swap = *x0;
+        *x0 = *x1;
+        *x1 = swap;
     }
 
     /* Make sure y0 is smaller than y1. */
-    if (y0 > y1) {
-        y0 = y0 + y1;
-        y1 = y0 - y1;
-        y0 = y0 - y1;
+    if (*y0 > *y1) {
+        int16_t swap = *y0;
+        *y0 = *y1;
+        *y1 = swap;
     }
 
     /* x1 or y1 is before the edge, nothing to do. */
-    if ((x1 < surface->clip.x0) || (y1 < surface->clip.y0)) {
-        return;
+    if ((*x1 < surface->clip.x0) || (*y1 < surface->clip.y0)) {
+        return false;
     }
 
     /* x0 or y0 is after the edge, nothing to do. */
-    if ((x0 > surface->clip.x1) || (y0 > surface->clip.y1)) {
-        return;
+    if ((*x0 > surface->clip.x1) || (*y0 > surface->clip.y1)) {
+        return false;
     }
 
-    x0 = MAX(x0, surface->clip.x0);
-    y0 = MAX(y0, surface->clip.y0);
-    x1 = MIN(x1, surface->clip.x1);
-    y1 = MIN(y1, surface->clip.y1);
+    *x0 = MAX(*x0, surface->clip.x0);
+    *y0 = MAX(*y0, surface->clip.y0);
+    *x1 = MIN(*x1, surface->clip.x1);
+    *y1 = MIN(*y1, surface->clip.y1);
+
+    return true;
+}
+
+void hagl_fill_rectangle_xyxy(
+    void const *_surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    hagl_color_t color
+) {
+    const hagl_surface_t *surface = _surface;
+    uint16_t width, height;
+
+    if (!clip_rectangle(surface, &x0, &y0, &x1, &y1)) {
+        return;
+    }
 
     width = x1 - x0 + 1;
     height = y1 - y0 + 1;
@@ -132,6 +145,29 @@ void hagl_fill_rectangle_xyxy(
     }
 }
 
+void hagl_fill_rectangle_span(
+    void const *_surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    hagl_span_t span, const void *paint
+) {
+    const hagl_surface_t *surface = _surface;
+
+    if (!clip_rectangle(surface, &x0, &y0, &x1, &y1)) {
+        return;
+    }
+
+    for (int16_t y = y0; y <= y1; y++) {
+        span(_surface, x0, y, x1 - x0 + 1, paint);
+    }
+}
+
+void hagl_fill_rectangle_alpha_xyxy(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    hagl_color_t color, uint8_t alpha
+) {
+    hagl_alpha_t paint = {color, alpha};
+    hagl_fill_rectangle_span(surface, x0, y0, x1, y1, hagl_span_alpha, &paint);
+}
+
 void hagl_draw_rounded_rectangle_xyxy(
     void const *_surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r,
     hagl_color_t color
@@ -207,51 +243,89 @@ void hagl_draw_rounded_rectangle_xyxy(
     }
 }
 
-void hagl_fill_rounded_rectangle_xyxy(
+/*
+ * Pass the corner rows t rows above and below the straight part. Half
+ * width k is the same the midpoint loop uses so right end is one pixel
+ * short as it has always been. Rows already covered by the straight part
+ * are skipped.
+ */
+static void corner_rows(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r,
+    int16_t t, int16_t k, hagl_span_t span, const void *paint
+) {
+    int16_t rx0 = x0 + r - k;
+    int16_t width = (x1 - r + k) - rx0;
+
+    if (width <= 0) {
+        return;
+    }
+    if (y0 + r - t < MIN(y0 + r, y1 - r)) {
+        span(surface, rx0, y0 + r - t, width, paint);
+    }
+    if (y1 - r + t > MAX(y0 + r, y1 - r)) {
+        span(surface, rx0, y1 - r + t, width, paint);
+    }
+}
+
+/*
+ * Rows r - x are reached with half width y and rows r - y with half
+ * width x. Both reach at most three rows around 45 degrees. Those are
+ * collected first and passed with the wider of the two. Rows reached
+ * by y several times are passed with the last and widest x.
+ */
+void hagl_fill_rounded_rectangle_span(
     void const *_surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r,
-    hagl_color_t color
+    hagl_span_t span, const void *paint
 ) {
     const hagl_surface_t *surface = _surface;
-
-    uint16_t width, height;
-    int16_t rx0, ry0, rx1, x, y, d;
+    int16_t overlap[3] = {-1, -1, -1};
+    int16_t x, y, d, last_x, last_y;
 
     /* Make sure x0 is smaller than x1. */
     if (x0 > x1) {
-        x0 = x0 + x1;
-        x1 = x0 - x1;
-        x0 = x0 - x1;
+        int16_t swap = x0;
+        x0 = x1;
+        x1 = swap;
     }
 
     /* Make sure y0 is smaller than y1. */
     if (y0 > y1) {
-        y0 = y0 + y1;
-        y1 = y0 - y1;
-        y0 = y0 - y1;
-    }
-
-    /* x1 or y1 is before the edge, nothing to do. */
-    if ((x1 < surface->clip.x0) || (y1 < surface->clip.y0)) {
-        return;
+        int16_t swap = y0;
+        y0 = y1;
+        y1 = swap;
     }
 
-    /* x0 or y0 is after the edge, nothing to do. */
-    if ((x0 > surface->clip.x1) || (y0 > surface->clip.y1)) {
+    /* Whole rectangle outside clip window, nothing to do. */
+    if ((x1 < surface->clip.x0) || (y1 < surface->clip.y0) ||
+        (x0 > surface->clip.x1) || (y0 > surface->clip.y1)) {
         return;
     }
 
     /* Max radius is half of shortest edge. */
-    width = x1 - x0 + 1;
-    height = y1 - y0 + 1;
-    r = MIN(r, MIN(width / 2, height / 2));
+    r = MIN(r, MIN((x1 - x0 + 1) / 2, (y1 - y0 + 1) / 2));
+    r = MAX(r, 0);
 
+    /* Find where the midpoint loop ends. */
     x = 0;
     y = r;
     d = 3 - 2 * r;
-
     while (y >= x) {
         x++;
+        if (d > 0) {
+            y--;
+            d = d + 4 * (x - y) + 10;
+        } else {
+            d = d + 4 * x + 6;
+        }
+    }
+    last_x = x;
+    last_y = y;
 
+    x = 0;
+    y = r;
+    d = 3 - 2 * r;
+    while (r > 0 && y >= x) {
+        x++;
         if (d > 0) {
             y--;
             d = d + 4 * (x - y) + 10;
@@ -259,33 +333,36 @@ void hagl_fill_rounded_rectangle_xyxy(
             d = d + 4 * x + 6;
         }
 
-        /* Top  */
-        ry0 = y0 + r - x;
-        rx0 = x0 + r - y;
-        rx1 = x1 - r + y;
-        width = rx1 - rx0;
-        hagl_draw_hline(surface, rx0, ry0, width, color);
-
-        ry0 = y0 + r - y;
-        rx0 = x0 + r - x;
-        rx1 = x1 - r + x;
-        width = rx1 - rx0;
-        hagl_draw_hline(surface, rx0, ry0, width, color);
-
-        /* Bottom */
-        ry0 = y1 - r + y;
-        rx0 = x0 + r - x;
-        rx1 = x1 - r + x;
-        width = rx1 - rx0;
-        hagl_draw_hline(surface, rx0, ry0, width, color);
-
-        ry0 = y1 - r + x;
-        rx0 = x0 + r - y;
-        rx1 = x1 - r + y;
-        width = rx1 - rx0;
-        hagl_draw_hline(surface, rx0, ry0, width, color);
+        /* Row r - x. */
+        if (x >= last_y) {
+            overlap[x - last_y] = MAX(overlap[x - last_y], y);
+        } else {
+            corner_rows(_surface, x0, y0, x1, y1, r, x, y, span, paint);
+        }
+
+        /* Row r - y when y is about to change. Row r is the straight part. */
+        if ((y < x || d > 0) && y > 0) {
+            if (y <= last_x) {
+                overlap[y - last_y] = MAX(overlap[y - last_y], x);
+            } else {
+                corner_rows(_surface, x0, y0, x1, y1, r, y, x, span, paint);
+            }
+        }
+    }
+
+    for (int16_t t = MAX(last_y, 1); r > 0 && t <= last_x; t++) {
+        corner_rows(_surface, x0, y0, x1, y1, r, t, overlap[t - last_y], span, paint);
     }
 
-    /* Center */
-    hagl_fill_rectangle_xyxy(surface, x0, y0 + r, x1, y1 - r, color);
+    /* Straight part, with even height and maximum radius it is two rows. */
+    for (y = MIN(y0 + r, y1 - r); y <= MAX(y0 + r, y1 - r); y++) {
+        span(_surface, x0, y, x1 - x0 + 1, paint);
+    }
+}
+
+void hagl_fill_rounded_rectangle_xyxy(
+    void const *surface, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r,
+    hagl_color_t color
+) {
+    hagl_fill_rounded_rectangle_span(surface, x0, y0, x1, y1, r, hagl_span_color, &color);
 }
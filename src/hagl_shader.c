@@ -0,0 +1,239 @@
+
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hagl/bitmap.h"
+#include "hagl/blit.h"
+#include "hagl/color.h"
+#include "hagl/hline.h"
+#include "hagl/shader.h"
+#include "hagl/surface.h"
+
+#include "hagl_math.h"
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+/* Clip span to the clip window. Returns false if nothing is visible. */
+static bool
+clip_span(const hagl_surface_t *surface, int16_t *x0, int16_t y0, uint16_t *width) {
+    if ((y0 < surface->clip.y0) || (y0 > surface->clip.y1)) {
+        return false;
+    }
+
+    int32_t left = MAX(*x0, surface->clip.x0);
+    int32_t right = MIN((int32_t)*x0 + *width - 1, surface->clip.x1);
+
+    if (left > right) {
+        return false;
+    }
+
+    *x0 = left;
+    *width = right - left + 1;
+    return true;
+}
+
+/* Blit a row of colors. Row must be inside the clip window. */
+static void put_row(
+    const hagl_surface_t *surface, int16_t x0, int16_t y0, hagl_color_t *colors,
+    uint16_t width
+) {
+    hagl_bitmap_t row;
+
+    hagl_bitmap_init(&row, width, 1, surface->depth, colors);
+    hagl_blit_xy(surface, x0, y0, &row);
+}
+
+/* Convert 16.16 fixed point position to a table index. */
+static inline uint16_t table_index(int64_t position, uint16_t count) {
+    if (position < 0) {
+        return 0;
+    }
+    return MIN(position >> 16, count - 1);
+}
+
+void hagl_gradient_table(
+    void const *surface, hagl_color_t *colors, uint16_t count, const uint8_t from[3],
+    const uint8_t to[3]
+) {
+    uint32_t n = MAX(count, 2) - 1;
+
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t rgb[3];
+        for (uint8_t c = 0; c < 3; c++) {
+            rgb[c] = (from[c] * (n - i) + to[c] * i + n / 2) / n;
+        }
+        colors[i] = hagl_color(surface, rgb[0], rgb[1], rgb[2]);
+    }
+}
+
+void hagl_gradient_linear(
+    hagl_gradient_t *gradient, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    const hagl_color_t *colors, uint16_t count
+) {
+    int32_t dx = x1 - x0;
+    int32_t dy = y1 - y0;
+    int64_t length = (int64_t)dx * dx + (int64_t)dy * dy;
+
+    gradient->type = HAGL_GRADIENT_LINEAR;
+    gradient->x0 = x0;
+    gradient->y0 = y0;
+    gradient->colors = colors;
+    gradient->count = count;
+    gradient->dx = 0;
+    gradient->dy = 0;
+
+    /* Project the pixel to the line, scaled to table index per pixel. */
+    if (length && count > 1) {
+        int64_t scale = (int64_t)(count - 1) << 16;
+        gradient->dx = dx * scale / length;
+        gradient->dy = dy * scale / length;
+    }
+}
+
+void hagl_gradient_radial(
+    hagl_gradient_t *gradient, int16_t x0, int16_t y0, uint16_t r,
+    const hagl_color_t *colors, uint16_t count
+) {
+    gradient->type = HAGL_GRADIENT_RADIAL;
+    gradient->x0 = x0;
+    gradient->y0 = y0;
+    gradient->colors = colors;
+    gradient->count = count;
+    gradient->dx = 0;
+    gradient->dy = 0;
+
+    /* Table index per pixel of distance. */
+    if (r && count > 1) {
+        gradient->dx = ((int64_t)(count - 1) << 16) / r;
+    }
+}
+
+void hagl_span_gradient(
+    void const *_surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+) {
+    const hagl_surface_t *surface = _surface;
+    const hagl_gradient_t *gradient = paint;
+    hagl_color_t buffer[HAGL_SHADER_BUFFER_SIZE / sizeof(hagl_color_t)];
+    uint16_t size = sizeof(buffer) / sizeof(hagl_color_t);
+
+    if (!clip_span(surface, &x0, y0, &width)) {
+        return;
+    }
+
+    if (HAGL_GRADIENT_LINEAR == gradient->type) {
+        int64_t position = (int64_t)(x0 - gradient->x0) * gradient->dx +
+                           (int64_t)(y0 - gradient->y0) * gradient->dy;
+
+        /* Whole span has the same color. */
+        if (0 == gradient->dx) {
+            hagl_color_t color = gradient->colors[table_index(position, gradient->count)];
+            hagl_draw_hline_xyw(surface, x0, y0, width, color);
+            return;
+        }
+
+        while (width) {
+            uint16_t count = MIN(width, size);
+            for (uint16_t i = 0; i < count; i++) {
+                buffer[i] = gradient->colors[table_index(position, gradient->count)];
+                position += gradient->dx;
+            }
+            put_row(surface, x0, y0, buffer, count);
+            x0 += count;
+            width -= count;
+        }
+        return;
+    }
+
+    /* Track integer distance incrementally, it changes at most by one. */
+    int32_t dx = x0 - gradient->x0;
+    int32_t dy = y0 - gradient->y0;
+    uint64_t distance2 = (int64_t)dx * dx + (int64_t)dy * dy;
+    uint32_t distance = isqrt(distance2);
+
+    while (width) {
+        uint16_t count = MIN(width, size);
+        for (uint16_t i = 0; i < count; i++) {
+            int64_t position = (int64_t)distance * gradient->dx;
+            buffer[i] = gradient->colors[table_index(position, gradient->count)];
+
+            distance2 += 2 * dx + 1;
+            dx++;
+            while ((uint64_t)(distance + 1) * (distance + 1) <= distance2) {
+                distance++;
+            }
+            while ((uint64_t)distance * distance > distance2) {
+                distance--;
+            }
+        }
+        put_row(surface, x0, y0, buffer, count);
+        x0 += count;
+        width -= count;
+    }
+}
+
+void hagl_span_pattern(
+    void const *_surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+) {
+    const hagl_surface_t *surface = _surface;
+    const hagl_pattern_t *pattern = paint;
+    const hagl_bitmap_t *bitmap = pattern->bitmap;
+    hagl_color_t buffer[HAGL_SHADER_BUFFER_SIZE / sizeof(hagl_color_t)];
+    uint16_t size = sizeof(buffer) / sizeof(hagl_color_t);
+    uint8_t bytes = bitmap->depth / 8;
+
+    if (!clip_span(surface, &x0, y0, &width)) {
+        return;
+    }
+
+    int32_t px = ((x0 - pattern->x0) % bitmap->width + bitmap->width) % bitmap->width;
+    int32_t py = ((y0 - pattern->y0) % bitmap->height + bitmap->height) % bitmap->height;
+    const uint8_t *row = bitmap->buffer + bitmap->pitch * py;
+
+    while (width) {
+        uint16_t count = MIN(width, size);
+        for (uint16_t i = 0; i < count; i++) {
+            buffer[i] = *(const hagl_color_t *)(row + bytes * px);
+            if (++px == bitmap->width) {
+                px = 0;
+            }
+        }
+        put_row(surface, x0, y0, buffer, count);
+        x0 += count;
+        width -= count;
+    }
+}
@@ -0,0 +1,52 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+
+#include "hagl/color.h"
+#include "hagl/hline.h"
+#include "hagl/span.h"
+
+void hagl_span_color(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+) {
+    hagl_draw_hline_xyw(surface, x0, y0, width, *(const hagl_color_t *)paint);
+}
+
+void hagl_span_alpha(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+) {
+    const hagl_alpha_t *alpha = paint;
+    hagl_draw_hline_alpha_xyw(surface, x0, y0, width, alpha->color, alpha->alpha);
+}
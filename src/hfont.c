@@ -0,0 +1,138 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hfont.h"
+
+#define LE16(ptr) ((uint16_t)((ptr)[0] | ((ptr)[1] << 8)))
+#define LE24(ptr) ((uint32_t)((ptr)[0] | ((ptr)[1] << 8) | ((uint32_t)(ptr)[2] << 16)))
+
+uint8_t hfont_meta(hfont_meta_t *meta, const uint8_t *font) {
+    if (!hfont_is_hfont(font)) {
+        return HFONT_ERR_SIGNATURE;
+    }
+
+    meta->bpp = font[HFONT_BPP];
+    meta->height = font[HFONT_HEIGHT];
+    meta->ascent = font[HFONT_ASCENT];
+    meta->ranges = LE16(&font[HFONT_RANGE_COUNT]);
+    meta->glyphs = LE16(&font[HFONT_GLYPH_COUNT]);
+
+    return HFONT_OK;
+}
+
+static const uint8_t *
+find_range(wchar_t code, const uint8_t *font, uint16_t ranges, uint16_t *hint) {
+    const uint8_t *range;
+    int32_t low, high, middle;
+
+    /* Try the range of the previous lookup first. */
+    if (hint && *hint < ranges) {
+        range = &font[HFONT_RANGE_TABLE_START + *hint * HFONT_RANGE_SIZE];
+        if (code >= LE16(range) && code <= LE16(range + 2)) {
+            return range;
+        }
+    }
+
+    /* Ranges are sorted, binary search for the rest. */
+    low = 0;
+    high = ranges - 1;
+    while (low <= high) {
+        middle = (low + high) / 2;
+        range = &font[HFONT_RANGE_TABLE_START + middle * HFONT_RANGE_SIZE];
+        if (code < LE16(range)) {
+            high = middle - 1;
+        } else if (code > LE16(range + 2)) {
+            low = middle + 1;
+        } else {
+            if (hint) {
+                *hint = middle;
+            }
+            return range;
+        }
+    }
+
+    return NULL;
+}
+
+uint8_t
+hfont_glyph(hfont_glyph_t *glyph, wchar_t code, const uint8_t *font, uint16_t *hint) {
+    const uint8_t *range, *entry;
+    uint16_t ranges, glyphs, index;
+
+    if (!hfont_is_hfont(font)) {
+        return HFONT_ERR_SIGNATURE;
+    }
+
+    ranges = LE16(&font[HFONT_RANGE_COUNT]);
+    glyphs = LE16(&font[HFONT_GLYPH_COUNT]);
+
+    range = find_range(code, font, ranges, hint);
+    if (NULL == range) {
+        return HFONT_ERR_GLYPH_NOT_FOUND;
+    }
+
+    index = LE16(range + 4) + (code - LE16(range));
+    if (index >= glyphs) {
+        return HFONT_ERR_GLYPH_NOT_FOUND;
+    }
+
+    // clang-format off
+    entry = &font[
+        HFONT_RANGE_TABLE_START +
+        ranges * HFONT_RANGE_SIZE +
+        index * HFONT_GLYPH_SIZE
+    ];
+    // clang-format on
+
+    glyph->width = entry[3];
+    glyph->height = entry[4];
+    glyph->x_offset = (int8_t)entry[5];
+    glyph->y_offset = (int8_t)entry[6];
+    glyph->advance = entry[7];
+    glyph->bpp = font[HFONT_BPP];
+
+    /* Bitmap data starts right after the glyph table. */
+    // clang-format off
+    glyph->buffer = &font[
+        HFONT_RANGE_TABLE_START +
+        ranges * HFONT_RANGE_SIZE +
+        glyphs * HFONT_GLYPH_SIZE +
+        LE24(entry)
+    ];
+    // clang-format on
+
+    return HFONT_OK;
+}
@@ -0,0 +1,65 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+
+#include "hrle.h"
+
+#define LE16(ptr) ((uint16_t)((ptr)[0] | ((ptr)[1] << 8)))
+#define LE32(ptr)                                                                      \
+    ((uint32_t)(ptr)[0] | ((uint32_t)(ptr)[1] << 8) | ((uint32_t)(ptr)[2] << 16) |     \
+     ((uint32_t)(ptr)[3] << 24))
+
+uint8_t hrle_meta(hrle_meta_t *meta, const uint8_t *rle) {
+    if (!hrle_is_hrle(rle)) {
+        return HRLE_ERR_SIGNATURE;
+    }
+
+    meta->depth = rle[HRLE_DEPTH];
+    meta->width = LE16(&rle[HRLE_WIDTH]);
+    meta->height = LE16(&rle[HRLE_HEIGHT]);
+    meta->transparent = rle[HRLE_FLAGS] & HRLE_FLAG_TRANSPARENT;
+    meta->color = LE32(&rle[HRLE_TRANSPARENT]);
+    meta->data = &rle[HRLE_DATA_START];
+
+    switch (meta->depth) {
+        case 8:
+        case 16:
+        case 24:
+        case 32:
+            return HRLE_OK;
+        default:
+            return HRLE_ERR_DEPTH;
+    }
+}
@@ -36,10 +36,14 @@ SPDX-License-Identifier: BSD-2-Clause
 
 */
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "hsl.h"
 
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
 rgb_t hsl_to_rgb888(hsl_t *hsl) {
     rgb_t rgb;
     float r, g, b, h, s, l;
@@ -109,3 +113,54 @@ rgb_t hsl_to_rgb888(hsl_t *hsl) {
 
     return rgb;
 }
+
+/*
+ * Lightness and saturation are in units of 1/256 and temporary values in
+ * units of 1/65536. Hue is split to 768 steps so that thirds and sixths
+ * are integers. Each channel is at the top within 1/6 of a circle from
+ * the center of its third, falls linearly to the bottom by 1/3 from the
+ * center and stays there.
+ */
+static inline uint8_t channel(uint32_t temp1, uint32_t temp2, int16_t distance) {
+    /* Hues are random in plasma effects, branches would be mispredicted. */
+    distance -= 768 & -(distance > 384);
+    distance += 768 & -(distance < -384);
+
+    int16_t sign = distance >> 15;
+    int16_t ramp = 256 - ((distance ^ sign) - sign);
+
+    ramp = MAX(ramp, 0);
+    ramp = MIN(ramp, 128);
+
+    return ((temp1 * 128 + (temp2 - temp1) * ramp) * 255) >> 23;
+}
+
+/* Saturation 0 needs no special case, both temporaries equal lightness. */
+static inline rgb_t hsl8_rgb(uint32_t s, uint32_t l, uint8_t h) {
+    uint32_t temp2 = (l < 128) ? l * (256 + s) : 256 * (l + s) - l * s;
+    uint32_t temp1 = 512 * l - temp2;
+    int16_t hue = h * 3;
+    rgb_t rgb;
+
+    rgb.r = channel(temp1, temp2, hue);
+    rgb.g = channel(temp1, temp2, hue - 256);
+    rgb.b = channel(temp1, temp2, hue - 512);
+
+    return rgb;
+}
+
+rgb_t hsl8_to_rgb888(const hsl8_t *hsl) {
+    return hsl8_rgb(hsl->s, hsl->l, hsl->h);
+}
+
+void hsl8_to_rgb888_array(rgb_t *output, const hsl8_t *input, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        output[i] = hsl8_rgb(input[i].s, input[i].l, input[i].h);
+    }
+}
+
+void hsl8_hue_table(rgb_t *table, uint8_t s, uint8_t l) {
+    for (uint16_t h = 0; h < 256; h++) {
+        table[h] = hsl8_rgb(s, l, h);
+    }
+}
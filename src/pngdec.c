@@ -0,0 +1,840 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "pngdec.h"
+
+#define BE32(ptr)                                                                      \
+    ((uint32_t)(ptr)[0] << 24 | (uint32_t)(ptr)[1] << 16 | (uint32_t)(ptr)[2] << 8 |   \
+     (uint32_t)(ptr)[3])
+
+/* Internal status for stopping the inflater after the last row. */
+#define PNGDEC_DONE (0xFF)
+
+#define MAX_BITS (15)
+#define MAX_LCODES (286)
+#define MAX_DCODES (30)
+#define FIX_LCODES (288)
+
+static const uint8_t signature[PNGDEC_SIGNATURE_SIZE] = {
+    0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'
+};
+
+static const uint16_t length_base[29] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const uint8_t length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+static const uint16_t distance_base[30] = {
+    1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+    193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+static const uint8_t distance_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8,
+    9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/* Order of the code length code lengths in a dynamic block header. */
+static const uint8_t order[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+/* Refill the input buffer when empty. Returns 0 on end of input. */
+static inline uint8_t refill(pngdec_t *decoder) {
+    if (decoder->offset < decoder->available) {
+        return 1;
+    }
+    decoder->offset = 0;
+    decoder->available =
+        decoder->read(decoder->device, decoder->buffer, PNGDEC_BUFFER_SIZE);
+    return decoder->available > 0;
+}
+
+/* Read bytes or skip them if buffer is NULL. */
+static uint8_t read_bytes(pngdec_t *decoder, uint8_t *buffer, uint32_t size) {
+    while (size) {
+        if (!refill(decoder)) {
+            return 0;
+        }
+        uint32_t count = decoder->available - decoder->offset;
+        if (count > size) {
+            count = size;
+        }
+        if (buffer) {
+            memcpy(buffer, decoder->buffer + decoder->offset, count);
+            buffer += count;
+        }
+        decoder->offset += count;
+        size -= count;
+    }
+    return 1;
+}
+
+/*
+ * Next byte of the zlib stream. Stream can be split into any number of
+ * consecutive IDAT chunks. Returns -1 on end of the image data.
+ */
+static int16_t idat_byte(pngdec_t *decoder) {
+    uint8_t header[12];
+
+    while (0 == decoder->chunk) {
+        /* CRC of the previous chunk followed by header of the next one. */
+        if (!read_bytes(decoder, header, sizeof(header))) {
+            return -1;
+        }
+        if (0 != memcmp(&header[8], "IDAT", 4)) {
+            return -1;
+        }
+        decoder->chunk = BE32(&header[4]);
+    }
+
+    if (!refill(decoder)) {
+        return -1;
+    }
+    decoder->chunk--;
+
+    return decoder->buffer[decoder->offset++];
+}
+
+static uint32_t bits(pngdec_t *decoder, uint8_t count) {
+    uint32_t value = decoder->bits;
+
+    while (decoder->bit_count < count) {
+        int16_t byte = idat_byte(decoder);
+        if (byte < 0) {
+            decoder->status = PNGDEC_ERR_INPUT;
+            return 0;
+        }
+        value |= (uint32_t)byte << decoder->bit_count;
+        decoder->bit_count += 8;
+    }
+
+    decoder->bits = value >> count;
+    decoder->bit_count -= count;
+
+    return value & ((1UL << count) - 1);
+}
+
+/* Decode one symbol. Codes are read bit by bit, first bit is the MSB. */
+static int16_t decode(pngdec_t *decoder, const pngdec_huffman_t *huffman) {
+    int32_t code = 0, first = 0, index = 0;
+
+    for (uint8_t length = 1; length <= MAX_BITS; length++) {
+        code |= bits(decoder, 1);
+        int32_t count = huffman->count[length];
+        if (code - count < first) {
+            return huffman->symbol[index + (code - first)];
+        }
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    return -1;
+}
+
+/*
+ * Build decoding tables from code lengths. Returns 0 for a complete code,
+ * positive for an incomplete code and negative for an oversubscribed code.
+ */
+static int16_t
+construct(pngdec_huffman_t *huffman, const uint8_t *lengths, uint16_t count) {
+    uint16_t offsets[MAX_BITS + 1];
+    int16_t left = 1;
+
+    memset(huffman->count, 0, sizeof(huffman->count));
+    for (uint16_t symbol = 0; symbol < count; symbol++) {
+        huffman->count[lengths[symbol]]++;
+    }
+    if (huffman->count[0] == count) {
+        return 0;
+    }
+
+    for (uint8_t length = 1; length <= MAX_BITS; length++) {
+        left <<= 1;
+        left -= huffman->count[length];
+        if (left < 0) {
+            return left;
+        }
+    }
+
+    offsets[1] = 0;
+    for (uint8_t length = 1; length < MAX_BITS; length++) {
+        offsets[length + 1] = offsets[length] + huffman->count[length];
+    }
+    for (uint16_t symbol = 0; symbol < count; symbol++) {
+        if (lengths[symbol]) {
+            huffman->symbol[offsets[lengths[symbol]]++] = symbol;
+        }
+    }
+
+    return left;
+}
+
+static inline uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+    int16_t p = a + b - c;
+    int16_t pa = p > a ? p - a : a - p;
+    int16_t pb = p > b ? p - b : b - p;
+    int16_t pc = p > c ? p - c : c - p;
+
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return (pb <= pc) ? b : c;
+}
+
+static uint8_t unfilter(pngdec_t *decoder) {
+    uint8_t *row = decoder->row + 1;
+    const uint8_t *previous = decoder->previous + 1;
+    uint32_t size = decoder->row_size;
+    uint8_t bpp = decoder->bpp;
+    uint32_t i;
+
+    switch (decoder->row[0]) {
+        case 0:
+            break;
+        case 1:
+            for (i = bpp; i < size; i++) {
+                row[i] += row[i - bpp];
+            }
+            break;
+        case 2:
+            for (i = 0; i < size; i++) {
+                row[i] += previous[i];
+            }
+            break;
+        case 3:
+            for (i = 0; i < bpp; i++) {
+                row[i] += previous[i] >> 1;
+            }
+            for (; i < size; i++) {
+                row[i] += (row[i - bpp] + previous[i]) >> 1;
+            }
+            break;
+        case 4:
+            for (i = 0; i < bpp; i++) {
+                row[i] += previous[i];
+            }
+            for (; i < size; i++) {
+                row[i] += paeth(row[i - bpp], previous[i], previous[i - bpp]);
+            }
+            break;
+        default:
+            return PNGDEC_ERR_FORMAT;
+    }
+
+    return PNGDEC_OK;
+}
+
+/* Get the nth sample of the row. */
+static inline uint16_t sample(const uint8_t *row, uint32_t n, uint8_t depth) {
+    if (8 == depth) {
+        return row[n];
+    }
+    if (16 == depth) {
+        return row[n * 2] << 8 | row[n * 2 + 1];
+    }
+
+    uint32_t bit = n * depth;
+    return (row[bit >> 3] >> (8 - depth - (bit & 7))) & ((1 << depth) - 1);
+}
+
+/* Scale sample to eight bits. */
+static inline uint8_t scale(uint16_t value, uint8_t depth) {
+    if (16 == depth) {
+        return value >> 8;
+    }
+    return value * (255 / ((1 << depth) - 1));
+}
+
+static uint8_t convert(pngdec_t *decoder, uint16_t x, uint8_t *rgba) {
+    const uint8_t *row = decoder->row + 1;
+    uint8_t depth = decoder->depth;
+    uint16_t r, g, b, index;
+
+    switch (decoder->color_type) {
+        case PNGDEC_COLOR_GRAY:
+            r = sample(row, x, depth);
+            rgba[0] = rgba[1] = rgba[2] = scale(r, depth);
+            rgba[3] = (decoder->has_key && r == decoder->key[0]) ? 0 : 255;
+            break;
+        case PNGDEC_COLOR_RGB:
+            r = sample(row, x * 3, depth);
+            g = sample(row, x * 3 + 1, depth);
+            b = sample(row, x * 3 + 2, depth);
+            rgba[0] = scale(r, depth);
+            rgba[1] = scale(g, depth);
+            rgba[2] = scale(b, depth);
+            rgba[3] = (decoder->has_key && r == decoder->key[0] && g == decoder->key[1] &&
+                       b == decoder->key[2])
+                          ? 0
+                          : 255;
+            break;
+        case PNGDEC_COLOR_INDEXED:
+            index = sample(row, x, depth);
+            if (index >= decoder->palette_size) {
+                return PNGDEC_ERR_FORMAT;
+            }
+            memcpy(rgba, &decoder->palette[index * 4], 4);
+            break;
+        case PNGDEC_COLOR_GRAY_ALPHA:
+            rgba[0] = rgba[1] = rgba[2] = scale(sample(row, x * 2, depth), depth);
+            rgba[3] = scale(sample(row, x * 2 + 1, depth), depth);
+            break;
+        default:
+            rgba[0] = scale(sample(row, x * 4, depth), depth);
+            rgba[1] = scale(sample(row, x * 4 + 1, depth), depth);
+            rgba[2] = scale(sample(row, x * 4 + 2, depth), depth);
+            rgba[3] = scale(sample(row, x * 4 + 3, depth), depth);
+            break;
+    }
+
+    return PNGDEC_OK;
+}
+
+/* Unfilter a complete scanline and hand it out in chunks. */
+static uint8_t output_row(pngdec_t *decoder) {
+    uint8_t status;
+    uint16_t count = 0;
+
+    status = unfilter(decoder);
+    if (PNGDEC_OK != status) {
+        return status;
+    }
+
+    for (uint16_t x = 0; x < decoder->width; x++) {
+        status = convert(decoder, x, &decoder->pixels[count * 4]);
+        if (PNGDEC_OK != status) {
+            return status;
+        }
+        count++;
+
+        if (PNGDEC_CHUNK_SIZE == count || x == decoder->width - 1) {
+            uint16_t x0 = x + 1 - count;
+            uint16_t y0 = decoder->y;
+            if (!decoder->write(decoder->device, decoder->pixels, x0, y0, count)) {
+                return PNGDEC_ERR_INTERRUPTED;
+            }
+            count = 0;
+        }
+    }
+
+    /* Current row becomes the previous row of the next one. */
+    uint8_t *swap = decoder->previous;
+    decoder->previous = decoder->row;
+    decoder->row = swap;
+    decoder->row_position = 0;
+
+    if (++decoder->y == decoder->height) {
+        return PNGDEC_DONE;
+    }
+
+    return PNGDEC_OK;
+}
+
+static inline uint8_t put(pngdec_t *decoder, uint8_t byte) {
+    decoder->window[decoder->window_position++ & decoder->window_mask] = byte;
+    if (decoder->window_filled <= decoder->window_mask) {
+        decoder->window_filled++;
+    }
+
+    decoder->row[decoder->row_position++] = byte;
+    if (decoder->row_position > decoder->row_size) {
+        return output_row(decoder);
+    }
+
+    return PNGDEC_OK;
+}
+
+static uint8_t stored(pngdec_t *decoder) {
+    uint8_t status;
+    int16_t byte[4];
+
+    /* Stored block starts from the next byte boundary. */
+    decoder->bits = 0;
+    decoder->bit_count = 0;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        byte[i] = idat_byte(decoder);
+        if (byte[i] < 0) {
+            return PNGDEC_ERR_INPUT;
+        }
+    }
+
+    uint16_t length = byte[0] | byte[1] << 8;
+    uint16_t complement = byte[2] | byte[3] << 8;
+    if (0xFFFF != (length ^ complement)) {
+        return PNGDEC_ERR_FORMAT;
+    }
+
+    while (length--) {
+        int16_t value = idat_byte(decoder);
+        if (value < 0) {
+            return PNGDEC_ERR_INPUT;
+        }
+        status = put(decoder, value);
+        if (PNGDEC_OK != status) {
+            return status;
+        }
+    }
+
+    return PNGDEC_OK;
+}
+
+static uint8_t codes(pngdec_t *decoder) {
+    uint8_t status;
+    int16_t symbol;
+
+    for (;;) {
+        symbol = decode(decoder, &decoder->lencode);
+        if (decoder->status) {
+            return decoder->status;
+        }
+        if (symbol < 0) {
+            return PNGDEC_ERR_FORMAT;
+        }
+
+        if (symbol < 256) {
+            status = put(decoder, symbol);
+            if (PNGDEC_OK != status) {
+                return status;
+            }
+            continue;
+        }
+
+        if (256 == symbol) {
+            return PNGDEC_OK;
+        }
+
+        /* Length and distance pair copies from the window. */
+        symbol -= 257;
+        if (symbol >= 29) {
+            return PNGDEC_ERR_FORMAT;
+        }
+        uint16_t length = length_base[symbol] + bits(decoder, length_extra[symbol]);
+
+        symbol = decode(decoder, &decoder->distcode);
+        if (symbol < 0 || symbol >= 30) {
+            return PNGDEC_ERR_FORMAT;
+        }
+        uint32_t distance =
+            distance_base[symbol] + bits(decoder, distance_extra[symbol]);
+        if (decoder->status) {
+            return decoder->status;
+        }
+        if (distance > decoder->window_filled) {
+            return PNGDEC_ERR_FORMAT;
+        }
+
+        while (length--) {
+            uint32_t from = (decoder->window_position - distance) & decoder->window_mask;
+            status = put(decoder, decoder->window[from]);
+            if (PNGDEC_OK != status) {
+                return status;
+            }
+        }
+    }
+}
+
+static uint8_t fixed(pngdec_t *decoder) {
+    uint8_t lengths[FIX_LCODES];
+    uint16_t symbol;
+
+    for (symbol = 0; symbol < 144; symbol++) {
+        lengths[symbol] = 8;
+    }
+    for (; symbol < 256; symbol++) {
+        lengths[symbol] = 9;
+    }
+    for (; symbol < 280; symbol++) {
+        lengths[symbol] = 7;
+    }
+    for (; symbol < FIX_LCODES; symbol++) {
+        lengths[symbol] = 8;
+    }
+    construct(&decoder->lencode, lengths, FIX_LCODES);
+
+    for (symbol = 0; symbol < MAX_DCODES; symbol++) {
+        lengths[symbol] = 5;
+    }
+    construct(&decoder->distcode, lengths, MAX_DCODES);
+
+    return codes(decoder);
+}
+
+static uint8_t dynamic(pngdec_t *decoder) {
+    uint8_t lengths[MAX_LCODES + MAX_DCODES];
+    uint16_t index;
+    int16_t error;
+
+    uint16_t nlen = bits(decoder, 5) + 257;
+    uint16_t ndist = bits(decoder, 5) + 1;
+    uint16_t ncode = bits(decoder, 4) + 4;
+
+    if (nlen > MAX_LCODES || ndist > MAX_DCODES) {
+        return PNGDEC_ERR_FORMAT;
+    }
+
+    for (index = 0; index < ncode; index++) {
+        lengths[order[index]] = bits(decoder, 3);
+    }
+    for (; index < 19; index++) {
+        lengths[order[index]] = 0;
+    }
+    if (decoder->status) {
+        return decoder->status;
+    }
+
+    /* Code length code must be complete. */
+    if (0 != construct(&decoder->lencode, lengths, 19)) {
+        return PNGDEC_ERR_FORMAT;
+    }
+
+    index = 0;
+    while (index < nlen + ndist) {
+        int16_t symbol = decode(decoder, &decoder->lencode);
+        if (decoder->status) {
+            return decoder->status;
+        }
+        if (symbol < 0) {
+            return PNGDEC_ERR_FORMAT;
+        }
+
+        if (symbol < 16) {
+            lengths[index++] = symbol;
+            continue;
+        }
+
+        /* Repeat previous length or zero. */
+        uint8_t length = 0;
+        uint8_t repeat;
+        if (16 == symbol) {
+            if (0 == index) {
+                return PNGDEC_ERR_FORMAT;
+            }
+            length = lengths[index - 1];
+            repeat = 3 + bits(decoder, 2);
+        } else if (17 == symbol) {
+            repeat = 3 + bits(decoder, 3);
+        } else {
+            repeat = 11 + bits(decoder, 7);
+        }
+        if (index + repeat > nlen + ndist) {
+            return PNGDEC_ERR_FORMAT;
+        }
+        while (repeat--) {
+            lengths[index++] = length;
+        }
+    }
+
+    /* Block must have an end code. */
+    if (0 == lengths[256]) {
+        return PNGDEC_ERR_FORMAT;
+    }
+
+    /* Incomplete codes are allowed only when there is a single code. */
+    error = construct(&decoder->lencode, lengths, nlen);
+    if (error < 0 || (error > 0 && nlen - decoder->lencode.count[0] != 1)) {
+        return PNGDEC_ERR_FORMAT;
+    }
+    error = construct(&decoder->distcode, lengths + nlen, ndist);
+    if (error < 0 || (error > 0 && ndist - decoder->distcode.count[0] != 1)) {
+        return PNGDEC_ERR_FORMAT;
+    }
+
+    return codes(decoder);
+}
+
+static uint8_t read_header(pngdec_t *decoder, const uint8_t *ihdr) {
+    uint32_t width = BE32(&ihdr[0]);
+    uint32_t height = BE32(&ihdr[4]);
+    uint8_t depth = ihdr[8];
+    uint8_t valid;
+
+    if (0 == width || 0 == height || ihdr[10] || ihdr[11] || ihdr[12] > 1) {
+        return PNGDEC_ERR_FORMAT;
+    }
+
+    switch (ihdr[9]) {
+        case PNGDEC_COLOR_GRAY:
+            decoder->channels = 1;
+            valid = 1 == depth || 2 == depth || 4 == depth || 8 == depth || 16 == depth;
+            break;
+        case PNGDEC_COLOR_INDEXED:
+            decoder->channels = 1;
+            valid = 1 == depth || 2 == depth || 4 == depth || 8 == depth;
+            break;
+        case PNGDEC_COLOR_RGB:
+            decoder->channels = 3;
+            valid = 8 == depth || 16 == depth;
+            break;
+        case PNGDEC_COLOR_GRAY_ALPHA:
+            decoder->channels = 2;
+            valid = 8 == depth || 16 == depth;
+            break;
+        case PNGDEC_COLOR_RGBA:
+            decoder->channels = 4;
+            valid = 8 == depth || 16 == depth;
+            break;
+        default:
+            valid = 0;
+            break;
+    }
+
+    if (!valid) {
+        return PNGDEC_ERR_FORMAT;
+    }
+
+    if (width > UINT16_MAX || height > UINT16_MAX || ihdr[12]) {
+        return PNGDEC_ERR_UNSUPPORTED;
+    }
+
+    uint32_t bits_per_pixel = decoder->channels * depth;
+
+    decoder->width = width;
+    decoder->height = height;
+    decoder->depth = depth;
+    decoder->color_type = ihdr[9];
+    decoder->bpp = (bits_per_pixel + 7) / 8;
+    decoder->row_size = (width * bits_per_pixel + 7) / 8;
+
+    return PNGDEC_OK;
+}
+
+static uint8_t read_transparency(pngdec_t *decoder, uint32_t length) {
+    uint8_t data[6];
+
+    if (PNGDEC_COLOR_INDEXED == decoder->color_type) {
+        if (length > decoder->palette_size) {
+            return PNGDEC_ERR_FORMAT;
+        }
+        for (uint32_t i = 0; i < length; i++) {
+            if (!read_bytes(decoder, &decoder->palette[i * 4 + 3], 1)) {
+                return PNGDEC_ERR_INPUT;
+            }
+        }
+        return PNGDEC_OK;
+    }
+
+    uint8_t size = decoder->channels * 2;
+    if ((PNGDEC_COLOR_GRAY != decoder->color_type &&
+         PNGDEC_COLOR_RGB != decoder->color_type) ||
+        length != size) {
+        return read_bytes(decoder, NULL, length) ? PNGDEC_OK : PNGDEC_ERR_INPUT;
+    }
+
+    if (!read_bytes(decoder, data, size)) {
+        return PNGDEC_ERR_INPUT;
+    }
+    for (uint8_t i = 0; i < decoder->channels; i++) {
+        decoder->key[i] = data[i * 2] << 8 | data[i * 2 + 1];
+    }
+    decoder->has_key = 1;
+
+    return PNGDEC_OK;
+}
+
+uint8_t pngdec_prepare(pngdec_t *decoder, pngdec_read_t read, void *device) {
+    uint8_t header[PNGDEC_SIGNATURE_SIZE];
+    uint8_t ihdr[13];
+    uint8_t status;
+
+    memset(decoder, 0, sizeof(pngdec_t));
+    decoder->read = read;
+    decoder->device = device;
+
+    if (!read_bytes(decoder, header, PNGDEC_SIGNATURE_SIZE)) {
+        return PNGDEC_ERR_INPUT;
+    }
+    if (0 != memcmp(header, signature, PNGDEC_SIGNATURE_SIZE)) {
+        return PNGDEC_ERR_SIGNATURE;
+    }
+
+    /* Header chunk must come first. */
+    if (!read_bytes(decoder, header, 8)) {
+        return PNGDEC_ERR_INPUT;
+    }
+    if (13 != BE32(header) || 0 != memcmp(&header[4], "IHDR", 4)) {
+        return PNGDEC_ERR_FORMAT;
+    }
+    if (!read_bytes(decoder, ihdr, sizeof(ihdr)) || !read_bytes(decoder, NULL, 4)) {
+        return PNGDEC_ERR_INPUT;
+    }
+    status = read_header(decoder, ihdr);
+    if (PNGDEC_OK != status) {
+        return status;
+    }
+
+    /* Read ancillary chunks until the image data starts. */
+    for (;;) {
+        if (!read_bytes(decoder, header, 8)) {
+            return PNGDEC_ERR_INPUT;
+        }
+        uint32_t length = BE32(header);
+        const uint8_t *type = &header[4];
+
+        if (0 == memcmp(type, "IDAT", 4)) {
+            decoder->chunk = length;
+            break;
+        }
+
+        if (0 == memcmp(type, "PLTE", 4)) {
+            if (0 != length % 3 || length > 256 * 3) {
+                return PNGDEC_ERR_FORMAT;
+            }
+            decoder->palette_size = length / 3;
+            for (uint16_t i = 0; i < decoder->palette_size; i++) {
+                if (!read_bytes(decoder, &decoder->palette[i * 4], 3)) {
+                    return PNGDEC_ERR_INPUT;
+                }
+                decoder->palette[i * 4 + 3] = 255;
+            }
+        } else if (0 == memcmp(type, "tRNS", 4)) {
+            status = read_transparency(decoder, length);
+            if (PNGDEC_OK != status) {
+                return status;
+            }
+        } else if (0 == memcmp(type, "IEND", 4)) {
+            return PNGDEC_ERR_FORMAT;
+        } else if (!(type[0] & 0x20)) {
+            /* Unknown critical chunk. */
+            return PNGDEC_ERR_UNSUPPORTED;
+        } else if (!read_bytes(decoder, NULL, length)) {
+            return PNGDEC_ERR_INPUT;
+        }
+
+        if (!read_bytes(decoder, NULL, 4)) {
+            return PNGDEC_ERR_INPUT;
+        }
+    }
+
+    if (PNGDEC_COLOR_INDEXED == decoder->color_type && 0 == decoder->palette_size) {
+        return PNGDEC_ERR_FORMAT;
+    }
+
+    return PNGDEC_OK;
+}
+
+/* Parse the zlib header and split the pool to window and scanlines. */
+/* Back references never reach further than the start of the image. */
+static uint32_t window_size(const pngdec_t *decoder, uint32_t window) {
+    uint32_t total = (decoder->row_size + 1) * decoder->height;
+
+    while (window > 1 && window / 2 >= total) {
+        window /= 2;
+    }
+    return window;
+}
+
+static uint8_t prepare_window(pngdec_t *decoder, void *pool, size_t size) {
+    int16_t cmf = idat_byte(decoder);
+    int16_t flg = idat_byte(decoder);
+
+    if (cmf < 0 || flg < 0) {
+        return PNGDEC_ERR_INPUT;
+    }
+
+    /* Deflate compression without preset dictionary. */
+    if (8 != (cmf & 0x0F) || (cmf >> 4) > 7 || 0 != (cmf << 8 | flg) % 31 ||
+        (flg & 0x20)) {
+        return PNGDEC_ERR_FORMAT;
+    }
+
+    uint32_t window = window_size(decoder, 1UL << ((cmf >> 4) + 8));
+
+    if (!pool || size < window + 2 * (decoder->row_size + 1)) {
+        return PNGDEC_ERR_MEMORY;
+    }
+
+    decoder->window = (uint8_t *)pool;
+    decoder->window_mask = window - 1;
+    decoder->row = decoder->window + window;
+    decoder->previous = decoder->row + decoder->row_size + 1;
+    memset(decoder->previous, 0, decoder->row_size + 1);
+
+    return PNGDEC_OK;
+}
+
+uint8_t pngdec_decode(pngdec_t *decoder, pngdec_write_t write, void *pool, size_t size) {
+    uint8_t status;
+    uint8_t last;
+
+    status = prepare_window(decoder, pool, size);
+    if (PNGDEC_OK != status) {
+        return status;
+    }
+
+    decoder->write = write;
+
+    do {
+        last = bits(decoder, 1);
+        uint8_t type = bits(decoder, 2);
+        if (decoder->status) {
+            return decoder->status;
+        }
+
+        if (0 == type) {
+            status = stored(decoder);
+        } else if (1 == type) {
+            status = fixed(decoder);
+        } else if (2 == type) {
+            status = dynamic(decoder);
+        } else {
+            status = PNGDEC_ERR_FORMAT;
+        }
+
+        if (PNGDEC_DONE == status) {
+            return PNGDEC_OK;
+        }
+        if (PNGDEC_OK != status) {
+            return status;
+        }
+    } while (!last);
+
+    /* Compressed data ended before the last row. */
+    return PNGDEC_ERR_FORMAT;
+}
+
+size_t pngdec_work_size(const pngdec_t *decoder) {
+    return window_size(decoder, 32768) + 2 * (decoder->row_size + 1);
+}
@@ -0,0 +1,193 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "qoidec.h"
+
+#define BE32(ptr)                                                                      \
+    ((uint32_t)(ptr)[0] << 24 | (uint32_t)(ptr)[1] << 16 | (uint32_t)(ptr)[2] << 8 |   \
+     (uint32_t)(ptr)[3])
+
+#define QOI_OP_INDEX (0x00)
+#define QOI_OP_DIFF (0x40)
+#define QOI_OP_LUMA (0x80)
+#define QOI_OP_RUN (0xC0)
+#define QOI_OP_RGB (0xFE)
+#define QOI_OP_RGBA (0xFF)
+#define QOI_MASK (0xC0)
+
+#define QOI_HASH(r, g, b, a) (((r) * 3 + (g) * 5 + (b) * 7 + (a) * 11) % 64)
+
+/* Refill the input buffer when empty. Returns 0 on end of input. */
+static inline uint8_t refill(qoidec_t *decoder) {
+    if (decoder->offset < decoder->available) {
+        return 1;
+    }
+    decoder->offset = 0;
+    decoder->available =
+        decoder->read(decoder->device, decoder->buffer, QOIDEC_BUFFER_SIZE);
+    return decoder->available > 0;
+}
+
+static uint8_t read_bytes(qoidec_t *decoder, uint8_t *buffer, uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        if (!refill(decoder)) {
+            return 0;
+        }
+        buffer[i] = decoder->buffer[decoder->offset++];
+    }
+    return 1;
+}
+
+uint8_t qoidec_prepare(qoidec_t *decoder, qoidec_read_t read, void *device) {
+    uint8_t header[QOIDEC_HEADER_SIZE];
+    uint32_t width, height;
+
+    decoder->read = read;
+    decoder->device = device;
+    decoder->offset = 0;
+    decoder->available = 0;
+
+    if (!read_bytes(decoder, header, QOIDEC_HEADER_SIZE)) {
+        return QOIDEC_ERR_INPUT;
+    }
+
+    if (!qoidec_is_qoi(header)) {
+        return QOIDEC_ERR_SIGNATURE;
+    }
+
+    width = BE32(&header[4]);
+    height = BE32(&header[8]);
+
+    if (0 == width || 0 == height || width > UINT16_MAX || height > UINT16_MAX) {
+        return QOIDEC_ERR_FORMAT;
+    }
+    if ((3 != header[12] && 4 != header[12]) || header[13] > 1) {
+        return QOIDEC_ERR_FORMAT;
+    }
+
+    decoder->width = width;
+    decoder->height = height;
+    decoder->channels = header[12];
+    decoder->colorspace = header[13];
+
+    return QOIDEC_OK;
+}
+
+uint8_t qoidec_decode(qoidec_t *decoder, qoidec_write_t write) {
+    uint8_t *index = decoder->index;
+    uint8_t r = 0, g = 0, b = 0, a = 255;
+    uint8_t bytes[4];
+    uint16_t count = 0;
+    uint8_t run = 0;
+
+    memset(index, 0, sizeof(decoder->index));
+
+    for (uint16_t y = 0; y < decoder->height; y++) {
+        for (uint16_t x = 0; x < decoder->width; x++) {
+            if (run) {
+                run--;
+            } else {
+                if (!refill(decoder)) {
+                    return QOIDEC_ERR_INPUT;
+                }
+
+                uint8_t op = decoder->buffer[decoder->offset++];
+
+                if (QOI_OP_RGB == op) {
+                    if (!read_bytes(decoder, bytes, 3)) {
+                        return QOIDEC_ERR_INPUT;
+                    }
+                    r = bytes[0];
+                    g = bytes[1];
+                    b = bytes[2];
+                } else if (QOI_OP_RGBA == op) {
+                    if (!read_bytes(decoder, bytes, 4)) {
+                        return QOIDEC_ERR_INPUT;
+                    }
+                    r = bytes[0];
+                    g = bytes[1];
+                    b = bytes[2];
+                    a = bytes[3];
+                } else if (QOI_OP_INDEX == (op & QOI_MASK)) {
+                    const uint8_t *color = &index[op * 4];
+                    r = color[0];
+                    g = color[1];
+                    b = color[2];
+                    a = color[3];
+                } else if (QOI_OP_DIFF == (op & QOI_MASK)) {
+                    r += ((op >> 4) & 0x03) - 2;
+                    g += ((op >> 2) & 0x03) - 2;
+                    b += (op & 0x03) - 2;
+                } else if (QOI_OP_LUMA == (op & QOI_MASK)) {
+                    if (!read_bytes(decoder, bytes, 1)) {
+                        return QOIDEC_ERR_INPUT;
+                    }
+                    int8_t dg = (op & 0x3F) - 32;
+                    r += dg - 8 + (bytes[0] >> 4);
+                    g += dg;
+                    b += dg - 8 + (bytes[0] & 0x0F);
+                } else {
+                    /* Current pixel plus the given number of repeats. */
+                    run = op & 0x3F;
+                }
+
+                uint8_t *color = &index[QOI_HASH(r, g, b, a) * 4];
+                color[0] = r;
+                color[1] = g;
+                color[2] = b;
+                color[3] = a;
+            }
+
+            uint8_t *pixel = &decoder->pixels[count * 4];
+            pixel[0] = r;
+            pixel[1] = g;
+            pixel[2] = b;
+            pixel[3] = a;
+            count++;
+
+            if (QOIDEC_CHUNK_SIZE == count || x == decoder->width - 1) {
+                if (!write(decoder->device, decoder->pixels, x + 1 - count, y, count)) {
+                    return QOIDEC_ERR_INTERRUPTED;
+                }
+                count = 0;
+            }
+        }
+    }
+
+    return QOIDEC_OK;
+}
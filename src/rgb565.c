@@ -32,15 +32,39 @@ SPDX-License-Identifier: MIT
 
 */
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#include "hagl/format.h"
 #include "rgb565.h"
 
+/* RGB565_SIMD 0:Scalar, 1:SSSE3, 2:NEON. Define RGB565_NO_SIMD to force scalar code. */
+#if defined(RGB565_NO_SIMD)
+#define RGB565_SIMD 0
+#elif defined(__SSSE3__)
+#define RGB565_SIMD 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RGB565_SIMD 2
+#else
+#define RGB565_SIMD 0
+#endif
+
+#if RGB565_SIMD == 1
+#include <tmmintrin.h>
+#elif RGB565_SIMD == 2
+#include <arm_neon.h>
+#endif
+
+#define SWAP16(value) ((uint16_t)(((value) << 8) | ((value) >> 8)))
+
 uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
     uint16_t rgb;
 
     rgb = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | ((b & 0xF8) >> 3);
-    rgb = (((rgb) << 8) & 0xFF00) | (((rgb) >> 8) & 0xFF);
+#if HAGL_PIXEL_RGB565 == HAGL_FORMAT_RGB565_SWAPPED
+    rgb = SWAP16(rgb);
+#endif
 
     return rgb;
 }
@@ -48,9 +72,9 @@ uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
 rgb_t rgb565_to_rgb888(uint16_t *input) {
     rgb_t rgb;
 
-    uint8_t r5 = (*input & 0xf800) >> 8; // 1111100000000000
-    uint8_t g6 = (*input & 0x07e0) >> 3; // 0000011111100000
-    uint8_t b5 = (*input & 0x001f) << 3; // 0000000000011111
+    uint8_t r5 = (*input & 0xf800) >> 11; // 1111100000000000
+    uint8_t g6 = (*input & 0x07e0) >> 5;  // 0000011111100000
+    uint8_t b5 = (*input & 0x001f);       // 0000000000011111
 
     rgb.r = (r5 * 527 + 23) >> 6;
     rgb.g = (g6 * 259 + 33) >> 6;
@@ -58,3 +82,248 @@ rgb_t rgb565_to_rgb888(uint16_t *input) {
 
     return rgb;
 }
+
+#if RGB565_SIMD == 1
+
+/* Shuffles which gather one channel of 16 pixels from three registers. */
+static const int8_t GATHER[3][3][16] = {
+    {{0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13}},
+    {{1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14}},
+    {{2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15}},
+};
+
+/* Shuffles which scatter three channels of 16 pixels to one register. */
+static const int8_t SCATTER[3][3][16] = {
+    {{0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5},
+     {-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1},
+     {-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1}},
+    {{-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1},
+     {5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10},
+     {-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1}},
+    {{-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1},
+     {-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1},
+     {10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15}},
+};
+
+static inline __m128i shuffle(__m128i value, const int8_t *mask) {
+    return _mm_shuffle_epi8(value, _mm_loadu_si128((const __m128i *)mask));
+}
+
+/* Pack 16 pixels at a time. Returns number of pixels converted. */
+static size_t
+pack_simd(uint16_t *output, const uint8_t *input, size_t count, bool swap, uint8_t red) {
+    const __m128i mask_f8 = _mm_set1_epi8((char)0xF8);
+    const __m128i mask_e0 = _mm_set1_epi8((char)0xE0);
+    const __m128i mask_1f = _mm_set1_epi8(0x1F);
+    const __m128i mask_07 = _mm_set1_epi8(0x07);
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        const uint8_t *src = input + i * 3;
+        __m128i in[3], channel[3];
+
+        /* Everything is loaded before storing so converting in place works. */
+        for (uint8_t j = 0; j < 3; j++) {
+            in[j] = _mm_loadu_si128((const __m128i *)(src + j * 16));
+        }
+        for (uint8_t k = 0; k < 3; k++) {
+            channel[k] = _mm_or_si128(
+                _mm_or_si128(shuffle(in[0], GATHER[k][0]), shuffle(in[1], GATHER[k][1])),
+                shuffle(in[2], GATHER[k][2])
+            );
+        }
+
+        __m128i r = channel[red];
+        __m128i g = channel[1];
+        __m128i b = channel[2 - red];
+
+        /* Eight bit shifts are done as sixteen bit shifts and masked. */
+        __m128i high = _mm_or_si128(
+            _mm_and_si128(r, mask_f8), _mm_and_si128(_mm_srli_epi16(g, 5), mask_07)
+        );
+        __m128i low = _mm_or_si128(
+            _mm_and_si128(_mm_slli_epi16(g, 3), mask_e0),
+            _mm_and_si128(_mm_srli_epi16(b, 3), mask_1f)
+        );
+        __m128i first = swap ? high : low;
+        __m128i second = swap ? low : high;
+
+        _mm_storeu_si128((__m128i *)(output + i), _mm_unpacklo_epi8(first, second));
+        _mm_storeu_si128((__m128i *)(output + i + 8), _mm_unpackhi_epi8(first, second));
+    }
+
+    return i;
+}
+
+static inline __m128i expand(__m128i value, int16_t multiplier, int16_t addend) {
+    return _mm_srli_epi16(
+        _mm_add_epi16(
+            _mm_mullo_epi16(value, _mm_set1_epi16(multiplier)), _mm_set1_epi16(addend)
+        ),
+        6
+    );
+}
+
+/* Unpack 16 pixels at a time. Returns number of pixels converted. */
+static size_t
+unpack_simd(uint8_t *output, const uint16_t *input, size_t count, bool swap) {
+    const __m128i bswap =
+        _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    const __m128i mask_3f = _mm_set1_epi16(0x3F);
+    const __m128i mask_1f = _mm_set1_epi16(0x1F);
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m128i channel[3][2];
+        __m128i packed[3];
+
+        for (uint8_t j = 0; j < 2; j++) {
+            __m128i pixels = _mm_loadu_si128((const __m128i *)(input + i + j * 8));
+            if (swap) {
+                pixels = _mm_shuffle_epi8(pixels, bswap);
+            }
+
+            __m128i green = _mm_and_si128(_mm_srli_epi16(pixels, 5), mask_3f);
+
+            channel[0][j] = expand(_mm_srli_epi16(pixels, 11), 527, 23);
+            channel[1][j] = expand(green, 259, 33);
+            channel[2][j] = expand(_mm_and_si128(pixels, mask_1f), 527, 23);
+        }
+        for (uint8_t k = 0; k < 3; k++) {
+            packed[k] = _mm_packus_epi16(channel[k][0], channel[k][1]);
+        }
+
+        uint8_t *dst = output + i * 3;
+        for (uint8_t j = 0; j < 3; j++) {
+            __m128i out = _mm_or_si128(
+                _mm_or_si128(
+                    shuffle(packed[0], SCATTER[j][0]), shuffle(packed[1], SCATTER[j][1])
+                ),
+                shuffle(packed[2], SCATTER[j][2])
+            );
+            _mm_storeu_si128((__m128i *)(dst + j * 16), out);
+        }
+    }
+
+    return i;
+}
+
+#elif RGB565_SIMD == 2
+
+/* Pack 16 pixels at a time. Returns number of pixels converted. */
+static size_t
+pack_simd(uint16_t *output, const uint8_t *input, size_t count, bool swap, uint8_t red) {
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        /* Everything is loaded before storing so converting in place works. */
+        uint8x16x3_t in = vld3q_u8(input + i * 3);
+        uint8x16_t r = in.val[red];
+        uint8x16_t g = in.val[1];
+        uint8x16_t b = in.val[2 - red];
+        uint8x16x2_t out;
+
+        uint8x16_t high = vorrq_u8(vandq_u8(r, vdupq_n_u8(0xF8)), vshrq_n_u8(g, 5));
+        uint8x16_t low =
+            vorrq_u8(vandq_u8(vshlq_n_u8(g, 3), vdupq_n_u8(0xE0)), vshrq_n_u8(b, 3));
+
+        out.val[0] = swap ? high : low;
+        out.val[1] = swap ? low : high;
+        vst2q_u8((uint8_t *)(output + i), out);
+    }
+
+    return i;
+}
+
+static inline uint8x16_t expand(uint8x16_t value, uint16_t multiplier, uint16_t addend) {
+    uint16x8_t low =
+        vmlaq_n_u16(vdupq_n_u16(addend), vmovl_u8(vget_low_u8(value)), multiplier);
+    uint16x8_t high =
+        vmlaq_n_u16(vdupq_n_u16(addend), vmovl_u8(vget_high_u8(value)), multiplier);
+    return vcombine_u8(vshrn_n_u16(low, 6), vshrn_n_u16(high, 6));
+}
+
+/* Unpack 16 pixels at a time. Returns number of pixels converted. */
+static size_t
+unpack_simd(uint8_t *output, const uint16_t *input, size_t count, bool swap) {
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        /* Low and high bytes of each pixel end up in separate registers. */
+        uint8x16x2_t in = vld2q_u8((const uint8_t *)(input + i));
+        uint8x16_t low = swap ? in.val[1] : in.val[0];
+        uint8x16_t high = swap ? in.val[0] : in.val[1];
+        uint8x16x3_t out;
+
+        uint8x16_t r5 = vshrq_n_u8(high, 3);
+        uint8x16_t g6 =
+            vorrq_u8(vshlq_n_u8(vandq_u8(high, vdupq_n_u8(0x07)), 3), vshrq_n_u8(low, 5));
+        uint8x16_t b5 = vandq_u8(low, vdupq_n_u8(0x1F));
+
+        out.val[0] = expand(r5, 527, 23);
+        out.val[1] = expand(g6, 259, 33);
+        out.val[2] = expand(b5, 527, 23);
+        vst3q_u8(output + i * 3, out);
+    }
+
+    return i;
+}
+
+#else
+
+static inline size_t
+pack_simd(uint16_t *output, const uint8_t *input, size_t count, bool swap, uint8_t red) {
+    (void)output;
+    (void)input;
+    (void)count;
+    (void)swap;
+    (void)red;
+    return 0;
+}
+
+static inline size_t
+unpack_simd(uint8_t *output, const uint16_t *input, size_t count, bool swap) {
+    (void)output;
+    (void)input;
+    (void)count;
+    (void)swap;
+    return 0;
+}
+
+#endif /* RGB565_SIMD */
+
+/* Red is the first byte of each pixel in RGB order and the last in BGR order. */
+static void
+pack(uint16_t *output, const uint8_t *input, size_t count, bool swap, uint8_t red) {
+    size_t i = pack_simd(output, input, count, swap, red);
+
+    for (; i < count; i++) {
+        const uint8_t *pixel = input + i * 3;
+        uint16_t color = ((pixel[red] & 0xF8) << 8) | ((pixel[1] & 0xFC) << 3) |
+                         (pixel[2 - red] >> 3);
+        output[i] = swap ? SWAP16(color) : color;
+    }
+}
+
+void rgb888_to_rgb565_n(uint16_t *output, const rgb_t *input, size_t count, bool swap) {
+    pack(output, (const uint8_t *)input, count, swap, 0);
+}
+
+void bgr888_to_rgb565_n(uint16_t *output, const uint8_t *input, size_t count, bool swap) {
+    pack(output, input, count, swap, 2);
+}
+
+void rgb565_to_rgb888_n(rgb_t *output, const uint16_t *input, size_t count, bool swap) {
+    size_t i = unpack_simd((uint8_t *)output, input, count, swap);
+
+    for (; i < count; i++) {
+        uint16_t pixel = swap ? SWAP16(input[i]) : input[i];
+        output[i] = rgb565_to_rgb888(&pixel);
+    }
+}
@@ -36,10 +36,14 @@ SPDX-License-Identifier: BSD-2-Clause
 
 */
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "rgb888.h"
 
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
 hsl_t rgb888_to_hsl(rgb_t *rgb) {
     hsl_t hsl;
     float r, g, b, h, s, l;
@@ -47,8 +51,9 @@ hsl_t rgb888_to_hsl(rgb_t *rgb) {
     g = rgb->g / 256.0;
     b = rgb->b / 256.0;
 
-    float maxColor = max(r, max(g, b));
-    float minColor = min(r, min(g, b));
+    /* The int min() and max() would truncate everything to zero. */
+    float maxColor = MAX(r, MAX(g, b));
+    float minColor = MIN(r, MIN(g, b));
 
     /* R == G == B, so it's a shade of gray. */
     if (minColor == maxColor) {
@@ -85,10 +90,63 @@ hsl_t rgb888_to_hsl(rgb_t *rgb) {
     return hsl;
 }
 
+/*
+ * Integer version of the above. Each channel is computed as a single
+ * fraction which is truncated like the float version.
+ */
+hsl8_t rgb888_to_hsl8(const rgb_t *rgb) {
+    int32_t r = rgb->r;
+    int32_t g = rgb->g;
+    int32_t b = rgb->b;
+    int32_t high = MAX(r, MAX(g, b));
+    int32_t low = MIN(r, MIN(g, b));
+    int32_t delta = high - low;
+    int32_t sum = high + low;
+    int32_t hue;
+    hsl8_t hsl;
+
+    /* R == G == B, so it's a shade of gray. */
+    if (0 == delta) {
+        hsl.h = 0;
+        hsl.s = 0;
+        hsl.l = (r * 255) >> 8;
+        return hsl;
+    }
+
+    hsl.l = (sum * 255) >> 9;
+
+    if (sum < 256) {
+        hsl.s = delta * 255 / sum;
+    } else {
+        hsl.s = delta * 255 / (512 - sum);
+    }
+
+    /* Hue in units of delta / 6 of a full circle. */
+    if (r == high) {
+        hue = g - b;
+        if (hue < 0) {
+            hue += 6 * delta;
+        }
+    } else if (g == high) {
+        hue = 2 * delta + b - r;
+    } else {
+        hue = 4 * delta + r - g;
+    }
+    hsl.h = hue * 255 / (6 * delta);
+
+    return hsl;
+}
+
+void rgb888_to_hsl8_array(hsl8_t *output, const rgb_t *input, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        output[i] = rgb888_to_hsl8(&input[i]);
+    }
+}
+
 uint16_t rgb888_to_rgb565(rgb_t *input) {
     uint16_t r5 = (input->r * 249 + 1014) >> 11;
     uint16_t g6 = (input->g * 253 + 505) >> 10;
     uint16_t b5 = (input->b * 249 + 1014) >> 11;
 
-    return (r5 | g6 | b5);
+    return (r5 << 11) | (g6 << 5) | b5;
 }
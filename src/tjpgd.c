@@ -22,6 +22,33 @@
 
 #include "tjpgd.h"
 #include "config.h"
+#include "hagl/format.h"
+#include "rgb565.h"
+
+/*-----------------------------------------------*/
+/* SIMD code path selected from compiler flags   */
+/*-----------------------------------------------*/
+
+/* JD_SIMD 0:Scalar, 1:SSE2, 2:AVX2, 3:NEON. Define TJPGD_NO_SIMD to force scalar code. */
+/* All the code paths produce bit-identical output. */
+
+#if defined(TJPGD_NO_SIMD)
+#define JD_SIMD		0
+#elif defined(__AVX2__)
+#define JD_SIMD		2
+#elif defined(__SSE2__) || defined(_M_X64)
+#define JD_SIMD		1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define JD_SIMD		3
+#else
+#define JD_SIMD		0
+#endif
+
+#if JD_SIMD == 1 || JD_SIMD == 2
+#include <immintrin.h>
+#elif JD_SIMD == 3
+#include <arm_neon.h>
+#endif
 
 /*-----------------------------------------------*/
 /* Zigzag-order to raster-order conversion table */
@@ -238,6 +265,25 @@ static int create_huffman_tbl (	/* 0:OK, !0:Failed */
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Refill input buffer                                                   */
+/*-----------------------------------------------------------------------*/
+
+static uint16_t refill (	/* Number of bytes available, 0: error */
+    JDEC* jd,			/* Pointer to the decompressor object */
+    const uint8_t** dp	/* Pointer to read ptr to be updated */
+)
+{
+    if (jd->inref) {	/* Zero-copy input, data is referenced in place */
+        return jd->inref(jd, dp);
+    }
+    *dp = jd->inbuf;	/* Top of input buffer */
+    return jd->infunc(jd, jd->inbuf, jd->sz_buf);
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Extract N bits from input stream                                      */
 /*-----------------------------------------------------------------------*/
@@ -247,17 +293,17 @@ static int bitext (	/* >=0: extracted data, <0: error code */
     int nbit		/* Number of bits to extract (1 to 11) */
 )
 {
-    uint8_t msk, s, *dp;
+    uint8_t msk, s;
+    const uint8_t *dp;
     uint16_t dc, v, f;
 
 
     msk = jd->dmsk; dc = jd->dctr; dp = jd->dptr;	/* Bit mask, number of data available, read ptr */
-    s = *dp; v = f = 0;
+    s = jd->dbyte; v = f = 0;
     do {
         if (!msk) {				/* Next byte? */
             if (!dc) {			/* No input data is available, re-fill input buffer */
-                dp = jd->inbuf;	/* Top of input buffer */
-                dc = jd->infunc(jd, dp, JD_SZBUF);
+                dc = refill(jd, &dp);
                 if (!dc) return 0 - (int16_t)JDR_INP;	/* Err: read error or wrong stream termination */
             } else {
                 dp++;			/* Next data ptr */
@@ -266,7 +312,7 @@ static int bitext (	/* >=0: extracted data, <0: error code */
             if (f) {			/* In flag sequence? */
                 f = 0;			/* Exit flag sequence */
                 if (*dp != 0) return 0 - (int16_t)JDR_FMT1;	/* Err: unexpected flag is detected (may be collapted data) */
-                *dp = s = 0xFF;			/* The flag is a data 0xFF */
+                s = 0xFF;				/* The flag is a data 0xFF */
             } else {
                 s = *dp;				/* Get next data byte */
                 if (s == 0xFF) {		/* Is start of flag sequence? */
@@ -280,7 +326,7 @@ static int bitext (	/* >=0: extracted data, <0: error code */
         msk >>= 1;
         nbit--;
     } while (nbit);
-    jd->dmsk = msk; jd->dctr = dc; jd->dptr = dp;
+    jd->dmsk = msk; jd->dctr = dc; jd->dptr = dp; jd->dbyte = s;
 
     return (int)v;
 }
@@ -299,18 +345,18 @@ static int16_t huffext (	/* >=0: decoded data, <0: error code */
     const uint8_t* hdata	/* Pointer to the data table */
 )
 {
-    uint8_t msk, s, *dp;
+    uint8_t msk, s;
+    const uint8_t *dp;
     uint16_t dc, v, f, bl, nd;
 
 
     msk = jd->dmsk; dc = jd->dctr; dp = jd->dptr;	/* Bit mask, number of data available, read ptr */
-    s = *dp; v = f = 0;
+    s = jd->dbyte; v = f = 0;
     bl = 16;	/* Max code length */
     do {
         if (!msk) {		/* Next byte? */
             if (!dc) {	/* No input data is available, re-fill input buffer */
-                dp = jd->inbuf;	/* Top of input buffer */
-                dc = jd->infunc(jd, dp, JD_SZBUF);
+                dc = refill(jd, &dp);
                 if (!dc) return 0 - (int16_t)JDR_INP;	/* Err: read error or wrong stream termination */
             } else {
                 dp++;	/* Next data ptr */
@@ -319,7 +365,7 @@ static int16_t huffext (	/* >=0: decoded data, <0: error code */
             if (f) {		/* In flag sequence? */
                 f = 0;		/* Exit flag sequence */
                 if (*dp != 0) return 0 - (int16_t)JDR_FMT1;	/* Err: unexpected flag is detected (may be collapted data) */
-                *dp = s = 0xFF;			/* The flag is a data 0xFF */
+                s = 0xFF;				/* The flag is a data 0xFF */
             } else {
                 s = *dp;				/* Get next data byte */
                 if (s == 0xFF) {		/* Is start of flag sequence? */
@@ -334,7 +380,7 @@ static int16_t huffext (	/* >=0: decoded data, <0: error code */
 
         for (nd = *hbits++; nd; nd--) {	/* Search the code word in this bit length */
             if (v == *hcode++) {		/* Matched? */
-                jd->dmsk = msk; jd->dctr = dc; jd->dptr = dp;
+                jd->dmsk = msk; jd->dctr = dc; jd->dptr = dp; jd->dbyte = s;
                 return *hdata;			/* Return the decoded data */
             }
             hdata++;
@@ -352,6 +398,290 @@ static int16_t huffext (	/* >=0: decoded data, <0: error code */
 /* Apply Inverse-DCT in Arai Algorithm (see also aa_idct.png)            */
 /*-----------------------------------------------------------------------*/
 
+#if JD_SIMD
+
+/* Vector operations on 32-bit lanes. AVX2 holds a whole row of the block in a */
+/* vector, SSE2 and NEON hold a half row. Multiplications wrap around exactly  */
+/* like the int32_t arithmetic of the scalar code. */
+
+#if JD_SIMD == 2
+typedef __m256i vint_t;
+#define VSET1(a)		_mm256_set1_epi32(a)
+#define VADD(a, b)		_mm256_add_epi32(a, b)
+#define VSUB(a, b)		_mm256_sub_epi32(a, b)
+#define VMUL12(a, b)	_mm256_srai_epi32(_mm256_mullo_epi32(a, b), 12)
+#elif JD_SIMD == 1
+typedef __m128i vint_t;
+#define VSET1(a)		_mm_set1_epi32(a)
+#define VADD(a, b)		_mm_add_epi32(a, b)
+#define VSUB(a, b)		_mm_sub_epi32(a, b)
+#define VMUL12(a, b)	_mm_srai_epi32(mullo32(a, b), 12)
+
+static inline __m128i mullo32 (
+    __m128i a,
+    __m128i b
+)
+{
+#ifdef __SSE4_1__
+    return _mm_mullo_epi32(a, b);
+#else
+    __m128i p02 = _mm_mul_epu32(a, b);	/* Low 32 bits of the product do not depend on signedness */
+    __m128i p13 = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(p02, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(p13, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
+#else
+typedef int32x4_t vint_t;
+#define VSET1(a)		vdupq_n_s32(a)
+#define VADD(a, b)		vaddq_s32(a, b)
+#define VSUB(a, b)		vsubq_s32(a, b)
+#define VMUL12(a, b)	vshrq_n_s32(vmulq_s32(a, b), 12)
+#endif
+
+/* One dimensional IDCT of eight vectors, same steps as in the scalar code */
+static inline void idct_pass (
+    vint_t* x,		/* Elements 0..7, transformed in place */
+    vint_t bias		/* Added to the DC element */
+)
+{
+    const vint_t M13 = VSET1((int32_t)(1.41421*4096)), M2 = VSET1((int32_t)(1.08239*4096)), M4 = VSET1((int32_t)(2.61313*4096)), M5 = VSET1((int32_t)(1.84776*4096));
+    vint_t v0, v1, v2, v3, v4, v5, v6, v7;
+    vint_t t10, t11, t12, t13;
+
+    v0 = VADD(x[0], bias);	/* Get even elements */
+    v1 = x[2];
+    v2 = x[4];
+    v3 = x[6];
+
+    t10 = VADD(v0, v2);		/* Process the even elements */
+    t12 = VSUB(v0, v2);
+    t11 = VMUL12(VSUB(v1, v3), M13);
+    v3 = VADD(v3, v1);
+    t11 = VSUB(t11, v3);
+    v0 = VADD(t10, v3);
+    v3 = VSUB(t10, v3);
+    v1 = VADD(t11, t12);
+    v2 = VSUB(t12, t11);
+
+    v4 = x[7];				/* Get odd elements */
+    v5 = x[1];
+    v6 = x[5];
+    v7 = x[3];
+
+    t10 = VSUB(v5, v4);		/* Process the odd elements */
+    t11 = VADD(v5, v4);
+    t12 = VSUB(v6, v7);
+    v7 = VADD(v7, v6);
+    v5 = VMUL12(VSUB(t11, v7), M13);
+    v7 = VADD(v7, t11);
+    t13 = VMUL12(VADD(t10, t12), M5);
+    v4 = VSUB(t13, VMUL12(t10, M2));
+    v6 = VSUB(VSUB(t13, VMUL12(t12, M4)), v7);
+    v5 = VSUB(v5, v6);
+    v4 = VSUB(v4, v5);
+
+    x[0] = VADD(v0, v7);	/* Write-back transformed values */
+    x[7] = VSUB(v0, v7);
+    x[1] = VADD(v1, v6);
+    x[6] = VSUB(v1, v6);
+    x[2] = VADD(v2, v5);
+    x[5] = VSUB(v2, v5);
+    x[3] = VADD(v3, v4);
+    x[4] = VSUB(v3, v4);
+}
+
+/* Descale 8 bits and saturate the same way as BYTECLIP() does. Without the */
+/* clipping table the saturation is done later by the narrowing packs. */
+static inline vint_t idct_clip (
+    vint_t v
+)
+{
+#if JD_SIMD == 2
+    v = _mm256_srai_epi32(v, 8);
+#if JD_TBLCLIP
+    v = _mm256_and_si256(v, _mm256_set1_epi32(0x3FF));
+    v = _mm256_andnot_si256(_mm256_cmpgt_epi32(v, _mm256_set1_epi32(511)), _mm256_min_epi32(v, _mm256_set1_epi32(255)));
+#else
+    v = _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16);	/* BYTECLIP() takes int16_t */
+#endif
+#elif JD_SIMD == 1
+    v = _mm_srai_epi32(v, 8);
+#if JD_TBLCLIP
+    v = _mm_and_si128(v, _mm_set1_epi32(0x3FF));	/* Upper halves are zero so 16-bit minimum will do */
+    v = _mm_andnot_si128(_mm_cmpgt_epi32(v, _mm_set1_epi32(511)), _mm_min_epi16(v, _mm_set1_epi32(255)));
+#else
+    v = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);	/* BYTECLIP() takes int16_t */
+#endif
+#else
+    v = vshrq_n_s32(v, 8);
+#if JD_TBLCLIP
+    v = vandq_s32(v, vdupq_n_s32(0x3FF));
+    v = vbicq_s32(vminq_s32(v, vdupq_n_s32(255)), vreinterpretq_s32_u32(vcgtq_s32(v, vdupq_n_s32(511))));
+#else
+    v = vshrq_n_s32(vshlq_n_s32(v, 16), 16);	/* BYTECLIP() takes int16_t */
+#endif
+#endif
+    return v;
+}
+
+#if JD_SIMD == 2
+
+static inline void transpose8 (
+    __m256i* r
+)
+{
+    __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+
+    t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+    r[0] = _mm256_unpacklo_epi64(t0, t2);
+    r[1] = _mm256_unpackhi_epi64(t0, t2);
+    r[2] = _mm256_unpacklo_epi64(t1, t3);
+    r[3] = _mm256_unpackhi_epi64(t1, t3);
+    r[4] = _mm256_unpacklo_epi64(t4, t6);
+    r[5] = _mm256_unpackhi_epi64(t4, t6);
+    r[6] = _mm256_unpacklo_epi64(t5, t7);
+    r[7] = _mm256_unpackhi_epi64(t5, t7);
+
+    t0 = _mm256_permute2x128_si256(r[0], r[4], 0x20);
+    t1 = _mm256_permute2x128_si256(r[1], r[5], 0x20);
+    t2 = _mm256_permute2x128_si256(r[2], r[6], 0x20);
+    t3 = _mm256_permute2x128_si256(r[3], r[7], 0x20);
+    t4 = _mm256_permute2x128_si256(r[0], r[4], 0x31);
+    t5 = _mm256_permute2x128_si256(r[1], r[5], 0x31);
+    t6 = _mm256_permute2x128_si256(r[2], r[6], 0x31);
+    t7 = _mm256_permute2x128_si256(r[3], r[7], 0x31);
+
+    r[0] = t0; r[1] = t1; r[2] = t2; r[3] = t3;
+    r[4] = t4; r[5] = t5; r[6] = t6; r[7] = t7;
+}
+
+static void block_idct (
+    int32_t* src,	/* Input block data (de-quantized and pre-scaled for Arai Algorithm) */
+    uint8_t* dst	/* Pointer to the destination to store the block as byte array */
+)
+{
+    __m256i r[8], p0, p1;
+    uint16_t i;
+
+    for (i = 0; i < 8; i++) r[i] = _mm256_loadu_si256((const __m256i*)(src + i * 8));
+
+    idct_pass(r, _mm256_setzero_si256());	/* Process columns, a lane per column */
+    transpose8(r);
+    idct_pass(r, _mm256_set1_epi32(128L << 8));	/* Process rows, a lane per row (remove DC offset (-128) here) */
+    for (i = 0; i < 8; i++) r[i] = idct_clip(r[i]);
+    transpose8(r);
+
+    for (i = 0; i < 8; i += 4) {	/* Pack four rows to bytes at a time */
+        p0 = _mm256_packs_epi32(r[i + 0], r[i + 1]);
+        p1 = _mm256_packs_epi32(r[i + 2], r[i + 3]);
+        p0 = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(p0, p1), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+        _mm256_storeu_si256((__m256i*)(dst + i * 8), p0);
+    }
+}
+
+#else	/* JD_SIMD == 2 */
+
+static inline void transpose4 (
+    vint_t* a,
+    vint_t* b,
+    vint_t* c,
+    vint_t* d
+)
+{
+#if JD_SIMD == 1
+    __m128i t0 = _mm_unpacklo_epi32(*a, *b);
+    __m128i t1 = _mm_unpacklo_epi32(*c, *d);
+    __m128i t2 = _mm_unpackhi_epi32(*a, *b);
+    __m128i t3 = _mm_unpackhi_epi32(*c, *d);
+
+    *a = _mm_unpacklo_epi64(t0, t1);
+    *b = _mm_unpackhi_epi64(t0, t1);
+    *c = _mm_unpacklo_epi64(t2, t3);
+    *d = _mm_unpackhi_epi64(t2, t3);
+#else
+    int32x4x2_t t0 = vtrnq_s32(*a, *b);
+    int32x4x2_t t1 = vtrnq_s32(*c, *d);
+
+    *a = vcombine_s32(vget_low_s32(t0.val[0]), vget_low_s32(t1.val[0]));
+    *b = vcombine_s32(vget_low_s32(t0.val[1]), vget_low_s32(t1.val[1]));
+    *c = vcombine_s32(vget_high_s32(t0.val[0]), vget_high_s32(t1.val[0]));
+    *d = vcombine_s32(vget_high_s32(t0.val[1]), vget_high_s32(t1.val[1]));
+#endif
+}
+
+/* Transpose 8x8 block held as left (r[0]) and right (r[1]) halves of the rows */
+static inline void transpose8 (
+    vint_t r[2][8]
+)
+{
+    vint_t t;
+    uint16_t i;
+
+    transpose4(&r[0][0], &r[0][1], &r[0][2], &r[0][3]);
+    transpose4(&r[0][4], &r[0][5], &r[0][6], &r[0][7]);
+    transpose4(&r[1][0], &r[1][1], &r[1][2], &r[1][3]);
+    transpose4(&r[1][4], &r[1][5], &r[1][6], &r[1][7]);
+    for (i = 0; i < 4; i++) {	/* Swap the off-diagonal quarters */
+        t = r[0][i + 4]; r[0][i + 4] = r[1][i]; r[1][i] = t;
+    }
+}
+
+static void block_idct (
+    int32_t* src,	/* Input block data (de-quantized and pre-scaled for Arai Algorithm) */
+    uint8_t* dst	/* Pointer to the destination to store the block as byte array */
+)
+{
+    vint_t r[2][8];
+    uint16_t i;
+
+    for (i = 0; i < 8; i++) {
+#if JD_SIMD == 1
+        r[0][i] = _mm_loadu_si128((const __m128i*)(src + i * 8));
+        r[1][i] = _mm_loadu_si128((const __m128i*)(src + i * 8 + 4));
+#else
+        r[0][i] = vld1q_s32(src + i * 8);
+        r[1][i] = vld1q_s32(src + i * 8 + 4);
+#endif
+    }
+
+    idct_pass(r[0], VSET1(0));		/* Process columns, a lane per column */
+    idct_pass(r[1], VSET1(0));
+    transpose8(r);
+    idct_pass(r[0], VSET1(128L << 8));	/* Process rows, a lane per row (remove DC offset (-128) here) */
+    idct_pass(r[1], VSET1(128L << 8));
+    for (i = 0; i < 8; i++) {
+        r[0][i] = idct_clip(r[0][i]);
+        r[1][i] = idct_clip(r[1][i]);
+    }
+    transpose8(r);
+
+#if JD_SIMD == 1
+    for (i = 0; i < 8; i += 2) {	/* Pack two rows to bytes at a time */
+        __m128i p0 = _mm_packs_epi32(r[0][i + 0], r[1][i + 0]);
+        __m128i p1 = _mm_packs_epi32(r[0][i + 1], r[1][i + 1]);
+        _mm_storeu_si128((__m128i*)(dst + i * 8), _mm_packus_epi16(p0, p1));
+    }
+#else
+    for (i = 0; i < 8; i++) {
+        int16x8_t p = vcombine_s16(vqmovn_s32(r[0][i]), vqmovn_s32(r[1][i]));
+        vst1_u8(dst + i * 8, vqmovun_s16(p));
+    }
+#endif
+}
+
+#endif	/* JD_SIMD == 2 */
+
+#else	/* JD_SIMD */
+
 static void block_idct (
     int32_t* src,	/* Input block data (de-quantized and pre-scaled for Arai Algorithm) */
     uint8_t* dst	/* Pointer to the destination to store the block as byte array */
@@ -457,6 +787,8 @@ static void block_idct (
     }
 }
 
+#endif	/* JD_SIMD */
+
 
 
 
@@ -465,7 +797,8 @@ static void block_idct (
 /*-----------------------------------------------------------------------*/
 
 static JRESULT mcu_load (
-    JDEC* jd		/* Pointer to the decompressor object */
+    JDEC* jd,		/* Pointer to the decompressor object */
+    uint8_t skip	/* 1: Only consume the huffman data, MCU is not going to be output */
 )
 {
     int32_t *tmp = (int32_t*)jd->workbuf;	/* Block working buffer for de-quantize and IDCT */
@@ -528,7 +861,9 @@ static JRESULT mcu_load (
             }
         } while (++i < 64);		/* Next AC element */
 
-        if (JD_USE_SCALE && jd->scale == 3) {
+        if (skip) {
+            /* Nothing to do, IDCT is not needed */
+        } else if (JD_USE_SCALE && jd->scale == 3) {
             *bp = (uint8_t)((*tmp / 256) + 128);	/* If scale ratio is 1/8, IDCT can be ommited and only DC element is used */
         } else {
             block_idct(tmp, bp);		/* Apply IDCT and store the block to the MCU buffer */
@@ -547,6 +882,125 @@ static JRESULT mcu_load (
 /* Output an MCU: Convert YCrCb to RGB and output it in RGB form         */
 /*-----------------------------------------------------------------------*/
 
+#if JD_SIMD && JD_FORMAT == 1
+
+/* Convert YCbCr to RGB565 eight pixels at a time. Arithmetic is done in */
+/* 16-bit lanes with the same coefficients and truncating division as in */
+/* the scalar code, so the result is identical. */
+
+#if JD_SIMD == 1 || JD_SIMD == 2
+
+static inline __m128i div128 (
+    __m128i v
+)
+{
+    return _mm_srai_epi16(_mm_add_epi16(v, _mm_srli_epi16(_mm_srai_epi16(v, 15), 9)), 7);	/* Round towards zero */
+}
+
+static inline __m128i ycc_to_rgb565 (
+    __m128i yy,		/* Y component */
+    __m128i cb,		/* Cb component, level restored */
+    __m128i cr		/* Cr component, level restored */
+)
+{
+    const __m128i zero = _mm_setzero_si128(), max = _mm_set1_epi16(255);
+    __m128i r, g, b, w;
+
+    r = _mm_add_epi16(yy, div128(_mm_mullo_epi16(cr, _mm_set1_epi16((int16_t)(1.402 * 128)))));
+    g = _mm_sub_epi16(yy, div128(_mm_add_epi16(_mm_mullo_epi16(cb, _mm_set1_epi16((int16_t)(0.344 * 128))), _mm_mullo_epi16(cr, _mm_set1_epi16((int16_t)(0.714 * 128))))));
+    b = _mm_add_epi16(yy, div128(_mm_mullo_epi16(cb, _mm_set1_epi16((int16_t)(1.772 * 128)))));
+    r = _mm_min_epi16(_mm_max_epi16(r, zero), max);
+    g = _mm_min_epi16(_mm_max_epi16(g, zero), max);
+    b = _mm_min_epi16(_mm_max_epi16(b, zero), max);
+
+    w = _mm_and_si128(_mm_slli_epi16(r, 8), _mm_set1_epi16((int16_t)0xF800));	/* RRRRR----------- */
+    w = _mm_or_si128(w, _mm_slli_epi16(_mm_and_si128(g, _mm_set1_epi16(0xFC)), 3));	/* -----GGGGGG----- */
+    w = _mm_or_si128(w, _mm_srli_epi16(b, 3));	/* -----------BBBBB */
+#ifdef TJPGD_NEEDS_BYTESWAP
+    w = _mm_or_si128(_mm_srli_epi16(w, 8), _mm_slli_epi16(w, 8));
+#endif
+    return w;
+}
+
+static void ycc_row (
+    const uint8_t* py,	/* Y components of the row */
+    const uint8_t* pc,	/* Cb components of the row, Cr components are 64 bytes after */
+    uint16_t mx,		/* MCU width (8 or 16) */
+    uint16_t* d			/* RGB565 output */
+)
+{
+    const __m128i zero = _mm_setzero_si128(), level = _mm_set1_epi16(128);
+    __m128i cb = _mm_loadl_epi64((const __m128i*)pc);
+    __m128i cr = _mm_loadl_epi64((const __m128i*)(pc + 64));
+    __m128i yy = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)py), zero);
+
+    if (mx == 16) {		/* Double block width, each chroma sample covers two pixels */
+        cb = _mm_unpacklo_epi8(cb, cb);
+        cr = _mm_unpacklo_epi8(cr, cr);
+        _mm_storeu_si128((__m128i*)d, ycc_to_rgb565(yy, _mm_sub_epi16(_mm_unpacklo_epi8(cb, zero), level), _mm_sub_epi16(_mm_unpacklo_epi8(cr, zero), level)));
+        yy = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(py + 64)), zero);
+        _mm_storeu_si128((__m128i*)(d + 8), ycc_to_rgb565(yy, _mm_sub_epi16(_mm_unpackhi_epi8(cb, zero), level), _mm_sub_epi16(_mm_unpackhi_epi8(cr, zero), level)));
+    } else {			/* Single block width */
+        _mm_storeu_si128((__m128i*)d, ycc_to_rgb565(yy, _mm_sub_epi16(_mm_unpacklo_epi8(cb, zero), level), _mm_sub_epi16(_mm_unpacklo_epi8(cr, zero), level)));
+    }
+}
+
+#else	/* JD_SIMD == 3 */
+
+static inline int16x8_t div128 (
+    int16x8_t v
+)
+{
+    return vshrq_n_s16(vaddq_s16(v, vreinterpretq_s16_u16(vshrq_n_u16(vreinterpretq_u16_s16(vshrq_n_s16(v, 15)), 9))), 7);	/* Round towards zero */
+}
+
+static inline uint16x8_t ycc_to_rgb565 (
+    uint8x8_t y8,	/* Y component */
+    uint8x8_t cb8,	/* Cb component */
+    uint8x8_t cr8	/* Cr component */
+)
+{
+    int16x8_t yy = vreinterpretq_s16_u16(vmovl_u8(y8));
+    int16x8_t cb = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cb8)), vdupq_n_s16(128));	/* Restore right level */
+    int16x8_t cr = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cr8)), vdupq_n_s16(128));
+    uint8x8_t r, g, b;
+    uint16x8_t w;
+
+    r = vqmovun_s16(vaddq_s16(yy, div128(vmulq_n_s16(cr, (int16_t)(1.402 * 128)))));
+    g = vqmovun_s16(vsubq_s16(yy, div128(vaddq_s16(vmulq_n_s16(cb, (int16_t)(0.344 * 128)), vmulq_n_s16(cr, (int16_t)(0.714 * 128))))));
+    b = vqmovun_s16(vaddq_s16(yy, div128(vmulq_n_s16(cb, (int16_t)(1.772 * 128)))));
+
+    w = vshlq_n_u16(vmovl_u8(vand_u8(r, vdup_n_u8(0xF8))), 8);		/* RRRRR----------- */
+    w = vorrq_u16(w, vshlq_n_u16(vmovl_u8(vand_u8(g, vdup_n_u8(0xFC))), 3));	/* -----GGGGGG----- */
+    w = vorrq_u16(w, vmovl_u8(vshr_n_u8(b, 3)));	/* -----------BBBBB */
+#ifdef TJPGD_NEEDS_BYTESWAP
+    w = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(w)));
+#endif
+    return w;
+}
+
+static void ycc_row (
+    const uint8_t* py,	/* Y components of the row */
+    const uint8_t* pc,	/* Cb components of the row, Cr components are 64 bytes after */
+    uint16_t mx,		/* MCU width (8 or 16) */
+    uint16_t* d			/* RGB565 output */
+)
+{
+    uint8x8_t cb = vld1_u8(pc), cr = vld1_u8(pc + 64);
+
+    if (mx == 16) {		/* Double block width, each chroma sample covers two pixels */
+        uint8x8x2_t cb2 = vzip_u8(cb, cb), cr2 = vzip_u8(cr, cr);
+        vst1q_u16(d, ycc_to_rgb565(vld1_u8(py), cb2.val[0], cr2.val[0]));
+        vst1q_u16(d + 8, ycc_to_rgb565(vld1_u8(py + 64), cb2.val[1], cr2.val[1]));
+    } else {			/* Single block width */
+        vst1q_u16(d, ycc_to_rgb565(vld1_u8(py), cb, cr));
+    }
+}
+
+#endif	/* JD_SIMD == 3 */
+
+#endif	/* JD_SIMD && JD_FORMAT == 1 */
+
 static JRESULT mcu_output (
     JDEC* jd,		/* Pointer to the decompressor object */
     uint16_t (*outfunc)(JDEC*, void*, JRECT*),	/* RGB output function */
@@ -572,6 +1026,36 @@ static JRESULT mcu_output (
     rect.left = x; rect.right = x + rx - 1;				/* Rectangular area in the frame buffer */
     rect.top = y; rect.bottom = y + ry - 1;
 
+#if JD_SIMD && JD_FORMAT == 1
+    if ((!JD_USE_SCALE || !jd->scale) && jd->format == 1) {	/* Not descaled, convert straight to RGB565 */
+        uint16_t *s, *d;
+
+        d = (uint16_t*)jd->workbuf;
+        for (iy = 0; iy < my; iy++) {
+            pc = jd->mcubuf;
+            py = pc + iy * 8;
+            if (my == 16) {		/* Double block height? */
+                pc += 64 * 4 + (iy >> 1) * 8;
+                if (iy >= 8) py += 64;
+            } else {			/* Single block height */
+                pc += mx * 8 + iy * 8;
+            }
+            ycc_row(py, pc, mx, d);
+            d += mx;
+        }
+
+        /* Squeeze up pixel table if a part of MCU is to be truncated */
+        if (rx < mx) {
+            s = d = (uint16_t*)jd->workbuf;
+            for (iy = 0; iy < ry; iy++) {
+                for (ix = 0; ix < rx; ix++) *d++ = *s++;	/* Copy effective pixels */
+                s += mx - rx;	/* Skip truncated pixels */
+            }
+        }
+
+        return outfunc(jd, jd->workbuf, &rect) ? JDR_OK : JDR_INTR;
+    }
+#endif
 
     if (!JD_USE_SCALE || jd->scale != 3) {	/* Not for 1/8 scaling */
 
@@ -673,21 +1157,12 @@ static JRESULT mcu_output (
     }
 
     /* Convert RGB888 to RGB565 if needed */
-    if (JD_FORMAT == 1) {
-        uint8_t *s = (uint8_t*)jd->workbuf;
-        uint16_t w, *d = (uint16_t*)s;
-        uint16_t n = rx * ry;
-
-        do {
-            w = (*s++ & 0xF8) << 8;		/* RRRRR----------- */
-            w |= (*s++ & 0xFC) << 3;	/* -----GGGGGG----- */
-            w |= *s++ >> 3;				/* -----------BBBBB */
+    if (jd->format == 1) {	/* Converted in place */
 #ifdef TJPGD_NEEDS_BYTESWAP
-            *d++ = (w>>8) | (w<<8);
+        rgb888_to_rgb565_n((uint16_t*)jd->workbuf, (const rgb_t*)jd->workbuf, rx * ry, true);
 #else
-            *d++ = w;
+        rgb888_to_rgb565_n((uint16_t*)jd->workbuf, (const rgb_t*)jd->workbuf, rx * ry, false);
 #endif
-        } while (--n);
     }
 
     /* Output the RGB rectangular */
@@ -708,7 +1183,7 @@ static JRESULT restart (
 {
     uint16_t i, dc;
     uint16_t d;
-    uint8_t *dp;
+    const uint8_t *dp;
 
 
     /* Discard padding bits and get two bytes from the input stream */
@@ -716,8 +1191,7 @@ static JRESULT restart (
     d = 0;
     for (i = 0; i < 2; i++) {
         if (!dc) {	/* No input data is available, re-fill input buffer */
-            dp = jd->inbuf;
-            dc = jd->infunc(jd, dp, JD_SZBUF);
+            dc = refill(jd, &dp);
             if (!dc) return JDR_INP;
         } else {
             dp++;
@@ -755,6 +1229,18 @@ JRESULT jd_prepare (
     uint16_t sz_pool,	/* Size of working buffer */
     void* dev			/* I/O device identifier for the session */
 )
+{
+    return jd_prepare_ex(jd, infunc, pool, sz_pool, JD_SZBUF, dev);
+}
+
+JRESULT jd_prepare_ex (
+    JDEC* jd,			/* Blank decompressor object */
+    uint16_t (*infunc)(JDEC*, uint8_t*, uint16_t),	/* JPEG strem input function */
+    void* pool,			/* Working buffer for the decompression session */
+    uint16_t sz_pool,	/* Size of working buffer, includes the stream input buffer */
+    uint16_t sz_buf,	/* Size of stream input buffer, must fit the largest header segment */
+    void* dev			/* I/O device identifier for the session */
+)
 {
     uint8_t *seg, b;
     uint16_t marker;
@@ -763,11 +1249,14 @@ JRESULT jd_prepare (
     JRESULT rc;
 
 
-    if (!pool) return JDR_PAR;
+    if (!pool || !sz_buf) return JDR_PAR;
 
     jd->pool = pool;		/* Work memroy */
     jd->sz_pool = sz_pool;	/* Size of given work memory */
+    jd->format = JD_FORMAT;	/* Output format can be changed after prepare */
+    jd->sz_buf = sz_buf;	/* Size of stream input buffer */
     jd->infunc = infunc;	/* Stream input function */
+    jd->inref = 0;			/* No zero-copy input (default) */
     jd->device = dev;		/* I/O device identifier */
     jd->nrst = 0;			/* No restart interval (default) */
 
@@ -780,7 +1269,7 @@ JRESULT jd_prepare (
     }
     for (i = 0; i < 4; jd->qttbl[i++] = 0) ;
 
-    jd->inbuf = seg = alloc_pool(jd, JD_SZBUF);		/* Allocate stream input buffer */
+    jd->inbuf = seg = alloc_pool(jd, sz_buf);		/* Allocate stream input buffer */
     if (!seg) return JDR_MEM1;
 
     if (jd->infunc(jd, seg, 2) != 2) return JDR_INP;/* Check SOI marker */
@@ -799,7 +1288,7 @@ JRESULT jd_prepare (
         switch (marker & 0xFF) {
         case 0xC0:	/* SOF0 (baseline JPEG) */
             /* Load segment data */
-            if (len > JD_SZBUF) return JDR_MEM2;
+            if (len > sz_buf) return JDR_MEM2;
             if (jd->infunc(jd, seg, len) != len) return JDR_INP;
 
             jd->width = LDB_WORD(seg+3);		/* Image width in unit of pixel */
@@ -825,7 +1314,7 @@ JRESULT jd_prepare (
 
         case 0xDD:	/* DRI */
             /* Load segment data */
-            if (len > JD_SZBUF) return JDR_MEM2;
+            if (len > sz_buf) return JDR_MEM2;
             if (jd->infunc(jd, seg, len) != len) return JDR_INP;
 
             /* Get restart interval (MCUs) */
@@ -834,7 +1323,7 @@ JRESULT jd_prepare (
 
         case 0xC4:	/* DHT */
             /* Load segment data */
-            if (len > JD_SZBUF) return JDR_MEM2;
+            if (len > sz_buf) return JDR_MEM2;
             if (jd->infunc(jd, seg, len) != len) return JDR_INP;
 
             /* Create huffman tables */
@@ -844,7 +1333,7 @@ JRESULT jd_prepare (
 
         case 0xDB:	/* DQT */
             /* Load segment data */
-            if (len > JD_SZBUF) return JDR_MEM2;
+            if (len > sz_buf) return JDR_MEM2;
             if (jd->infunc(jd, seg, len) != len) return JDR_INP;
 
             /* Create de-quantizer tables */
@@ -854,7 +1343,7 @@ JRESULT jd_prepare (
 
         case 0xDA:	/* SOS */
             /* Load segment data */
-            if (len > JD_SZBUF) return JDR_MEM2;
+            if (len > sz_buf) return JDR_MEM2;
             if (jd->infunc(jd, seg, len) != len) return JDR_INP;
 
             if (!jd->width || !jd->height) return JDR_FMT1;	/* Err: Invalid image size */
@@ -885,9 +1374,9 @@ JRESULT jd_prepare (
             if (!jd->mcubuf) return JDR_MEM1;			/* Err: not enough memory */
 
             /* Pre-load the JPEG data to extract it from the bit stream */
-            jd->dptr = seg; jd->dctr = 0; jd->dmsk = 0;	/* Prepare to read bit stream */
-            if (ofs %= JD_SZBUF) {						/* Align read offset to JD_SZBUF */
-                jd->dctr = jd->infunc(jd, seg + ofs, (uint16_t)(JD_SZBUF - ofs));
+            jd->dptr = seg; jd->dctr = 0; jd->dmsk = 0; jd->dbyte = 0;	/* Prepare to read bit stream */
+            if (ofs %= sz_buf) {						/* Align read offset to sz_buf */
+                jd->dctr = jd->infunc(jd, seg + ofs, (uint16_t)(sz_buf - ofs));
                 jd->dptr = seg + ofs - 1;
             }
 
@@ -930,8 +1419,52 @@ JRESULT jd_decomp (
     uint8_t scale							/* Output de-scaling factor (0 to 3) */
 )
 {
-    uint16_t x, y, mx, my;
+    return jd_decomp_rect(jd, outfunc, scale, 0);
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Decompress the part of the JPEG picture inside a rectangle            */
+/*-----------------------------------------------------------------------*/
+
+JRESULT jd_decomp_rect (
+    JDEC* jd,								/* Initialized decompression object */
+    uint16_t (*outfunc)(JDEC*, void*, JRECT*),	/* RGB output function */
+    uint8_t scale,							/* Output de-scaling factor (0 to 3) */
+    const JRECT* roi						/* Region of interest in source pixels, 0: whole picture */
+)
+{
+    uint32_t nx, ny;
+
+
+    nx = (jd->width + jd->msx * 8 - 1) / (jd->msx * 8);	/* Number of MCUs in the picture */
+    ny = (jd->height + jd->msy * 8 - 1) / (jd->msy * 8);
+
+    return jd_decomp_range(jd, outfunc, scale, roi, 0, nx * ny);
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Start to decompress a range of MCUs                                   */
+/*-----------------------------------------------------------------------*/
+
+JRESULT jd_decomp_range (
+    JDEC* jd,								/* Initialized decompression object */
+    uint16_t (*outfunc)(JDEC*, void*, JRECT*),	/* RGB output function */
+    uint8_t scale,							/* Output de-scaling factor (0 to 3) */
+    const JRECT* roi,						/* Region of interest in source pixels, 0: whole picture */
+    uint32_t mcu,							/* First MCU, 0 or the first MCU of a restart interval */
+    uint32_t count							/* Number of MCUs to decompress */
+)
+{
+    uint32_t x, y, nx;
+    uint16_t mx, my;
     uint16_t rst, rsc;
+    uint8_t skip;
     JRESULT rc;
 
 
@@ -939,24 +1472,75 @@ JRESULT jd_decomp (
     jd->scale = scale;
 
     mx = jd->msx * 8; my = jd->msy * 8;			/* Size of the MCU (pixel) */
+    nx = (jd->width + mx - 1) / mx;				/* Number of MCUs in a row */
+    x = mcu % nx * mx;							/* Position of the first MCU */
+    y = mcu / nx * my;
 
     jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;	/* Initialize DC values */
-    rst = rsc = 0;
+    rst = 0;
+    rsc = jd->nrst ? (uint16_t)(mcu / jd->nrst) : 0;	/* Next expected restart marker */
 
     rc = JDR_OK;
-    for (y = 0; y < jd->height; y += my) {		/* Vertical loop of MCUs */
-        for (x = 0; x < jd->width; x += mx) {	/* Horizontal loop of MCUs */
-            if (jd->nrst && rst++ == jd->nrst) {	/* Process restart interval if enabled */
-                rc = restart(jd, rsc++);
-                if (rc != JDR_OK) return rc;
-                rst = 1;
-            }
-            rc = mcu_load(jd);					/* Load an MCU (decompress huffman coded stream and apply IDCT) */
+    for ( ; count && y < jd->height; count--) {
+        if (roi && y > roi->bottom) break;		/* Rest of the picture is below the region */
+        if (jd->nrst && rst++ == jd->nrst) {	/* Process restart interval if enabled */
+            rc = restart(jd, rsc++);
             if (rc != JDR_OK) return rc;
+            rst = 1;
+        }
+        skip = roi && (x + mx <= roi->left || x > roi->right || y + my <= roi->top);
+        rc = mcu_load(jd, skip);				/* Load an MCU (decompress huffman coded stream and apply IDCT) */
+        if (rc != JDR_OK) return rc;
+        if (!skip) {							/* MCU is inside of the region */
             rc = mcu_output(jd, outfunc, x, y);	/* Output the MCU (color space conversion, scaling and output) */
             if (rc != JDR_OK) return rc;
         }
+        x += mx;								/* Next MCU */
+        if (x >= jd->width) {
+            x = 0; y += my;
+        }
     }
 
     return rc;
 }
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Create a decompressor sharing the tables of a prepared one            */
+/*-----------------------------------------------------------------------*/
+
+JRESULT jd_clone (
+    JDEC* jd,			/* Blank decompressor object */
+    const JDEC* src,	/* Prepared decompressor object, must outlive the clone */
+    void* pool,			/* Working buffer for the decompression session */
+    uint16_t sz_pool,	/* Size of working buffer */
+    void* dev			/* I/O device identifier for the session */
+)
+{
+    uint16_t n, len;
+
+
+    if (!pool) return JDR_PAR;
+
+    *jd = *src;				/* Huffman and dequantizer tables are only read while decompressing */
+    jd->pool = pool;
+    jd->sz_pool = sz_pool;
+    jd->device = dev;
+
+    jd->inbuf = alloc_pool(jd, jd->sz_buf);		/* Allocate stream input buffer */
+    if (!jd->inbuf) return JDR_MEM1;
+
+    n = jd->msy * jd->msx;						/* Same working buffers as in jd_prepare() */
+    len = n * 64 * 2 + 64;
+    if (len < 256) len = 256;
+    jd->workbuf = alloc_pool(jd, len);
+    if (!jd->workbuf) return JDR_MEM1;
+    jd->mcubuf = (uint8_t*)alloc_pool(jd, (uint16_t)((n + 2) * 64));
+    if (!jd->mcubuf) return JDR_MEM1;
+
+    jd->dptr = jd->inbuf; jd->dctr = 0; jd->dmsk = 0; jd->dbyte = 0;	/* Bit stream is read from the start of the input */
+
+    return JDR_OK;
+}
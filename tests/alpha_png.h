@@ -0,0 +1,24 @@
+/*
+
+32x24 RGBA png image with dynamic Huffman codes. Generated with Pillow:
+
+    image.save(file, "PNG", optimize=True)
+
+where pixel at (x, y) is (x * 8, y * 10, (x + y) * 4, alpha) and alpha
+is 0 for x < 8, 128 for x < 16 and 255 for the rest.
+
+*/
+// clang-format off
+static const unsigned char alpha_png[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+    0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x18,
+    0x08, 0x06, 0x00, 0x00, 0x00, 0x9b, 0x53, 0xff, 0x34, 0x00, 0x00, 0x00,
+    0x37, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0xed, 0xce, 0x21, 0x0e, 0x00,
+    0x20, 0x0c, 0xc5, 0xd0, 0x92, 0x7c, 0x41, 0xb8, 0x34, 0x1c, 0x7d, 0x37,
+    0xd8, 0x24, 0xa6, 0xa2, 0xaa, 0xe6, 0x2d, 0x80, 0x4d, 0xba, 0xde, 0xf0,
+    0xef, 0xf0, 0xdb, 0xc2, 0x09, 0xf0, 0x2f, 0x01, 0x02, 0x04, 0x08, 0x10,
+    0x20, 0x40, 0x80, 0x00, 0x01, 0x02, 0x04, 0x14, 0x61, 0xa5, 0x0f, 0x37,
+    0x5b, 0x4f, 0xa8, 0x58, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44,
+    0xae, 0x42, 0x60, 0x82,
+};
+// clang-format on
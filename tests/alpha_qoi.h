@@ -0,0 +1,278 @@
+/*
+
+Same 32x24 RGBA image as in alpha_png.h as qoi. Generated with Pillow:
+
+    image.save(file, "QOI")
+
+where pixel at (x, y) is (x * 8, y * 10, (x + y) * 4, alpha) and alpha
+is 0 for x < 8, 128 for x < 16 and 255 for the rest.
+
+*/
+// clang-format off
+static const unsigned char alpha_qoi[] = {
+    0x71, 0x6f, 0x69, 0x66, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x18,
+    0x04, 0x01, 0x00, 0xfe, 0x08, 0x00, 0x04, 0xfe, 0x10, 0x00, 0x08, 0xfe,
+    0x18, 0x00, 0x0c, 0xfe, 0x20, 0x00, 0x10, 0xfe, 0x28, 0x00, 0x14, 0xfe,
+    0x30, 0x00, 0x18, 0xfe, 0x38, 0x00, 0x1c, 0xff, 0x40, 0x00, 0x20, 0x80,
+    0xfe, 0x48, 0x00, 0x24, 0xfe, 0x50, 0x00, 0x28, 0xfe, 0x58, 0x00, 0x2c,
+    0xfe, 0x60, 0x00, 0x30, 0xfe, 0x68, 0x00, 0x34, 0xfe, 0x70, 0x00, 0x38,
+    0xfe, 0x78, 0x00, 0x3c, 0xff, 0x80, 0x00, 0x40, 0xff, 0xfe, 0x88, 0x00,
+    0x44, 0xfe, 0x90, 0x00, 0x48, 0xfe, 0x98, 0x00, 0x4c, 0xfe, 0xa0, 0x00,
+    0x50, 0xfe, 0xa8, 0x00, 0x54, 0xfe, 0xb0, 0x00, 0x58, 0xfe, 0xb8, 0x00,
+    0x5c, 0xfe, 0xc0, 0x00, 0x60, 0xfe, 0xc8, 0x00, 0x64, 0xfe, 0xd0, 0x00,
+    0x68, 0xfe, 0xd8, 0x00, 0x6c, 0xfe, 0xe0, 0x00, 0x70, 0xfe, 0xe8, 0x00,
+    0x74, 0xfe, 0xf0, 0x00, 0x78, 0xfe, 0xf8, 0x00, 0x7c, 0xff, 0x00, 0x0a,
+    0x04, 0x00, 0xfe, 0x08, 0x0a, 0x08, 0xfe, 0x10, 0x0a, 0x0c, 0xfe, 0x18,
+    0x0a, 0x10, 0xfe, 0x20, 0x0a, 0x14, 0xfe, 0x28, 0x0a, 0x18, 0xfe, 0x30,
+    0x0a, 0x1c, 0xfe, 0x38, 0x0a, 0x20, 0xff, 0x40, 0x0a, 0x24, 0x80, 0xfe,
+    0x48, 0x0a, 0x28, 0xfe, 0x50, 0x0a, 0x2c, 0xfe, 0x58, 0x0a, 0x30, 0xfe,
+    0x60, 0x0a, 0x34, 0xfe, 0x68, 0x0a, 0x38, 0xfe, 0x70, 0x0a, 0x3c, 0xfe,
+    0x78, 0x0a, 0x40, 0xff, 0x80, 0x0a, 0x44, 0xff, 0xfe, 0x88, 0x0a, 0x48,
+    0xfe, 0x90, 0x0a, 0x4c, 0xfe, 0x98, 0x0a, 0x50, 0xfe, 0xa0, 0x0a, 0x54,
+    0xfe, 0xa8, 0x0a, 0x58, 0xfe, 0xb0, 0x0a, 0x5c, 0xfe, 0xb8, 0x0a, 0x60,
+    0xfe, 0xc0, 0x0a, 0x64, 0xfe, 0xc8, 0x0a, 0x68, 0xfe, 0xd0, 0x0a, 0x6c,
+    0xfe, 0xd8, 0x0a, 0x70, 0xfe, 0xe0, 0x0a, 0x74, 0xfe, 0xe8, 0x0a, 0x78,
+    0xfe, 0xf0, 0x0a, 0x7c, 0xfe, 0xf8, 0x0a, 0x80, 0xff, 0x00, 0x14, 0x08,
+    0x00, 0xfe, 0x08, 0x14, 0x0c, 0xfe, 0x10, 0x14, 0x10, 0xfe, 0x18, 0x14,
+    0x14, 0xfe, 0x20, 0x14, 0x18, 0xfe, 0x28, 0x14, 0x1c, 0xfe, 0x30, 0x14,
+    0x20, 0xfe, 0x38, 0x14, 0x24, 0xff, 0x40, 0x14, 0x28, 0x80, 0xfe, 0x48,
+    0x14, 0x2c, 0xfe, 0x50, 0x14, 0x30, 0xfe, 0x58, 0x14, 0x34, 0xfe, 0x60,
+    0x14, 0x38, 0xfe, 0x68, 0x14, 0x3c, 0xfe, 0x70, 0x14, 0x40, 0xfe, 0x78,
+    0x14, 0x44, 0xff, 0x80, 0x14, 0x48, 0xff, 0xfe, 0x88, 0x14, 0x4c, 0xfe,
+    0x90, 0x14, 0x50, 0xfe, 0x98, 0x14, 0x54, 0xfe, 0xa0, 0x14, 0x58, 0xfe,
+    0xa8, 0x14, 0x5c, 0xfe, 0xb0, 0x14, 0x60, 0xfe, 0xb8, 0x14, 0x64, 0xfe,
+    0xc0, 0x14, 0x68, 0xfe, 0xc8, 0x14, 0x6c, 0xfe, 0xd0, 0x14, 0x70, 0xfe,
+    0xd8, 0x14, 0x74, 0xfe, 0xe0, 0x14, 0x78, 0xfe, 0xe8, 0x14, 0x7c, 0xfe,
+    0xf0, 0x14, 0x80, 0xfe, 0xf8, 0x14, 0x84, 0xff, 0x00, 0x1e, 0x0c, 0x00,
+    0xfe, 0x08, 0x1e, 0x10, 0xfe, 0x10, 0x1e, 0x14, 0xfe, 0x18, 0x1e, 0x18,
+    0xfe, 0x20, 0x1e, 0x1c, 0xfe, 0x28, 0x1e, 0x20, 0xfe, 0x30, 0x1e, 0x24,
+    0xfe, 0x38, 0x1e, 0x28, 0xff, 0x40, 0x1e, 0x2c, 0x80, 0xfe, 0x48, 0x1e,
+    0x30, 0xfe, 0x50, 0x1e, 0x34, 0xfe, 0x58, 0x1e, 0x38, 0xfe, 0x60, 0x1e,
+    0x3c, 0xfe, 0x68, 0x1e, 0x40, 0xfe, 0x70, 0x1e, 0x44, 0xfe, 0x78, 0x1e,
+    0x48, 0xff, 0x80, 0x1e, 0x4c, 0xff, 0xfe, 0x88, 0x1e, 0x50, 0xfe, 0x90,
+    0x1e, 0x54, 0xfe, 0x98, 0x1e, 0x58, 0xfe, 0xa0, 0x1e, 0x5c, 0xfe, 0xa8,
+    0x1e, 0x60, 0xfe, 0xb0, 0x1e, 0x64, 0xfe, 0xb8, 0x1e, 0x68, 0xfe, 0xc0,
+    0x1e, 0x6c, 0xfe, 0xc8, 0x1e, 0x70, 0xfe, 0xd0, 0x1e, 0x74, 0xfe, 0xd8,
+    0x1e, 0x78, 0xfe, 0xe0, 0x1e, 0x7c, 0xfe, 0xe8, 0x1e, 0x80, 0xfe, 0xf0,
+    0x1e, 0x84, 0xfe, 0xf8, 0x1e, 0x88, 0xff, 0x00, 0x28, 0x10, 0x00, 0xfe,
+    0x08, 0x28, 0x14, 0xfe, 0x10, 0x28, 0x18, 0xfe, 0x18, 0x28, 0x1c, 0xfe,
+    0x20, 0x28, 0x20, 0xfe, 0x28, 0x28, 0x24, 0xfe, 0x30, 0x28, 0x28, 0xfe,
+    0x38, 0x28, 0x2c, 0xff, 0x40, 0x28, 0x30, 0x80, 0xfe, 0x48, 0x28, 0x34,
+    0xfe, 0x50, 0x28, 0x38, 0xfe, 0x58, 0x28, 0x3c, 0xfe, 0x60, 0x28, 0x40,
+    0xfe, 0x68, 0x28, 0x44, 0xfe, 0x70, 0x28, 0x48, 0xfe, 0x78, 0x28, 0x4c,
+    0xff, 0x80, 0x28, 0x50, 0xff, 0xfe, 0x88, 0x28, 0x54, 0xfe, 0x90, 0x28,
+    0x58, 0xfe, 0x98, 0x28, 0x5c, 0xfe, 0xa0, 0x28, 0x60, 0xfe, 0xa8, 0x28,
+    0x64, 0xfe, 0xb0, 0x28, 0x68, 0xfe, 0xb8, 0x28, 0x6c, 0xfe, 0xc0, 0x28,
+    0x70, 0xfe, 0xc8, 0x28, 0x74, 0xfe, 0xd0, 0x28, 0x78, 0xfe, 0xd8, 0x28,
+    0x7c, 0xfe, 0xe0, 0x28, 0x80, 0xfe, 0xe8, 0x28, 0x84, 0xfe, 0xf0, 0x28,
+    0x88, 0xfe, 0xf8, 0x28, 0x8c, 0xff, 0x00, 0x32, 0x14, 0x00, 0xfe, 0x08,
+    0x32, 0x18, 0xfe, 0x10, 0x32, 0x1c, 0xfe, 0x18, 0x32, 0x20, 0xfe, 0x20,
+    0x32, 0x24, 0xfe, 0x28, 0x32, 0x28, 0xfe, 0x30, 0x32, 0x2c, 0xfe, 0x38,
+    0x32, 0x30, 0xff, 0x40, 0x32, 0x34, 0x80, 0xfe, 0x48, 0x32, 0x38, 0xfe,
+    0x50, 0x32, 0x3c, 0xfe, 0x58, 0x32, 0x40, 0xfe, 0x60, 0x32, 0x44, 0xfe,
+    0x68, 0x32, 0x48, 0xfe, 0x70, 0x32, 0x4c, 0xfe, 0x78, 0x32, 0x50, 0xff,
+    0x80, 0x32, 0x54, 0xff, 0xfe, 0x88, 0x32, 0x58, 0xfe, 0x90, 0x32, 0x5c,
+    0xfe, 0x98, 0x32, 0x60, 0xfe, 0xa0, 0x32, 0x64, 0xfe, 0xa8, 0x32, 0x68,
+    0xfe, 0xb0, 0x32, 0x6c, 0xfe, 0xb8, 0x32, 0x70, 0xfe, 0xc0, 0x32, 0x74,
+    0xfe, 0xc8, 0x32, 0x78, 0xfe, 0xd0, 0x32, 0x7c, 0xfe, 0xd8, 0x32, 0x80,
+    0xfe, 0xe0, 0x32, 0x84, 0xfe, 0xe8, 0x32, 0x88, 0xfe, 0xf0, 0x32, 0x8c,
+    0xfe, 0xf8, 0x32, 0x90, 0xff, 0x00, 0x3c, 0x18, 0x00, 0xfe, 0x08, 0x3c,
+    0x1c, 0xfe, 0x10, 0x3c, 0x20, 0xfe, 0x18, 0x3c, 0x24, 0xfe, 0x20, 0x3c,
+    0x28, 0xfe, 0x28, 0x3c, 0x2c, 0xfe, 0x30, 0x3c, 0x30, 0xfe, 0x38, 0x3c,
+    0x34, 0xff, 0x40, 0x3c, 0x38, 0x80, 0xfe, 0x48, 0x3c, 0x3c, 0xfe, 0x50,
+    0x3c, 0x40, 0xfe, 0x58, 0x3c, 0x44, 0xfe, 0x60, 0x3c, 0x48, 0xfe, 0x68,
+    0x3c, 0x4c, 0xfe, 0x70, 0x3c, 0x50, 0xfe, 0x78, 0x3c, 0x54, 0xff, 0x80,
+    0x3c, 0x58, 0xff, 0xfe, 0x88, 0x3c, 0x5c, 0xfe, 0x90, 0x3c, 0x60, 0xfe,
+    0x98, 0x3c, 0x64, 0xfe, 0xa0, 0x3c, 0x68, 0xfe, 0xa8, 0x3c, 0x6c, 0xfe,
+    0xb0, 0x3c, 0x70, 0xfe, 0xb8, 0x3c, 0x74, 0xfe, 0xc0, 0x3c, 0x78, 0xfe,
+    0xc8, 0x3c, 0x7c, 0xfe, 0xd0, 0x3c, 0x80, 0xfe, 0xd8, 0x3c, 0x84, 0xfe,
+    0xe0, 0x3c, 0x88, 0xfe, 0xe8, 0x3c, 0x8c, 0xfe, 0xf0, 0x3c, 0x90, 0xfe,
+    0xf8, 0x3c, 0x94, 0xff, 0x00, 0x46, 0x1c, 0x00, 0xfe, 0x08, 0x46, 0x20,
+    0xfe, 0x10, 0x46, 0x24, 0xfe, 0x18, 0x46, 0x28, 0xfe, 0x20, 0x46, 0x2c,
+    0xfe, 0x28, 0x46, 0x30, 0xfe, 0x30, 0x46, 0x34, 0xfe, 0x38, 0x46, 0x38,
+    0xff, 0x40, 0x46, 0x3c, 0x80, 0xfe, 0x48, 0x46, 0x40, 0xfe, 0x50, 0x46,
+    0x44, 0xfe, 0x58, 0x46, 0x48, 0xfe, 0x60, 0x46, 0x4c, 0xfe, 0x68, 0x46,
+    0x50, 0xfe, 0x70, 0x46, 0x54, 0xfe, 0x78, 0x46, 0x58, 0xff, 0x80, 0x46,
+    0x5c, 0xff, 0xfe, 0x88, 0x46, 0x60, 0xfe, 0x90, 0x46, 0x64, 0xfe, 0x98,
+    0x46, 0x68, 0xfe, 0xa0, 0x46, 0x6c, 0xfe, 0xa8, 0x46, 0x70, 0xfe, 0xb0,
+    0x46, 0x74, 0xfe, 0xb8, 0x46, 0x78, 0xfe, 0xc0, 0x46, 0x7c, 0xfe, 0xc8,
+    0x46, 0x80, 0xfe, 0xd0, 0x46, 0x84, 0xfe, 0xd8, 0x46, 0x88, 0xfe, 0xe0,
+    0x46, 0x8c, 0xfe, 0xe8, 0x46, 0x90, 0xfe, 0xf0, 0x46, 0x94, 0xfe, 0xf8,
+    0x46, 0x98, 0xff, 0x00, 0x50, 0x20, 0x00, 0xfe, 0x08, 0x50, 0x24, 0xfe,
+    0x10, 0x50, 0x28, 0xfe, 0x18, 0x50, 0x2c, 0xfe, 0x20, 0x50, 0x30, 0xfe,
+    0x28, 0x50, 0x34, 0xfe, 0x30, 0x50, 0x38, 0xfe, 0x38, 0x50, 0x3c, 0xff,
+    0x40, 0x50, 0x40, 0x80, 0xfe, 0x48, 0x50, 0x44, 0xfe, 0x50, 0x50, 0x48,
+    0xfe, 0x58, 0x50, 0x4c, 0xfe, 0x60, 0x50, 0x50, 0xfe, 0x68, 0x50, 0x54,
+    0xfe, 0x70, 0x50, 0x58, 0xfe, 0x78, 0x50, 0x5c, 0xff, 0x80, 0x50, 0x60,
+    0xff, 0xfe, 0x88, 0x50, 0x64, 0xfe, 0x90, 0x50, 0x68, 0xfe, 0x98, 0x50,
+    0x6c, 0xfe, 0xa0, 0x50, 0x70, 0xfe, 0xa8, 0x50, 0x74, 0xfe, 0xb0, 0x50,
+    0x78, 0xfe, 0xb8, 0x50, 0x7c, 0xfe, 0xc0, 0x50, 0x80, 0xfe, 0xc8, 0x50,
+    0x84, 0xfe, 0xd0, 0x50, 0x88, 0xfe, 0xd8, 0x50, 0x8c, 0xfe, 0xe0, 0x50,
+    0x90, 0xfe, 0xe8, 0x50, 0x94, 0xfe, 0xf0, 0x50, 0x98, 0xfe, 0xf8, 0x50,
+    0x9c, 0xff, 0x00, 0x5a, 0x24, 0x00, 0xfe, 0x08, 0x5a, 0x28, 0xfe, 0x10,
+    0x5a, 0x2c, 0xfe, 0x18, 0x5a, 0x30, 0xfe, 0x20, 0x5a, 0x34, 0xfe, 0x28,
+    0x5a, 0x38, 0xfe, 0x30, 0x5a, 0x3c, 0xfe, 0x38, 0x5a, 0x40, 0xff, 0x40,
+    0x5a, 0x44, 0x80, 0xfe, 0x48, 0x5a, 0x48, 0xfe, 0x50, 0x5a, 0x4c, 0xfe,
+    0x58, 0x5a, 0x50, 0xfe, 0x60, 0x5a, 0x54, 0xfe, 0x68, 0x5a, 0x58, 0xfe,
+    0x70, 0x5a, 0x5c, 0xfe, 0x78, 0x5a, 0x60, 0xff, 0x80, 0x5a, 0x64, 0xff,
+    0xfe, 0x88, 0x5a, 0x68, 0xfe, 0x90, 0x5a, 0x6c, 0xfe, 0x98, 0x5a, 0x70,
+    0xfe, 0xa0, 0x5a, 0x74, 0xfe, 0xa8, 0x5a, 0x78, 0xfe, 0xb0, 0x5a, 0x7c,
+    0xfe, 0xb8, 0x5a, 0x80, 0xfe, 0xc0, 0x5a, 0x84, 0xfe, 0xc8, 0x5a, 0x88,
+    0xfe, 0xd0, 0x5a, 0x8c, 0xfe, 0xd8, 0x5a, 0x90, 0xfe, 0xe0, 0x5a, 0x94,
+    0xfe, 0xe8, 0x5a, 0x98, 0xfe, 0xf0, 0x5a, 0x9c, 0xfe, 0xf8, 0x5a, 0xa0,
+    0xff, 0x00, 0x64, 0x28, 0x00, 0xfe, 0x08, 0x64, 0x2c, 0xfe, 0x10, 0x64,
+    0x30, 0xfe, 0x18, 0x64, 0x34, 0xfe, 0x20, 0x64, 0x38, 0xfe, 0x28, 0x64,
+    0x3c, 0xfe, 0x30, 0x64, 0x40, 0xfe, 0x38, 0x64, 0x44, 0xff, 0x40, 0x64,
+    0x48, 0x80, 0xfe, 0x48, 0x64, 0x4c, 0xfe, 0x50, 0x64, 0x50, 0xfe, 0x58,
+    0x64, 0x54, 0xfe, 0x60, 0x64, 0x58, 0xfe, 0x68, 0x64, 0x5c, 0xfe, 0x70,
+    0x64, 0x60, 0xfe, 0x78, 0x64, 0x64, 0xff, 0x80, 0x64, 0x68, 0xff, 0xfe,
+    0x88, 0x64, 0x6c, 0xfe, 0x90, 0x64, 0x70, 0xfe, 0x98, 0x64, 0x74, 0xfe,
+    0xa0, 0x64, 0x78, 0xfe, 0xa8, 0x64, 0x7c, 0xfe, 0xb0, 0x64, 0x80, 0xfe,
+    0xb8, 0x64, 0x84, 0xfe, 0xc0, 0x64, 0x88, 0xfe, 0xc8, 0x64, 0x8c, 0xfe,
+    0xd0, 0x64, 0x90, 0xfe, 0xd8, 0x64, 0x94, 0xfe, 0xe0, 0x64, 0x98, 0xfe,
+    0xe8, 0x64, 0x9c, 0xfe, 0xf0, 0x64, 0xa0, 0xfe, 0xf8, 0x64, 0xa4, 0xff,
+    0x00, 0x6e, 0x2c, 0x00, 0xfe, 0x08, 0x6e, 0x30, 0xfe, 0x10, 0x6e, 0x34,
+    0xfe, 0x18, 0x6e, 0x38, 0xfe, 0x20, 0x6e, 0x3c, 0xfe, 0x28, 0x6e, 0x40,
+    0xfe, 0x30, 0x6e, 0x44, 0xfe, 0x38, 0x6e, 0x48, 0xff, 0x40, 0x6e, 0x4c,
+    0x80, 0xfe, 0x48, 0x6e, 0x50, 0xfe, 0x50, 0x6e, 0x54, 0xfe, 0x58, 0x6e,
+    0x58, 0xfe, 0x60, 0x6e, 0x5c, 0xfe, 0x68, 0x6e, 0x60, 0xfe, 0x70, 0x6e,
+    0x64, 0xfe, 0x78, 0x6e, 0x68, 0xff, 0x80, 0x6e, 0x6c, 0xff, 0xfe, 0x88,
+    0x6e, 0x70, 0xfe, 0x90, 0x6e, 0x74, 0xfe, 0x98, 0x6e, 0x78, 0xfe, 0xa0,
+    0x6e, 0x7c, 0xfe, 0xa8, 0x6e, 0x80, 0xfe, 0xb0, 0x6e, 0x84, 0xfe, 0xb8,
+    0x6e, 0x88, 0xfe, 0xc0, 0x6e, 0x8c, 0xfe, 0xc8, 0x6e, 0x90, 0xfe, 0xd0,
+    0x6e, 0x94, 0xfe, 0xd8, 0x6e, 0x98, 0xfe, 0xe0, 0x6e, 0x9c, 0xfe, 0xe8,
+    0x6e, 0xa0, 0xfe, 0xf0, 0x6e, 0xa4, 0xfe, 0xf8, 0x6e, 0xa8, 0xff, 0x00,
+    0x78, 0x30, 0x00, 0xfe, 0x08, 0x78, 0x34, 0xfe, 0x10, 0x78, 0x38, 0xfe,
+    0x18, 0x78, 0x3c, 0xfe, 0x20, 0x78, 0x40, 0xfe, 0x28, 0x78, 0x44, 0xfe,
+    0x30, 0x78, 0x48, 0xfe, 0x38, 0x78, 0x4c, 0xff, 0x40, 0x78, 0x50, 0x80,
+    0xfe, 0x48, 0x78, 0x54, 0xfe, 0x50, 0x78, 0x58, 0xfe, 0x58, 0x78, 0x5c,
+    0xfe, 0x60, 0x78, 0x60, 0xfe, 0x68, 0x78, 0x64, 0xfe, 0x70, 0x78, 0x68,
+    0xfe, 0x78, 0x78, 0x6c, 0xff, 0x80, 0x78, 0x70, 0xff, 0xfe, 0x88, 0x78,
+    0x74, 0xfe, 0x90, 0x78, 0x78, 0xfe, 0x98, 0x78, 0x7c, 0xfe, 0xa0, 0x78,
+    0x80, 0xfe, 0xa8, 0x78, 0x84, 0xfe, 0xb0, 0x78, 0x88, 0xfe, 0xb8, 0x78,
+    0x8c, 0xfe, 0xc0, 0x78, 0x90, 0xfe, 0xc8, 0x78, 0x94, 0xfe, 0xd0, 0x78,
+    0x98, 0xfe, 0xd8, 0x78, 0x9c, 0xfe, 0xe0, 0x78, 0xa0, 0xfe, 0xe8, 0x78,
+    0xa4, 0xfe, 0xf0, 0x78, 0xa8, 0xfe, 0xf8, 0x78, 0xac, 0xff, 0x00, 0x82,
+    0x34, 0x00, 0xfe, 0x08, 0x82, 0x38, 0xfe, 0x10, 0x82, 0x3c, 0xfe, 0x18,
+    0x82, 0x40, 0xfe, 0x20, 0x82, 0x44, 0xfe, 0x28, 0x82, 0x48, 0xfe, 0x30,
+    0x82, 0x4c, 0xfe, 0x38, 0x82, 0x50, 0xff, 0x40, 0x82, 0x54, 0x80, 0xfe,
+    0x48, 0x82, 0x58, 0xfe, 0x50, 0x82, 0x5c, 0xfe, 0x58, 0x82, 0x60, 0xfe,
+    0x60, 0x82, 0x64, 0xfe, 0x68, 0x82, 0x68, 0xfe, 0x70, 0x82, 0x6c, 0xfe,
+    0x78, 0x82, 0x70, 0xff, 0x80, 0x82, 0x74, 0xff, 0xfe, 0x88, 0x82, 0x78,
+    0xfe, 0x90, 0x82, 0x7c, 0xfe, 0x98, 0x82, 0x80, 0xfe, 0xa0, 0x82, 0x84,
+    0xfe, 0xa8, 0x82, 0x88, 0xfe, 0xb0, 0x82, 0x8c, 0xfe, 0xb8, 0x82, 0x90,
+    0xfe, 0xc0, 0x82, 0x94, 0xfe, 0xc8, 0x82, 0x98, 0xfe, 0xd0, 0x82, 0x9c,
+    0xfe, 0xd8, 0x82, 0xa0, 0xfe, 0xe0, 0x82, 0xa4, 0xfe, 0xe8, 0x82, 0xa8,
+    0xfe, 0xf0, 0x82, 0xac, 0xfe, 0xf8, 0x82, 0xb0, 0xff, 0x00, 0x8c, 0x38,
+    0x00, 0xfe, 0x08, 0x8c, 0x3c, 0xfe, 0x10, 0x8c, 0x40, 0xfe, 0x18, 0x8c,
+    0x44, 0xfe, 0x20, 0x8c, 0x48, 0xfe, 0x28, 0x8c, 0x4c, 0xfe, 0x30, 0x8c,
+    0x50, 0xfe, 0x38, 0x8c, 0x54, 0xff, 0x40, 0x8c, 0x58, 0x80, 0xfe, 0x48,
+    0x8c, 0x5c, 0xfe, 0x50, 0x8c, 0x60, 0xfe, 0x58, 0x8c, 0x64, 0xfe, 0x60,
+    0x8c, 0x68, 0xfe, 0x68, 0x8c, 0x6c, 0xfe, 0x70, 0x8c, 0x70, 0xfe, 0x78,
+    0x8c, 0x74, 0xff, 0x80, 0x8c, 0x78, 0xff, 0xfe, 0x88, 0x8c, 0x7c, 0xfe,
+    0x90, 0x8c, 0x80, 0xfe, 0x98, 0x8c, 0x84, 0xfe, 0xa0, 0x8c, 0x88, 0xfe,
+    0xa8, 0x8c, 0x8c, 0xfe, 0xb0, 0x8c, 0x90, 0xfe, 0xb8, 0x8c, 0x94, 0xfe,
+    0xc0, 0x8c, 0x98, 0xfe, 0xc8, 0x8c, 0x9c, 0xfe, 0xd0, 0x8c, 0xa0, 0xfe,
+    0xd8, 0x8c, 0xa4, 0xfe, 0xe0, 0x8c, 0xa8, 0xfe, 0xe8, 0x8c, 0xac, 0xfe,
+    0xf0, 0x8c, 0xb0, 0xfe, 0xf8, 0x8c, 0xb4, 0xff, 0x00, 0x96, 0x3c, 0x00,
+    0xfe, 0x08, 0x96, 0x40, 0xfe, 0x10, 0x96, 0x44, 0xfe, 0x18, 0x96, 0x48,
+    0xfe, 0x20, 0x96, 0x4c, 0xfe, 0x28, 0x96, 0x50, 0xfe, 0x30, 0x96, 0x54,
+    0xfe, 0x38, 0x96, 0x58, 0xff, 0x40, 0x96, 0x5c, 0x80, 0xfe, 0x48, 0x96,
+    0x60, 0xfe, 0x50, 0x96, 0x64, 0xfe, 0x58, 0x96, 0x68, 0xfe, 0x60, 0x96,
+    0x6c, 0xfe, 0x68, 0x96, 0x70, 0xfe, 0x70, 0x96, 0x74, 0xfe, 0x78, 0x96,
+    0x78, 0xff, 0x80, 0x96, 0x7c, 0xff, 0xfe, 0x88, 0x96, 0x80, 0xfe, 0x90,
+    0x96, 0x84, 0xfe, 0x98, 0x96, 0x88, 0xfe, 0xa0, 0x96, 0x8c, 0xfe, 0xa8,
+    0x96, 0x90, 0xfe, 0xb0, 0x96, 0x94, 0xfe, 0xb8, 0x96, 0x98, 0xfe, 0xc0,
+    0x96, 0x9c, 0xfe, 0xc8, 0x96, 0xa0, 0xfe, 0xd0, 0x96, 0xa4, 0xfe, 0xd8,
+    0x96, 0xa8, 0xfe, 0xe0, 0x96, 0xac, 0xfe, 0xe8, 0x96, 0xb0, 0xfe, 0xf0,
+    0x96, 0xb4, 0xfe, 0xf8, 0x96, 0xb8, 0xff, 0x00, 0xa0, 0x40, 0x00, 0xfe,
+    0x08, 0xa0, 0x44, 0xfe, 0x10, 0xa0, 0x48, 0xfe, 0x18, 0xa0, 0x4c, 0xfe,
+    0x20, 0xa0, 0x50, 0xfe, 0x28, 0xa0, 0x54, 0xfe, 0x30, 0xa0, 0x58, 0xfe,
+    0x38, 0xa0, 0x5c, 0xff, 0x40, 0xa0, 0x60, 0x80, 0xfe, 0x48, 0xa0, 0x64,
+    0xfe, 0x50, 0xa0, 0x68, 0xfe, 0x58, 0xa0, 0x6c, 0xfe, 0x60, 0xa0, 0x70,
+    0xfe, 0x68, 0xa0, 0x74, 0xfe, 0x70, 0xa0, 0x78, 0xfe, 0x78, 0xa0, 0x7c,
+    0xff, 0x80, 0xa0, 0x80, 0xff, 0xfe, 0x88, 0xa0, 0x84, 0xfe, 0x90, 0xa0,
+    0x88, 0xfe, 0x98, 0xa0, 0x8c, 0xfe, 0xa0, 0xa0, 0x90, 0xfe, 0xa8, 0xa0,
+    0x94, 0xfe, 0xb0, 0xa0, 0x98, 0xfe, 0xb8, 0xa0, 0x9c, 0xfe, 0xc0, 0xa0,
+    0xa0, 0xfe, 0xc8, 0xa0, 0xa4, 0xfe, 0xd0, 0xa0, 0xa8, 0xfe, 0xd8, 0xa0,
+    0xac, 0xfe, 0xe0, 0xa0, 0xb0, 0xfe, 0xe8, 0xa0, 0xb4, 0xfe, 0xf0, 0xa0,
+    0xb8, 0xfe, 0xf8, 0xa0, 0xbc, 0xff, 0x00, 0xaa, 0x44, 0x00, 0xfe, 0x08,
+    0xaa, 0x48, 0xfe, 0x10, 0xaa, 0x4c, 0xfe, 0x18, 0xaa, 0x50, 0xfe, 0x20,
+    0xaa, 0x54, 0xfe, 0x28, 0xaa, 0x58, 0xfe, 0x30, 0xaa, 0x5c, 0xfe, 0x38,
+    0xaa, 0x60, 0xff, 0x40, 0xaa, 0x64, 0x80, 0xfe, 0x48, 0xaa, 0x68, 0xfe,
+    0x50, 0xaa, 0x6c, 0xfe, 0x58, 0xaa, 0x70, 0xfe, 0x60, 0xaa, 0x74, 0xfe,
+    0x68, 0xaa, 0x78, 0xfe, 0x70, 0xaa, 0x7c, 0xfe, 0x78, 0xaa, 0x80, 0xff,
+    0x80, 0xaa, 0x84, 0xff, 0xfe, 0x88, 0xaa, 0x88, 0xfe, 0x90, 0xaa, 0x8c,
+    0xfe, 0x98, 0xaa, 0x90, 0xfe, 0xa0, 0xaa, 0x94, 0xfe, 0xa8, 0xaa, 0x98,
+    0xfe, 0xb0, 0xaa, 0x9c, 0xfe, 0xb8, 0xaa, 0xa0, 0xfe, 0xc0, 0xaa, 0xa4,
+    0xfe, 0xc8, 0xaa, 0xa8, 0xfe, 0xd0, 0xaa, 0xac, 0xfe, 0xd8, 0xaa, 0xb0,
+    0xfe, 0xe0, 0xaa, 0xb4, 0xfe, 0xe8, 0xaa, 0xb8, 0xfe, 0xf0, 0xaa, 0xbc,
+    0xfe, 0xf8, 0xaa, 0xc0, 0xff, 0x00, 0xb4, 0x48, 0x00, 0xfe, 0x08, 0xb4,
+    0x4c, 0xfe, 0x10, 0xb4, 0x50, 0xfe, 0x18, 0xb4, 0x54, 0xfe, 0x20, 0xb4,
+    0x58, 0xfe, 0x28, 0xb4, 0x5c, 0xfe, 0x30, 0xb4, 0x60, 0xfe, 0x38, 0xb4,
+    0x64, 0xff, 0x40, 0xb4, 0x68, 0x80, 0xfe, 0x48, 0xb4, 0x6c, 0xfe, 0x50,
+    0xb4, 0x70, 0xfe, 0x58, 0xb4, 0x74, 0xfe, 0x60, 0xb4, 0x78, 0xfe, 0x68,
+    0xb4, 0x7c, 0xfe, 0x70, 0xb4, 0x80, 0xfe, 0x78, 0xb4, 0x84, 0xff, 0x80,
+    0xb4, 0x88, 0xff, 0xfe, 0x88, 0xb4, 0x8c, 0xfe, 0x90, 0xb4, 0x90, 0xfe,
+    0x98, 0xb4, 0x94, 0xfe, 0xa0, 0xb4, 0x98, 0xfe, 0xa8, 0xb4, 0x9c, 0xfe,
+    0xb0, 0xb4, 0xa0, 0xfe, 0xb8, 0xb4, 0xa4, 0xfe, 0xc0, 0xb4, 0xa8, 0xfe,
+    0xc8, 0xb4, 0xac, 0xfe, 0xd0, 0xb4, 0xb0, 0xfe, 0xd8, 0xb4, 0xb4, 0xfe,
+    0xe0, 0xb4, 0xb8, 0xfe, 0xe8, 0xb4, 0xbc, 0xfe, 0xf0, 0xb4, 0xc0, 0xfe,
+    0xf8, 0xb4, 0xc4, 0xff, 0x00, 0xbe, 0x4c, 0x00, 0xfe, 0x08, 0xbe, 0x50,
+    0xfe, 0x10, 0xbe, 0x54, 0xfe, 0x18, 0xbe, 0x58, 0xfe, 0x20, 0xbe, 0x5c,
+    0xfe, 0x28, 0xbe, 0x60, 0xfe, 0x30, 0xbe, 0x64, 0xfe, 0x38, 0xbe, 0x68,
+    0xff, 0x40, 0xbe, 0x6c, 0x80, 0xfe, 0x48, 0xbe, 0x70, 0xfe, 0x50, 0xbe,
+    0x74, 0xfe, 0x58, 0xbe, 0x78, 0xfe, 0x60, 0xbe, 0x7c, 0xfe, 0x68, 0xbe,
+    0x80, 0xfe, 0x70, 0xbe, 0x84, 0xfe, 0x78, 0xbe, 0x88, 0xff, 0x80, 0xbe,
+    0x8c, 0xff, 0xfe, 0x88, 0xbe, 0x90, 0xfe, 0x90, 0xbe, 0x94, 0xfe, 0x98,
+    0xbe, 0x98, 0xfe, 0xa0, 0xbe, 0x9c, 0xfe, 0xa8, 0xbe, 0xa0, 0xfe, 0xb0,
+    0xbe, 0xa4, 0xfe, 0xb8, 0xbe, 0xa8, 0xfe, 0xc0, 0xbe, 0xac, 0xfe, 0xc8,
+    0xbe, 0xb0, 0xfe, 0xd0, 0xbe, 0xb4, 0xfe, 0xd8, 0xbe, 0xb8, 0xfe, 0xe0,
+    0xbe, 0xbc, 0xfe, 0xe8, 0xbe, 0xc0, 0xfe, 0xf0, 0xbe, 0xc4, 0xfe, 0xf8,
+    0xbe, 0xc8, 0xff, 0x00, 0xc8, 0x50, 0x00, 0xfe, 0x08, 0xc8, 0x54, 0xfe,
+    0x10, 0xc8, 0x58, 0xfe, 0x18, 0xc8, 0x5c, 0xfe, 0x20, 0xc8, 0x60, 0xfe,
+    0x28, 0xc8, 0x64, 0xfe, 0x30, 0xc8, 0x68, 0xfe, 0x38, 0xc8, 0x6c, 0xff,
+    0x40, 0xc8, 0x70, 0x80, 0xfe, 0x48, 0xc8, 0x74, 0xfe, 0x50, 0xc8, 0x78,
+    0xfe, 0x58, 0xc8, 0x7c, 0xfe, 0x60, 0xc8, 0x80, 0xfe, 0x68, 0xc8, 0x84,
+    0xfe, 0x70, 0xc8, 0x88, 0xfe, 0x78, 0xc8, 0x8c, 0xff, 0x80, 0xc8, 0x90,
+    0xff, 0xfe, 0x88, 0xc8, 0x94, 0xfe, 0x90, 0xc8, 0x98, 0xfe, 0x98, 0xc8,
+    0x9c, 0xfe, 0xa0, 0xc8, 0xa0, 0xfe, 0xa8, 0xc8, 0xa4, 0xfe, 0xb0, 0xc8,
+    0xa8, 0xfe, 0xb8, 0xc8, 0xac, 0xfe, 0xc0, 0xc8, 0xb0, 0xfe, 0xc8, 0xc8,
+    0xb4, 0xfe, 0xd0, 0xc8, 0xb8, 0xfe, 0xd8, 0xc8, 0xbc, 0xfe, 0xe0, 0xc8,
+    0xc0, 0xfe, 0xe8, 0xc8, 0xc4, 0xfe, 0xf0, 0xc8, 0xc8, 0xfe, 0xf8, 0xc8,
+    0xcc, 0xff, 0x00, 0xd2, 0x54, 0x00, 0xfe, 0x08, 0xd2, 0x58, 0xfe, 0x10,
+    0xd2, 0x5c, 0xfe, 0x18, 0xd2, 0x60, 0xfe, 0x20, 0xd2, 0x64, 0xfe, 0x28,
+    0xd2, 0x68, 0xfe, 0x30, 0xd2, 0x6c, 0xfe, 0x38, 0xd2, 0x70, 0xff, 0x40,
+    0xd2, 0x74, 0x80, 0xfe, 0x48, 0xd2, 0x78, 0xfe, 0x50, 0xd2, 0x7c, 0xfe,
+    0x58, 0xd2, 0x80, 0xfe, 0x60, 0xd2, 0x84, 0xfe, 0x68, 0xd2, 0x88, 0xfe,
+    0x70, 0xd2, 0x8c, 0xfe, 0x78, 0xd2, 0x90, 0xff, 0x80, 0xd2, 0x94, 0xff,
+    0xfe, 0x88, 0xd2, 0x98, 0xfe, 0x90, 0xd2, 0x9c, 0xfe, 0x98, 0xd2, 0xa0,
+    0xfe, 0xa0, 0xd2, 0xa4, 0xfe, 0xa8, 0xd2, 0xa8, 0xfe, 0xb0, 0xd2, 0xac,
+    0xfe, 0xb8, 0xd2, 0xb0, 0xfe, 0xc0, 0xd2, 0xb4, 0xfe, 0xc8, 0xd2, 0xb8,
+    0xfe, 0xd0, 0xd2, 0xbc, 0xfe, 0xd8, 0xd2, 0xc0, 0xfe, 0xe0, 0xd2, 0xc4,
+    0xfe, 0xe8, 0xd2, 0xc8, 0xfe, 0xf0, 0xd2, 0xcc, 0xfe, 0xf8, 0xd2, 0xd0,
+    0xff, 0x00, 0xdc, 0x58, 0x00, 0xfe, 0x08, 0xdc, 0x5c, 0xfe, 0x10, 0xdc,
+    0x60, 0xfe, 0x18, 0xdc, 0x64, 0xfe, 0x20, 0xdc, 0x68, 0xfe, 0x28, 0xdc,
+    0x6c, 0xfe, 0x30, 0xdc, 0x70, 0xfe, 0x38, 0xdc, 0x74, 0xff, 0x40, 0xdc,
+    0x78, 0x80, 0xfe, 0x48, 0xdc, 0x7c, 0xfe, 0x50, 0xdc, 0x80, 0xfe, 0x58,
+    0xdc, 0x84, 0xfe, 0x60, 0xdc, 0x88, 0xfe, 0x68, 0xdc, 0x8c, 0xfe, 0x70,
+    0xdc, 0x90, 0xfe, 0x78, 0xdc, 0x94, 0xff, 0x80, 0xdc, 0x98, 0xff, 0xfe,
+    0x88, 0xdc, 0x9c, 0xfe, 0x90, 0xdc, 0xa0, 0xfe, 0x98, 0xdc, 0xa4, 0xfe,
+    0xa0, 0xdc, 0xa8, 0xfe, 0xa8, 0xdc, 0xac, 0xfe, 0xb0, 0xdc, 0xb0, 0xfe,
+    0xb8, 0xdc, 0xb4, 0xfe, 0xc0, 0xdc, 0xb8, 0xfe, 0xc8, 0xdc, 0xbc, 0xfe,
+    0xd0, 0xdc, 0xc0, 0xfe, 0xd8, 0xdc, 0xc4, 0xfe, 0xe0, 0xdc, 0xc8, 0xfe,
+    0xe8, 0xdc, 0xcc, 0xfe, 0xf0, 0xdc, 0xd0, 0xfe, 0xf8, 0xdc, 0xd4, 0xff,
+    0x00, 0xe6, 0x5c, 0x00, 0xfe, 0x08, 0xe6, 0x60, 0xfe, 0x10, 0xe6, 0x64,
+    0xfe, 0x18, 0xe6, 0x68, 0xfe, 0x20, 0xe6, 0x6c, 0xfe, 0x28, 0xe6, 0x70,
+    0xfe, 0x30, 0xe6, 0x74, 0xfe, 0x38, 0xe6, 0x78, 0xff, 0x40, 0xe6, 0x7c,
+    0x80, 0xfe, 0x48, 0xe6, 0x80, 0xfe, 0x50, 0xe6, 0x84, 0xfe, 0x58, 0xe6,
+    0x88, 0xfe, 0x60, 0xe6, 0x8c, 0xfe, 0x68, 0xe6, 0x90, 0xfe, 0x70, 0xe6,
+    0x94, 0xfe, 0x78, 0xe6, 0x98, 0xff, 0x80, 0xe6, 0x9c, 0xff, 0xfe, 0x88,
+    0xe6, 0xa0, 0xfe, 0x90, 0xe6, 0xa4, 0xfe, 0x98, 0xe6, 0xa8, 0xfe, 0xa0,
+    0xe6, 0xac, 0xfe, 0xa8, 0xe6, 0xb0, 0xfe, 0xb0, 0xe6, 0xb4, 0xfe, 0xb8,
+    0xe6, 0xb8, 0xfe, 0xc0, 0xe6, 0xbc, 0xfe, 0xc8, 0xe6, 0xc0, 0xfe, 0xd0,
+    0xe6, 0xc4, 0xfe, 0xd8, 0xe6, 0xc8, 0xfe, 0xe0, 0xe6, 0xcc, 0xfe, 0xe8,
+    0xe6, 0xd0, 0xfe, 0xf0, 0xe6, 0xd4, 0xfe, 0xf8, 0xe6, 0xd8, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+};
+// clang-format on
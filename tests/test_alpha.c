@@ -0,0 +1,298 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crc32.h"
+#include "greatest.h"
+#include "hagl/bitmap.h"
+#include "hagl/circle.h"
+#include "hagl/clip.h"
+#include "hagl/color.h"
+#include "hagl/hline.h"
+#include "hagl/pixel.h"
+#include "hagl/polygon.h"
+#include "hagl/rectangle.h"
+#include "save_image.h"
+
+#define TEST_WIDTH 320
+#define TEST_HEIGHT 240
+#define TEST_DEPTH 16
+
+static hagl_bitmap_t bitmap;
+static uint8_t buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+static uint8_t background[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+
+static void setup_callback(void *data) {
+    srand(1);
+    for (size_t i = 0; i < sizeof(background); i++) {
+        background[i] = rand();
+    }
+    memcpy(buffer, background, sizeof(buffer));
+    hagl_bitmap_init(&bitmap, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, buffer);
+}
+
+static void teardown_callback(void *data) {
+    char filename[256];
+    snprintf(filename, sizeof(filename), "output/%s.png", greatest_info.name_buf);
+    save_image(&bitmap, filename);
+}
+
+static void clear_background(void) {
+    memset(background, 0, sizeof(background));
+    memset(buffer, 0, sizeof(buffer));
+}
+
+static hagl_color_t background_pixel(int16_t x, int16_t y) {
+    hagl_color_t color;
+    memcpy(&color, background + (y * TEST_WIDTH + x) * 2, 2);
+    return color;
+}
+
+/*
+ * Every pixel must be either untouched or blended exactly once. Returns
+ * number of blended pixels.
+ */
+static uint32_t count_blended(hagl_color_t color, uint8_t alpha, uint32_t *bad) {
+    uint32_t count = 0;
+    *bad = 0;
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            hagl_color_t before = background_pixel(x, y);
+            hagl_color_t after = hagl_get_pixel(&bitmap, x, y);
+            if (after == before) {
+                continue;
+            }
+            if (after == hagl_blend(&bitmap, color, before, alpha)) {
+                count++;
+            } else {
+                (*bad)++;
+            }
+        }
+    }
+    return count;
+}
+
+/* Odd and even start and width exercise both single pixels and pairs. */
+TEST test_hline_alpha_matches_blend(void) {
+    hagl_color_t color = hagl_color(&bitmap, 200, 100, 50);
+
+    for (int16_t x0 = 0; x0 < 4; x0++) {
+        for (uint16_t width = 0; width < 9; width++) {
+            int16_t y = x0 * 10 + width;
+            hagl_draw_hline_alpha(&bitmap, x0, y, width, color, 100);
+
+            for (int16_t x = 0; x < 16; x++) {
+                hagl_color_t expected = background_pixel(x, y);
+                if (x >= x0 && x < x0 + width) {
+                    expected = hagl_blend(&bitmap, color, expected, 100);
+                }
+                ASSERT_EQ(expected, hagl_get_pixel(&bitmap, x, y));
+            }
+        }
+    }
+
+    PASS();
+}
+
+TEST test_hline_alpha_without_callback(void) {
+    hagl_color_t color = hagl_color(&bitmap, 10, 220, 130);
+
+    for (int16_t y = 0; y < 64; y++) {
+        hagl_draw_hline_alpha(&bitmap, y - 8, y, y * 5, color, y * 4);
+    }
+    uint32_t fast = crc32(buffer, sizeof(buffer));
+
+    memcpy(buffer, background, sizeof(buffer));
+    bitmap.blend_hline = NULL;
+    for (int16_t y = 0; y < 64; y++) {
+        hagl_draw_hline_alpha(&bitmap, y - 8, y, y * 5, color, y * 4);
+    }
+
+    ASSERT_EQ(fast, crc32(buffer, sizeof(buffer)));
+
+    PASS();
+}
+
+TEST test_hline_alpha_opaque_and_transparent(void) {
+    hagl_draw_hline_alpha(&bitmap, 10, 10, 20, 0x1234, 255);
+    hagl_draw_hline_alpha(&bitmap, 10, 11, 20, 0x1234, 0);
+
+    for (int16_t x = 10; x < 30; x++) {
+        ASSERT_EQ(0x1234, hagl_get_pixel(&bitmap, x, 10));
+        ASSERT_EQ(background_pixel(x, 11), hagl_get_pixel(&bitmap, x, 11));
+    }
+
+    PASS();
+}
+
+TEST test_hline_alpha_clip(void) {
+    clear_background();
+    hagl_set_clip(&bitmap, 20, 20, 40, 40);
+
+    hagl_draw_hline_alpha(&bitmap, 0, 30, 100, 0xFFFF, 128);
+    hagl_draw_hline_alpha(&bitmap, 0, 10, 100, 0xFFFF, 128);
+
+    uint32_t bad;
+    ASSERT_EQ(21, count_blended(0xFFFF, 128, &bad));
+    ASSERT_EQ(0, bad);
+
+    PASS();
+}
+
+/* Bitmaps in the other RGB565 byte order are blended in their own order. */
+TEST test_hline_alpha_rgb565_format(void) {
+    static uint16_t pixels[8];
+    hagl_bitmap_t other;
+    uint8_t format = HAGL_FORMAT_RGB565;
+
+    if (HAGL_FORMAT_RGB565 == hagl_native_format(16)) {
+        format = HAGL_FORMAT_RGB565_SWAPPED;
+    }
+    hagl_bitmap_init_format(&other, 8, 1, format, pixels);
+    memset(pixels, 0, sizeof(pixels));
+
+    uint16_t red = 0xF800;
+    if (HAGL_FORMAT_RGB565_SWAPPED == format) {
+        red = 0x00F8;
+    }
+    hagl_draw_hline_alpha(&other, 1, 0, 6, red, 128);
+
+    for (uint8_t x = 1; x < 7; x++) {
+        uint16_t pixel = pixels[x];
+        if (HAGL_FORMAT_RGB565_SWAPPED == format) {
+            pixel = (pixel << 8) | (pixel >> 8);
+        }
+        ASSERT_EQ(15 << 11, pixel);
+    }
+    ASSERT_EQ(0, pixels[0]);
+    ASSERT_EQ(0, pixels[7]);
+
+    PASS();
+}
+
+TEST test_fill_rectangle_alpha(void) {
+    clear_background();
+    hagl_fill_rectangle_alpha(&bitmap, 30, 20, 10, 10, 0xF0F0, 77);
+
+    uint32_t bad;
+    ASSERT_EQ(21 * 11, count_blended(0xF0F0, 77, &bad));
+    ASSERT_EQ(0, bad);
+
+    PASS();
+}
+
+/* Translucent circle covers the same pixels as an opaque one, each once. */
+TEST test_fill_circle_alpha(void) {
+    static uint8_t opaque[sizeof(buffer)];
+
+    for (int16_t r = 0; r < 50; r += 7) {
+        memset(buffer, 0, sizeof(buffer));
+        hagl_fill_circle(&bitmap, 160, 120, r, 0xFFFF);
+        memcpy(opaque, buffer, sizeof(buffer));
+
+        memcpy(buffer, background, sizeof(buffer));
+        hagl_fill_circle_alpha(&bitmap, 160, 120, r, 0xFFFF, 100);
+
+        uint32_t bad;
+        uint32_t count = count_blended(0xFFFF, 100, &bad);
+        ASSERT_EQ(0, bad);
+
+        uint32_t expected = 0;
+        for (size_t i = 0; i < sizeof(opaque); i += 2) {
+            if (opaque[i]) {
+                uint16_t before, after;
+                memcpy(&before, background + i, 2);
+                memcpy(&after, buffer + i, 2);
+                /* Some colors do not change when blended. */
+                expected += (before != after);
+            } else {
+                ASSERT_MEM_EQ(background + i, buffer + i, 2);
+            }
+        }
+        ASSERT_EQ(expected, count);
+    }
+
+    PASS();
+}
+
+/* Horizontal edges overlap the spans between nodes. */
+TEST test_fill_polygon_alpha(void) {
+    static uint8_t opaque[sizeof(buffer)];
+    int16_t vertices[16] = {
+        10, 10, 60, 10, 60, 40, 40, 40, 40, 20, 30, 20, 30, 40, 10, 40
+    };
+
+    memset(buffer, 0, sizeof(buffer));
+    hagl_fill_polygon(&bitmap, 8, vertices, 0xFFFF);
+    memcpy(opaque, buffer, sizeof(buffer));
+
+    memcpy(buffer, background, sizeof(buffer));
+    hagl_fill_polygon_alpha(&bitmap, 8, vertices, 0xFFFF, 100);
+
+    uint32_t bad;
+    count_blended(0xFFFF, 100, &bad);
+    ASSERT_EQ(0, bad);
+
+    for (size_t i = 0; i < sizeof(opaque); i += 2) {
+        if (!opaque[i]) {
+            ASSERT_MEM_EQ(background + i, buffer + i, 2);
+        }
+    }
+
+    PASS();
+}
+
+SUITE(alpha_suite) {
+    SET_SETUP(setup_callback, NULL);
+    SET_TEARDOWN(teardown_callback, NULL);
+    RUN_TEST(test_hline_alpha_matches_blend);
+    RUN_TEST(test_hline_alpha_without_callback);
+    RUN_TEST(test_hline_alpha_opaque_and_transparent);
+    RUN_TEST(test_hline_alpha_clip);
+    RUN_TEST(test_hline_alpha_rgb565_format);
+    RUN_TEST(test_fill_rectangle_alpha);
+    RUN_TEST(test_fill_circle_alpha);
+    RUN_TEST(test_fill_polygon_alpha);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+    GREATEST_MAIN_BEGIN();
+    RUN_SUITE(alpha_suite);
+    GREATEST_MAIN_END();
+}
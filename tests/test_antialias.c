@@ -0,0 +1,232 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crc32.h"
+#include "greatest.h"
+#include "hagl/antialias.h"
+#include "hagl/bitmap.h"
+#include "hagl/clip.h"
+#include "hagl/color.h"
+#include "hagl/pixel.h"
+#include "hagl/rectangle.h"
+#include "save_image.h"
+
+#define TEST_WIDTH 320
+#define TEST_HEIGHT 240
+#define TEST_DEPTH 16
+#define PI 3.14159265
+
+static hagl_bitmap_t bitmap;
+static uint8_t buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+static hagl_color_t white;
+/* Alpha of white blended over black. */
+static int16_t levels[65536];
+
+static void setup_callback(void *data) {
+    memset(buffer, 0, sizeof(buffer));
+    hagl_bitmap_init(&bitmap, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, buffer);
+    white = hagl_color(&bitmap, 255, 255, 255);
+
+    for (int32_t i = 0; i < 65536; i++) {
+        levels[i] = -1;
+    }
+    for (int16_t alpha = 255; alpha >= 0; alpha--) {
+        levels[hagl_blend(&bitmap, white, 0, alpha)] = alpha;
+    }
+}
+
+static void teardown_callback(void *data) {
+    char filename[256];
+    snprintf(filename, sizeof(filename), "output/%s.png", greatest_info.name_buf);
+    save_image(&bitmap, filename);
+}
+
+/* Sum of coverage in pixels or negative if some pixel is not white over black. */
+static double area(void) {
+    uint32_t sum = 0;
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            int16_t level = levels[hagl_get_pixel(&bitmap, x, y)];
+            if (level < 0) {
+                return -1;
+            }
+            sum += level;
+        }
+    }
+    return sum / 255.0;
+}
+
+TEST test_fill_circle_aa_area(void) {
+    for (int16_t r = 0; r < 110; r += 9) {
+        memset(buffer, 0, sizeof(buffer));
+        hagl_fill_circle_aa(&bitmap, 160, 120, r, white);
+
+        double expected = PI * (r + 0.5) * (r + 0.5);
+        ASSERT_IN_RANGE(expected, area(), 0.5 + expected * 0.02);
+    }
+
+    PASS();
+}
+
+TEST test_draw_circle_aa_length(void) {
+    for (int16_t r = 5; r < 110; r += 9) {
+        memset(buffer, 0, sizeof(buffer));
+        hagl_draw_circle_aa(&bitmap, 160, 120, r, white);
+
+        double expected = 2 * PI * r;
+        ASSERT_IN_RANGE(expected, area(), expected * 0.05);
+    }
+
+    PASS();
+}
+
+TEST test_fill_ellipse_aa_area(void) {
+    for (int16_t a = 1; a < 150; a += 23) {
+        for (int16_t b = 1; b < 110; b += 17) {
+            memset(buffer, 0, sizeof(buffer));
+            hagl_fill_ellipse_aa(&bitmap, 160, 120, a, b, white);
+
+            double expected = PI * (a + 0.5) * (b + 0.5);
+            ASSERT_IN_RANGE(expected, area(), expected * 0.04);
+        }
+    }
+
+    PASS();
+}
+
+/* Interior is solid and nothing is drawn further than a pixel from the edge. */
+TEST test_fill_circle_aa_edge(void) {
+    int16_t r = 50;
+    hagl_fill_circle_aa(&bitmap, 160, 120, r, white);
+
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            int32_t d2 = (x - 160) * (x - 160) + (y - 120) * (y - 120);
+            hagl_color_t pixel = hagl_get_pixel(&bitmap, x, y);
+            if (d2 <= (r - 1) * (r - 1)) {
+                ASSERT_EQ(white, pixel);
+            }
+            if (d2 >= (r + 1) * (r + 1)) {
+                ASSERT_EQ(0, pixel);
+            }
+        }
+    }
+
+    PASS();
+}
+
+/* Circle is an ellipse with equal radii. */
+TEST test_ellipse_aa_circle(void) {
+    hagl_fill_circle_aa(&bitmap, 100, 120, 40, white);
+    hagl_draw_circle_aa(&bitmap, 220, 120, 40, white);
+    uint32_t circle = crc32(buffer, sizeof(buffer));
+
+    memset(buffer, 0, sizeof(buffer));
+    hagl_fill_ellipse_aa(&bitmap, 100, 120, 40, 40, white);
+    hagl_draw_ellipse_aa(&bitmap, 220, 120, 40, 40, white);
+
+    ASSERT_EQ(circle, crc32(buffer, sizeof(buffer)));
+
+    PASS();
+}
+
+/* Straight edges are on pixel boundaries and stay sharp. */
+TEST test_rounded_rectangle_aa_sharp(void) {
+    static uint8_t expected[sizeof(buffer)];
+
+    hagl_fill_rectangle_xyxy(&bitmap, 10, 20, 200, 150, white);
+    hagl_draw_rectangle_xyxy(&bitmap, 220, 20, 300, 150, white);
+    memcpy(expected, buffer, sizeof(buffer));
+
+    memset(buffer, 0, sizeof(buffer));
+    hagl_fill_rounded_rectangle_aa_xyxy(&bitmap, 200, 150, 10, 20, 0, white);
+    hagl_draw_rounded_rectangle_aa_xyxy(&bitmap, 220, 20, 300, 150, 0, white);
+    ASSERT_MEM_EQ(expected, buffer, sizeof(buffer));
+
+    memset(buffer, 0, sizeof(buffer));
+    hagl_fill_rounded_rectangle_aa_xyxy(&bitmap, 10, 20, 200, 150, 12, white);
+    hagl_draw_rounded_rectangle_aa_xyxy(&bitmap, 220, 20, 300, 150, 12, white);
+    for (int16_t y = 32; y <= 138; y++) {
+        size_t row = y * TEST_WIDTH * 2;
+        ASSERT_MEM_EQ(expected + row, buffer + row, TEST_WIDTH * 2);
+    }
+
+    ASSERT_EQ(0, hagl_get_pixel(&bitmap, 10, 20));
+    ASSERT_EQ(0, hagl_get_pixel(&bitmap, 300, 150));
+    ASSERT_EQ(white, hagl_get_pixel(&bitmap, 22, 20));
+    ASSERT_EQ(white, hagl_get_pixel(&bitmap, 288, 150));
+
+    PASS();
+}
+
+TEST test_aa_clip(void) {
+    hagl_set_clip(&bitmap, 100, 100, 160, 160);
+    hagl_fill_circle_aa(&bitmap, 100, 100, 80, white);
+    hagl_draw_ellipse_aa(&bitmap, 160, 160, 70, 30, white);
+    hagl_fill_rounded_rectangle_aa(&bitmap, 0, 0, 319, 239, 40, 0xFFFF);
+
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            if (x < 100 || x > 160 || y < 100 || y > 160) {
+                ASSERT_EQ(0, hagl_get_pixel(&bitmap, x, y));
+            }
+        }
+    }
+
+    PASS();
+}
+
+SUITE(antialias_suite) {
+    SET_SETUP(setup_callback, NULL);
+    SET_TEARDOWN(teardown_callback, NULL);
+    RUN_TEST(test_fill_circle_aa_area);
+    RUN_TEST(test_draw_circle_aa_length);
+    RUN_TEST(test_fill_ellipse_aa_area);
+    RUN_TEST(test_fill_circle_aa_edge);
+    RUN_TEST(test_ellipse_aa_circle);
+    RUN_TEST(test_rounded_rectangle_aa_sharp);
+    RUN_TEST(test_aa_clip);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+    GREATEST_MAIN_BEGIN();
+    RUN_SUITE(antialias_suite);
+    GREATEST_MAIN_END();
+}
@@ -0,0 +1,274 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crc32.h"
+#include "greatest.h"
+#include "hagl/arc.h"
+#include "hagl/bitmap.h"
+#include "hagl/circle.h"
+#include "hagl/clip.h"
+#include "hagl/hline.h"
+#include "hagl/pixel.h"
+#include "save_image.h"
+
+#define TEST_WIDTH 320
+#define TEST_HEIGHT 240
+#define TEST_DEPTH 16
+
+static hagl_bitmap_t bitmap;
+static uint8_t buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+
+static uint32_t count_pixels(hagl_bitmap_t *bitmap, hagl_color_t color) {
+    uint32_t count = 0;
+    for (int16_t y = 0; y < bitmap->height; y++) {
+        for (int16_t x = 0; x < bitmap->width; x++) {
+            if (hagl_get_pixel(bitmap, x, y) == color) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+static void setup_callback(void *data) {
+    memset(buffer, 0, sizeof(buffer));
+    hagl_bitmap_init(&bitmap, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, buffer);
+}
+
+static void teardown_callback(void *data) {
+    char filename[256];
+    snprintf(filename, sizeof(filename), "output/%s.png", greatest_info.name_buf);
+    save_image(&bitmap, filename);
+}
+
+static int16_t last_x;
+static int16_t last_y;
+static uint32_t span_pixels;
+static bool span_ordered;
+
+/* Checks that spans come from top to bottom and left to right. */
+static void record_span(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+) {
+    if (y0 < last_y || (y0 == last_y && x0 <= last_x)) {
+        span_ordered = false;
+    }
+    last_x = x0 + width - 1;
+    last_y = y0;
+    span_pixels += width;
+    hagl_draw_hline_xyw(surface, x0, y0, width, *(const hagl_color_t *)paint);
+}
+
+/* Full turn draws the same pixels as a filled circle. */
+TEST test_fill_pie_full(void) {
+    for (int16_t r = 0; r < 100; r += 7) {
+        memset(buffer, 0, sizeof(buffer));
+        hagl_fill_circle(&bitmap, 160, 120, r, 0xFFFF);
+        uint32_t crc = crc32(bitmap.buffer, bitmap.size);
+
+        memset(buffer, 0, sizeof(buffer));
+        hagl_fill_pie(&bitmap, 160, 120, r, HAGL_DEGREES(45), HAGL_DEGREES(405), 0xFFFF);
+        ASSERT_EQ(crc, crc32(bitmap.buffer, bitmap.size));
+    }
+
+    PASS();
+}
+
+/*
+ * Quarter from 0 to 90 degrees is the bottom right quarter. Both edges
+ * are included.
+ *
+ * (60,120) (160,120)--(260,120)
+ *              |   ####
+ *              |  ####
+ *          (160,220)
+ */
+TEST test_fill_pie_quarter(void) {
+    hagl_fill_pie(&bitmap, 160, 120, 100, 0, HAGL_DEGREES(90), 0xFFFF);
+
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 160, 120));
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 260, 120));
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 160, 220));
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 220, 180));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 159, 121));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 161, 119));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 100, 60));
+
+    /* Four quarters cover the circle, axes are drawn twice. */
+    hagl_fill_pie(&bitmap, 160, 120, 100, HAGL_DEGREES(90), HAGL_DEGREES(180), 0xFFFF);
+    hagl_fill_pie(&bitmap, 160, 120, 100, HAGL_DEGREES(180), HAGL_DEGREES(270), 0xFFFF);
+    hagl_fill_pie(&bitmap, 160, 120, 100, HAGL_DEGREES(270), HAGL_DEGREES(360), 0xFFFF);
+    uint32_t count = count_pixels(&bitmap, 0xFFFF);
+
+    memset(buffer, 0, sizeof(buffer));
+    hagl_fill_circle(&bitmap, 160, 120, 100, 0xFFFF);
+    ASSERT_EQ(count_pixels(&bitmap, 0xFFFF), count);
+
+    PASS();
+}
+
+/* End angle smaller than start wraps around zero. */
+TEST test_fill_pie_wrap(void) {
+    hagl_fill_pie(&bitmap, 160, 120, 100, HAGL_DEGREES(315), HAGL_DEGREES(45), 0xFFFF);
+
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 250, 120));
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 230, 60));
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 230, 180));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 160, 60));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 100, 120));
+
+    /* Equal angles draw nothing. */
+    memset(buffer, 0, sizeof(buffer));
+    hagl_fill_pie(&bitmap, 160, 120, 100, HAGL_DEGREES(30), HAGL_DEGREES(30), 0xFFFF);
+    hagl_fill_pie(&bitmap, 160, 120, -1, 0, HAGL_DEGREES(360), 0xFFFF);
+    ASSERT_EQ(0, count_pixels(&bitmap, 0xFFFF));
+
+    PASS();
+}
+
+/* Full arc is the edge of a filled circle. */
+TEST test_draw_arc_edge(void) {
+    hagl_draw_arc(&bitmap, 160, 120, 100, 0, HAGL_DEGREES(360), 0xFFFF);
+    uint32_t count = count_pixels(&bitmap, 0xFFFF);
+
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 160, 20));
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 60, 120));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 160, 21));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 61, 120));
+
+    /* Nothing inside a smaller circle and nothing outside of the circle. */
+    hagl_fill_circle(&bitmap, 160, 120, 98, 0x0000);
+    ASSERT_EQ(count, count_pixels(&bitmap, 0xFFFF));
+    hagl_fill_circle(&bitmap, 160, 120, 100, 0x0001);
+    ASSERT_EQ(0, count_pixels(&bitmap, 0xFFFF));
+
+    /* Close to hagl_draw_circle(), only a few pixels differ. */
+    memset(buffer, 0, sizeof(buffer));
+    hagl_draw_circle(&bitmap, 160, 120, 100, 0xFFFF);
+    hagl_draw_arc(&bitmap, 160, 120, 100, 0, HAGL_DEGREES(360), 0x0000);
+    ASSERT(count_pixels(&bitmap, 0xFFFF) < 16);
+
+    PASS();
+}
+
+/*
+ * Ring from 20 to 30 pixels has 11 pixels on each axis and nothing in
+ * the middle.
+ */
+TEST test_fill_ring(void) {
+    hagl_fill_ring(&bitmap, 160, 120, 20, 30, 0, HAGL_DEGREES(360), 0xFFFF);
+
+    for (int16_t x = 130; x < 190; x++) {
+        hagl_color_t expected = (x <= 140 || x >= 180) ? 0xFFFF : 0x0000;
+        ASSERT_EQ(expected, hagl_get_pixel(&bitmap, x, 120));
+    }
+
+    /* Ring with inner radius of zero is a pie. */
+    memset(buffer, 0, sizeof(buffer));
+    hagl_fill_ring(&bitmap, 160, 120, 0, 50, HAGL_DEGREES(10), HAGL_DEGREES(200), 0xFFFF);
+    uint32_t crc = crc32(bitmap.buffer, bitmap.size);
+
+    memset(buffer, 0, sizeof(buffer));
+    hagl_fill_pie(&bitmap, 160, 120, 50, HAGL_DEGREES(10), HAGL_DEGREES(200), 0xFFFF);
+    ASSERT_EQ(crc, crc32(bitmap.buffer, bitmap.size));
+
+    PASS();
+}
+
+/*
+ * Three quarter ring passes every pixel once in order. Rows crossing
+ * the gap have three spans.
+ */
+TEST test_fill_ring_span_order(void) {
+    hagl_color_t color = 0xFFFF;
+
+    last_x = INT16_MIN;
+    last_y = INT16_MIN;
+    span_pixels = 0;
+    span_ordered = true;
+    hagl_fill_ring_span(
+        &bitmap, 160, 120, 60, 100, HAGL_DEGREES(-30), HAGL_DEGREES(240), record_span,
+        &color
+    );
+
+    ASSERT(span_ordered);
+    ASSERT_EQ(count_pixels(&bitmap, 0xFFFF), span_pixels);
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 160, 40));
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 160, 200));
+
+    PASS();
+}
+
+TEST test_fill_ring_clip(void) {
+    hagl_color_t color = 0xFFFF;
+
+    hagl_set_clip(&bitmap, 140, 100, 179, 109);
+    last_x = INT16_MIN;
+    last_y = INT16_MIN;
+    span_pixels = 0;
+    span_ordered = true;
+    hagl_fill_ring_span(
+        &bitmap, 160, 120, 10, 50, 0, HAGL_DEGREES(360), record_span, &color
+    );
+
+    ASSERT(span_ordered);
+    ASSERT_EQ(109, last_y);
+    ASSERT_EQ(40 * 10, count_pixels(&bitmap, 0xFFFF));
+
+    PASS();
+}
+
+SUITE(arc_suite) {
+    SET_SETUP(setup_callback, NULL);
+    SET_TEARDOWN(teardown_callback, NULL);
+    RUN_TEST(test_fill_pie_full);
+    RUN_TEST(test_fill_pie_quarter);
+    RUN_TEST(test_fill_pie_wrap);
+    RUN_TEST(test_draw_arc_edge);
+    RUN_TEST(test_fill_ring);
+    RUN_TEST(test_fill_ring_span_order);
+    RUN_TEST(test_fill_ring_clip);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+    GREATEST_MAIN_BEGIN();
+    RUN_SUITE(arc_suite);
+    GREATEST_MAIN_END();
+}
@@ -0,0 +1,257 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "hagl.h"
+#include "hagl/bezier.h"
+#include "hagl/bitmap.h"
+#include "hagl/pixel.h"
+#include "hagl/polygon.h"
+#include "save_image.h"
+
+#define TEST_WIDTH 320
+#define TEST_HEIGHT 240
+#define TEST_DEPTH 16
+
+static hagl_bitmap_t bitmap;
+static uint8_t buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+static int16_t vertices[2 * 512];
+
+static uint32_t count_pixels(hagl_bitmap_t *bitmap, hagl_color_t color) {
+    uint32_t count = 0;
+    for (int16_t y = 0; y < bitmap->height; y++) {
+        for (int16_t x = 0; x < bitmap->width; x++) {
+            if (hagl_get_pixel(bitmap, x, y) == color) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+static void setup_callback(void *data) {
+    memset(buffer, 0, sizeof(buffer));
+    hagl_bitmap_init(&bitmap, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, buffer);
+}
+
+static void teardown_callback(void *data) {
+    char filename[256];
+    snprintf(filename, sizeof(filename), "output/%s.png", greatest_info.name_buf);
+    save_image(&bitmap, filename);
+}
+
+/* Distance from a point to the closest line of the path. */
+static double path_distance(const hagl_path_t *path, double x, double y) {
+    double best = 1e9;
+
+    for (int16_t i = 0; i + 1 < path->amount; i++) {
+        double x0 = path->vertices[i * 2];
+        double y0 = path->vertices[i * 2 + 1];
+        double dx = path->vertices[i * 2 + 2] - x0;
+        double dy = path->vertices[i * 2 + 3] - y0;
+        double length = dx * dx + dy * dy;
+        double t = length ? ((x - x0) * dx + (y - y0) * dy) / length : 0;
+
+        t = t < 0 ? 0 : (t > 1 ? 1 : t);
+        best = fmin(best, hypot(x0 + t * dx - x, y0 + t * dy - y));
+    }
+
+    return best;
+}
+
+/* Curve with control points on a line is a single line. */
+TEST test_path_straight(void) {
+    hagl_path_t path;
+
+    hagl_path_init(&path, vertices, 512, HAGL_BEZIER_TOLERANCE);
+    hagl_path_move_to(&path, 10, 10);
+    ASSERT_EQ(HAGL_OK, hagl_path_quadratic_to(&path, 60, 35, 110, 60));
+    ASSERT_EQ(2, path.amount);
+    ASSERT_EQ(HAGL_OK, hagl_path_cubic_to(&path, 110, 80, 110, 100, 110, 120));
+    ASSERT_EQ(3, path.amount);
+    ASSERT_EQ(110, vertices[4]);
+    ASSERT_EQ(120, vertices[5]);
+
+    PASS();
+}
+
+/*
+ * Every point of the curve is within the tolerance of the lines. Vertices
+ * are rounded to pixels which adds at most half a diagonal.
+ */
+TEST test_path_tolerance(void) {
+    hagl_path_t path;
+    int16_t previous = 0;
+
+    for (uint16_t tolerance = 256; tolerance >= 16; tolerance /= 2) {
+        hagl_path_init(&path, vertices, 512, tolerance);
+        hagl_path_move_to(&path, 10, 200);
+        ASSERT_EQ(HAGL_OK, hagl_path_cubic_to(&path, 40, -100, 280, 330, 310, 20));
+
+        ASSERT_EQ(10, vertices[0]);
+        ASSERT_EQ(200, vertices[1]);
+        ASSERT_EQ(310, vertices[path.amount * 2 - 2]);
+        ASSERT_EQ(20, vertices[path.amount * 2 - 1]);
+
+        for (uint16_t i = 0; i <= 1000; i++) {
+            double t = i / 1000.0;
+            double u = 1 - t;
+            double x = u * u * u * 10 + 3 * u * u * t * 40 + 3 * u * t * t * 280 +
+                       t * t * t * 310;
+            double y = u * u * u * 200 + 3 * u * u * t * -100 + 3 * u * t * t * 330 +
+                       t * t * t * 20;
+            ASSERT(path_distance(&path, x, y) <= tolerance / 256.0 + 0.71);
+        }
+
+        /* Smaller tolerance needs more lines. */
+        ASSERT(path.amount > previous);
+        previous = path.amount;
+    }
+
+    PASS();
+}
+
+/* Vertices which do not fit are dropped. */
+TEST test_path_overflow(void) {
+    hagl_path_t path;
+
+    hagl_path_init(&path, vertices, 4, HAGL_BEZIER_TOLERANCE);
+    ASSERT_EQ(HAGL_ERR_GENERAL, hagl_path_quadratic_to(&path, 10, 10, 20, 20));
+    ASSERT_EQ(HAGL_OK, hagl_path_move_to(&path, 0, 0));
+    ASSERT_EQ(HAGL_ERR_GENERAL, hagl_path_quadratic_to(&path, 150, 0, 150, 150));
+    ASSERT_EQ(4, path.amount);
+
+    PASS();
+}
+
+TEST test_draw_quadratic(void) {
+    hagl_draw_quadratic(&bitmap, 10, 200, 160, -100, 310, 200, 64, 0xFFFF);
+
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 10, 200));
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 310, 200));
+    /* Top of the curve is halfway to the control point. */
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 160, 50));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 160, 48));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 160, 52));
+
+    PASS();
+}
+
+/* Circle from four cubic curves, control points at 0.5523 of the radius. */
+TEST test_fill_path_circle(void) {
+    hagl_path_t path;
+
+    hagl_path_init(&path, vertices, 512, HAGL_BEZIER_TOLERANCE);
+    hagl_path_move_to(&path, 260, 120);
+    hagl_path_cubic_to(&path, 260, 175, 215, 220, 160, 220);
+    hagl_path_cubic_to(&path, 105, 220, 60, 175, 60, 120);
+    hagl_path_cubic_to(&path, 60, 65, 105, 20, 160, 20);
+    hagl_path_cubic_to(&path, 215, 20, 260, 65, 260, 120);
+    hagl_fill_path(&bitmap, &path, 0xFFFF);
+
+    double area = count_pixels(&bitmap, 0xFFFF);
+    ASSERT(fabs(area - 3.14159265 * 100 * 100) < 0.02 * area);
+
+    /* Outline is drawn over the edge of the fill. */
+    hagl_draw_path(&bitmap, &path, 0x0001);
+    ASSERT_EQ(0x0001, hagl_get_pixel(&bitmap, 160, 20));
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 160, 120));
+
+    PASS();
+}
+
+/* Polyline is not closed. */
+TEST test_draw_polyline(void) {
+    int16_t triangle[6] = {10, 10, 100, 10, 100, 100};
+
+    hagl_draw_polyline(&bitmap, 3, triangle, 0xFFFF);
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 50, 10));
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 100, 50));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 50, 50));
+
+    hagl_draw_polygon(&bitmap, 3, triangle, 0xFFFF);
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 50, 50));
+
+    PASS();
+}
+
+/* Polygons with more than 255 vertices used to loop forever. */
+TEST test_fill_path_many_vertices(void) {
+    hagl_path_t path;
+
+    hagl_path_init(&path, vertices, 512, HAGL_BEZIER_TOLERANCE);
+    hagl_path_move_to(&path, 10, 10);
+    for (int16_t y = 10; y <= 229; y++) {
+        hagl_path_line_to(&path, 310, y);
+    }
+    for (int16_t y = 229; y > 10; y--) {
+        hagl_path_line_to(&path, 10, y);
+    }
+    ASSERT_EQ(440, path.amount);
+
+    hagl_fill_path(&bitmap, &path, 0xFFFF);
+    uint32_t count = count_pixels(&bitmap, 0xFFFF);
+
+    /* Same as the rectangle with four vertices. */
+    int16_t rectangle[8] = {10, 10, 310, 10, 310, 229, 10, 229};
+    memset(buffer, 0, sizeof(buffer));
+    hagl_fill_polygon(&bitmap, 4, rectangle, 0xFFFF);
+    ASSERT_EQ(count_pixels(&bitmap, 0xFFFF), count);
+
+    PASS();
+}
+
+SUITE(bezier_suite) {
+    SET_SETUP(setup_callback, NULL);
+    SET_TEARDOWN(teardown_callback, NULL);
+    RUN_TEST(test_path_straight);
+    RUN_TEST(test_path_tolerance);
+    RUN_TEST(test_path_overflow);
+    RUN_TEST(test_draw_quadratic);
+    RUN_TEST(test_fill_path_circle);
+    RUN_TEST(test_draw_polyline);
+    RUN_TEST(test_fill_path_many_vertices);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+    GREATEST_MAIN_BEGIN();
+    RUN_SUITE(bezier_suite);
+    GREATEST_MAIN_END();
+}
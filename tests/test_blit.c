@@ -186,6 +186,127 @@ TEST test_blit_xyxy_reversed(void) {
     PASS();
 }
 
+static hagl_color_t palette[256];
+
+static void init_indexed(hagl_bitmap_t *indexed, uint8_t *buffer, uint8_t depth) {
+    for (uint16_t i = 0; i < 256; i++) {
+        palette[i] = 0x1000 + i;
+    }
+    hagl_bitmap_init_indexed(indexed, 5, 3, depth, buffer, palette);
+    for (int16_t y = 0; y < 3; y++) {
+        for (int16_t x = 0; x < 5; x++) {
+            hagl_put_pixel(indexed, x, y, (x * 3 + y) % (1 << depth));
+        }
+    }
+}
+
+/*
+ * Pixels are packed MSB first and rows padded to full bytes:
+ *
+ * 4 bpp 5x3 bitmap has pitch of 3 bytes.
+ */
+TEST test_indexed_pixel(void) {
+    hagl_bitmap_t indexed;
+    uint8_t buffer[INDEXED_BITMAP_SIZE(5, 3, 4)];
+
+    memset(buffer, 0, sizeof(buffer));
+    hagl_bitmap_init_indexed(&indexed, 5, 3, 4, buffer, palette);
+
+    ASSERT_EQ(3, indexed.pitch);
+    ASSERT_EQ(9, indexed.size);
+
+    hagl_put_pixel(&indexed, 0, 0, 0x0a);
+    hagl_put_pixel(&indexed, 1, 0, 0x0b);
+    hagl_put_pixel(&indexed, 4, 2, 0x0f);
+
+    ASSERT_EQ(0xab, buffer[0]);
+    ASSERT_EQ(0xf0, buffer[8]);
+    ASSERT_EQ(0x0a, hagl_get_pixel(&indexed, 0, 0));
+    ASSERT_EQ(0x0b, hagl_get_pixel(&indexed, 1, 0));
+    ASSERT_EQ(0x0f, hagl_get_pixel(&indexed, 4, 2));
+    ASSERT_EQ(0x00, hagl_get_pixel(&indexed, 3, 2));
+
+    /* Only the given pixel changes. */
+    hagl_put_pixel(&indexed, 0, 0, 0x01);
+    ASSERT_EQ(0x1b, buffer[0]);
+
+    PASS();
+}
+
+TEST test_blit_indexed(void) {
+    const uint8_t depths[] = {1, 2, 4, 8};
+    hagl_bitmap_t indexed;
+    uint8_t buffer[INDEXED_BITMAP_SIZE(5, 3, 8)];
+
+    for (uint8_t i = 0; i < sizeof(depths); i++) {
+        memset(buffer, 0, sizeof(buffer));
+        init_indexed(&indexed, buffer, depths[i]);
+        hagl_blit_xy(&bitmap, 10, 10, &indexed);
+
+        for (int16_t y = 0; y < 3; y++) {
+            for (int16_t x = 0; x < 5; x++) {
+                hagl_color_t expected = palette[(x * 3 + y) % (1 << depths[i])];
+                ASSERT_EQ(expected, hagl_get_pixel(&bitmap, 10 + x, 10 + y));
+            }
+        }
+    }
+
+    /* Nothing outside of the bitmap. */
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 9, 10));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 15, 10));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 10, 13));
+
+    PASS();
+}
+
+/*
+ * Indexed bitmap partially outside of the clip window:
+ *
+ * (-2,-1)--(2,-1)
+ *   |    (0,0)--(2,0)
+ * (-2,1)---(2,1)
+ */
+TEST test_blit_indexed_clip(void) {
+    hagl_bitmap_t indexed;
+    uint8_t buffer[INDEXED_BITMAP_SIZE(5, 3, 2)];
+
+    init_indexed(&indexed, buffer, 2);
+    hagl_blit_xy(&bitmap, -2, -1, &indexed);
+
+    for (int16_t y = 0; y < 2; y++) {
+        for (int16_t x = 0; x < 3; x++) {
+            hagl_color_t expected = palette[((x + 2) * 3 + y + 1) % 4];
+            ASSERT_EQ(expected, hagl_get_pixel(&bitmap, x, y));
+        }
+    }
+    ASSERT_EQ(TEST_WIDTH * TEST_HEIGHT - 6, count_pixels(&bitmap, 0x0000));
+
+    PASS();
+}
+
+/*
+ * Scale blit of a 5x3 indexed source into a 10x6 region at (20,20),
+ * each source pixel becomes a 2x2 block.
+ */
+TEST test_blit_indexed_xywh(void) {
+    hagl_bitmap_t indexed;
+    uint8_t buffer[INDEXED_BITMAP_SIZE(5, 3, 4)];
+
+    init_indexed(&indexed, buffer, 4);
+    hagl_blit_xywh(&bitmap, 20, 20, 10, 6, &indexed);
+
+    for (int16_t y = 0; y < 6; y++) {
+        for (int16_t x = 0; x < 10; x++) {
+            hagl_color_t expected = palette[((x / 2) * 3 + y / 2) % 16];
+            ASSERT_EQ(expected, hagl_get_pixel(&bitmap, 20 + x, 20 + y));
+        }
+    }
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 30, 20));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 20, 26));
+
+    PASS();
+}
+
 SUITE(blit_suite) {
     SET_SETUP(setup_callback, NULL);
     SET_TEARDOWN(teardown_callback, NULL);
@@ -193,6 +314,10 @@ SUITE(blit_suite) {
     RUN_TEST(test_blit_xywh);
     RUN_TEST(test_blit_xyxy_match_xywh);
     RUN_TEST(test_blit_xyxy_reversed);
+    RUN_TEST(test_indexed_pixel);
+    RUN_TEST(test_blit_indexed);
+    RUN_TEST(test_blit_indexed_clip);
+    RUN_TEST(test_blit_indexed_xywh);
 }
 
 GREATEST_MAIN_DEFS();
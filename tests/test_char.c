@@ -38,7 +38,9 @@ SPDX-License-Identifier: MIT
 #include "save_image.h"
 
 #include "fontx.h"
+#include "hagl.h"
 #include "hagl/bitmap.h"
+#include "hagl/blit.h"
 #include "hagl/char.h"
 #include "hagl/pixel.h"
 
@@ -199,6 +201,29 @@ TEST test_get_glyph_invalid_code(void) {
     PASS();
 }
 
+/* Glyph bitmap on the stack has garbage palette and format. */
+TEST test_get_glyph_blit_uninitialised(void) {
+    hagl_bitmap_t glyph;
+    uint8_t status;
+
+    memset(&glyph, 0xAA, sizeof(glyph));
+    glyph.buffer = glyph_buffer;
+
+    status = hagl_get_glyph(&surface, 0x41, 0xF800, &glyph, font5x7);
+    ASSERT_EQ(0, status);
+    ASSERT_EQ(NULL, glyph.palette);
+    ASSERT_EQ(HAGL_FORMAT_NATIVE, glyph.format);
+
+    hagl_blit(&surface, 10, 10, &glyph);
+
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 10, 10));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 11, 10));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 12, 10));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 13, 10));
+
+    PASS();
+}
+
 TEST test_put_char_returns_width(void) {
     uint8_t width;
 
@@ -329,20 +354,128 @@ TEST test_put_text_cr(void) {
     PASS();
 }
 
+/*
+ * 16x16 glyph does not fit the default glyph buffer and is drawn in strips.
+ * Only A (0x41) is defined, it is a filled square with hollow center row.
+ */
+TEST test_put_char_larger_than_buffer(void) {
+    static uint8_t font16x16[FONTX_GLYPH_DATA_START + 256 * 32];
+    uint8_t *glyph = &font16x16[FONTX_GLYPH_DATA_START + 0x41 * 32];
+
+    memset(font16x16, 0, sizeof(font16x16));
+    memcpy(font16x16, "FONTX2", 6);
+    font16x16[FONTX_WIDTH] = 16;
+    font16x16[FONTX_HEIGHT] = 16;
+    font16x16[FONTX_TYPE] = FONTX_TYPE_SBCS;
+    memset(glyph, 0xFF, 32);
+    glyph[8 * 2] = 0x00;
+    glyph[8 * 2 + 1] = 0x00;
+
+    if (16 * 16 * (TEST_DEPTH / 8) <= HAGL_CHAR_BUFFER_SIZE) {
+        SKIP();
+    }
+    ASSERT_EQ(16, hagl_put_char(&surface, 0x41, 20, 20, 0xF800, font16x16));
+
+    ASSERT_EQ(15 * 16, count_pixels(&surface, 0xF800));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 20, 20));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 35, 35));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 27, 28));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 36, 35));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 35, 36));
+
+    PASS();
+}
+
+/*
+ * 8x255 glyph with an empty row 200. With a big glyph buffer more than
+ * 255 rows fit, which used to wrap the row counters.
+ */
+TEST test_put_char_tall_glyph(void) {
+    static uint8_t font8x255[FONTX_GLYPH_DATA_START + 256 * 255];
+    uint8_t *glyph = &font8x255[FONTX_GLYPH_DATA_START + 0x41 * 255];
+
+    memset(font8x255, 0, sizeof(font8x255));
+    memcpy(font8x255, "FONTX2", 6);
+    font8x255[FONTX_WIDTH] = 8;
+    font8x255[FONTX_HEIGHT] = 255;
+    font8x255[FONTX_TYPE] = FONTX_TYPE_SBCS;
+    memset(glyph, 0xFF, 255);
+    glyph[200] = 0x00;
+
+    ASSERT_EQ(8, hagl_put_char(&surface, 0x41, 0, 0, 0xF800, font8x255));
+
+    /* Rows past the bottom of the surface are clipped. */
+    ASSERT_EQ(8 * (TEST_HEIGHT - 1), count_pixels(&surface, 0xF800));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 0, 200));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 7, 239));
+
+    PASS();
+}
+
+/* Each pixel of the scaled glyph matches the unscaled glyph pixel. */
+TEST test_put_char_scaled_pixels(void) {
+    ASSERT_EQ(5, hagl_put_char(&surface, 0x41, 0, 0, 0xF800, font5x7));
+    ASSERT_EQ(15, hagl_put_char_scaled(&surface, 0x41, 10, 20, 0xF800, font5x7, 3));
+
+    for (int16_t y = 0; y < 7 * 3; y++) {
+        for (int16_t x = 0; x < 5 * 3; x++) {
+            ASSERT_EQ(
+                hagl_get_pixel(&surface, x / 3, y / 3),
+                hagl_get_pixel(&surface, 10 + x, 20 + y)
+            );
+        }
+    }
+
+    /* 14 pixels in the unscaled and 14 * 3 * 3 in the scaled glyph. */
+    ASSERT_EQ(14 + 14 * 9, count_pixels(&surface, 0xF800));
+
+    PASS();
+}
+
+TEST test_put_char_scaled_invalid(void) {
+    ASSERT_EQ(0, hagl_put_char_scaled(&surface, 0x7F, 0, 0, 0xF800, font5x7, 2));
+    ASSERT_EQ(0, hagl_put_char_scaled(&surface, 0x41, 0, 0, 0xF800, font5x7, 0));
+    ASSERT_EQ(0, count_pixels(&surface, 0xF800));
+
+    PASS();
+}
+
+/* Width and line height are multiplied by scale. */
+TEST test_put_text_scaled(void) {
+    uint16_t width;
+
+    width = hagl_put_text_scaled(&surface, L"AB", 0, 0, 0xF800, font6x9, 2);
+    ASSERT_EQ(24, width);
+
+    hagl_put_text_scaled(&surface, L"A\nA", 100, 0, 0xF800, font6x9, 2);
+
+    /* Second 'A' at (0, 18): foreground block at (4, 20). */
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 4, 20));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 5, 21));
+
+    PASS();
+}
+
 SUITE(char_suite) {
     SET_SETUP(setup_callback, NULL);
     SET_TEARDOWN(teardown_callback, NULL);
     RUN_TEST(test_get_glyph_bitmap_dimensions);
     RUN_TEST(test_get_glyph_content);
     RUN_TEST(test_get_glyph_invalid_code);
+    RUN_TEST(test_get_glyph_blit_uninitialised);
     RUN_TEST(test_put_char_returns_width);
     RUN_TEST(test_put_char_invalid_returns_zero);
     RUN_TEST(test_put_char_pixels);
     RUN_TEST(test_put_char_pixel_count);
+    RUN_TEST(test_put_char_larger_than_buffer);
+    RUN_TEST(test_put_char_tall_glyph);
     RUN_TEST(test_put_text_single_char);
     RUN_TEST(test_put_text_string_width);
     RUN_TEST(test_put_text_lf);
     RUN_TEST(test_put_text_cr);
+    RUN_TEST(test_put_char_scaled_pixels);
+    RUN_TEST(test_put_char_scaled_invalid);
+    RUN_TEST(test_put_text_scaled);
 }
 
 GREATEST_MAIN_DEFS();
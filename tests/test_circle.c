@@ -38,6 +38,7 @@ SPDX-License-Identifier: MIT
 #include "hagl/bitmap.h"
 #include "hagl/circle.h"
 #include "hagl/clip.h"
+#include "hagl/hline.h"
 #include "hagl/pixel.h"
 #include "save_image.h"
 
@@ -466,6 +467,81 @@ TEST test_fill_circle_custom_clip_regression(void) {
     PASS();
 }
 
+/*
+ * Circle drawn without hline and vline callbacks has the same pixels.
+ * Bounding box touching the clip window is drawn without clipping.
+ */
+TEST test_draw_circle_without_hline(void) {
+    hagl_set_clip(&bitmap, 50, 20, 250, 220);
+    hagl_draw_circle(&bitmap, 150, 120, 100, 0xFFFF);
+    hagl_draw_circle(&bitmap, 150, 120, 101, 0xFFFF);
+    uint32_t crc = crc32(bitmap.buffer, bitmap.size);
+
+    memset(buffer, 0, sizeof(buffer));
+    bitmap.hline = NULL;
+    bitmap.vline = NULL;
+    hagl_draw_circle(&bitmap, 150, 120, 100, 0xFFFF);
+    hagl_draw_circle(&bitmap, 150, 120, 101, 0xFFFF);
+
+    ASSERT_EQ(crc, crc32(bitmap.buffer, bitmap.size));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 150, 19));
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 150, 20));
+    PASS();
+}
+
+static int16_t span_rows[TEST_HEIGHT];
+static uint16_t span_count;
+
+static void record_span(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+) {
+    if (span_count < TEST_HEIGHT) {
+        span_rows[span_count] = y0;
+    }
+    span_count++;
+    hagl_draw_hline_xyw(surface, x0, y0, width, *(const hagl_color_t *)paint);
+}
+
+/*
+ * Every row is passed once from top to bottom and the pixels are the
+ * same as with hagl_fill_circle().
+ */
+TEST test_fill_circle_span_order(void) {
+    hagl_color_t color = 0xFFFF;
+
+    for (int16_t r = 0; r < 100; r += 7) {
+        memset(buffer, 0, sizeof(buffer));
+        hagl_fill_circle(&bitmap, 160, 120, r, color);
+        uint32_t crc = crc32(bitmap.buffer, bitmap.size);
+
+        memset(buffer, 0, sizeof(buffer));
+        span_count = 0;
+        hagl_fill_circle_span(&bitmap, 160, 120, r, record_span, &color);
+
+        ASSERT_EQ(crc, crc32(bitmap.buffer, bitmap.size));
+        ASSERT_EQ(r * 2 + 1, span_count);
+        for (uint16_t i = 0; i < span_count; i++) {
+            ASSERT_EQ(120 - r + i, span_rows[i]);
+        }
+    }
+
+    PASS();
+}
+
+TEST test_fill_circle_span_clip(void) {
+    hagl_color_t color = 0xFFFF;
+
+    hagl_set_clip(&bitmap, 0, 100, 319, 109);
+    span_count = 0;
+    hagl_fill_circle_span(&bitmap, 160, 120, 50, record_span, &color);
+
+    ASSERT_EQ(10, span_count);
+    ASSERT_EQ(100, span_rows[0]);
+    ASSERT_EQ(109, span_rows[9]);
+
+    PASS();
+}
+
 SUITE(circle_suite) {
     SET_SETUP(setup_callback, NULL);
     SET_TEARDOWN(teardown_callback, NULL);
@@ -479,6 +555,7 @@ SUITE(circle_suite) {
     RUN_TEST(test_draw_circle_clip_outside);
     RUN_TEST(test_draw_circle_custom_clip);
     RUN_TEST(test_draw_circle_custom_clip_regression);
+    RUN_TEST(test_draw_circle_without_hline);
     RUN_TEST(test_fill_circle);
     RUN_TEST(test_fill_circle_regression);
     RUN_TEST(test_fill_circle_radius_0);
@@ -489,6 +566,8 @@ SUITE(circle_suite) {
     RUN_TEST(test_fill_circle_clip_outside);
     RUN_TEST(test_fill_circle_custom_clip);
     RUN_TEST(test_fill_circle_custom_clip_regression);
+    RUN_TEST(test_fill_circle_span_order);
+    RUN_TEST(test_fill_circle_span_clip);
 }
 
 GREATEST_MAIN_DEFS();
@@ -32,16 +32,27 @@ SPDX-License-Identifier: MIT
 */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "greatest.h"
 #include "hagl/bitmap.h"
 #include "hagl/color.h"
 #include "rgb565.h"
+#include "rgb888.h"
 
 #define TEST_WIDTH 320
 #define TEST_HEIGHT 240
 #define TEST_DEPTH 16
 
+/* Colors in the byte order of rgb565() and hagl_color(). */
+#if HAGL_PIXEL_RGB565 == HAGL_FORMAT_RGB565_SWAPPED
+#define SWAPPED true
+#define NATIVE(color) ((uint16_t)(((color) << 8) | ((color) >> 8)))
+#else
+#define SWAPPED false
+#define NATIVE(color) ((uint16_t)(color))
+#endif
+
 static hagl_bitmap_t bitmap;
 static uint8_t buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
 
@@ -110,12 +121,168 @@ TEST test_color_delegates_to_surface(void) {
     PASS();
 }
 
+TEST test_blend_opaque_and_transparent(void) {
+    ASSERT_EQ(NATIVE(0xF800), hagl_blend(&bitmap, NATIVE(0xF800), NATIVE(0x001F), 255));
+    ASSERT_EQ(NATIVE(0x001F), hagl_blend(&bitmap, NATIVE(0xF800), NATIVE(0x001F), 0));
+
+    PASS();
+}
+
+/* Half way between white and black is mid gray, allow rounding either way. */
+TEST test_blend_half(void) {
+    hagl_color_t result =
+        NATIVE(hagl_blend(&bitmap, NATIVE(0xFFFF), NATIVE(0x0000), 128));
+
+    ASSERT_IN_RANGE(15, (result >> 11) & 0x1F, 1);
+    ASSERT_IN_RANGE(31, (result >> 5) & 0x3F, 1);
+    ASSERT_IN_RANGE(15, result & 0x1F, 1);
+
+    PASS();
+}
+
+/* Blending must not leak between channels. */
+TEST test_blend_channels(void) {
+    hagl_color_t result =
+        NATIVE(hagl_blend(&bitmap, NATIVE(0xF800), NATIVE(0x001F), 128));
+
+    ASSERT_IN_RANGE(15, (result >> 11) & 0x1F, 1);
+    ASSERT_EQ(0, (result >> 5) & 0x3F);
+    ASSERT_IN_RANGE(15, result & 0x1F, 1);
+
+    PASS();
+}
+
+/* Green is split between the bytes so it shows a wrong byte order. */
+TEST test_blend_green(void) {
+    hagl_color_t result =
+        NATIVE(hagl_blend(&bitmap, NATIVE(0x07E0), NATIVE(0x0000), 128));
+
+    ASSERT_EQ(0, (result >> 11) & 0x1F);
+    ASSERT_IN_RANGE(31, (result >> 5) & 0x3F, 1);
+    ASSERT_EQ(0, result & 0x1F);
+
+    PASS();
+}
+
+/*
+ * Colors from rgb565() are in the display byte order. Half of red and
+ * blue is 15 of 31 in both channels, half of red and green is 15 of 31
+ * and 31 of 63.
+ */
+TEST test_blend_rgb565_colors(void) {
+    hagl_color_t red = rgb565(255, 0, 0);
+    hagl_color_t green = rgb565(0, 255, 0);
+    hagl_color_t blue = rgb565(0, 0, 255);
+
+    ASSERT_EQ(rgb565(15 << 3, 0, 15 << 3), hagl_blend(&bitmap, red, blue, 128));
+    ASSERT_EQ(rgb565(15 << 3, 31 << 2, 0), hagl_blend(&bitmap, red, green, 128));
+
+    PASS();
+}
+
+TEST test_rgb565_byte_order(void) {
+    ASSERT_EQ(NATIVE(0xF800), rgb565(255, 0, 0));
+    ASSERT_EQ(NATIVE(0x07E0), rgb565(0, 255, 0));
+    ASSERT_EQ(NATIVE(0x001F), rgb565(0, 0, 255));
+    ASSERT_EQ(HAGL_PIXEL_RGB565, hagl_native_format(16));
+
+    PASS();
+}
+
+TEST test_rgb888_to_rgb565(void) {
+    rgb_t red = {255, 0, 0};
+    rgb_t green = {0, 255, 0};
+    rgb_t blue = {0, 0, 255};
+
+    /* Used to OR all channels together without shifting. */
+    ASSERT_EQ(0xF800, rgb888_to_rgb565(&red));
+    ASSERT_EQ(0x07E0, rgb888_to_rgb565(&green));
+    ASSERT_EQ(0x001F, rgb888_to_rgb565(&blue));
+
+    PASS();
+}
+
+/* Odd counts exercise both the vector and the scalar tail. */
+TEST test_rgb888_to_rgb565_n(void) {
+    static rgb_t rgb[1000];
+    static uint16_t rgb565_n[1000];
+    static uint8_t in_place[1000 * 3];
+    const uint16_t counts[] = {0, 1, 15, 16, 17, 33, 1000};
+
+    for (uint16_t i = 0; i < 1000; i++) {
+        rgb[i] = (rgb_t){i * 7, i * 13 + 5, i * 31 + 11};
+    }
+
+    for (uint8_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        uint16_t count = counts[c];
+
+        rgb888_to_rgb565_n(rgb565_n, rgb, count, SWAPPED);
+        for (uint16_t i = 0; i < count; i++) {
+            ASSERT_EQ(rgb565(rgb[i].r, rgb[i].g, rgb[i].b), rgb565_n[i]);
+        }
+
+        rgb888_to_rgb565_n(rgb565_n, rgb, count, !SWAPPED);
+        for (uint16_t i = 0; i < count; i++) {
+            uint16_t expected = rgb565(rgb[i].r, rgb[i].g, rgb[i].b);
+            ASSERT_EQ((uint16_t)((expected << 8) | (expected >> 8)), rgb565_n[i]);
+        }
+
+        /* Blue first, like HAGL_FORMAT_RGB888. */
+        for (uint16_t i = 0; i < count; i++) {
+            in_place[i * 3] = rgb[i].b;
+            in_place[i * 3 + 1] = rgb[i].g;
+            in_place[i * 3 + 2] = rgb[i].r;
+        }
+        bgr888_to_rgb565_n((uint16_t *)in_place, in_place, count, SWAPPED);
+        for (uint16_t i = 0; i < count; i++) {
+            uint16_t pixel;
+            memcpy(&pixel, in_place + i * 2, 2);
+            ASSERT_EQ(rgb565(rgb[i].r, rgb[i].g, rgb[i].b), pixel);
+        }
+    }
+
+    PASS();
+}
+
+TEST test_rgb565_to_rgb888_n(void) {
+    static uint16_t rgb565_n[65536 + 7];
+    static rgb_t rgb[65536 + 7];
+
+    for (uint32_t i = 0; i < 65536 + 7; i++) {
+        rgb565_n[i] = i;
+    }
+
+    rgb565_to_rgb888_n(rgb, rgb565_n, 65536 + 7, false);
+    for (uint32_t i = 0; i < 65536 + 7; i++) {
+        rgb_t expected = rgb565_to_rgb888(&rgb565_n[i]);
+        ASSERT_MEM_EQ(&expected, &rgb[i], sizeof(rgb_t));
+    }
+
+    rgb565_to_rgb888_n(rgb, rgb565_n, 65536 + 7, true);
+    for (uint32_t i = 0; i < 65536 + 7; i++) {
+        uint16_t swapped = (rgb565_n[i] << 8) | (rgb565_n[i] >> 8);
+        rgb_t expected = rgb565_to_rgb888(&swapped);
+        ASSERT_MEM_EQ(&expected, &rgb[i], sizeof(rgb_t));
+    }
+
+    PASS();
+}
+
 SUITE(color_suite) {
     SET_SETUP(setup_callback, NULL);
     RUN_TEST(test_color_default_black);
     RUN_TEST(test_color_default_white);
     RUN_TEST(test_color_fallback_arbitrary);
     RUN_TEST(test_color_delegates_to_surface);
+    RUN_TEST(test_blend_opaque_and_transparent);
+    RUN_TEST(test_blend_half);
+    RUN_TEST(test_blend_channels);
+    RUN_TEST(test_blend_green);
+    RUN_TEST(test_blend_rgb565_colors);
+    RUN_TEST(test_rgb565_byte_order);
+    RUN_TEST(test_rgb888_to_rgb565);
+    RUN_TEST(test_rgb888_to_rgb565_n);
+    RUN_TEST(test_rgb565_to_rgb888_n);
 }
 
 GREATEST_MAIN_DEFS();
@@ -270,6 +270,26 @@ TEST test_draw_ellipse_custom_clip_regression(void) {
     PASS();
 }
 
+/*
+ * Ellipse drawn without hline and vline callbacks has the same pixels.
+ */
+TEST test_draw_ellipse_without_hline(void) {
+    hagl_draw_ellipse(&bitmap, 160, 120, 150, 60, 0xFFFF);
+    hagl_draw_ellipse(&bitmap, 160, 120, 30, 110, 0xFFFF);
+    hagl_draw_ellipse(&bitmap, 0, 120, 100, 100, 0xFFFF);
+    uint32_t crc = crc32(bitmap.buffer, bitmap.size);
+
+    memset(buffer, 0, sizeof(buffer));
+    bitmap.hline = NULL;
+    bitmap.vline = NULL;
+    hagl_draw_ellipse(&bitmap, 160, 120, 150, 60, 0xFFFF);
+    hagl_draw_ellipse(&bitmap, 160, 120, 30, 110, 0xFFFF);
+    hagl_draw_ellipse(&bitmap, 0, 120, 100, 100, 0xFFFF);
+
+    ASSERT_EQ(crc, crc32(bitmap.buffer, bitmap.size));
+    PASS();
+}
+
 SUITE(ellipse_suite) {
     SET_SETUP(setup_callback, NULL);
     SET_TEARDOWN(teardown_callback, NULL);
@@ -283,6 +303,7 @@ SUITE(ellipse_suite) {
     RUN_TEST(test_draw_ellipse_clip_outside);
     RUN_TEST(test_draw_ellipse_custom_clip);
     RUN_TEST(test_draw_ellipse_custom_clip_regression);
+    RUN_TEST(test_draw_ellipse_without_hline);
 }
 
 GREATEST_MAIN_DEFS();
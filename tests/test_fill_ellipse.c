@@ -37,6 +37,7 @@ SPDX-License-Identifier: MIT
 #include "greatest.h"
 #include "hagl/bitmap.h"
 #include "hagl/clip.h"
+#include "hagl/hline.h"
 #include "hagl/ellipse.h"
 #include "hagl/pixel.h"
 #include "save_image.h"
@@ -249,6 +250,63 @@ TEST test_fill_ellipse_custom_clip_regression(void) {
     PASS();
 }
 
+static int16_t span_rows[TEST_HEIGHT];
+static uint16_t span_count;
+
+static void record_span(
+    void const *surface, int16_t x0, int16_t y0, uint16_t width, const void *paint
+) {
+    if (span_count < TEST_HEIGHT) {
+        span_rows[span_count] = y0;
+    }
+    span_count++;
+    hagl_draw_hline_xyw(surface, x0, y0, width, *(const hagl_color_t *)paint);
+}
+
+/*
+ * Every row is passed once from top to bottom and the pixels are the
+ * same as with hagl_fill_ellipse().
+ */
+TEST test_fill_ellipse_span_order(void) {
+    hagl_color_t color = 0xFFFF;
+
+    for (int16_t a = 0; a < 150; a += 13) {
+        for (int16_t b = 0; b < 110; b += 11) {
+            memset(buffer, 0, sizeof(buffer));
+            hagl_fill_ellipse(&bitmap, 160, 120, a, b, color);
+            uint32_t crc = crc32(bitmap.buffer, bitmap.size);
+
+            memset(buffer, 0, sizeof(buffer));
+            span_count = 0;
+            hagl_fill_ellipse_span(&bitmap, 160, 120, a, b, record_span, &color);
+
+            ASSERT_EQ(crc, crc32(bitmap.buffer, bitmap.size));
+            ASSERT_EQ(b * 2 + 1, span_count);
+            for (uint16_t i = 0; i < span_count; i++) {
+                ASSERT_EQ(120 - b + i, span_rows[i]);
+            }
+        }
+    }
+
+    PASS();
+}
+
+/*
+ * Thin ellipse has no holes:
+ * Center (100,100), a=1, b=30. Every row has at least the center pixel.
+ */
+TEST test_fill_ellipse_thin(void) {
+    hagl_fill_ellipse(&bitmap, 100, 100, 1, 30, 0xFFFF);
+
+    for (int16_t y = 70; y <= 130; y++) {
+        ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 100, y));
+    }
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 100, 69));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 100, 131));
+
+    PASS();
+}
+
 SUITE(fill_ellipse_suite) {
     SET_SETUP(setup_callback, NULL);
     SET_TEARDOWN(teardown_callback, NULL);
@@ -262,6 +320,8 @@ SUITE(fill_ellipse_suite) {
     RUN_TEST(test_fill_ellipse_clip_outside);
     RUN_TEST(test_fill_ellipse_custom_clip);
     RUN_TEST(test_fill_ellipse_custom_clip_regression);
+    RUN_TEST(test_fill_ellipse_span_order);
+    RUN_TEST(test_fill_ellipse_thin);
 }
 
 GREATEST_MAIN_DEFS();
@@ -514,6 +514,45 @@ TEST test_fill_polygon_trapezoid_regression(void) {
     PASS();
 }
 
+/*
+ * Comb with 20 teeth has more horizontal edges on the top row than
+ * can be merged. The rest are still drawn:
+ *
+ * (10,10)-(13,10) (18,10)-(21,10) ...
+ *   |#######|       |#######|
+ *   |#######(13,20)-(18,20)#|
+ *   |#######################|
+ * (10,30)---------------------(165,30)
+ */
+TEST test_fill_polygon_comb(void) {
+    int16_t vertices[(2 + 20 * 4) * 2];
+    int16_t amount = 0;
+
+    vertices[amount * 2] = 10;
+    vertices[amount * 2 + 1] = 30;
+    amount++;
+    for (int16_t t = 0; t < 20; t++) {
+        int16_t x = 10 + t * 8;
+        int16_t tooth[] = {x, 10, x + 3, 10, x + 3, 20, x + 8, 20};
+        memcpy(&vertices[amount * 2], tooth, sizeof(tooth));
+        amount += 4;
+    }
+    vertices[amount * 2 - 2] = 165;
+    vertices[amount * 2 - 1] = 30;
+
+    hagl_fill_polygon(&bitmap, amount, vertices, 0xFFFF);
+
+    uint16_t filled = 0;
+    for (int16_t x = 0; x < TEST_WIDTH; x++) {
+        filled += 0xFFFF == hagl_get_pixel(&bitmap, x, 10);
+    }
+    ASSERT_EQ(20 * 4, filled);
+    ASSERT_EQ(0xFFFF, hagl_get_pixel(&bitmap, 165, 10));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&bitmap, 166, 10));
+
+    PASS();
+}
+
 TEST test_fill_polygon_degenerate_zero_vertices(void) {
     int16_t vertices[] = {0, 0};
     hagl_fill_polygon(&bitmap, 0, vertices, 0xFFFF);
@@ -563,6 +602,7 @@ SUITE(fill_polygon_suite) {
     RUN_TEST(test_fill_polygon_clip_outside);
     RUN_TEST(test_fill_polygon_trapezoid);
     RUN_TEST(test_fill_polygon_trapezoid_regression);
+    RUN_TEST(test_fill_polygon_comb);
     RUN_TEST(test_fill_polygon_degenerate_zero_vertices);
     RUN_TEST(test_fill_polygon_degenerate_one_vertex);
     RUN_TEST(test_fill_polygon_degenerate_two_vertices);
@@ -0,0 +1,442 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "save_image.h"
+
+#include "hagl/bitmap.h"
+#include "hagl/blit.h"
+#include "hagl/clip.h"
+#include "hagl/color.h"
+#include "hagl/format.h"
+#include "hagl/pixel.h"
+
+#define TEST_WIDTH 320
+#define TEST_HEIGHT 240
+#define TEST_DEPTH 16
+
+static const uint8_t formats[] = {
+    HAGL_FORMAT_RGB332,
+    HAGL_FORMAT_RGB565,
+    HAGL_FORMAT_RGB565_SWAPPED,
+    HAGL_FORMAT_RGB888,
+    HAGL_FORMAT_ARGB8888,
+};
+
+/* Pure colors survive conversion to any format and back. */
+static const uint32_t colors[] = {
+    0xFF000000, 0xFFFFFFFF, 0xFFFF0000, 0xFF00FF00, 0xFF0000FF, 0xFFFF00FF,
+};
+
+static hagl_bitmap_t surface;
+static uint8_t surface_buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+
+static void setup_callback(void *data) {
+    memset(surface_buffer, 0, sizeof(surface_buffer));
+    hagl_bitmap_init(&surface, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, surface_buffer);
+}
+
+static void teardown_callback(void *data) {
+    char filename[256];
+    snprintf(filename, sizeof(filename), "output/%s.png", greatest_info.name_buf);
+    save_image(&surface, filename);
+}
+
+/* RGB888 pixel is stored least significant byte first. */
+static void put_rgb888(hagl_bitmap_t *bitmap, int16_t x, int16_t y, uint32_t rgb) {
+    uint8_t *pixel = bitmap->buffer + bitmap->pitch * y + x * 3;
+    pixel[0] = rgb;
+    pixel[1] = rgb >> 8;
+    pixel[2] = rgb >> 16;
+}
+
+TEST test_format_depth(void) {
+    ASSERT_EQ(8, hagl_format_depth(HAGL_FORMAT_RGB332));
+    ASSERT_EQ(16, hagl_format_depth(HAGL_FORMAT_RGB565));
+    ASSERT_EQ(16, hagl_format_depth(HAGL_FORMAT_RGB565_SWAPPED));
+    ASSERT_EQ(24, hagl_format_depth(HAGL_FORMAT_RGB888));
+    ASSERT_EQ(32, hagl_format_depth(HAGL_FORMAT_ARGB8888));
+    ASSERT_EQ(0, hagl_format_depth(HAGL_FORMAT_NATIVE));
+
+    ASSERT_EQ(HAGL_FORMAT_RGB565_SWAPPED, hagl_native_format(16));
+    ASSERT_EQ(HAGL_FORMAT_RGB565_SWAPPED, hagl_bitmap_format(&surface));
+
+    PASS();
+}
+
+TEST test_convert_rgb888_to_rgb565(void) {
+    const uint8_t rgb[] = {0x00, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0x00};
+    uint16_t rgb565[3];
+
+    hagl_convert(rgb565, HAGL_FORMAT_RGB565, rgb, HAGL_FORMAT_RGB888, 3);
+    ASSERT_EQ(0xF800, rgb565[0]);
+    ASSERT_EQ(0x07E0, rgb565[1]);
+    ASSERT_EQ(0x001F, rgb565[2]);
+
+    hagl_convert(rgb565, HAGL_FORMAT_RGB565_SWAPPED, rgb, HAGL_FORMAT_RGB888, 3);
+    ASSERT_EQ(0x00F8, rgb565[0]);
+    ASSERT_EQ(0xE007, rgb565[1]);
+    ASSERT_EQ(0x1F00, rgb565[2]);
+
+    PASS();
+}
+
+TEST test_convert_round_trip(void) {
+    const uint8_t count = sizeof(colors) / sizeof(colors[0]);
+    uint8_t converted[sizeof(colors)];
+    uint32_t argb[sizeof(colors) / sizeof(colors[0])];
+
+    for (uint8_t i = 0; i < sizeof(formats); i++) {
+        hagl_convert(converted, formats[i], colors, HAGL_FORMAT_ARGB8888, count);
+        hagl_convert(argb, HAGL_FORMAT_ARGB8888, converted, formats[i], count);
+        ASSERT_MEM_EQ(colors, argb, sizeof(colors));
+
+        /* Every format to every other format and back. */
+        for (uint8_t j = 0; j < sizeof(formats); j++) {
+            uint8_t other[sizeof(colors)];
+            hagl_convert(other, formats[j], converted, formats[i], count);
+            hagl_convert(converted, formats[i], other, formats[j], count);
+            hagl_convert(argb, HAGL_FORMAT_ARGB8888, converted, formats[i], count);
+            ASSERT_MEM_EQ(colors, argb, sizeof(colors));
+        }
+    }
+
+    PASS();
+}
+
+TEST test_convert_widens(void) {
+    const uint16_t rgb565 = 0x8410;
+    uint32_t argb;
+
+    /* Half intensity gray, high bits are replicated to the low bits. */
+    hagl_convert(&argb, HAGL_FORMAT_ARGB8888, &rgb565, HAGL_FORMAT_RGB565, 1);
+    ASSERT_EQ(0xFF848284, argb);
+
+    PASS();
+}
+
+TEST test_blit_rgb888(void) {
+    static uint8_t buffer[4 * 3 * 3];
+    hagl_bitmap_t source;
+
+    hagl_bitmap_init_format(&source, 4, 3, HAGL_FORMAT_RGB888, buffer);
+    ASSERT_EQ(24, source.depth);
+    ASSERT_EQ(12, source.pitch);
+
+    for (int16_t y = 0; y < 3; y++) {
+        for (int16_t x = 0; x < 4; x++) {
+            put_rgb888(&source, x, y, (x * 64) << 16 | (y * 100) << 8 | 0x80);
+        }
+    }
+
+    hagl_blit(&surface, 10, 20, &source);
+
+    for (int16_t y = 0; y < 3; y++) {
+        for (int16_t x = 0; x < 4; x++) {
+            hagl_color_t expected = hagl_color(&surface, x * 64, y * 100, 0x80);
+            ASSERT_EQ(expected, hagl_get_pixel(&surface, 10 + x, 20 + y));
+        }
+    }
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 14, 20));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 10, 23));
+
+    PASS();
+}
+
+/* Converted rows land on the rows of a surface narrower than hagl_color_t. */
+TEST test_blit_rgb332_surface(void) {
+    static uint8_t buffer[4 * 3 * 3];
+    static uint8_t rgb332_buffer[8 * 6];
+    hagl_bitmap_t source;
+    hagl_bitmap_t rgb332;
+
+    hagl_bitmap_init_format(&source, 4, 3, HAGL_FORMAT_RGB888, buffer);
+    for (int16_t y = 0; y < 3; y++) {
+        for (int16_t x = 0; x < 4; x++) {
+            put_rgb888(&source, x, y, (x * 64) << 16 | (y * 100) << 8 | 0x80);
+        }
+    }
+
+    memset(rgb332_buffer, 0, sizeof(rgb332_buffer));
+    hagl_bitmap_init(&rgb332, 8, 6, 8, rgb332_buffer);
+    hagl_blit(&rgb332, 2, 1, &source);
+
+    for (int16_t y = 0; y < 3; y++) {
+        for (int16_t x = 0; x < 4; x++) {
+            uint8_t expected = (x * 64) >> 5 << 5 | (y * 100) >> 5 << 2 | 0x80 >> 6;
+            ASSERT_EQ(expected, rgb332_buffer[(1 + y) * 8 + 2 + x]);
+        }
+    }
+    ASSERT_EQ(0x00, rgb332_buffer[1 * 8 + 6]);
+    ASSERT_EQ(0x00, rgb332_buffer[4 * 8 + 2]);
+
+    PASS();
+}
+
+/*
+ * Source offset uses source depth and rows advance by source pitch:
+ *
+ * (-2,-1)------(1,-1)
+ *   |    (0,0)--(1,0)
+ * (-2,2)-------(1,2)
+ */
+TEST test_bitmap_blit_clipped(void) {
+    static uint8_t buffer[4 * 4 * 3];
+    hagl_bitmap_t source;
+
+    hagl_bitmap_init_format(&source, 4, 4, HAGL_FORMAT_RGB888, buffer);
+    for (int16_t y = 0; y < 4; y++) {
+        for (int16_t x = 0; x < 4; x++) {
+            put_rgb888(&source, x, y, (x * 80) << 16 | (y * 80) << 8);
+        }
+    }
+
+    surface.blit(&surface, -2, -1, &source);
+
+    for (int16_t y = 0; y < 3; y++) {
+        for (int16_t x = 0; x < 2; x++) {
+            hagl_color_t expected = hagl_color(&surface, (x + 2) * 80, (y + 1) * 80, 0);
+            ASSERT_EQ(expected, hagl_get_pixel(&surface, x, y));
+        }
+    }
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 2, 0));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 0, 3));
+
+    PASS();
+}
+
+/*
+ * Scale blit of a 2x2 ARGB8888 source into a 4x4 region at (30,30),
+ * partially outside of the clip window.
+ */
+TEST test_blit_scaled_argb8888(void) {
+    uint32_t buffer[] = {0xFFFF0000, 0xFF00FF00, 0xFF0000FF, 0xFFFFFFFF};
+    hagl_bitmap_t source;
+
+    hagl_bitmap_init_format(&source, 2, 2, HAGL_FORMAT_ARGB8888, buffer);
+    hagl_blit_xywh(&surface, 30, 30, 4, 4, &source);
+
+    ASSERT_EQ(hagl_color(&surface, 255, 0, 0), hagl_get_pixel(&surface, 31, 31));
+    ASSERT_EQ(hagl_color(&surface, 0, 255, 0), hagl_get_pixel(&surface, 32, 30));
+    ASSERT_EQ(hagl_color(&surface, 0, 0, 255), hagl_get_pixel(&surface, 30, 33));
+    ASSERT_EQ(hagl_color(&surface, 255, 255, 255), hagl_get_pixel(&surface, 33, 33));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 34, 33));
+
+    hagl_set_clip(&surface, 0, 0, 40, 40);
+    hagl_blit_xywh(&surface, 39, 39, 4, 4, &source);
+    ASSERT_EQ(hagl_color(&surface, 255, 0, 0), hagl_get_pixel(&surface, 40, 40));
+    hagl_set_clip(&surface, 0, 0, TEST_WIDTH - 1, TEST_HEIGHT - 1);
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 41, 40));
+
+    PASS();
+}
+
+/* Red level of a RGB565 pixel. */
+static uint8_t red565(uint16_t pixel) {
+    return pixel >> 11;
+}
+
+/* Flat gray between two levels is dithered to half and half. */
+TEST test_dither_ordered(void) {
+    uint8_t rgb[4 * 3];
+    uint16_t rgb565[4];
+    uint8_t high = 0;
+    hagl_dither_t dither;
+
+    memset(rgb, 132, sizeof(rgb));
+    hagl_dither_init(&dither, HAGL_DITHER_ORDERED, NULL, 4);
+
+    for (int16_t y = 0; y < 4; y++) {
+        hagl_dither_row(&dither, 0, y);
+        hagl_convert_dither(
+            rgb565, HAGL_FORMAT_RGB565, rgb, HAGL_FORMAT_RGB888, 4, &dither
+        );
+        for (uint8_t x = 0; x < 4; x++) {
+            ASSERT(16 == red565(rgb565[x]) || 17 == red565(rgb565[x]));
+            high += 17 == red565(rgb565[x]);
+        }
+    }
+    ASSERT_EQ(8, high);
+
+    PASS();
+}
+
+/* Average of the dithered rows stays close to the original color. */
+TEST test_dither_diffusion(void) {
+    static uint8_t rgb[100 * 3];
+    static int16_t errors[HAGL_DITHER_ERRORS(100)];
+    uint8_t rgb332[100];
+    uint32_t sum = 0;
+    hagl_dither_t dither;
+
+    memset(rgb, 100, sizeof(rgb));
+    hagl_dither_init(&dither, HAGL_DITHER_DIFFUSION, errors, 100);
+    ASSERT_EQ(HAGL_DITHER_DIFFUSION, dither.mode);
+
+    for (int16_t y = 0; y < 10; y++) {
+        hagl_dither_row(&dither, 0, y);
+        /* Row is converted in two parts which continue each other. */
+        hagl_convert_dither(
+            rgb332, HAGL_FORMAT_RGB332, rgb, HAGL_FORMAT_RGB888, 30, &dither
+        );
+        hagl_convert_dither(
+            rgb332 + 30, HAGL_FORMAT_RGB332, rgb + 90, HAGL_FORMAT_RGB888, 70, &dither
+        );
+        for (uint8_t x = 0; x < 100; x++) {
+            uint8_t b = rgb332[x] & 0x03;
+            sum += b * 0x55;
+        }
+    }
+
+    /* Without dithering every pixel would have blue of 85. */
+    ASSERT_IN_RANGE(100, sum / 1000, 2);
+
+    PASS();
+}
+
+TEST test_dither_fallback(void) {
+    const uint8_t rgb[] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC};
+    uint16_t expected[2];
+    uint16_t rgb565[2];
+    hagl_dither_t dither;
+
+    /* Error diffusion without error buffer is ordered dithering. */
+    hagl_dither_init(&dither, HAGL_DITHER_DIFFUSION, NULL, 2);
+    ASSERT_EQ(HAGL_DITHER_ORDERED, dither.mode);
+
+    /* No dithering and formats which are not dithered convert as is. */
+    hagl_dither_init(&dither, HAGL_DITHER_NONE, NULL, 2);
+    hagl_convert(expected, HAGL_FORMAT_RGB565, rgb, HAGL_FORMAT_RGB888, 2);
+    hagl_convert_dither(rgb565, HAGL_FORMAT_RGB565, rgb, HAGL_FORMAT_RGB888, 2, &dither);
+    ASSERT_MEM_EQ(expected, rgb565, sizeof(rgb565));
+    hagl_convert_dither(rgb565, HAGL_FORMAT_RGB565, rgb, HAGL_FORMAT_RGB888, 2, NULL);
+    ASSERT_MEM_EQ(expected, rgb565, sizeof(rgb565));
+
+    uint8_t copy[6];
+    hagl_dither_init(&dither, HAGL_DITHER_ORDERED, NULL, 2);
+    hagl_convert_dither(copy, HAGL_FORMAT_RGB888, rgb, HAGL_FORMAT_RGB888, 2, &dither);
+    ASSERT_MEM_EQ(rgb, copy, sizeof(rgb));
+
+    PASS();
+}
+
+/* Narrowing in place gives the same result as converting to another buffer. */
+TEST test_dither_in_place(void) {
+    static uint8_t rgb[200 * 3];
+    uint16_t expected[200];
+    hagl_dither_t dither;
+
+    for (uint16_t i = 0; i < sizeof(rgb); i++) {
+        rgb[i] = i * 7;
+    }
+
+    hagl_dither_init(&dither, HAGL_DITHER_ORDERED, NULL, 200);
+    hagl_dither_row(&dither, 3, 5);
+    hagl_convert_dither(
+        expected, HAGL_FORMAT_RGB565, rgb, HAGL_FORMAT_RGB888, 200, &dither
+    );
+
+    hagl_dither_row(&dither, 3, 5);
+    hagl_convert_dither(rgb, HAGL_FORMAT_RGB565, rgb, HAGL_FORMAT_RGB888, 200, &dither);
+    ASSERT_MEM_EQ(expected, rgb, sizeof(expected));
+
+    PASS();
+}
+
+/* Dithered blit stays within one level of the truncated blit. */
+TEST test_blit_dither(void) {
+    static uint8_t buffer[64 * 8 * 3];
+    static int16_t errors[HAGL_DITHER_ERRORS(64)];
+    hagl_bitmap_t source;
+    hagl_dither_t dither;
+    uint32_t dithered = 0;
+    uint32_t original = 0;
+
+    hagl_bitmap_init_format(&source, 64, 8, HAGL_FORMAT_RGB888, buffer);
+    for (int16_t y = 0; y < 8; y++) {
+        for (int16_t x = 0; x < 64; x++) {
+            put_rgb888(&source, x, y, (x * 4 + 2) << 16);
+            original += x * 4 + 2;
+        }
+    }
+
+    hagl_dither_init(&dither, HAGL_DITHER_DIFFUSION, errors, 64);
+    hagl_blit_dither(&surface, 10, 10, &source, &dither);
+    hagl_blit(&surface, 10, 20, &source);
+
+    for (int16_t y = 0; y < 8; y++) {
+        for (int16_t x = 0; x < 64; x++) {
+            uint16_t pixel = hagl_get_pixel(&surface, 10 + x, 10 + y);
+            uint16_t reference = hagl_get_pixel(&surface, 10 + x, 20 + y);
+            uint8_t red = red565((pixel >> 8) | (pixel << 8));
+            uint8_t expected = red565((reference >> 8) | (reference << 8));
+
+            ASSERT_IN_RANGE(expected, red, 1);
+            dithered += (red << 3) | (red >> 2);
+        }
+    }
+
+    /* Average of the dithered pixels is the average of the original. */
+    ASSERT_IN_RANGE(original / 512, dithered / 512, 1);
+
+    PASS();
+}
+
+SUITE(format_suite) {
+    SET_SETUP(setup_callback, NULL);
+    SET_TEARDOWN(teardown_callback, NULL);
+    RUN_TEST(test_format_depth);
+    RUN_TEST(test_convert_rgb888_to_rgb565);
+    RUN_TEST(test_convert_round_trip);
+    RUN_TEST(test_convert_widens);
+    RUN_TEST(test_blit_rgb888);
+    RUN_TEST(test_blit_rgb332_surface);
+    RUN_TEST(test_bitmap_blit_clipped);
+    RUN_TEST(test_blit_scaled_argb8888);
+    RUN_TEST(test_dither_ordered);
+    RUN_TEST(test_dither_diffusion);
+    RUN_TEST(test_dither_fallback);
+    RUN_TEST(test_dither_in_place);
+    RUN_TEST(test_blit_dither);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+    GREATEST_MAIN_BEGIN();
+    RUN_SUITE(format_suite);
+    GREATEST_MAIN_END();
+}
@@ -0,0 +1,259 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "save_image.h"
+
+#include "hagl/bitmap.h"
+#include "hagl/char.h"
+#include "hagl/pixel.h"
+#include "hagl/rectangle.h"
+#include "hfont.h"
+
+#define TEST_WIDTH 320
+#define TEST_HEIGHT 240
+#define TEST_DEPTH 16
+
+/*
+ * Two bits per pixel font with two code ranges.
+ *
+ * A  width 4, height 2, offset (1, 2), advance 6
+ *    3 3 3 0
+ *    0 2 0 3
+ * B  width 1, height 1, offset (0, 0), advance 3
+ *    3
+ * •  width 2, height 2, offset (0, 1), advance 4
+ *    1 1
+ *    1 1
+ */
+// clang-format off
+static const uint8_t font[] = {
+    'H', 'F', 'N', 'T', 0x01, 0x02, 0x06, 0x05, 0x02, 0x00, 0x03, 0x00,
+    0x41, 0x00, 0x42, 0x00, 0x00, 0x00,
+    0x22, 0x20, 0x22, 0x20, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x04, 0x02, 0x01, 0x02, 0x06,
+    0x02, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x03,
+    0x03, 0x00, 0x00, 0x02, 0x02, 0x00, 0x01, 0x04,
+    0xfc, 0x23, 0xc0, 0x55,
+};
+// clang-format on
+
+static hagl_bitmap_t surface;
+static uint8_t surface_buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+
+static void setup_callback(void *data) {
+    memset(surface_buffer, 0, sizeof(surface_buffer));
+    hagl_bitmap_init(&surface, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, surface_buffer);
+}
+
+static void teardown_callback(void *data) {
+    char filename[256];
+    snprintf(filename, sizeof(filename), "output/%s.png", greatest_info.name_buf);
+    save_image(&surface, filename);
+}
+
+TEST test_meta(void) {
+    hfont_meta_t meta;
+
+    ASSERT_EQ(HFONT_OK, hfont_meta(&meta, font));
+    ASSERT_EQ(2, meta.bpp);
+    ASSERT_EQ(6, meta.height);
+    ASSERT_EQ(5, meta.ascent);
+    ASSERT_EQ(2, meta.ranges);
+    ASSERT_EQ(3, meta.glyphs);
+
+    PASS();
+}
+
+TEST test_meta_invalid_signature(void) {
+    const uint8_t fontx[] = {'F', 'O', 'N', 'T', 'X', '2'};
+    hfont_meta_t meta;
+
+    ASSERT_FALSE(hfont_is_hfont(fontx));
+    ASSERT_EQ(HFONT_ERR_SIGNATURE, hfont_meta(&meta, fontx));
+
+    PASS();
+}
+
+TEST test_glyph(void) {
+    hfont_glyph_t glyph;
+
+    ASSERT_EQ(HFONT_OK, hfont_glyph(&glyph, 0x41, font, NULL));
+    ASSERT_EQ(4, glyph.width);
+    ASSERT_EQ(2, glyph.height);
+    ASSERT_EQ(1, glyph.x_offset);
+    ASSERT_EQ(2, glyph.y_offset);
+    ASSERT_EQ(6, glyph.advance);
+    ASSERT_EQ(2, glyph.bpp);
+    ASSERT_EQ(0xfc, glyph.buffer[0]);
+
+    ASSERT_EQ(HFONT_OK, hfont_glyph(&glyph, 0x2022, font, NULL));
+    ASSERT_EQ(2, glyph.width);
+    ASSERT_EQ(4, glyph.advance);
+    ASSERT_EQ(0x55, glyph.buffer[0]);
+
+    PASS();
+}
+
+/* Hint is updated to the range of the last successful lookup. */
+TEST test_glyph_hint(void) {
+    hfont_glyph_t glyph;
+    uint16_t hint = 0;
+
+    ASSERT_EQ(HFONT_OK, hfont_glyph(&glyph, 0x2022, font, &hint));
+    ASSERT_EQ(1, hint);
+    ASSERT_EQ(0x55, glyph.buffer[0]);
+
+    ASSERT_EQ(HFONT_OK, hfont_glyph(&glyph, 0x42, font, &hint));
+    ASSERT_EQ(0, hint);
+    ASSERT_EQ(0xc0, glyph.buffer[0]);
+
+    /* Out of bounds hint falls back to search. */
+    hint = 100;
+    ASSERT_EQ(HFONT_OK, hfont_glyph(&glyph, 0x41, font, &hint));
+    ASSERT_EQ(0, hint);
+
+    PASS();
+}
+
+TEST test_glyph_not_found(void) {
+    hfont_glyph_t glyph;
+    uint16_t hint = 0;
+
+    ASSERT_EQ(HFONT_ERR_GLYPH_NOT_FOUND, hfont_glyph(&glyph, 0x40, font, NULL));
+    ASSERT_EQ(HFONT_ERR_GLYPH_NOT_FOUND, hfont_glyph(&glyph, 0x43, font, &hint));
+    ASSERT_EQ(HFONT_ERR_GLYPH_NOT_FOUND, hfont_glyph(&glyph, 0x2023, font, &hint));
+    ASSERT_EQ(0, hint);
+
+    PASS();
+}
+
+TEST test_put_char_returns_advance(void) {
+    ASSERT_EQ(6, hagl_put_char(&surface, 0x41, 0, 0, 0xF800, font));
+    ASSERT_EQ(3, hagl_put_char(&surface, 0x42, 0, 0, 0xF800, font));
+    ASSERT_EQ(0, hagl_put_char(&surface, 0x43, 0, 0, 0xF800, font));
+
+    PASS();
+}
+
+/* Glyph is offset inside the cell and partial coverage is blended. */
+TEST test_put_char_pixels(void) {
+    hagl_fill_rectangle_xywh(&surface, 0, 0, 40, 40, 0x001F);
+    hagl_put_char(&surface, 0x41, 10, 10, 0xF800, font);
+
+    /* Row 0: 3 3 3 0 */
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 11, 12));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 12, 12));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 13, 12));
+    ASSERT_EQ(0x001F, hagl_get_pixel(&surface, 14, 12));
+
+    /* Row 1: 0 2 0 3 */
+    ASSERT_EQ(0x001F, hagl_get_pixel(&surface, 11, 13));
+    ASSERT_EQ(
+        hagl_blend(&surface, 0xF800, 0x001F, 170), hagl_get_pixel(&surface, 12, 13)
+    );
+    ASSERT_EQ(0x001F, hagl_get_pixel(&surface, 13, 13));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 14, 13));
+
+    /* Offset area of the cell is left untouched. */
+    ASSERT_EQ(0x001F, hagl_get_pixel(&surface, 10, 10));
+    ASSERT_EQ(0x001F, hagl_get_pixel(&surface, 10, 12));
+
+    PASS();
+}
+
+/* Offsets and advance are scaled, blended pixels become blended blocks. */
+TEST test_put_char_scaled(void) {
+    hagl_color_t blended = hagl_blend(&surface, 0xF800, 0x0000, 170);
+
+    ASSERT_EQ(12, hagl_put_char_scaled(&surface, 0x41, 10, 10, 0xF800, font, 2));
+
+    /* Row 0: 3 3 3 0 */
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 11, 14));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 12, 14));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 17, 15));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 18, 14));
+
+    /* Row 1: 0 2 0 3 */
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 12, 16));
+    ASSERT_EQ(blended, hagl_get_pixel(&surface, 14, 16));
+    ASSERT_EQ(blended, hagl_get_pixel(&surface, 15, 17));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 16, 16));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 19, 17));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 19, 18));
+
+    PASS();
+}
+
+TEST test_put_text_width(void) {
+    ASSERT_EQ(9, hagl_put_text(&surface, L"AB", 0, 0, 0xF800, font));
+    ASSERT_EQ(13, hagl_put_text(&surface, L"A\x2022" L"B", 0, 20, 0xF800, font));
+
+    PASS();
+}
+
+/* LF advances y by the line height of the font. */
+TEST test_put_text_lf(void) {
+    hagl_put_text(&surface, L"A\nA", 0, 0, 0xF800, font);
+
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 1, 2));
+    ASSERT_EQ(0xF800, hagl_get_pixel(&surface, 1, 8));
+
+    PASS();
+}
+
+SUITE(hfont_suite) {
+    SET_SETUP(setup_callback, NULL);
+    SET_TEARDOWN(teardown_callback, NULL);
+    RUN_TEST(test_meta);
+    RUN_TEST(test_meta_invalid_signature);
+    RUN_TEST(test_glyph);
+    RUN_TEST(test_glyph_hint);
+    RUN_TEST(test_glyph_not_found);
+    RUN_TEST(test_put_char_returns_advance);
+    RUN_TEST(test_put_char_pixels);
+    RUN_TEST(test_put_char_scaled);
+    RUN_TEST(test_put_text_width);
+    RUN_TEST(test_put_text_lf);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+    GREATEST_MAIN_BEGIN();
+    RUN_SUITE(hfont_suite);
+    GREATEST_MAIN_END();
+}
@@ -0,0 +1,235 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crc32.h"
+#include "greatest.h"
+#include "save_image.h"
+
+#include "hagl.h"
+#include "hagl/bitmap.h"
+#include "hagl/blit.h"
+#include "hagl/clip.h"
+#include "hagl/pixel.h"
+#include "hrle.h"
+
+#define TEST_WIDTH 320
+#define TEST_HEIGHT 240
+#define TEST_DEPTH 16
+
+#define BACKGROUND 0x1234
+
+/*
+ * 6x3 bitmap with 0xf81f as the transparent color, T below.
+ *
+ *    ffff ffff ffff ffff ffff ffff    run of 6
+ *    001f 07e0 T    T    f800 f800    literal of 2, run of 2, run of 2
+ *    0001 0002 T    0003 0004 0005    literal of 6
+ */
+// clang-format off
+static const uint8_t rle[] = {
+    'H', 'R', 'L', 'E', 0x01, 0x10, 0x06, 0x00, 0x03, 0x00, 0x01, 0x00,
+    0x1f, 0xf8, 0x00, 0x00,
+    0x85, 0xff, 0xff,
+    0x01, 0x1f, 0x00, 0xe0, 0x07, 0x81, 0x1f, 0xf8, 0x81, 0x00, 0xf8,
+    0x05, 0x01, 0x00, 0x02, 0x00, 0x1f, 0xf8, 0x03, 0x00, 0x04, 0x00, 0x05, 0x00,
+};
+
+static const hagl_color_t raw[] = {
+    0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,
+    0x001f, 0x07e0, BACKGROUND, BACKGROUND, 0xf800, 0xf800,
+    0x0001, 0x0002, BACKGROUND, 0x0003, 0x0004, 0x0005,
+};
+// clang-format on
+
+static hagl_bitmap_t surface;
+static uint8_t surface_buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+
+static hagl_bitmap_t reference;
+static uint8_t reference_buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+
+static void fill(hagl_bitmap_t *bitmap) {
+    for (int16_t y = 0; y < bitmap->height; y++) {
+        for (int16_t x = 0; x < bitmap->width; x++) {
+            hagl_put_pixel(bitmap, x, y, BACKGROUND);
+        }
+    }
+}
+
+static void setup_callback(void *data) {
+    hagl_bitmap_init(&surface, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, surface_buffer);
+    hagl_bitmap_init(&reference, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, reference_buffer);
+    fill(&surface);
+    fill(&reference);
+}
+
+static void teardown_callback(void *data) {
+    char filename[256];
+    snprintf(filename, sizeof(filename), "output/%s.png", greatest_info.name_buf);
+    save_image(&surface, filename);
+}
+
+/* Draw the raw pixels one by one as the expected result. */
+static void draw_reference(int16_t x0, int16_t y0) {
+    for (int16_t y = 0; y < 3; y++) {
+        for (int16_t x = 0; x < 6; x++) {
+            hagl_put_pixel(&reference, x0 + x, y0 + y, raw[y * 6 + x]);
+        }
+    }
+}
+
+TEST test_meta(void) {
+    hrle_meta_t meta;
+
+    ASSERT_EQ(HRLE_OK, hrle_meta(&meta, rle));
+    ASSERT_EQ(16, meta.depth);
+    ASSERT_EQ(6, meta.width);
+    ASSERT_EQ(3, meta.height);
+    ASSERT(meta.transparent);
+    ASSERT_EQ(0xf81f, meta.color);
+    ASSERT_EQ(&rle[HRLE_DATA_START], meta.data);
+    PASS();
+}
+
+TEST test_meta_invalid(void) {
+    hrle_meta_t meta;
+    uint8_t data[sizeof(rle)];
+
+    memcpy(data, rle, sizeof(rle));
+    data[HRLE_DEPTH] = 12;
+    ASSERT_EQ(HRLE_ERR_DEPTH, hrle_meta(&meta, data));
+
+    data[0] = 'X';
+    ASSERT_EQ(HRLE_ERR_SIGNATURE, hrle_meta(&meta, data));
+    PASS();
+}
+
+TEST test_blit_rle(void) {
+    ASSERT_EQ(HAGL_OK, hagl_blit_rle(&surface, 10, 20, rle));
+    draw_reference(10, 20);
+
+    ASSERT_EQ(0xffff, hagl_get_pixel(&surface, 10, 20));
+    ASSERT_EQ(0xffff, hagl_get_pixel(&surface, 15, 20));
+    ASSERT_EQ(0x07e0, hagl_get_pixel(&surface, 11, 21));
+    ASSERT_EQ(0xf800, hagl_get_pixel(&surface, 15, 21));
+    ASSERT_EQ(0x0005, hagl_get_pixel(&surface, 15, 22));
+    ASSERT_EQ(BACKGROUND, hagl_get_pixel(&surface, 16, 20));
+    ASSERT_EQ(BACKGROUND, hagl_get_pixel(&surface, 10, 23));
+
+    ASSERT_EQ(
+        crc32(reference.buffer, reference.size), crc32(surface.buffer, surface.size)
+    );
+    PASS();
+}
+
+TEST test_blit_rle_transparent(void) {
+    hagl_blit_rle(&surface, 0, 0, rle);
+
+    /* Transparent run and literal pixel keep the background. */
+    ASSERT_EQ(BACKGROUND, hagl_get_pixel(&surface, 2, 1));
+    ASSERT_EQ(BACKGROUND, hagl_get_pixel(&surface, 3, 1));
+    ASSERT_EQ(BACKGROUND, hagl_get_pixel(&surface, 2, 2));
+    PASS();
+}
+
+/*
+ * Clip window cuts the bitmap from every side:
+ *
+ *    ffff [ffff ffff ffff ffff] ffff
+ *    001f [07e0 T    T    f800] f800
+ *    0001  0002 T    0003 0004  0005
+ */
+TEST test_blit_rle_clip(void) {
+    hagl_set_clip(&surface, 51, 40, 54, 41);
+    hagl_set_clip(&reference, 51, 40, 54, 41);
+
+    hagl_blit_rle(&surface, 50, 40, rle);
+    draw_reference(50, 40);
+
+    /* Reading pixels is also clipped. */
+    hagl_set_clip(&surface, 0, 0, TEST_WIDTH - 1, TEST_HEIGHT - 1);
+
+    ASSERT_EQ(BACKGROUND, hagl_get_pixel(&surface, 50, 40));
+    ASSERT_EQ(0xffff, hagl_get_pixel(&surface, 51, 40));
+    ASSERT_EQ(0xf800, hagl_get_pixel(&surface, 54, 41));
+    ASSERT_EQ(BACKGROUND, hagl_get_pixel(&surface, 55, 41));
+    ASSERT_EQ(BACKGROUND, hagl_get_pixel(&surface, 53, 42));
+
+    ASSERT_EQ(
+        crc32(reference.buffer, reference.size), crc32(surface.buffer, surface.size)
+    );
+
+    /* Rows above the clip window are skipped. */
+    fill(&surface);
+    fill(&reference);
+    hagl_set_clip(&surface, 51, 40, 54, 41);
+
+    hagl_blit_rle(&surface, 50, 39, rle);
+    draw_reference(50, 39);
+
+    ASSERT_EQ(0x07e0, hagl_get_pixel(&surface, 51, 40));
+    ASSERT_EQ(
+        crc32(reference.buffer, reference.size), crc32(surface.buffer, surface.size)
+    );
+    PASS();
+}
+
+TEST test_blit_rle_depth_mismatch(void) {
+    hagl_bitmap_t small;
+    uint8_t small_buffer[8 * 8];
+
+    hagl_bitmap_init(&small, 8, 8, 8, small_buffer);
+    ASSERT_EQ(HAGL_ERR_GENERAL, hagl_blit_rle(&small, 0, 0, rle));
+    PASS();
+}
+
+SUITE(hrle_suite) {
+    SET_SETUP(setup_callback, NULL);
+    SET_TEARDOWN(teardown_callback, NULL);
+    RUN_TEST(test_meta);
+    RUN_TEST(test_meta_invalid);
+    RUN_TEST(test_blit_rle);
+    RUN_TEST(test_blit_rle_transparent);
+    RUN_TEST(test_blit_rle_clip);
+    RUN_TEST(test_blit_rle_depth_mismatch);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+    GREATEST_MAIN_BEGIN();
+    RUN_SUITE(hrle_suite);
+    GREATEST_MAIN_END();
+}
@@ -0,0 +1,149 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "greatest.h"
+
+#include "hsl.h"
+#include "rgb888.h"
+
+/* Largest difference of any channel. */
+static int16_t rgb_distance(rgb_t a, rgb_t b) {
+    int16_t distance = abs(a.r - b.r);
+    distance = max(distance, abs(a.g - b.g));
+    return max(distance, abs(a.b - b.b));
+}
+
+TEST test_rgb888_to_hsl_primaries(void) {
+    rgb_t red = {255, 0, 0};
+    rgb_t green = {0, 255, 0};
+    rgb_t blue = {0, 0, 255};
+    rgb_t gray = {128, 128, 128};
+    hsl_t hsl;
+
+    /* Used to return gray for everything. */
+    hsl = rgb888_to_hsl(&red);
+    ASSERT_EQ(0, (int)hsl.h);
+    ASSERT_EQ(255, (int)hsl.s);
+    ASSERT_EQ(127, (int)hsl.l);
+
+    hsl = rgb888_to_hsl(&green);
+    ASSERT_EQ(85, (int)hsl.h);
+
+    hsl = rgb888_to_hsl(&blue);
+    ASSERT_EQ(170, (int)hsl.h);
+
+    hsl = rgb888_to_hsl(&gray);
+    ASSERT_EQ(0, (int)hsl.s);
+    ASSERT_EQ(127, (int)hsl.l);
+
+    PASS();
+}
+
+TEST test_hsl8_to_rgb888(void) {
+    for (uint16_t h = 0; h < 256; h++) {
+        for (uint16_t s = 0; s < 256; s += 3) {
+            for (uint16_t l = 0; l < 256; l += 5) {
+                hsl_t hsl = {h, s, l};
+                hsl8_t hsl8 = {h, s, l};
+                rgb_t expected = hsl_to_rgb888(&hsl);
+                rgb_t rgb = hsl8_to_rgb888(&hsl8);
+                ASSERT(rgb_distance(expected, rgb) <= 1);
+            }
+        }
+    }
+
+    PASS();
+}
+
+TEST test_rgb888_to_hsl8(void) {
+    for (uint16_t r = 0; r < 256; r += 3) {
+        for (uint16_t g = 0; g < 256; g += 5) {
+            for (uint16_t b = 0; b < 256; b += 7) {
+                rgb_t rgb = {r, g, b};
+                hsl_t expected = rgb888_to_hsl(&rgb);
+                hsl8_t hsl = rgb888_to_hsl8(&rgb);
+                ASSERT_IN_RANGE(expected.h, hsl.h, 1);
+                ASSERT_IN_RANGE(expected.s, hsl.s, 1);
+                ASSERT_IN_RANGE(expected.l, hsl.l, 1);
+            }
+        }
+    }
+
+    PASS();
+}
+
+TEST test_hsl8_array_and_table(void) {
+    hsl8_t hsl[256];
+    rgb_t rgb[256];
+    rgb_t table[256];
+    hsl8_t back[256];
+
+    for (uint16_t h = 0; h < 256; h++) {
+        hsl[h] = (hsl8_t){h, 200, 100};
+    }
+
+    hsl8_to_rgb888_array(rgb, hsl, 256);
+    hsl8_hue_table(table, 200, 100);
+    rgb888_to_hsl8_array(back, rgb, 256);
+
+    for (uint16_t h = 0; h < 256; h++) {
+        rgb_t expected = hsl8_to_rgb888(&hsl[h]);
+        hsl8_t expected_back = rgb888_to_hsl8(&rgb[h]);
+
+        ASSERT_MEM_EQ(&expected, &rgb[h], sizeof(rgb_t));
+        ASSERT_MEM_EQ(&expected, &table[h], sizeof(rgb_t));
+        ASSERT_MEM_EQ(&expected_back, &back[h], sizeof(hsl8_t));
+    }
+
+    PASS();
+}
+
+SUITE(hsl_suite) {
+    RUN_TEST(test_rgb888_to_hsl_primaries);
+    RUN_TEST(test_hsl8_to_rgb888);
+    RUN_TEST(test_rgb888_to_hsl8);
+    RUN_TEST(test_hsl8_array_and_table);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+    GREATEST_MAIN_BEGIN();
+    RUN_SUITE(hsl_suite);
+    GREATEST_MAIN_END();
+}
@@ -0,0 +1,1152 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crc32.h"
+#include "greatest.h"
+#include "save_image.h"
+#include "stb_image_write.h"
+
+#include "hagl.h"
+#include "hagl/bitmap.h"
+#include "hagl/clip.h"
+#include "hagl/format.h"
+#include "hagl/image.h"
+#include "hagl/image_cache.h"
+#include "hagl/pixel.h"
+#include "alpha_png.h"
+#include "alpha_qoi.h"
+#include "pngdec.h"
+#include "qoidec.h"
+#include "restart_jpg.h"
+
+#define TEST_WIDTH 80
+#define TEST_HEIGHT 64
+#define TEST_DEPTH 16
+
+#define IMAGE_WIDTH 64
+#define IMAGE_HEIGHT 48
+
+#define ALPHA_WIDTH 32
+#define ALPHA_HEIGHT 24
+
+typedef struct {
+    uint8_t data[64 * 1024];
+    size_t size;
+    size_t offset;
+} jpeg_t;
+
+static jpeg_t jpeg;
+static jpeg_t other;
+static jpeg_t subsampled;
+
+static hagl_bitmap_t surface;
+static uint8_t surface_buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+
+static hagl_bitmap_t reference;
+static uint8_t reference_buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+
+static void jpeg_writer(void *context, void *data, int size) {
+    jpeg_t *jpeg = context;
+
+    memcpy(jpeg->data + jpeg->size, data, size);
+    jpeg->size += size;
+}
+
+/*
+ * Encode a noisy test image so the entropy coded data contains
+ * plenty of stuffed 0xFF bytes.
+ */
+static void encode_jpeg(
+    jpeg_t *jpeg, uint16_t width, uint16_t height, uint32_t seed, uint8_t quality
+) {
+    static uint8_t rgb[IMAGE_WIDTH * IMAGE_HEIGHT * 3];
+
+    for (uint16_t i = 0; i < width * height * 3; i++) {
+        seed = seed * 1103515245 + 12345;
+        rgb[i] = (i % 3) * 80 + ((seed >> 16) & 0x3F);
+    }
+
+    jpeg->size = 0;
+    jpeg->offset = 0;
+    stbi_write_jpg_to_func(jpeg_writer, jpeg, width, height, 3, rgb, quality);
+}
+
+static size_t stream_reader(void *user, uint8_t *buffer, size_t size) {
+    jpeg_t *jpeg = user;
+
+    /* Hand out data in small uneven chunks. */
+    if (size > 37) {
+        size = 37;
+    }
+    if (size > jpeg->size - jpeg->offset) {
+        size = jpeg->size - jpeg->offset;
+    }
+    if (buffer) {
+        memcpy(buffer, jpeg->data + jpeg->offset, size);
+    }
+    jpeg->offset += size;
+
+    return size;
+}
+
+static void setup_callback(void *data) {
+    memset(surface_buffer, 0, sizeof(surface_buffer));
+    hagl_bitmap_init(&surface, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, surface_buffer);
+
+    memset(reference_buffer, 0, sizeof(reference_buffer));
+    hagl_bitmap_init(
+        &reference, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, reference_buffer
+    );
+
+    encode_jpeg(&jpeg, IMAGE_WIDTH, IMAGE_HEIGHT, 1, 95);
+    encode_jpeg(&other, 24, 16, 2, 95);
+    /* Quality 90 and below uses 2x2 chroma subsampling. */
+    encode_jpeg(&subsampled, 61, 45, 3, 75);
+}
+
+static void teardown_callback(void *data) {
+    char filename[256];
+    snprintf(filename, sizeof(filename), "output/%s.png", greatest_info.name_buf);
+    save_image(&surface, filename);
+}
+
+TEST test_encoded_data_has_stuffed_bytes(void) {
+    uint16_t count = 0;
+
+    for (size_t i = 1; i < jpeg.size; i++) {
+        if (0xFF == jpeg.data[i - 1] && 0x00 == jpeg.data[i]) {
+            count++;
+        }
+    }
+    ASSERT(count > 0);
+
+    PASS();
+}
+
+/* Memory and file decoding produce identical output. */
+TEST test_load_image_mem(void) {
+    FILE *fp = fopen("output/test_load_image_mem.jpg", "wb");
+    ASSERT(fp);
+    fwrite(jpeg.data, 1, jpeg.size, fp);
+    fclose(fp);
+
+    ASSERT_EQ(
+        HAGL_OK, hagl_load_image(&reference, 8, 8, "output/test_load_image_mem.jpg")
+    );
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&surface, 8, 8, jpeg.data, jpeg.size));
+
+    ASSERT_MEM_EQ(reference_buffer, surface_buffer, sizeof(surface_buffer));
+
+    /* Image is inside the given position only. */
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 7, 7));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 8 + IMAGE_WIDTH, 8 + IMAGE_HEIGHT));
+    ASSERT(0x0000 != hagl_get_pixel(&surface, 8, 8));
+
+    PASS();
+}
+
+TEST test_load_image_stream(void) {
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&reference, 0, 0, jpeg.data, jpeg.size));
+    ASSERT_EQ(HAGL_OK, hagl_load_image_stream(&surface, 0, 0, stream_reader, &jpeg));
+
+    ASSERT_MEM_EQ(reference_buffer, surface_buffer, sizeof(surface_buffer));
+
+    PASS();
+}
+
+TEST test_load_image_mem_truncated(void) {
+    uint32_t status;
+
+    status = hagl_load_image_mem(&surface, 0, 0, jpeg.data, jpeg.size / 2);
+    ASSERT_EQ(HAGL_ERR_TJPGD + 2, status);
+
+    status = hagl_load_image_mem(&surface, 0, 0, jpeg.data, 1);
+    ASSERT_EQ(HAGL_ERR_TJPGD + 2, status);
+
+    PASS();
+}
+
+TEST test_load_image_mem_invalid(void) {
+    const uint8_t garbage[] = {'G', 'I', 'F', '8', '9', 'a', 0x01, 0x00};
+
+    ASSERT_EQ(
+        HAGL_ERR_TJPGD + 6, hagl_load_image_mem(&surface, 0, 0, garbage, sizeof(garbage))
+    );
+
+    PASS();
+}
+
+static void fill_surface(hagl_bitmap_t *bitmap, hagl_color_t color) {
+    for (int16_t y = 0; y < bitmap->height; y++) {
+        for (int16_t x = 0; x < bitmap->width; x++) {
+            hagl_put_pixel(bitmap, x, y, color);
+        }
+    }
+}
+
+/* Expected pixel of alpha_png.h and alpha_qoi.h over given background. */
+static hagl_color_t alpha_pixel(int16_t x, int16_t y, hagl_color_t background) {
+    hagl_color_t color = hagl_color(&surface, x * 8, y * 10, (x + y) * 4);
+    uint8_t alpha = (x < 8) ? 0 : (x < 16) ? 128 : 255;
+
+    return hagl_blend(&surface, color, background, alpha);
+}
+
+/* Count pixels which differ from the alpha image drawn at x0, y0. */
+static uint32_t alpha_errors(int16_t x0, int16_t y0, hagl_color_t background) {
+    uint32_t errors = 0;
+
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            hagl_color_t expected = background;
+            if (x >= x0 && y >= y0 && x < x0 + ALPHA_WIDTH && y < y0 + ALPHA_HEIGHT) {
+                expected = alpha_pixel(x - x0, y - y0, background);
+            }
+            if (expected != hagl_get_pixel(&surface, x, y)) {
+                errors++;
+            }
+        }
+    }
+
+    return errors;
+}
+
+TEST test_load_image_png(void) {
+    hagl_color_t background = hagl_color(&surface, 0, 0, 255);
+
+    fill_surface(&surface, background);
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&surface, 4, 4, alpha_png, sizeof(alpha_png)));
+    ASSERT_EQ(0, alpha_errors(4, 4, background));
+
+    PASS();
+}
+
+TEST test_load_image_qoi(void) {
+    hagl_color_t background = hagl_color(&surface, 0, 0, 255);
+
+    fill_surface(&surface, background);
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&surface, 4, 4, alpha_qoi, sizeof(alpha_qoi)));
+    ASSERT_EQ(0, alpha_errors(4, 4, background));
+
+    PASS();
+}
+
+/* Format is detected also when the signature has to be peeked. */
+TEST test_load_image_png_qoi_file_and_stream(void) {
+    static jpeg_t png, qoi;
+    hagl_color_t background = hagl_color(&surface, 0, 0, 255);
+
+    memcpy(png.data, alpha_png, sizeof(alpha_png));
+    png.size = sizeof(alpha_png);
+    memcpy(qoi.data, alpha_qoi, sizeof(alpha_qoi));
+    qoi.size = sizeof(alpha_qoi);
+
+    FILE *fp = fopen("output/alpha.qoi", "wb");
+    ASSERT(fp);
+    fwrite(alpha_qoi, 1, sizeof(alpha_qoi), fp);
+    fclose(fp);
+
+    fill_surface(&surface, background);
+    ASSERT_EQ(HAGL_OK, hagl_load_image_stream(&surface, 4, 4, stream_reader, &png));
+    ASSERT_EQ(0, alpha_errors(4, 4, background));
+
+    fill_surface(&surface, background);
+    ASSERT_EQ(HAGL_OK, hagl_load_image_stream(&surface, 4, 4, stream_reader, &qoi));
+    ASSERT_EQ(0, alpha_errors(4, 4, background));
+
+    fill_surface(&surface, background);
+    ASSERT_EQ(HAGL_OK, hagl_load_image(&surface, 4, 4, "output/alpha.qoi"));
+    ASSERT_EQ(0, alpha_errors(4, 4, background));
+
+    PASS();
+}
+
+/* Encoder of stb_image_write uses all filter types. */
+TEST test_load_image_png_filters(void) {
+    static uint8_t rgb[IMAGE_WIDTH * IMAGE_HEIGHT * 3];
+    static jpeg_t png;
+    uint32_t seed = 4;
+
+    for (uint16_t i = 0; i < sizeof(rgb); i++) {
+        seed = seed * 1103515245 + 12345;
+        rgb[i] = ((i / 3) % IMAGE_WIDTH) * 4 + ((seed >> 16) & 0x07);
+    }
+
+    png.size = 0;
+    stbi_write_png_to_func(
+        jpeg_writer, &png, IMAGE_WIDTH, IMAGE_HEIGHT, 3, rgb, IMAGE_WIDTH * 3
+    );
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&surface, 0, 0, png.data, png.size));
+
+    for (int16_t y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int16_t x = 0; x < IMAGE_WIDTH; x++) {
+            const uint8_t *pixel = &rgb[(y * IMAGE_WIDTH + x) * 3];
+            hagl_color_t expected = hagl_color(&surface, pixel[0], pixel[1], pixel[2]);
+            ASSERT_EQ(expected, hagl_get_pixel(&surface, x, y));
+        }
+    }
+
+    PASS();
+}
+
+TEST test_load_image_png_cropped_scaled(void) {
+    hagl_color_t background = hagl_color(&surface, 0, 0, 255);
+    hagl_image_options_t options = {
+        .scale = 1, .x = 6, .y = 4, .width = 20, .height = 16
+    };
+
+    fill_surface(&surface, background);
+    ASSERT_EQ(
+        HAGL_OK,
+        hagl_load_image_mem_ex(&surface, 2, 2, alpha_png, sizeof(alpha_png), &options)
+    );
+
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            hagl_color_t expected = background;
+            if (x >= 2 && y >= 2 && x < 2 + 10 && y < 2 + 8) {
+                expected = alpha_pixel(6 + (x - 2) * 2, 4 + (y - 2) * 2, background);
+            }
+            ASSERT_EQ(expected, hagl_get_pixel(&surface, x, y));
+        }
+    }
+
+    PASS();
+}
+
+/* Decoding to a bitmap blends with the existing bitmap contents. */
+TEST test_decode_image_png_qoi(void) {
+    static uint8_t buffer[ALPHA_WIDTH * ALPHA_HEIGHT * 2];
+    hagl_bitmap_t bitmap;
+
+    hagl_bitmap_init(&bitmap, ALPHA_WIDTH, ALPHA_HEIGHT, 16, buffer);
+
+    memset(buffer, 0, sizeof(buffer));
+    ASSERT_EQ(HAGL_OK, hagl_decode_image_mem(&bitmap, alpha_png, sizeof(alpha_png)));
+    hagl_blit(&surface, 4, 4, &bitmap);
+    ASSERT_EQ(0, alpha_errors(4, 4, 0x0000));
+
+    memset(buffer, 0, sizeof(buffer));
+    ASSERT_EQ(HAGL_OK, hagl_decode_image_mem(&bitmap, alpha_qoi, sizeof(alpha_qoi)));
+    hagl_blit(&surface, 4, 4, &bitmap);
+    ASSERT_EQ(0, alpha_errors(4, 4, 0x0000));
+
+    PASS();
+}
+
+TEST test_image_size_png_qoi(void) {
+    uint16_t width = 0, height = 0;
+
+    ASSERT_EQ(
+        HAGL_OK, hagl_image_size_mem(alpha_png, sizeof(alpha_png), &width, &height)
+    );
+    ASSERT_EQ(ALPHA_WIDTH, width);
+    ASSERT_EQ(ALPHA_HEIGHT, height);
+
+    width = height = 0;
+    ASSERT_EQ(
+        HAGL_OK, hagl_image_size_mem(alpha_qoi, sizeof(alpha_qoi), &width, &height)
+    );
+    ASSERT_EQ(ALPHA_WIDTH, width);
+    ASSERT_EQ(ALPHA_HEIGHT, height);
+
+    PASS();
+}
+
+TEST test_load_image_png_qoi_errors(void) {
+    static uint8_t work[4 * 1024 + 2 * (ALPHA_WIDTH * 4 + 1)];
+    hagl_image_options_t options = {.work = work, .work_size = 1024};
+
+    ASSERT_EQ(
+        HAGL_ERR_PNGDEC + PNGDEC_ERR_INPUT,
+        hagl_load_image_mem(&surface, 0, 0, alpha_png, sizeof(alpha_png) / 2)
+    );
+    ASSERT_EQ(
+        HAGL_ERR_PNGDEC + PNGDEC_ERR_INPUT,
+        hagl_load_image_mem(&surface, 0, 0, alpha_png, PNGDEC_SIGNATURE_SIZE)
+    );
+    ASSERT_EQ(
+        HAGL_ERR_QOIDEC + QOIDEC_ERR_INPUT,
+        hagl_load_image_mem(&surface, 0, 0, alpha_qoi, sizeof(alpha_qoi) / 2)
+    );
+
+    /* Window of a small image is smaller than 32K. */
+    ASSERT_EQ(
+        HAGL_ERR_PNGDEC + PNGDEC_ERR_MEMORY,
+        hagl_load_image_mem_ex(&surface, 0, 0, alpha_png, sizeof(alpha_png), &options)
+    );
+    options.work_size = sizeof(work);
+    ASSERT_EQ(
+        HAGL_OK,
+        hagl_load_image_mem_ex(&surface, 0, 0, alpha_png, sizeof(alpha_png), &options)
+    );
+
+    PASS();
+}
+
+TEST test_load_image_missing_file(void) {
+    ASSERT_EQ(HAGL_ERR_FILE_IO, hagl_load_image(&surface, 0, 0, "output/missing.jpg"));
+
+    PASS();
+}
+
+TEST test_image_size(void) {
+    uint16_t width, height;
+
+    ASSERT_EQ(HAGL_OK, hagl_image_size_mem(jpeg.data, jpeg.size, &width, &height));
+    ASSERT_EQ(IMAGE_WIDTH, width);
+    ASSERT_EQ(IMAGE_HEIGHT, height);
+
+    ASSERT_EQ(HAGL_OK, hagl_image_size_mem(other.data, other.size, &width, &height));
+    ASSERT_EQ(24, width);
+    ASSERT_EQ(16, height);
+
+    PASS();
+}
+
+/* Decoded bitmap blits to the same output as decoding to the surface. */
+TEST test_decode_image_mem(void) {
+    static uint8_t buffer[IMAGE_WIDTH * IMAGE_HEIGHT * 2];
+    hagl_bitmap_t bitmap;
+
+    hagl_bitmap_init(&bitmap, IMAGE_WIDTH, IMAGE_HEIGHT, 16, buffer);
+    ASSERT_EQ(HAGL_OK, hagl_decode_image_mem(&bitmap, jpeg.data, jpeg.size));
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&reference, 0, 0, jpeg.data, jpeg.size));
+
+    for (int16_t y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int16_t x = 0; x < IMAGE_WIDTH; x++) {
+            ASSERT_EQ(hagl_get_pixel(&reference, x, y), hagl_get_pixel(&bitmap, x, y));
+        }
+    }
+
+    PASS();
+}
+
+/* Swapped RGB565 pixel to red, green and blue levels. */
+static void levels(hagl_color_t color, int16_t *rgb) {
+    uint16_t pixel = (color >> 8) | (color << 8);
+    rgb[0] = pixel >> 11;
+    rgb[1] = (pixel >> 5) & 0x3F;
+    rgb[2] = pixel & 0x1F;
+}
+
+/* Dithered colors are within one level of the truncated colors. */
+TEST test_load_image_mem_dither(void) {
+    static uint8_t buffer[IMAGE_WIDTH * IMAGE_HEIGHT * 2];
+    hagl_image_options_t options = {.dither = HAGL_DITHER_ORDERED};
+    hagl_bitmap_t bitmap;
+    uint16_t changed = 0;
+
+    hagl_bitmap_init(&bitmap, IMAGE_WIDTH, IMAGE_HEIGHT, 16, buffer);
+    ASSERT_EQ(
+        HAGL_OK, hagl_decode_image_mem_ex(&bitmap, jpeg.data, jpeg.size, &options)
+    );
+    ASSERT_EQ(
+        HAGL_OK, hagl_load_image_mem_ex(&surface, 0, 0, jpeg.data, jpeg.size, &options)
+    );
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&reference, 0, 0, jpeg.data, jpeg.size));
+
+    for (int16_t y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int16_t x = 0; x < IMAGE_WIDTH; x++) {
+            hagl_color_t color = hagl_get_pixel(&surface, x, y);
+            int16_t dithered[3], truncated[3];
+
+            ASSERT_EQ(color, hagl_get_pixel(&bitmap, x, y));
+
+            levels(color, dithered);
+            levels(hagl_get_pixel(&reference, x, y), truncated);
+            for (uint8_t c = 0; c < 3; c++) {
+                ASSERT_IN_RANGE(truncated[c], dithered[c], 1);
+            }
+            changed += color != hagl_get_pixel(&reference, x, y);
+        }
+    }
+    ASSERT(changed > 0);
+
+    /* Same for png which is blended with the background. */
+    memset(buffer, 0, sizeof(buffer));
+    memset(surface_buffer, 0, sizeof(surface_buffer));
+    ASSERT_EQ(
+        HAGL_OK, hagl_decode_image_mem_ex(&bitmap, alpha_png, sizeof(alpha_png), &options)
+    );
+    ASSERT_EQ(
+        HAGL_OK,
+        hagl_load_image_mem_ex(&surface, 0, 0, alpha_png, sizeof(alpha_png), &options)
+    );
+    for (int16_t y = 0; y < ALPHA_HEIGHT; y++) {
+        for (int16_t x = 0; x < ALPHA_WIDTH; x++) {
+            ASSERT_EQ(hagl_get_pixel(&surface, x, y), hagl_get_pixel(&bitmap, x, y));
+        }
+    }
+
+    /*
+     * On RGB332 surface truncation loses half a level on average, dithering
+     * nothing. Compare red and green averages to the RGB565 reference.
+     */
+    static uint8_t rgb332_buffer[IMAGE_WIDTH * IMAGE_HEIGHT];
+    hagl_bitmap_t rgb332;
+    int32_t error[2] = {0, 0};
+
+    hagl_bitmap_init(&rgb332, IMAGE_WIDTH, IMAGE_HEIGHT, 8, rgb332_buffer);
+    ASSERT_EQ(
+        HAGL_OK, hagl_load_image_mem_ex(&rgb332, 0, 0, jpeg.data, jpeg.size, &options)
+    );
+    for (int16_t y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int16_t x = 0; x < IMAGE_WIDTH; x++) {
+            uint8_t color = rgb332_buffer[y * IMAGE_WIDTH + x];
+            int16_t truncated[3];
+
+            levels(hagl_get_pixel(&reference, x, y), truncated);
+            error[0] += (color >> 5) * 32 - truncated[0] * 8;
+            error[1] += ((color >> 2) & 0x07) * 32 - truncated[1] * 4;
+        }
+    }
+    ASSERT_IN_RANGE(0, error[0] / (IMAGE_WIDTH * IMAGE_HEIGHT), 4);
+    ASSERT_IN_RANGE(0, error[1] / (IMAGE_WIDTH * IMAGE_HEIGHT), 4);
+
+    PASS();
+}
+
+/* Bitmap pitch is respected and parts not fitting the bitmap are ignored. */
+TEST test_decode_image_mem_clipped(void) {
+    static uint8_t buffer[20 * 40 * 2];
+    hagl_bitmap_t bitmap;
+
+    memset(buffer, 0xAA, sizeof(buffer));
+    hagl_bitmap_init(&bitmap, 10, 40, 16, buffer);
+    bitmap.pitch = 20 * 2;
+
+    ASSERT_EQ(HAGL_OK, hagl_decode_image_mem(&bitmap, jpeg.data, jpeg.size));
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&reference, 0, 0, jpeg.data, jpeg.size));
+
+    for (int16_t y = 0; y < 40; y++) {
+        for (int16_t x = 0; x < 10; x++) {
+            ASSERT_EQ(hagl_get_pixel(&reference, x, y), hagl_get_pixel(&bitmap, x, y));
+        }
+        for (int16_t x = 10; x < 20; x++) {
+            ASSERT_EQ(0xAA, buffer[y * bitmap.pitch + x * 2]);
+            ASSERT_EQ(0xAA, buffer[y * bitmap.pitch + x * 2 + 1]);
+        }
+    }
+
+    PASS();
+}
+
+/* Decoded pixels are converted to the format of the bitmap. */
+TEST test_decode_image_formats(void) {
+    static const uint8_t formats[] = {
+        HAGL_FORMAT_RGB332, HAGL_FORMAT_RGB565, HAGL_FORMAT_RGB888,
+        HAGL_FORMAT_ARGB8888
+    };
+    static uint8_t native[IMAGE_WIDTH * IMAGE_HEIGHT * 2];
+    static uint8_t buffer[IMAGE_WIDTH * IMAGE_HEIGHT * 4];
+    static uint8_t expected[IMAGE_WIDTH * IMAGE_HEIGHT * 4];
+    hagl_bitmap_t reference16;
+    hagl_bitmap_t bitmap;
+
+    hagl_bitmap_init(&reference16, IMAGE_WIDTH, IMAGE_HEIGHT, 16, native);
+    ASSERT_EQ(HAGL_OK, hagl_decode_image_mem(&reference16, jpeg.data, jpeg.size));
+
+    for (uint8_t i = 0; i < sizeof(formats); i++) {
+        size_t size = IMAGE_WIDTH * IMAGE_HEIGHT * hagl_format_depth(formats[i]) / 8;
+
+        hagl_bitmap_init_format(&bitmap, IMAGE_WIDTH, IMAGE_HEIGHT, formats[i], buffer);
+        ASSERT_EQ(HAGL_OK, hagl_decode_image_mem(&bitmap, jpeg.data, jpeg.size));
+        hagl_convert(
+            expected, formats[i], native, HAGL_PIXEL_RGB565, IMAGE_WIDTH * IMAGE_HEIGHT
+        );
+        ASSERT_MEM_EQ(expected, buffer, size);
+    }
+
+    /* Translucent png pixels are blended in RGB888. */
+    memset(native, 0, sizeof(native));
+    memset(buffer, 0, sizeof(buffer));
+    hagl_bitmap_init(&reference16, ALPHA_WIDTH, ALPHA_HEIGHT, 16, native);
+    hagl_bitmap_init_format(
+        &bitmap, ALPHA_WIDTH, ALPHA_HEIGHT, HAGL_FORMAT_RGB888, buffer
+    );
+    ASSERT_EQ(HAGL_OK, hagl_decode_image_mem(&reference16, alpha_png, sizeof(alpha_png)));
+    ASSERT_EQ(HAGL_OK, hagl_decode_image_mem(&bitmap, alpha_png, sizeof(alpha_png)));
+
+    for (int16_t y = 0; y < ALPHA_HEIGHT; y++) {
+        for (int16_t x = 0; x < ALPHA_WIDTH; x++) {
+            uint16_t pixel;
+            int16_t wide[3], narrow[3];
+
+            hagl_convert(
+                &pixel, HAGL_PIXEL_RGB565, buffer + (y * ALPHA_WIDTH + x) * 3,
+                HAGL_FORMAT_RGB888, 1
+            );
+            levels(pixel, wide);
+            levels(hagl_get_pixel(&reference16, x, y), narrow);
+            for (uint8_t c = 0; c < 3; c++) {
+                ASSERT_IN_RANGE(narrow[c], wide[c], 1);
+            }
+        }
+    }
+
+    PASS();
+}
+
+/* Indexed bitmaps store palette indices and cannot be decoded to. */
+TEST test_decode_image_unsupported_depth(void) {
+    static const hagl_color_t palette[256] = {0};
+    static uint8_t buffer[IMAGE_WIDTH * IMAGE_HEIGHT];
+    hagl_bitmap_t bitmap;
+
+    hagl_bitmap_init_indexed(&bitmap, IMAGE_WIDTH, IMAGE_HEIGHT, 8, buffer, palette);
+    ASSERT_EQ(HAGL_ERR_GENERAL, hagl_decode_image_mem(&bitmap, jpeg.data, jpeg.size));
+
+    PASS();
+}
+
+TEST test_image_cache_hit(void) {
+    static uint8_t pool[IMAGE_WIDTH * IMAGE_HEIGHT * 2];
+    hagl_image_cache_t cache;
+    hagl_bitmap_t *first, *second;
+
+    hagl_image_cache_init(&cache, pool, sizeof(pool));
+
+    first = hagl_image_cache_get_mem(&cache, jpeg.data, jpeg.size);
+    ASSERT(first);
+    ASSERT_EQ(IMAGE_WIDTH, first->width);
+    ASSERT_EQ(IMAGE_HEIGHT, first->height);
+
+    /* Image is not decoded again. */
+    memset(first->buffer, 0, first->size);
+    second = hagl_image_cache_get_mem(&cache, jpeg.data, jpeg.size);
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(0x0000, hagl_get_pixel(second, 0, 0));
+
+    PASS();
+}
+
+TEST test_image_cache_too_big(void) {
+    static uint8_t pool[IMAGE_WIDTH * IMAGE_HEIGHT];
+    hagl_image_cache_t cache;
+
+    hagl_image_cache_init(&cache, pool, sizeof(pool));
+
+    ASSERT_EQ(NULL, hagl_image_cache_get_mem(&cache, jpeg.data, jpeg.size));
+    ASSERT(hagl_image_cache_get_mem(&cache, other.data, other.size));
+
+    PASS();
+}
+
+/* Least recently used image is evicted and the rest are compacted. */
+TEST test_image_cache_evict(void) {
+    static uint8_t pool[IMAGE_WIDTH * IMAGE_HEIGHT * 2 + 24 * 16 * 2];
+    static uint8_t buffer[24 * 16 * 2];
+    hagl_image_cache_t cache;
+    hagl_bitmap_t expected;
+    hagl_bitmap_t *image;
+
+    hagl_bitmap_init(&expected, 24, 16, 16, buffer);
+    hagl_decode_image_mem(&expected, other.data, other.size);
+
+    hagl_image_cache_init(&cache, pool, sizeof(pool));
+
+    /* Small image first, then the big one after it in the pool. */
+    ASSERT(hagl_image_cache_get_mem(&cache, other.data, other.size));
+    ASSERT(hagl_image_cache_get_mem(&cache, jpeg.data, jpeg.size));
+    ASSERT_EQ(2, cache.count);
+
+    /* Same image from a different address does not fit, evicts the small one. */
+    memcpy(&reference_buffer, jpeg.data, jpeg.size);
+    image = hagl_image_cache_get_mem(&cache, reference_buffer, jpeg.size);
+    ASSERT(image);
+    ASSERT_EQ(1, cache.count);
+    ASSERT_EQ(pool, image->buffer);
+
+    /* Now the big image got evicted, small one is decoded to after it. */
+    image = hagl_image_cache_get_mem(&cache, other.data, other.size);
+    ASSERT(image);
+    ASSERT_EQ(2, cache.count);
+    ASSERT_EQ(pool + IMAGE_WIDTH * IMAGE_HEIGHT * 2, image->buffer);
+    ASSERT_MEM_EQ(buffer, image->buffer, sizeof(buffer));
+
+    PASS();
+}
+
+/* Evicting an older image does not move the entries returned after it. */
+TEST test_image_cache_evict_stable(void) {
+    static uint8_t pool[24 * 16 * 2 * 2];
+    static uint8_t buffer[24 * 16 * 2];
+    hagl_image_cache_t cache;
+    hagl_bitmap_t expected;
+    hagl_bitmap_t *first, *second;
+
+    ASSERT(other.size <= sizeof(surface_buffer));
+    hagl_bitmap_init(&expected, 24, 16, 16, buffer);
+    hagl_decode_image_mem(&expected, other.data, other.size);
+
+    /* Same image from three addresses, two of them fit. */
+    memcpy(reference_buffer, other.data, other.size);
+    memcpy(surface_buffer, other.data, other.size);
+
+    hagl_image_cache_init(&cache, pool, sizeof(pool));
+
+    first = hagl_image_cache_get_mem(&cache, other.data, other.size);
+    second = hagl_image_cache_get_mem(&cache, reference_buffer, other.size);
+    ASSERT(first);
+    ASSERT(second);
+    ASSERT_EQ(pool + sizeof(buffer), second->buffer);
+
+    /* First image is evicted and the second one moves down in the pool. */
+    ASSERT(hagl_image_cache_get_mem(&cache, surface_buffer, other.size));
+    ASSERT_EQ(2, cache.count);
+    ASSERT_EQ(pool, second->buffer);
+    ASSERT_MEM_EQ(buffer, second->buffer, sizeof(buffer));
+    ASSERT_EQ(second, hagl_image_cache_get_mem(&cache, reference_buffer, other.size));
+
+    PASS();
+}
+
+/* These two filenames have the same FNV-1a hash. */
+TEST test_image_cache_hash_collision(void) {
+    static uint8_t pool[IMAGE_WIDTH * IMAGE_HEIGHT * 2 + 24 * 16 * 2];
+    hagl_image_cache_t cache;
+    hagl_bitmap_t *first, *second;
+    FILE *fp;
+
+    fp = fopen("output/ooczw.jpg", "wb");
+    ASSERT(fp);
+    fwrite(jpeg.data, 1, jpeg.size, fp);
+    fclose(fp);
+
+    fp = fopen("output/ufbpa.jpg", "wb");
+    ASSERT(fp);
+    fwrite(other.data, 1, other.size, fp);
+    fclose(fp);
+
+    hagl_image_cache_init(&cache, pool, sizeof(pool));
+
+    first = hagl_image_cache_get(&cache, "output/ooczw.jpg");
+    second = hagl_image_cache_get(&cache, "output/ufbpa.jpg");
+    ASSERT(first);
+    ASSERT(second);
+    ASSERT(first != second);
+    ASSERT_EQ(IMAGE_WIDTH, first->width);
+    ASSERT_EQ(24, second->width);
+    ASSERT_EQ(first, hagl_image_cache_get(&cache, "output/ooczw.jpg"));
+
+    PASS();
+}
+
+/* Descaled image covers exactly half of the original size. */
+TEST test_load_image_scaled(void) {
+    hagl_image_options_t options = {.scale = 1};
+
+    ASSERT_EQ(
+        HAGL_OK, hagl_load_image_mem_ex(&surface, 0, 0, jpeg.data, jpeg.size, &options)
+    );
+
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            if (x < IMAGE_WIDTH / 2 && y < IMAGE_HEIGHT / 2) {
+                ASSERT(0x0000 != hagl_get_pixel(&surface, x, y));
+            } else {
+                ASSERT_EQ(0x0000, hagl_get_pixel(&surface, x, y));
+            }
+        }
+    }
+
+    options.scale = 4;
+    ASSERT_EQ(
+        HAGL_ERR_TJPGD + 5,
+        hagl_load_image_mem_ex(&surface, 0, 0, jpeg.data, jpeg.size, &options)
+    );
+
+    PASS();
+}
+
+/* Cropped area is drawn at given position and matches the full image. */
+TEST test_load_image_cropped(void) {
+    hagl_image_options_t options = {.x = 13, .y = 7, .width = 20, .height = 17};
+
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&reference, 0, 0, jpeg.data, jpeg.size));
+    ASSERT_EQ(
+        HAGL_OK, hagl_load_image_mem_ex(&surface, 5, 5, jpeg.data, jpeg.size, &options)
+    );
+
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            if (x >= 5 && x < 25 && y >= 5 && y < 22) {
+                ASSERT_EQ(
+                    hagl_get_pixel(&reference, x - 5 + 13, y - 5 + 7),
+                    hagl_get_pixel(&surface, x, y)
+                );
+            } else {
+                ASSERT_EQ(0x0000, hagl_get_pixel(&surface, x, y));
+            }
+        }
+    }
+
+    PASS();
+}
+
+/* Crop going over the image edge is limited to the image. */
+TEST test_load_image_cropped_over_edge(void) {
+    hagl_image_options_t options = {.x = 40, .y = 40, .width = 100, .height = 100};
+
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&reference, 0, 0, jpeg.data, jpeg.size));
+    ASSERT_EQ(
+        HAGL_OK, hagl_load_image_mem_ex(&surface, 0, 0, jpeg.data, jpeg.size, &options)
+    );
+
+    ASSERT_EQ(hagl_get_pixel(&reference, 40, 40), hagl_get_pixel(&surface, 0, 0));
+    ASSERT_EQ(
+        hagl_get_pixel(&reference, IMAGE_WIDTH - 1, IMAGE_HEIGHT - 1),
+        hagl_get_pixel(&surface, IMAGE_WIDTH - 41, IMAGE_HEIGHT - 41)
+    );
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, IMAGE_WIDTH - 40, 0));
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 0, IMAGE_HEIGHT - 40));
+
+    /* Crop completely outside the image draws nothing. */
+    memset(surface_buffer, 0, sizeof(surface_buffer));
+    options.x = IMAGE_WIDTH;
+    ASSERT_EQ(
+        HAGL_OK, hagl_load_image_mem_ex(&surface, 0, 0, jpeg.data, jpeg.size, &options)
+    );
+    ASSERT_EQ(0x0000, hagl_get_pixel(&surface, 0, 0));
+
+    PASS();
+}
+
+/* Decoding stops after the last needed row so truncated data is fine. */
+TEST test_load_image_cropped_truncated(void) {
+    hagl_image_options_t options = {.x = 0, .y = 0, .width = IMAGE_WIDTH, .height = 8};
+    size_t size = jpeg.size / 2;
+
+    ASSERT_EQ(
+        HAGL_ERR_TJPGD + 2, hagl_load_image_mem(&surface, 0, 0, jpeg.data, size)
+    );
+    ASSERT_EQ(
+        HAGL_OK, hagl_load_image_mem_ex(&surface, 0, 0, jpeg.data, size, &options)
+    );
+
+    /* Same applies when the rest is outside the clip window. */
+    hagl_set_clip(&surface, 0, 0, TEST_WIDTH - 1, 7);
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&surface, 0, 0, jpeg.data, size));
+
+    PASS();
+}
+
+/* Image partially outside the clip window matches the full image. */
+TEST test_load_image_clipped(void) {
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&reference, 0, 0, jpeg.data, jpeg.size));
+
+    hagl_set_clip(&surface, 20, 10, 50, 30);
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&surface, -10, -5, jpeg.data, jpeg.size));
+
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            if (x >= 20 && x <= 50 && y >= 10 && y <= 30) {
+                ASSERT_EQ(
+                    hagl_get_pixel(&reference, x + 10, y + 5),
+                    hagl_get_pixel(&surface, x, y)
+                );
+            } else {
+                ASSERT_EQ(0x0000, surface_buffer[(y * TEST_WIDTH + x) * 2]);
+            }
+        }
+    }
+
+    PASS();
+}
+
+TEST test_decode_image_mem_cropped_scaled(void) {
+    static uint8_t buffer[8 * 8 * 2];
+    hagl_image_options_t options = {.scale = 1, .x = 16, .y = 16, .width = 16};
+    hagl_bitmap_t bitmap;
+
+    /* Zero height means whole image, crop is ignored. */
+    hagl_bitmap_init(&bitmap, 8, 8, 16, buffer);
+    ASSERT_EQ(HAGL_OK, hagl_decode_image_mem_ex(&bitmap, jpeg.data, jpeg.size, &options));
+    ASSERT_EQ(
+        HAGL_OK,
+        hagl_load_image_mem_ex(&reference, 0, 0, jpeg.data, jpeg.size, &options)
+    );
+    ASSERT_EQ(hagl_get_pixel(&reference, 0, 0), hagl_get_pixel(&bitmap, 0, 0));
+
+    options.height = 16;
+    ASSERT_EQ(HAGL_OK, hagl_decode_image_mem_ex(&bitmap, jpeg.data, jpeg.size, &options));
+
+    for (int16_t y = 0; y < 8; y++) {
+        for (int16_t x = 0; x < 8; x++) {
+            ASSERT_EQ(
+                hagl_get_pixel(&reference, x + 8, y + 8), hagl_get_pixel(&bitmap, x, y)
+            );
+        }
+    }
+
+    PASS();
+}
+
+/*
+ * Checksum was taken from a build with TJPGD_NO_SIMD. Vectorized IDCT and
+ * color conversion must produce identical output.
+ */
+TEST test_load_image_checksum(void) {
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&surface, 0, 0, jpeg.data, jpeg.size));
+    ASSERT_EQ(
+        HAGL_OK, hagl_load_image_mem(&surface, 16, 16, subsampled.data, subsampled.size)
+    );
+
+    uint32_t crc = crc32(surface_buffer, sizeof(surface_buffer));
+
+    ASSERT_EQ(0xE16BD67E, crc);
+
+    PASS();
+}
+
+/* Bigger input buffer and a caller provided work pool. */
+TEST test_load_image_work_pool(void) {
+    static uint8_t pool[8192];
+    hagl_image_options_t options = {
+        .buffer_size = 4096, .work = pool, .work_size = sizeof(pool)
+    };
+
+    ASSERT_EQ(HAGL_OK, hagl_load_image_mem(&reference, 0, 0, jpeg.data, jpeg.size));
+    ASSERT_EQ(
+        HAGL_OK,
+        hagl_load_image_stream_ex(&surface, 0, 0, stream_reader, &jpeg, &options)
+    );
+    ASSERT_MEM_EQ(reference_buffer, surface_buffer, sizeof(surface_buffer));
+
+    PASS();
+}
+
+TEST test_load_image_work_pool_too_small(void) {
+    static uint8_t pool[1024];
+    hagl_image_options_t options = {.work = pool, .work_size = sizeof(pool)};
+
+    /* JDR_MEM1, not enough memory for the tables. */
+    ASSERT_EQ(
+        HAGL_ERR_TJPGD + 3,
+        hagl_load_image_mem_ex(&surface, 0, 0, jpeg.data, jpeg.size, &options)
+    );
+
+    /* JDR_MEM2, header segments do not fit the input buffer. */
+    options.work = NULL;
+    options.buffer_size = 64;
+    ASSERT_EQ(
+        HAGL_ERR_TJPGD + 4,
+        hagl_load_image_mem_ex(&surface, 0, 0, jpeg.data, jpeg.size, &options)
+    );
+
+    PASS();
+}
+
+/* Small png needs a window of the image size only, not 32K. */
+TEST test_png_work_size(void) {
+    static jpeg_t png;
+    static uint8_t pool[8 * 1024];
+    hagl_image_options_t options = {.work = pool};
+    pngdec_t decoder;
+    size_t size;
+
+    memcpy(png.data, alpha_png, sizeof(alpha_png));
+    png.size = sizeof(alpha_png);
+    png.offset = 0;
+
+    ASSERT_EQ(PNGDEC_OK, pngdec_prepare(&decoder, stream_reader, &png));
+    size = pngdec_work_size(&decoder);
+    ASSERT_EQ(4096 + 2 * (decoder.row_size + 1), size);
+    ASSERT(size <= sizeof(pool));
+
+    options.work_size = size;
+    ASSERT_EQ(
+        HAGL_OK,
+        hagl_load_image_mem_ex(&surface, 4, 4, alpha_png, sizeof(alpha_png), &options)
+    );
+
+    options.work_size = size - 1;
+    ASSERT_EQ(
+        HAGL_ERR_PNGDEC + PNGDEC_ERR_MEMORY,
+        hagl_load_image_mem_ex(&surface, 4, 4, alpha_png, sizeof(alpha_png), &options)
+    );
+
+    PASS();
+}
+
+#ifdef HAGL_IMAGE_PARALLEL
+
+/* Any number of threads gives the same output as sequential decoding. */
+TEST test_decode_image_mem_parallel(void) {
+    hagl_bitmap_t bitmap;
+
+    hagl_bitmap_init(&bitmap, IMAGE_WIDTH, IMAGE_HEIGHT, TEST_DEPTH, reference_buffer);
+    ASSERT_EQ(
+        HAGL_OK, hagl_decode_image_mem(&bitmap, restart_jpg, sizeof(restart_jpg))
+    );
+
+    for (uint8_t threads = 0; threads < 8; threads++) {
+        memset(surface_buffer, 0, sizeof(surface_buffer));
+        hagl_bitmap_init(&bitmap, IMAGE_WIDTH, IMAGE_HEIGHT, TEST_DEPTH, surface_buffer);
+        ASSERT_EQ(
+            HAGL_OK,
+            hagl_decode_image_mem_parallel(
+                &bitmap, restart_jpg, sizeof(restart_jpg), NULL, threads
+            )
+        );
+        ASSERT_MEM_EQ(reference_buffer, surface_buffer, bitmap.size);
+    }
+
+    PASS();
+}
+
+TEST test_decode_image_mem_parallel_cropped_scaled(void) {
+    hagl_image_options_t options = {
+        .scale = 1, .x = 8, .y = 20, .width = 40, .height = 20
+    };
+    hagl_bitmap_t bitmap;
+
+    hagl_bitmap_init(&bitmap, 20, 10, TEST_DEPTH, reference_buffer);
+    ASSERT_EQ(
+        HAGL_OK,
+        hagl_decode_image_mem_ex(&bitmap, restart_jpg, sizeof(restart_jpg), &options)
+    );
+
+    hagl_bitmap_init(&bitmap, 20, 10, TEST_DEPTH, surface_buffer);
+    ASSERT_EQ(
+        HAGL_OK,
+        hagl_decode_image_mem_parallel(
+            &bitmap, restart_jpg, sizeof(restart_jpg), &options, 4
+        )
+    );
+    ASSERT_MEM_EQ(reference_buffer, surface_buffer, bitmap.size);
+
+    PASS();
+}
+
+/* Images without restart markers are decoded in one go. */
+TEST test_decode_image_mem_parallel_no_restart(void) {
+    hagl_bitmap_t bitmap;
+
+    hagl_bitmap_init(&bitmap, IMAGE_WIDTH, IMAGE_HEIGHT, TEST_DEPTH, reference_buffer);
+    ASSERT_EQ(HAGL_OK, hagl_decode_image_mem(&bitmap, jpeg.data, jpeg.size));
+
+    hagl_bitmap_init(&bitmap, IMAGE_WIDTH, IMAGE_HEIGHT, TEST_DEPTH, surface_buffer);
+    ASSERT_EQ(
+        HAGL_OK, hagl_decode_image_mem_parallel(&bitmap, jpeg.data, jpeg.size, NULL, 4)
+    );
+    ASSERT_MEM_EQ(reference_buffer, surface_buffer, bitmap.size);
+
+    PASS();
+}
+
+TEST test_decode_image_mem_parallel_broken_marker(void) {
+    static uint8_t broken[sizeof(restart_jpg)];
+    hagl_bitmap_t bitmap;
+    size_t i;
+
+    /* Renumber the last restart marker. */
+    memcpy(broken, restart_jpg, sizeof(broken));
+    for (i = sizeof(broken) - 2; i > 0; i--) {
+        if (0xFF == broken[i] && 0xD0 == (broken[i + 1] & 0xF8)) {
+            break;
+        }
+    }
+    ASSERT(i > 0);
+    broken[i + 1] = 0xD0 | ((broken[i + 1] + 1) & 7);
+
+    hagl_bitmap_init(&bitmap, IMAGE_WIDTH, IMAGE_HEIGHT, TEST_DEPTH, surface_buffer);
+    ASSERT_EQ(
+        HAGL_ERR_TJPGD + 6,
+        hagl_decode_image_mem_parallel(&bitmap, broken, sizeof(broken), NULL, 4)
+    );
+
+    PASS();
+}
+
+#endif /* HAGL_IMAGE_PARALLEL */
+
+SUITE(image_suite) {
+    SET_SETUP(setup_callback, NULL);
+    SET_TEARDOWN(teardown_callback, NULL);
+    RUN_TEST(test_encoded_data_has_stuffed_bytes);
+    RUN_TEST(test_load_image_mem);
+    RUN_TEST(test_load_image_stream);
+    RUN_TEST(test_load_image_checksum);
+    RUN_TEST(test_load_image_mem_truncated);
+    RUN_TEST(test_load_image_mem_invalid);
+    RUN_TEST(test_load_image_png);
+    RUN_TEST(test_load_image_qoi);
+    RUN_TEST(test_load_image_png_qoi_file_and_stream);
+    RUN_TEST(test_load_image_png_filters);
+    RUN_TEST(test_load_image_png_cropped_scaled);
+    RUN_TEST(test_decode_image_png_qoi);
+    RUN_TEST(test_image_size_png_qoi);
+    RUN_TEST(test_load_image_png_qoi_errors);
+    RUN_TEST(test_load_image_missing_file);
+    RUN_TEST(test_load_image_scaled);
+    RUN_TEST(test_load_image_cropped);
+    RUN_TEST(test_load_image_cropped_over_edge);
+    RUN_TEST(test_load_image_cropped_truncated);
+    RUN_TEST(test_load_image_clipped);
+    RUN_TEST(test_load_image_mem_dither);
+    RUN_TEST(test_decode_image_mem_cropped_scaled);
+    RUN_TEST(test_image_size);
+    RUN_TEST(test_decode_image_mem);
+    RUN_TEST(test_decode_image_mem_clipped);
+    RUN_TEST(test_decode_image_formats);
+    RUN_TEST(test_decode_image_unsupported_depth);
+    RUN_TEST(test_image_cache_hit);
+    RUN_TEST(test_image_cache_too_big);
+    RUN_TEST(test_image_cache_evict);
+    RUN_TEST(test_image_cache_evict_stable);
+    RUN_TEST(test_image_cache_hash_collision);
+    RUN_TEST(test_load_image_work_pool);
+    RUN_TEST(test_load_image_work_pool_too_small);
+    RUN_TEST(test_png_work_size);
+#ifdef HAGL_IMAGE_PARALLEL
+    RUN_TEST(test_decode_image_mem_parallel);
+    RUN_TEST(test_decode_image_mem_parallel_cropped_scaled);
+    RUN_TEST(test_decode_image_mem_parallel_no_restart);
+    RUN_TEST(test_decode_image_mem_parallel_broken_marker);
+#endif /* HAGL_IMAGE_PARALLEL */
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+    GREATEST_MAIN_BEGIN();
+    RUN_SUITE(image_suite);
+    GREATEST_MAIN_END();
+}
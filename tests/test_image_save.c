@@ -0,0 +1,375 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crc32.h"
+#include "greatest.h"
+#include "hagl.h"
+#include "hagl/bitmap.h"
+#include "hagl/image_save.h"
+#include "pngdec.h"
+#include "qoidec.h"
+#include "rgb565.h"
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+#define TEST_DEPTH 16
+
+typedef struct {
+    uint8_t data[16 * 1024];
+    size_t size;
+    size_t offset;
+} stream_t;
+
+static hagl_bitmap_t bitmap;
+static uint8_t buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+static uint8_t decoded[TEST_WIDTH * TEST_HEIGHT * 4];
+static stream_t stream;
+
+static size_t stream_writer(void *user, const uint8_t *data, size_t size) {
+    stream_t *stream = user;
+
+    if (size > sizeof(stream->data) - stream->size) {
+        return 0;
+    }
+    memcpy(stream->data + stream->size, data, size);
+    stream->size += size;
+
+    return size;
+}
+
+static size_t stream_reader(void *user, uint8_t *data, size_t size) {
+    stream_t *stream = user;
+
+    if (size > stream->size - stream->offset) {
+        size = stream->size - stream->offset;
+    }
+    memcpy(data, stream->data + stream->offset, size);
+    stream->offset += size;
+
+    return size;
+}
+
+static size_t failing_writer(void *user, const uint8_t *data, size_t size) {
+    return 0;
+}
+
+static uint8_t decoded_writer(
+    void *user, const uint8_t *rgba, uint16_t x0, uint16_t y0, uint16_t width
+) {
+    memcpy(&decoded[(y0 * TEST_WIDTH + x0) * 4], rgba, width * 4);
+    return 1;
+}
+
+/* Pixels are stored as byte swapped RGB565. */
+static void expected_rgb(int16_t x, int16_t y, uint8_t *rgb) {
+    uint16_t pixel = hagl_get_pixel(&bitmap, x, y);
+    pixel = (pixel << 8) | (pixel >> 8);
+    rgb_t color = rgb565_to_rgb888(&pixel);
+
+    rgb[0] = color.r;
+    rgb[1] = color.g;
+    rgb[2] = color.b;
+}
+
+static uint32_t decoded_errors(void) {
+    uint32_t errors = 0;
+    uint8_t rgb[3];
+
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            const uint8_t *pixel = &decoded[(y * TEST_WIDTH + x) * 4];
+            expected_rgb(x, y, rgb);
+            if (0 != memcmp(rgb, pixel, 3) || 255 != pixel[3]) {
+                errors++;
+            }
+        }
+    }
+
+    return errors;
+}
+
+static uint32_t be32(const uint8_t *data) {
+    return (uint32_t)data[0] << 24 | data[1] << 16 | data[2] << 8 | data[3];
+}
+
+static void setup_callback(void *data) {
+    memset(buffer, 0, sizeof(buffer));
+    hagl_bitmap_init(&bitmap, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, buffer);
+
+    /* Flat area for runs and a gradient for the diff and luma ops. */
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            hagl_color_t color = hagl_color(&bitmap, 255, 0, 0);
+            if (y > 8) {
+                color = hagl_color(&bitmap, x * 7, y * 11, (x * y) & 0xFF);
+            }
+            hagl_put_pixel(&bitmap, x, y, color);
+        }
+    }
+
+    memset(&stream, 0, sizeof(stream));
+    memset(decoded, 0, sizeof(decoded));
+}
+
+TEST test_save_image_ppm(void) {
+    const char *header = "P6\n37 23\n255\n";
+    size_t offset = strlen(header);
+    uint8_t rgb[3];
+
+    ASSERT_EQ(
+        HAGL_OK, hagl_save_image_stream(&bitmap, HAGL_IMAGE_PPM, stream_writer, &stream)
+    );
+    ASSERT_EQ(offset + TEST_WIDTH * TEST_HEIGHT * 3, stream.size);
+    ASSERT_MEM_EQ(header, stream.data, offset);
+
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            expected_rgb(x, y, rgb);
+            ASSERT_MEM_EQ(rgb, &stream.data[offset + (y * TEST_WIDTH + x) * 3], 3);
+        }
+    }
+
+    /* Pure red survives the RGB565 round trip. */
+    ASSERT_EQ(255, stream.data[offset]);
+    ASSERT_EQ(0, stream.data[offset + 1]);
+    ASSERT_EQ(0, stream.data[offset + 2]);
+
+    PASS();
+}
+
+TEST test_save_image_qoi(void) {
+    qoidec_t decoder;
+
+    ASSERT_EQ(
+        HAGL_OK, hagl_save_image_stream(&bitmap, HAGL_IMAGE_QOI, stream_writer, &stream)
+    );
+    ASSERT(stream.size < TEST_WIDTH * TEST_HEIGHT * 3);
+
+    ASSERT_EQ(QOIDEC_OK, qoidec_prepare(&decoder, stream_reader, &stream));
+    ASSERT_EQ(TEST_WIDTH, decoder.width);
+    ASSERT_EQ(TEST_HEIGHT, decoder.height);
+    ASSERT_EQ(3, decoder.channels);
+    ASSERT_EQ(QOIDEC_OK, qoidec_decode(&decoder, decoded_writer));
+    ASSERT_EQ(0, decoded_errors());
+
+    /* Stream ends with the end marker. */
+    const uint8_t end[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+    ASSERT_MEM_EQ(end, &stream.data[stream.size - 8], 8);
+
+    PASS();
+}
+
+TEST test_save_image_png(void) {
+    static uint8_t work[4 * 1024 + 2 * (TEST_WIDTH * 3 + 1)];
+    pngdec_t decoder;
+
+    ASSERT_EQ(
+        HAGL_OK, hagl_save_image_stream(&bitmap, HAGL_IMAGE_PNG, stream_writer, &stream)
+    );
+
+    ASSERT_EQ(PNGDEC_OK, pngdec_prepare(&decoder, stream_reader, &stream));
+    ASSERT_EQ(TEST_WIDTH, decoder.width);
+    ASSERT_EQ(TEST_HEIGHT, decoder.height);
+    ASSERT_EQ(PNGDEC_OK, pngdec_decode(&decoder, decoded_writer, work, sizeof(work)));
+    ASSERT_EQ(0, decoded_errors());
+
+    PASS();
+}
+
+/* Decoder does not verify checksums so check them here. */
+TEST test_save_image_png_checksums(void) {
+    static uint8_t zlib[TEST_HEIGHT * (TEST_WIDTH * 3 + 1 + 5) + 6];
+    size_t offset = 8, size = 0;
+    uint32_t a = 1, b = 0;
+
+    ASSERT_EQ(
+        HAGL_OK, hagl_save_image_stream(&bitmap, HAGL_IMAGE_PNG, stream_writer, &stream)
+    );
+
+    while (offset < stream.size) {
+        uint32_t length = be32(&stream.data[offset]);
+        const uint8_t *type = &stream.data[offset + 4];
+
+        ASSERT_EQ(crc32(type, length + 4), be32(type + 4 + length));
+        if (0 == memcmp(type, "IDAT", 4)) {
+            memcpy(zlib + size, type + 4, length);
+            size += length;
+        }
+        offset += length + 12;
+    }
+    ASSERT_EQ(stream.size, offset);
+    ASSERT_EQ(sizeof(zlib), size);
+
+    /* Stored blocks, one per row, each preceded by a five byte header. */
+    for (uint16_t y = 0; y < TEST_HEIGHT; y++) {
+        const uint8_t *row = &zlib[2 + y * (TEST_WIDTH * 3 + 1 + 5) + 5];
+        for (uint16_t i = 0; i < TEST_WIDTH * 3 + 1; i++) {
+            a = (a + row[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+    }
+    ASSERT_EQ(b << 16 | a, be32(&zlib[size - 4]));
+
+    PASS();
+}
+
+TEST test_save_image_file(void) {
+    static uint8_t data[sizeof(stream.data)];
+
+    ASSERT_EQ(
+        HAGL_OK, hagl_save_image_stream(&bitmap, HAGL_IMAGE_QOI, stream_writer, &stream)
+    );
+    ASSERT_EQ(
+        HAGL_OK, hagl_save_image(&bitmap, HAGL_IMAGE_QOI, "output/test_save_image.qoi")
+    );
+
+    FILE *fp = fopen("output/test_save_image.qoi", "rb");
+    ASSERT(fp);
+    size_t size = fread(data, 1, sizeof(data), fp);
+    fclose(fp);
+
+    ASSERT_EQ(stream.size, size);
+    ASSERT_MEM_EQ(stream.data, data, size);
+
+    PASS();
+}
+
+TEST test_save_image_indexed(void) {
+    static stream_t expected;
+    static uint8_t indexed_buffer[INDEXED_BITMAP_SIZE(TEST_WIDTH, TEST_HEIGHT, 4)];
+    hagl_color_t palette[16];
+    hagl_bitmap_t indexed;
+
+    for (uint8_t i = 0; i < 16; i++) {
+        palette[i] = hagl_color(&bitmap, i * 16, 255 - i * 16, i * 8);
+    }
+    hagl_bitmap_init_indexed(
+        &indexed, TEST_WIDTH, TEST_HEIGHT, 4, indexed_buffer, palette
+    );
+
+    /* Same image as indices and as colors. */
+    for (int16_t y = 0; y < TEST_HEIGHT; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            hagl_put_pixel(&indexed, x, y, (x + y) % 16);
+            hagl_put_pixel(&bitmap, x, y, palette[(x + y) % 16]);
+        }
+    }
+
+    memset(&expected, 0, sizeof(expected));
+    ASSERT_EQ(
+        HAGL_OK, hagl_save_image_stream(&bitmap, HAGL_IMAGE_PNG, stream_writer, &expected)
+    );
+    ASSERT_EQ(
+        HAGL_OK, hagl_save_image_stream(&indexed, HAGL_IMAGE_PNG, stream_writer, &stream)
+    );
+    ASSERT_EQ(expected.size, stream.size);
+    ASSERT_MEM_EQ(expected.data, stream.data, stream.size);
+
+    PASS();
+}
+
+/* Little endian RGB565 is not the native format of the test build. */
+TEST test_save_image_format(void) {
+    static uint8_t other_buffer[TEST_WIDTH * TEST_HEIGHT * 2];
+    static uint8_t work[4 * 1024 + 2 * (TEST_WIDTH * 3 + 1)];
+    hagl_bitmap_t other;
+    pngdec_t decoder;
+
+    hagl_bitmap_init_format(
+        &other, TEST_WIDTH, TEST_HEIGHT, HAGL_FORMAT_RGB565, other_buffer
+    );
+    hagl_convert(
+        other_buffer, HAGL_FORMAT_RGB565, buffer, hagl_bitmap_format(&bitmap),
+        TEST_WIDTH * TEST_HEIGHT
+    );
+
+    ASSERT_EQ(
+        HAGL_OK, hagl_save_image_stream(&other, HAGL_IMAGE_PNG, stream_writer, &stream)
+    );
+    ASSERT_EQ(PNGDEC_OK, pngdec_prepare(&decoder, stream_reader, &stream));
+    ASSERT_EQ(PNGDEC_OK, pngdec_decode(&decoder, decoded_writer, work, sizeof(work)));
+    ASSERT_EQ(0, decoded_errors());
+
+    PASS();
+}
+
+TEST test_save_image_errors(void) {
+    static uint8_t small[4 * 4];
+    hagl_bitmap_t unsupported;
+
+    ASSERT_EQ(
+        HAGL_ERR_FILE_IO,
+        hagl_save_image_stream(&bitmap, HAGL_IMAGE_PNG, failing_writer, NULL)
+    );
+    ASSERT_EQ(
+        HAGL_ERR_GENERAL, hagl_save_image_stream(&bitmap, 3, stream_writer, &stream)
+    );
+
+    hagl_bitmap_init(&unsupported, 4, 4, 4, small);
+    ASSERT_EQ(
+        HAGL_ERR_GENERAL,
+        hagl_save_image_stream(&unsupported, HAGL_IMAGE_PPM, stream_writer, &stream)
+    );
+
+    ASSERT_EQ(
+        HAGL_ERR_FILE_IO,
+        hagl_save_image(&bitmap, HAGL_IMAGE_PPM, "output/missing/test_save_image.ppm")
+    );
+
+    PASS();
+}
+
+SUITE(image_save_suite) {
+    SET_SETUP(setup_callback, NULL);
+    RUN_TEST(test_save_image_ppm);
+    RUN_TEST(test_save_image_qoi);
+    RUN_TEST(test_save_image_png);
+    RUN_TEST(test_save_image_png_checksums);
+    RUN_TEST(test_save_image_file);
+    RUN_TEST(test_save_image_indexed);
+    RUN_TEST(test_save_image_format);
+    RUN_TEST(test_save_image_errors);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+    GREATEST_MAIN_BEGIN();
+    RUN_SUITE(image_save_suite);
+    GREATEST_MAIN_END();
+}
@@ -0,0 +1,318 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "hagl/bitmap.h"
+#include "hagl/circle.h"
+#include "hagl/clip.h"
+#include "hagl/color.h"
+#include "hagl/pixel.h"
+#include "hagl/polygon.h"
+#include "hagl/rectangle.h"
+#include "hagl/shader.h"
+#include "hagl/span.h"
+#include "save_image.h"
+
+#define TEST_WIDTH 320
+#define TEST_HEIGHT 240
+#define TEST_DEPTH 16
+
+static hagl_bitmap_t bitmap;
+static uint8_t buffer[TEST_WIDTH * TEST_HEIGHT * (TEST_DEPTH / 8)];
+static hagl_color_t colors[64];
+
+static void setup_callback(void *data) {
+    const uint8_t from[3] = {255, 0, 0};
+    const uint8_t to[3] = {0, 0, 255};
+
+    memset(buffer, 0, sizeof(buffer));
+    hagl_bitmap_init(&bitmap, TEST_WIDTH, TEST_HEIGHT, TEST_DEPTH, buffer);
+    hagl_gradient_table(&bitmap, colors, 64, from, to);
+}
+
+static void teardown_callback(void *data) {
+    char filename[256];
+    snprintf(filename, sizeof(filename), "output/%s.png", greatest_info.name_buf);
+    save_image(&bitmap, filename);
+}
+
+/* Index of the color in the table or -1. */
+static int16_t color_index(hagl_color_t color) {
+    for (int16_t i = 0; i < 64; i++) {
+        if (colors[i] == color) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+TEST test_gradient_table(void) {
+    ASSERT_EQ(hagl_color(&bitmap, 255, 0, 0), colors[0]);
+    ASSERT_EQ(hagl_color(&bitmap, 0, 0, 255), colors[63]);
+    ASSERT_EQ(hagl_color(&bitmap, 126, 0, 129), colors[32]);
+
+    PASS();
+}
+
+/* Every row of a vertical gradient has one color from the table. */
+TEST test_gradient_vertical(void) {
+    hagl_gradient_t gradient;
+    hagl_gradient_linear(&gradient, 0, 40, 0, 103, colors, 64);
+    hagl_fill_rectangle_span(
+        &bitmap, 0, 0, TEST_WIDTH - 1, 149, hagl_span_gradient, &gradient
+    );
+
+    for (int16_t y = 0; y < 150; y++) {
+        int16_t expected = y - 40;
+        if (expected < 0) {
+            expected = 0;
+        }
+        if (expected > 63) {
+            expected = 63;
+        }
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            ASSERT_EQ(colors[expected], hagl_get_pixel(&bitmap, x, y));
+        }
+    }
+
+    PASS();
+}
+
+/*
+ * Horizontal gradient is longer than the shader buffer. Neighbouring table
+ * colors can be equal in RGB565 so only the order is checked.
+ */
+TEST test_gradient_horizontal(void) {
+    hagl_gradient_t gradient;
+    hagl_gradient_linear(&gradient, 10, 0, 310, 0, colors, 64);
+    hagl_fill_rectangle_span(
+        &bitmap, 0, 0, TEST_WIDTH - 1, 9, hagl_span_gradient, &gradient
+    );
+
+    for (int16_t y = 0; y < 10; y++) {
+        ASSERT_EQ(colors[0], hagl_get_pixel(&bitmap, 0, y));
+        ASSERT_EQ(colors[0], hagl_get_pixel(&bitmap, 10, y));
+        ASSERT_EQ(colors[63], hagl_get_pixel(&bitmap, 310, y));
+        ASSERT_EQ(colors[63], hagl_get_pixel(&bitmap, 319, y));
+
+        int16_t previous = 0;
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            int16_t index = color_index(hagl_get_pixel(&bitmap, x, y));
+            ASSERT(index >= previous);
+            previous = index;
+        }
+    }
+
+    PASS();
+}
+
+/* Pixels at the same distance along the line have the same color. */
+TEST test_gradient_diagonal(void) {
+    hagl_gradient_t gradient;
+    hagl_gradient_linear(&gradient, 0, 0, 100, 100, colors, 64);
+    hagl_fill_rectangle_span(&bitmap, 0, 0, 99, 99, hagl_span_gradient, &gradient);
+
+    for (int16_t i = 0; i < 100; i++) {
+        ASSERT_EQ(hagl_get_pixel(&bitmap, i, 99 - i), hagl_get_pixel(&bitmap, 0, 99));
+    }
+    ASSERT_EQ(colors[0], hagl_get_pixel(&bitmap, 0, 0));
+    ASSERT_EQ(colors[63], hagl_get_pixel(&bitmap, 99, 99));
+
+    PASS();
+}
+
+TEST test_gradient_radial(void) {
+    hagl_gradient_t gradient;
+    hagl_gradient_radial(&gradient, 160, 120, 63, colors, 64);
+    hagl_fill_circle_span(&bitmap, 160, 120, 80, hagl_span_gradient, &gradient);
+
+    ASSERT_EQ(colors[0], hagl_get_pixel(&bitmap, 160, 120));
+    ASSERT_EQ(colors[10], hagl_get_pixel(&bitmap, 170, 120));
+    ASSERT_EQ(colors[10], hagl_get_pixel(&bitmap, 160, 110));
+    ASSERT_EQ(colors[5], hagl_get_pixel(&bitmap, 163, 124));
+    ASSERT_EQ(colors[63], hagl_get_pixel(&bitmap, 223, 120));
+    ASSERT_EQ(colors[63], hagl_get_pixel(&bitmap, 160, 200));
+    ASSERT_EQ(colors[63], hagl_get_pixel(&bitmap, 100, 80));
+    ASSERT_EQ(0, hagl_get_pixel(&bitmap, 160, 201));
+
+    for (int16_t y = 40; y <= 200; y++) {
+        for (int16_t x = 80; x <= 240; x++) {
+            int32_t dx = x - 160;
+            int32_t dy = y - 120;
+            int32_t d = 0;
+            while ((d + 1) * (d + 1) <= dx * dx + dy * dy) {
+                d++;
+            }
+            hagl_color_t pixel = hagl_get_pixel(&bitmap, x, y);
+            if (pixel) {
+                ASSERT_EQ(colors[d < 63 ? d : 63], pixel);
+            }
+        }
+    }
+
+    PASS();
+}
+
+TEST test_pattern(void) {
+    static uint16_t tile[3 * 5];
+    hagl_bitmap_t texture;
+    hagl_pattern_t pattern = {.bitmap = &texture, .x0 = 7, .y0 = -2};
+
+    for (uint16_t i = 0; i < 15; i++) {
+        tile[i] = i + 1;
+    }
+    hagl_bitmap_init(&texture, 3, 5, 16, tile);
+
+    hagl_fill_rectangle_span(
+        &bitmap, 0, 0, TEST_WIDTH - 1, 30, hagl_span_pattern, &pattern
+    );
+
+    for (int16_t y = 0; y < 31; y++) {
+        for (int16_t x = 0; x < TEST_WIDTH; x++) {
+            int16_t tx = ((x - 7) % 3 + 3) % 3;
+            int16_t ty = ((y + 2) % 5 + 5) % 5;
+            ASSERT_EQ(tile[ty * 3 + tx], hagl_get_pixel(&bitmap, x, y));
+        }
+    }
+
+    PASS();
+}
+
+TEST test_shader_clip(void) {
+    hagl_gradient_t gradient;
+    hagl_gradient_linear(&gradient, 0, 0, 63, 0, colors, 64);
+    hagl_set_clip(&bitmap, 20, 20, 40, 40);
+    hagl_fill_rectangle_span(&bitmap, 0, 0, 100, 100, hagl_span_gradient, &gradient);
+
+    for (int16_t y = 0; y < 100; y++) {
+        for (int16_t x = 0; x < 100; x++) {
+            hagl_color_t pixel = hagl_get_pixel(&bitmap, x, y);
+            if (x >= 20 && x <= 40 && y >= 20 && y <= 40) {
+                ASSERT_EQ(colors[x], pixel);
+            } else {
+                ASSERT_EQ(0, pixel);
+            }
+        }
+    }
+
+    PASS();
+}
+
+/* Shaded shapes cover the same pixels as solid ones. */
+TEST test_shader_shapes(void) {
+    static uint8_t solid[sizeof(buffer)];
+    int16_t vertices[10] = {20, 20, 200, 40, 300, 200, 100, 220, 60, 100};
+    hagl_gradient_t gradient;
+    hagl_gradient_linear(&gradient, 0, 0, TEST_WIDTH, TEST_HEIGHT, colors, 64);
+
+    for (uint8_t shape = 0; shape < 3; shape++) {
+        memset(buffer, 0, sizeof(buffer));
+        if (0 == shape) {
+            hagl_fill_polygon(&bitmap, 5, vertices, 0xFFFF);
+        } else if (1 == shape) {
+            hagl_fill_circle(&bitmap, 150, 110, 90, 0xFFFF);
+        } else {
+            hagl_fill_rounded_rectangle_xyxy(&bitmap, 10, 20, 300, 200, 30, 0xFFFF);
+        }
+        memcpy(solid, buffer, sizeof(buffer));
+
+        memset(buffer, 0, sizeof(buffer));
+        if (0 == shape) {
+            hagl_fill_polygon_span(&bitmap, 5, vertices, hagl_span_gradient, &gradient);
+        } else if (1 == shape) {
+            hagl_fill_circle_span(&bitmap, 150, 110, 90, hagl_span_gradient, &gradient);
+        } else {
+            hagl_fill_rounded_rectangle_span(
+                &bitmap, 10, 20, 300, 200, 30, hagl_span_gradient, &gradient
+            );
+        }
+
+        for (size_t i = 0; i < sizeof(buffer); i += 2) {
+            uint16_t a, b;
+            memcpy(&a, solid + i, 2);
+            memcpy(&b, buffer + i, 2);
+            ASSERT_EQ(0 != a, 0 != b);
+        }
+    }
+
+    PASS();
+}
+
+/* Each pixel of a rounded rectangle is drawn exactly once. */
+TEST test_rounded_rectangle_span_once(void) {
+    hagl_alpha_t paint = {.color = 0xFFFF, .alpha = 128};
+    hagl_color_t once = hagl_blend(&bitmap, 0xFFFF, 0, 128);
+
+    for (int16_t r = 0; r < 40; r += 3) {
+        memset(buffer, 0, sizeof(buffer));
+        hagl_fill_rounded_rectangle_span(
+            &bitmap, 10, 10, 100 + r, 70, r, hagl_span_alpha, &paint
+        );
+        for (int16_t y = 0; y < 100; y++) {
+            for (int16_t x = 0; x < 160; x++) {
+                hagl_color_t pixel = hagl_get_pixel(&bitmap, x, y);
+                ASSERT(0 == pixel || once == pixel);
+            }
+        }
+        ASSERT_EQ(once, hagl_get_pixel(&bitmap, 50, 40));
+    }
+
+    PASS();
+}
+
+SUITE(shader_suite) {
+    SET_SETUP(setup_callback, NULL);
+    SET_TEARDOWN(teardown_callback, NULL);
+    RUN_TEST(test_gradient_table);
+    RUN_TEST(test_gradient_vertical);
+    RUN_TEST(test_gradient_horizontal);
+    RUN_TEST(test_gradient_diagonal);
+    RUN_TEST(test_gradient_radial);
+    RUN_TEST(test_pattern);
+    RUN_TEST(test_shader_clip);
+    RUN_TEST(test_shader_shapes);
+    RUN_TEST(test_rounded_rectangle_span_once);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+    GREATEST_MAIN_BEGIN();
+    RUN_SUITE(shader_suite);
+    GREATEST_MAIN_END();
+}
@@ -0,0 +1,266 @@
+#!/usr/bin/env python3
+#
+# MIT License
+#
+# Copyright (c) 2026 Mika Tuupola
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# -cut-
+#
+# This file is part of the HAGL graphics library:
+# https://github.com/tuupola/hagl
+#
+# SPDX-License-Identifier: MIT
+#
+
+"""
+Convert a BDF or TrueType font to a HFNT font C header.
+
+BDF fonts are converted as is with one bit per pixel. TrueType fonts are
+rasterized with Pillow and can be antialiased with 2 or 4 bits per pixel.
+
+    tools/hfont.py --bpp 4 --size 14 --range 32-126 DejaVuSans.ttf font.h
+    tools/hfont.py --range 32-126 --range 160-255 6x13.bdf font.h
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+
+class Glyph:
+    def __init__(self, code, width, height, x_offset, y_offset, advance, pixels):
+        self.code = code
+        self.width = width
+        self.height = height
+        self.x_offset = x_offset
+        self.y_offset = y_offset
+        self.advance = advance
+        # Row major coverage values, already quantized to bpp.
+        self.pixels = pixels
+
+
+def parse_ranges(values):
+    codes = set()
+    for value in values:
+        if "-" in value:
+            first, last = value.split("-", 1)
+            codes.update(range(int(first, 0), int(last, 0) + 1))
+        else:
+            codes.add(int(value, 0))
+    return sorted(codes)
+
+
+def load_bdf(filename, codes):
+    glyphs = {}
+    ascent = descent = None
+    bbox = None
+
+    with open(filename, "r", encoding="latin-1") as file:
+        lines = iter(file.read().splitlines())
+
+    for line in lines:
+        if line.startswith("FONT_ASCENT"):
+            ascent = int(line.split()[1])
+        elif line.startswith("FONT_DESCENT"):
+            descent = int(line.split()[1])
+        elif line.startswith("FONTBOUNDINGBOX"):
+            bbox = [int(value) for value in line.split()[1:5]]
+        elif line.startswith("STARTCHAR"):
+            code = advance = None
+            width = height = xoff = yoff = 0
+            rows = []
+            for line in lines:
+                if line.startswith("ENCODING"):
+                    code = int(line.split()[1])
+                elif line.startswith("DWIDTH"):
+                    advance = int(line.split()[1])
+                elif line.startswith("BBX"):
+                    width, height, xoff, yoff = [int(v) for v in line.split()[1:5]]
+                elif line.startswith("BITMAP"):
+                    for line in lines:
+                        if line.startswith("ENDCHAR"):
+                            break
+                        rows.append(int(line, 16) if line.strip() else 0)
+                    break
+
+            if code not in codes:
+                continue
+
+            if ascent is None:
+                ascent = bbox[1] + bbox[3]
+            pixels = []
+            bits = ((width + 7) // 8) * 8
+            for row in rows:
+                for x in range(width):
+                    pixels.append((row >> (bits - 1 - x)) & 1)
+
+            glyphs[code] = Glyph(
+                code, width, height, xoff, ascent - (yoff + height), advance, pixels
+            )
+
+    if ascent is None or descent is None:
+        ascent = bbox[1] + bbox[3]
+        descent = -bbox[3]
+
+    return glyphs, ascent + descent, ascent
+
+
+def load_truetype(filename, codes, size, bpp):
+    try:
+        from PIL import Image, ImageDraw, ImageFont
+    except ImportError:
+        sys.exit("TrueType fonts require Pillow: pip install pillow")
+
+    font = ImageFont.truetype(filename, size)
+    ascent, descent = font.getmetrics()
+    maximum = (1 << bpp) - 1
+    glyphs = {}
+
+    for code in codes:
+        char = chr(code)
+        if not font.getmask(char).getbbox() and not char.isspace():
+            continue
+
+        advance = int(round(font.getlength(char)))
+        pad = size
+        image = Image.new("L", (advance + 2 * pad, ascent + descent + 2 * pad), 0)
+        draw = ImageDraw.Draw(image)
+        draw.text((pad, pad + ascent), char, font=font, fill=255, anchor="ls")
+
+        box = image.getbbox()
+        if box is None:
+            glyphs[code] = Glyph(code, 0, 0, 0, 0, advance, [])
+            continue
+
+        left, top, right, bottom = box
+        crop = image.crop(box)
+        pixels = [(value * maximum + 127) // 255 for value in crop.tobytes()]
+        glyphs[code] = Glyph(
+            code, right - left, bottom - top, left - pad, top - pad, advance, pixels
+        )
+
+    return glyphs, ascent + descent, ascent
+
+
+def pack(glyph, bpp):
+    data = bytearray()
+    accumulator = 0
+    bits = 0
+    for value in glyph.pixels:
+        accumulator = (accumulator << bpp) | value
+        bits += bpp
+        if 8 == bits:
+            data.append(accumulator)
+            accumulator = 0
+            bits = 0
+    if bits:
+        data.append(accumulator << (8 - bits))
+    return bytes(data)
+
+
+def build(glyphs, height, ascent, bpp):
+    codes = sorted(glyphs)
+
+    # Consecutive codes share a range.
+    ranges = []
+    for index, code in enumerate(codes):
+        if ranges and ranges[-1][1] + 1 == code:
+            ranges[-1][1] = code
+        else:
+            ranges.append([code, code, index])
+
+    table = bytearray()
+    bitmaps = bytearray()
+    for code in codes:
+        glyph = glyphs[code]
+        table += struct.pack("<I", len(bitmaps))[:3]
+        table += struct.pack(
+            "<BBbbB",
+            glyph.width,
+            glyph.height,
+            glyph.x_offset,
+            glyph.y_offset,
+            glyph.advance,
+        )
+        bitmaps += pack(glyph, bpp)
+
+    font = bytearray(b"HFNT")
+    font += struct.pack("<BBBBHH", 1, bpp, height, ascent, len(ranges), len(codes))
+    for first, last, index in ranges:
+        font += struct.pack("<HHH", first, last, index)
+    font += table
+    font += bitmaps
+
+    return bytes(font)
+
+
+def write_header(filename, name, font, source):
+    with open(filename, "w") as file:
+        file.write("/*\n\nHFNT version of %s.\n\n*/\n" % os.path.basename(source))
+        file.write("// clang-format off\n")
+        file.write("const unsigned char %s[] = {\n" % name)
+        for offset in range(0, len(font), 12):
+            row = ", ".join("0x%02x" % value for value in font[offset : offset + 12])
+            file.write("    %s,\n" % row)
+        file.write("};\n")
+        file.write("// clang-format on\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a font to HFNT C header.")
+    parser.add_argument("input", help="BDF or TrueType font")
+    parser.add_argument("output", help="C header file")
+    parser.add_argument("--name", help="name of the C array")
+    parser.add_argument("--size", type=int, default=12, help="TrueType pixel size")
+    parser.add_argument("--bpp", type=int, default=1, choices=[1, 2, 4])
+    parser.add_argument(
+        "--range",
+        action="append",
+        default=[],
+        help="code point or range such as 32-126, can be repeated",
+    )
+    args = parser.parse_args()
+
+    codes = parse_ranges(args.range or ["32-126"])
+
+    if args.input.lower().endswith(".bdf"):
+        if 1 != args.bpp:
+            sys.exit("BDF fonts support only one bit per pixel")
+        glyphs, height, ascent = load_bdf(args.input, codes)
+    else:
+        glyphs, height, ascent = load_truetype(args.input, codes, args.size, args.bpp)
+
+    if not glyphs:
+        sys.exit("No glyphs found")
+
+    name = args.name
+    if not name:
+        name = os.path.splitext(os.path.basename(args.output))[0]
+        name = re.sub(r"\W", "_", name)
+
+    font = build(glyphs, height, ascent, args.bpp)
+    write_header(args.output, name, font, args.input)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+#
+# MIT License
+#
+# Copyright (c) 2026 Mika Tuupola
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# -cut-
+#
+# This file is part of the HAGL graphics library:
+# https://github.com/tuupola/hagl
+#
+# SPDX-License-Identifier: MIT
+#
+
+"""
+Convert an image to a HRLE run length encoded bitmap C header.
+
+Pixels are converted to the raw color values of the target depth. Fully
+or mostly transparent pixels are mapped to a transparent color which is
+skipped when drawing. Flat colored icons and UI assets compress well.
+
+    tools/hrle.py --depth 16 icon.png icon.h
+    tools/hrle.py --depth 16 --transparent 0xf81f sprite.bmp sprite.h
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+HRLE_RUN = 0x80
+HRLE_MAX_COUNT = 128
+HRLE_FLAG_TRANSPARENT = 0x01
+
+
+def rgb332(r, g, b):
+    return (r & 0xE0) | ((g & 0xE0) >> 3) | (b >> 6)
+
+
+def rgb565(r, g, b, swap):
+    color = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+    if swap:
+        color = ((color & 0xFF) << 8) | (color >> 8)
+    return color
+
+
+def convert(pixel, depth, swap):
+    r, g, b = pixel[:3]
+    if 8 == depth:
+        return rgb332(r, g, b)
+    if 16 == depth:
+        return rgb565(r, g, b, swap)
+    return (r << 16) | (g << 8) | b
+
+
+def load(filename, depth, swap, key):
+    from PIL import Image
+
+    image = Image.open(filename).convert("RGBA")
+    width, height = image.size
+    data = image.tobytes()
+    pixels = [data[offset : offset + 4] for offset in range(0, len(data), 4)]
+
+    colors = [convert(pixel, depth, swap) for pixel in pixels]
+    masked = [pixel[3] < 128 for pixel in pixels]
+
+    if any(masked) and key is None:
+        # Pick a transparent color which is not used by any opaque pixel.
+        used = set(color for color, mask in zip(colors, masked) if not mask)
+        key = next(color for color in range(1 << depth) if color not in used)
+
+    if key is not None:
+        colors = [key if mask else color for color, mask in zip(colors, masked)]
+
+    rows = [colors[y * width : (y + 1) * width] for y in range(height)]
+    return width, height, rows, key
+
+
+def encode_row(row, depth, key):
+    size = depth // 8
+    data = bytearray()
+    literal = []
+
+    def flush():
+        while literal:
+            chunk = literal[:HRLE_MAX_COUNT]
+            del literal[:HRLE_MAX_COUNT]
+            data.append(len(chunk) - 1)
+            for color in chunk:
+                data.extend(color.to_bytes(size, "little"))
+
+    x = 0
+    while x < len(row):
+        end = x
+        while end < len(row) and row[end] == row[x]:
+            end += 1
+        count = end - x
+
+        # Single pixels go to literals unless they are transparent.
+        if 1 == count and row[x] != key:
+            literal.append(row[x])
+        else:
+            flush()
+            while count:
+                chunk = min(count, HRLE_MAX_COUNT)
+                data.append(HRLE_RUN | (chunk - 1))
+                data.extend(row[x].to_bytes(size, "little"))
+                count -= chunk
+        x = end
+
+    flush()
+    return bytes(data)
+
+
+def build(width, height, rows, depth, key):
+    flags = HRLE_FLAG_TRANSPARENT if key is not None else 0
+    rle = bytearray(b"HRLE")
+    rle += struct.pack("<BBHHBBI", 1, depth, width, height, flags, 0, key or 0)
+    for row in rows:
+        rle += encode_row(row, depth, key)
+    return bytes(rle)
+
+
+def write_header(filename, name, rle, source):
+    with open(filename, "w") as file:
+        file.write("/*\n\nHRLE version of %s.\n\n*/\n" % os.path.basename(source))
+        file.write("// clang-format off\n")
+        file.write("const unsigned char %s[] = {\n" % name)
+        for offset in range(0, len(rle), 12):
+            row = ", ".join("0x%02x" % value for value in rle[offset : offset + 12])
+            file.write("    %s,\n" % row)
+        file.write("};\n")
+        file.write("// clang-format on\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an image to HRLE C header.")
+    parser.add_argument("input", help="image file readable by Pillow")
+    parser.add_argument("output", help="C header file")
+    parser.add_argument("--name", help="name of the C array")
+    parser.add_argument("--depth", type=int, default=16, choices=[8, 16, 24, 32])
+    parser.add_argument(
+        "--transparent",
+        type=lambda value: int(value, 0),
+        help="raw color value used for transparent pixels",
+    )
+    parser.add_argument(
+        "--no-swap",
+        action="store_true",
+        help="do not swap bytes of RGB565 colors like rgb565() does",
+    )
+    args = parser.parse_args()
+
+    width, height, rows, key = load(
+        args.input, args.depth, not args.no_swap, args.transparent
+    )
+
+    if width > 0xFFFF or height > 0xFFFF:
+        sys.exit("Image is too big")
+
+    name = args.name
+    if not name:
+        name = os.path.splitext(os.path.basename(args.output))[0]
+        name = re.sub(r"\W", "_", name)
+
+    rle = build(width, height, rows, args.depth, key)
+    write_header(args.output, name, rle, args.input)
+
+
+if __name__ == "__main__":
+    main()